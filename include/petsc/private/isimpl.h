@@ -49,6 +49,10 @@ struct _p_IS {
 
 extern PetscErrorCode ISLoad_Default(IS, PetscViewer);
 
+PETSC_INTERN PetscErrorCode ISDifference_Interval(IS,IS,IS*);
+PETSC_INTERN PetscErrorCode ISSum_Interval(IS,IS,PetscBool*,IS*);
+PETSC_INTERN PetscErrorCode ISExpand_Interval(IS,IS,PetscBool*,IS*);
+
 struct _ISLocalToGlobalMappingOps {
   PetscErrorCode (*globaltolocalmappingsetup)(ISLocalToGlobalMapping);
   PetscErrorCode (*globaltolocalmappingapply)(ISLocalToGlobalMapping,ISGlobalToLocalMappingMode,PetscInt,const PetscInt[],PetscInt*,PetscInt[]);
@@ -63,6 +67,7 @@ struct _p_ISLocalToGlobalMapping{
   PetscInt    *indices;         /* global index of each local index */
   PetscInt     globalstart;     /* first global referenced in indices */
   PetscInt     globalend;       /* last + 1 global referenced in indices */
+  PetscReal    hashratio;       /* without a type, use a hash table when the span of the indices exceeds this multiple of their number */
   PetscBool    info_cached;     /* reuse GetInfo */
   PetscBool    info_free;
   PetscInt     info_nproc;
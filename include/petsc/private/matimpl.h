@@ -5,6 +5,7 @@
 #include <petscmat.h>
 #include <petscmatcoarsen.h>
 #include <petsc/private/petscimpl.h>
+#include <petsc/private/hashmapijv.h>
 
 PETSC_EXTERN PetscBool MatRegisterAllCalled;
 PETSC_EXTERN PetscBool MatSeqAIJRegisterAllCalled;
@@ -331,6 +332,21 @@ struct _MatStash {
   MPI_Datatype   blocktype;
   size_t         blocktype_size;
   InsertMode     *insertmode;   /* Pointer to check mat->insertmode and set upon message arrival in case no local values have been set. */
+
+  /* The following variables are used when the off-process entries are frozen with MAT_SAME_OFF_PROC_ENTRIES */
+  PetscBool      frozen;          /* The entries of the recording assembly are known, later assemblies only exchange values */
+  PetscBool      frozen_record;   /* The current assembly records the entries */
+  PetscBool      frozen_values;   /* The current exchange carries values only */
+  PetscInt       frozen_count;    /* Number of recordings, tells the matrix when data derived from the received entries is stale */
+  PetscInt       frozen_n;        /* Number of entries stashed in the recording assembly */
+  PetscInt       *frozen_idx;     /* Their rows and columns, interlaced, in stashing order */
+  PetscInt       *frozen_map;     /* Their location in frozen_sendvals[] */
+  PetscInt       frozen_nsend;    /* Number of entries sent, sorted by row and column and without duplicates */
+  PetscInt       *frozen_sendidx; /* Their rows and columns, interlaced */
+  PetscInt       *frozen_sendoffset,*frozen_recvoffset; /* First entry exchanged with sendranks[i] and recvranks[i] */
+  PetscInt       frozen_nrecv;    /* Number of entries received, in the order of recvranks[] */
+  PetscInt       *frozen_recvrows,*frozen_recvcols;
+  PetscScalar    *frozen_sendvals,*frozen_recvvals; /* The message to or from rank i starts at frozen_*offset[i]*bs2+i and ends with one entry encoding the InsertMode */
 };
 
 PETSC_INTERN PetscErrorCode MatStashCreate_Private(MPI_Comm,PetscInt,MatStash*);
@@ -344,6 +360,7 @@ PETSC_INTERN PetscErrorCode MatStashValuesRowBlocked_Private(MatStash*,PetscInt,
 PETSC_INTERN PetscErrorCode MatStashValuesColBlocked_Private(MatStash*,PetscInt,PetscInt,const PetscInt[],const PetscScalar[],PetscInt,PetscInt,PetscInt);
 PETSC_INTERN PetscErrorCode MatStashScatterBegin_Private(Mat,MatStash*,PetscInt*);
 PETSC_INTERN PetscErrorCode MatStashScatterGetMesg_Private(MatStash*,PetscMPIInt*,PetscInt**,PetscInt**,PetscScalar**,PetscInt*);
+PETSC_INTERN PetscErrorCode MatStashScatterGetFrozenMesg_Private(MatStash*,PetscMPIInt*,PetscInt*,PetscScalar**,PetscInt*);
 PETSC_INTERN PetscErrorCode MatGetInfo_External(Mat,MatInfoType,MatInfo*);
 
 typedef struct {
@@ -395,6 +412,7 @@ struct _p_Mat {
   PetscBool              symmetric_eternal;
   PetscBool              nooffprocentries,nooffproczerorows;
   PetscBool              subsetoffprocentries;
+  PetscBool              sameoffprocentries;
   PetscBool              submat_singleis; /* for efficient PCSetUP_ASM() */
   PetscBool              structure_only;
 #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
@@ -413,6 +431,10 @@ struct _p_Mat {
   PetscInt               factorerror_zeropivot_row;     /* Row where zero pivot was detected */
   PetscInt               nblocks,*bsizes;   /* support for MatSetVariableBlockSizes() */
   char                   *defaultvectype;
+  PetscBool              hash_active;       /* values are kept in hash_ht until the final assembly, see MatSetUp_SeqAIJ() */
+  PetscHMapIJV           hash_ht;
+  struct _MatOps         *hash_ops;         /* operations of the matrix type, restored at the end of the hash assembly */
+  PetscInt               *hash_rowi,*hash_rowj,hash_rownz; /* sorted columns of the local rows of hash_ht when it had hash_rownz entries */
 };
 
 PETSC_INTERN PetscErrorCode MatAXPY_Basic(Mat,PetscScalar,Mat,MatStructure);
@@ -1649,6 +1671,8 @@ PETSC_EXTERN PetscLogEvent MAT_Scale;
 PETSC_EXTERN PetscLogEvent MAT_AssemblyBegin;
 PETSC_EXTERN PetscLogEvent MAT_AssemblyEnd;
 PETSC_EXTERN PetscLogEvent MAT_SetValues;
+PETSC_EXTERN PetscLogEvent MAT_PreallCOO;
+PETSC_EXTERN PetscLogEvent MAT_SetVCOO;
 PETSC_EXTERN PetscLogEvent MAT_GetValues;
 PETSC_EXTERN PetscLogEvent MAT_GetRow;
 PETSC_EXTERN PetscLogEvent MAT_GetRowIJ;
@@ -783,6 +783,8 @@ PETSC_EXTERN PetscMPIInt Petsc_OuterComm_keyval;
 PETSC_EXTERN PetscMPIInt Petsc_Seq_keyval;
 PETSC_EXTERN PetscMPIInt Petsc_ShmComm_keyval;
 
+PETSC_INTERN PetscErrorCode PetscShmCommGetLeaderComm(PetscShmComm,MPI_Comm*,const PetscMPIInt**,const PetscMPIInt**);
+
 /*
   PETSc communicators have this attribute, see
   PetscCommDuplicate(), PetscCommDestroy(), PetscCommGetNewTag(), PetscObjectGetName()
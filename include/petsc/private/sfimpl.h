@@ -27,6 +27,8 @@ struct _PetscSFOps {
   PetscErrorCode (*ReduceEnd)(PetscSF,MPI_Datatype,const void*,void*,MPI_Op);
   PetscErrorCode (*FetchAndOpBegin)(PetscSF,MPI_Datatype,void*,const void*,void*,MPI_Op);
   PetscErrorCode (*FetchAndOpEnd)(PetscSF,MPI_Datatype,void*,const void *,void *,MPI_Op);
+  PetscErrorCode (*BatchBegin)(PetscSF);
+  PetscErrorCode (*BatchEnd)(PetscSF);
 };
 
 struct _p_PetscSF {
@@ -93,6 +93,7 @@ struct _VecOps {
   PetscErrorCode (*restorelocalvector)(Vec,Vec);
   PetscErrorCode (*getlocalvectorread)(Vec,Vec);
   PetscErrorCode (*restorelocalvectorread)(Vec,Vec);
+  PetscErrorCode (*axpbypczdotnorm)(Vec,PetscScalar,PetscScalar,PetscScalar,Vec,Vec,Vec,PetscScalar*,PetscReal*); /* z = alpha x + beta y + gamma z, (z,w), ||z||_2 */
 };
 
 /*
@@ -127,6 +128,16 @@ typedef struct {
   PetscBool     ignorenegidx;           /* ignore negative indices passed into VecSetValues/VetGetValues */
   InsertMode    insertmode;
   PetscInt      *bowners;
+  /* Once the communication pattern is frozen the values are stashed directly into one buffer per destination */
+  PetscBool      frozen;
+  PetscMPIInt    ndests;                /* number of destinations */
+  PetscMPIInt    *dests;                /* ranks of the destinations, sorted */
+  PetscMPIInt    dlast;                 /* destination of the most recently stashed value */
+  const PetscInt *range;                /* ownership ranges of the vector */
+  PetscInt       *dn,*dnmax;            /* number of values in, and capacity of, the buffer for each destination */
+  PetscInt       *dlimit;               /* number of values each destination can receive */
+  PetscInt       **didx;                /* global row numbers for each destination */
+  PetscScalar    **darray;              /* values for each destination */
 } VecStash;
 
 struct _p_Vec {
@@ -174,6 +185,7 @@ PETSC_EXTERN PetscLogEvent VEC_Swap;
 PETSC_EXTERN PetscLogEvent VEC_AssemblyBegin;
 PETSC_EXTERN PetscLogEvent VEC_DotNorm2;
 PETSC_EXTERN PetscLogEvent VEC_AXPBYPCZ;
+PETSC_EXTERN PetscLogEvent VEC_AXPBYPCZDotNorm;
 PETSC_EXTERN PetscLogEvent VEC_Ops;
 PETSC_EXTERN PetscLogEvent VEC_ViennaCLCopyToGPU;
 PETSC_EXTERN PetscLogEvent VEC_ViennaCLCopyFromGPU;
@@ -206,6 +218,8 @@ PETSC_EXTERN PetscErrorCode VecCUDACopyFromGPU(Vec v);
 PETSC_EXTERN PetscErrorCode VecDuplicateVecs_Default(Vec,PetscInt,Vec *[]);
 PETSC_EXTERN PetscErrorCode VecDestroyVecs_Default(PetscInt,Vec []);
 PETSC_INTERN PetscErrorCode VecLoad_Binary(Vec, PetscViewer);
+PETSC_INTERN PetscErrorCode VecView_Binary_Compressed(Vec,PetscViewer);
+PETSC_INTERN PetscErrorCode VecLoad_Binary_Compressed(Vec,PetscViewer);
 PETSC_EXTERN PetscErrorCode VecLoad_Default(Vec, PetscViewer);
 
 PETSC_EXTERN PetscInt  NormIds[7];  /* map from NormType to IDs used to cache/retreive values of norms */
@@ -220,6 +234,10 @@ PETSC_INTERN PetscErrorCode VecStashScatterBegin_Private(VecStash*,PetscInt*);
 PETSC_INTERN PetscErrorCode VecStashScatterGetMesg_Private(VecStash*,PetscMPIInt*,PetscInt**,PetscScalar**,PetscInt*);
 PETSC_INTERN PetscErrorCode VecStashSortCompress_Private(VecStash*);
 PETSC_INTERN PetscErrorCode VecStashGetOwnerList_Private(VecStash*,PetscLayout,PetscMPIInt*,PetscMPIInt**);
+PETSC_INTERN PetscErrorCode VecStashFreeze_Private(VecStash*,PetscLayout,PetscMPIInt,const PetscMPIInt[],const PetscInt[]);
+PETSC_INTERN PetscErrorCode VecStashUnfreeze_Private(VecStash*);
+PETSC_INTERN PetscErrorCode VecStashGetFrozenValues_Private(VecStash*,PetscMPIInt,PetscInt*,PetscInt**,PetscScalar**);
+PETSC_INTERN PetscErrorCode VecStashValueFrozen_Private(VecStash*,PetscInt,PetscScalar);
 
 /*
   VecStashValue_Private - inserts a single value into the stash.
@@ -232,6 +250,10 @@ PETSC_INTERN PetscErrorCode VecStashGetOwnerList_Private(VecStash*,PetscLayout,P
 PETSC_STATIC_INLINE PetscErrorCode VecStashValue_Private(VecStash *stash,PetscInt row,PetscScalar value)
 {
   PetscErrorCode ierr;
+  if ((stash)->frozen) {
+    ierr = VecStashValueFrozen_Private(stash,row,value);CHKERRQ(ierr);
+    return 0;
+  }
   /* Check and see if we have sufficient memory */
   if (((stash)->n + 1) > (stash)->nmax) {
     ierr = VecStashExpand_Private(stash,1);CHKERRQ(ierr);
@@ -316,4 +338,30 @@ PETSC_EXTERN PetscErrorCode VecTaggerRegisterAll(void);
 PETSC_EXTERN PetscErrorCode VecTaggerComputeIS_FromBoxes(VecTagger,Vec,IS*);
 PETSC_EXTERN PetscMPIInt Petsc_Reduction_keyval;
 
+/*
+   Requests queued in a VecReduction; each one owns one (two for NORM_1_AND_2) slots of the reduction buffers
+*/
+typedef enum {VEC_REDUCTION_DOT,VEC_REDUCTION_TDOT,VEC_REDUCTION_NORM,VEC_REDUCTION_MAX,VEC_REDUCTION_MIN,VEC_REDUCTION_SUM} VecReductionOp;
+
+typedef struct {
+  VecReductionOp    op;
+  NormType          ntype;
+  Vec               x,y;
+  PetscInt          slot;        /* first entry of lvalues/gvalues used by this request */
+  PetscScalar       *sresult;    /* where DOT, TDOT and SUM results go */
+  PetscReal         *rresult;    /* where NORM, MAX and MIN results go */
+  const PetscScalar *xa,*ya;     /* local arrays during the fused pass */
+} VecReductionRequest;
+
+struct _n_VecReduction {
+  MPI_Comm            comm;
+  PetscInt            nreq,maxreq;
+  VecReductionRequest *req;
+  PetscInt            nvalues,maxvalues;
+  PetscScalar         *lvalues,*gvalues;  /* 2*maxvalues long, the second half of lvalues holds the reduction types */
+  PetscInt            *reducetype;
+  MPI_Request         request;
+  PetscBool           pending;            /* VecReductionBegin() called but not yet VecReductionEnd() */
+};
+
 #endif
@@ -18,7 +18,7 @@ PETSC_EXTERN PetscErrorCode VecScatterRegisterAll(void);
 
 typedef enum { VEC_SCATTER_SEQ_GENERAL,VEC_SCATTER_SEQ_STRIDE,
                VEC_SCATTER_MPI_GENERAL,VEC_SCATTER_MPI_TOALL,
-               VEC_SCATTER_MPI_TOONE} VecScatterFormat;
+               VEC_SCATTER_MPI_TOONE,VEC_SCATTER_SF} VecScatterFormat;
 
 #define VECSCATTER_IMPL_HEADER \
       VecScatterFormat format;
@@ -99,6 +99,9 @@ typedef struct {
   MPI_Status             *sstatus,*rstatus;
   PetscInt               bs;
   PetscBool              contiq;
+  PetscInt               multin;        /* number of vectors multivalues can hold */
+  PetscScalar            *multivalues;  /* buffer for the messages of VecScatterBeginMulti(), vector after vector for each proc */
+  MPI_Request            *multirequests;
 #if defined(PETSC_HAVE_MPI_WIN_CREATE_FEATURE)      /* these uses windows for communication only within each node */
   PetscMPIInt            msize,sharedcnt;           /* total to entries that are going to processes with the same shared memory space */
   PetscScalar            *sharedspace;              /* space each process puts data to be read from other processes; allocated by MPI */
@@ -297,6 +300,8 @@ struct _VecScatterOps {
   PetscErrorCode (*viewfromoptions)(VecScatter,const char prefix[],const char name[]);
   PetscErrorCode (*remap)(VecScatter,PetscInt *,PetscInt*);
   PetscErrorCode (*getmerged)(VecScatter,PetscBool *);
+  PetscErrorCode (*beginmulti)(VecScatter,PetscInt,Vec*,Vec*,InsertMode,ScatterMode);
+  PetscErrorCode (*endmulti)(VecScatter,PetscInt,Vec*,Vec*,InsertMode,ScatterMode);
 };
 
 struct _p_VecScatter {
@@ -313,6 +318,9 @@ struct _p_VecScatter {
 
 PETSC_INTERN PetscErrorCode VecScatterCreate_Seq(VecScatter);
 PETSC_INTERN PetscErrorCode VecScatterCreate_MPI1(VecScatter);
+PETSC_INTERN PetscErrorCode VecScatterCreate_SF(VecScatter);
+PETSC_INTERN PetscErrorCode VecScatterSFCacheDestroy(void);
+PETSC_INTERN PetscErrorCode VecScatterRemap_SF(VecScatter,const PetscInt[],const PetscInt[]);
 PETSC_INTERN PetscErrorCode VecScatterCreate_MPI3(VecScatter);
 PETSC_INTERN PetscErrorCode VecScatterCreate_MPI3Node(VecScatter);
 
@@ -63,6 +63,8 @@ PETSC_EXTERN PetscErrorCode AOPetscToApplication(AO,PetscInt,PetscInt[]);
 PETSC_EXTERN PetscErrorCode AOApplicationToPetsc(AO,PetscInt,PetscInt[]);
 PETSC_EXTERN PetscErrorCode AOPetscToApplicationIS(AO,IS);
 PETSC_EXTERN PetscErrorCode AOApplicationToPetscIS(AO,IS);
+PETSC_EXTERN PetscErrorCode AOPetscToApplicationISs(AO,PetscInt,IS[]);
+PETSC_EXTERN PetscErrorCode AOApplicationToPetscISs(AO,PetscInt,IS[]);
 
 PETSC_EXTERN PetscErrorCode AOPetscToApplicationPermuteInt(AO, PetscInt, PetscInt[]);
 PETSC_EXTERN PetscErrorCode AOApplicationToPetscPermuteInt(AO, PetscInt, PetscInt[]);
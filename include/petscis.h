@@ -24,6 +24,7 @@ typedef const char* ISType;
 #define ISGENERAL      "general"
 #define ISSTRIDE       "stride"
 #define ISBLOCK        "block"
+#define ISINTERVAL     "interval"
 
 /* Dynamic creation and loading functions */
 PETSC_EXTERN PetscFunctionList ISList;
@@ -41,6 +42,10 @@ PETSC_EXTERN PetscErrorCode ISCreateBlock(MPI_Comm,PetscInt,PetscInt,const Petsc
 PETSC_EXTERN PetscErrorCode ISBlockSetIndices(IS,PetscInt,PetscInt,const PetscInt[],PetscCopyMode);
 PETSC_EXTERN PetscErrorCode ISCreateStride(MPI_Comm,PetscInt,PetscInt,PetscInt,IS *);
 PETSC_EXTERN PetscErrorCode ISStrideSetStride(IS,PetscInt,PetscInt,PetscInt);
+PETSC_EXTERN PetscErrorCode ISCreateInterval(MPI_Comm,PetscInt,const PetscInt[],const PetscInt[],IS*);
+PETSC_EXTERN PetscErrorCode ISIntervalSetIntervals(IS,PetscInt,const PetscInt[],const PetscInt[]);
+PETSC_EXTERN PetscErrorCode ISIntervalSetIndices(IS,PetscInt,const PetscInt[]);
+PETSC_EXTERN PetscErrorCode ISIntervalGetIntervals(IS,PetscInt*,const PetscInt*[],const PetscInt*[]);
 
 PETSC_EXTERN PetscErrorCode ISDestroy(IS*);
 PETSC_EXTERN PetscErrorCode ISSetPermutation(IS);
@@ -310,6 +315,7 @@ PETSC_EXTERN PetscErrorCode PetscLayoutGetRange(PetscLayout,PetscInt *,PetscInt
 PETSC_EXTERN PetscErrorCode PetscLayoutGetRanges(PetscLayout,const PetscInt *[]);
 PETSC_EXTERN PetscErrorCode PetscLayoutCompare(PetscLayout,PetscLayout,PetscBool*);
 PETSC_EXTERN PetscErrorCode PetscLayoutSetISLocalToGlobalMapping(PetscLayout,ISLocalToGlobalMapping);
+PETSC_EXTERN PetscErrorCode PetscParallelSortInt(PetscLayout,PetscLayout,PetscInt[],PetscInt[]);
 PETSC_EXTERN PetscErrorCode PetscSFSetGraphLayout(PetscSF,PetscLayout,PetscInt,const PetscInt*,PetscCopyMode,const PetscInt*);
 
 PETSC_EXTERN PetscClassId PETSC_SECTION_CLASSID;
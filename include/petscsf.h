@@ -21,12 +21,15 @@ $     PETSCSFBASIC which uses MPI 1 message passing to perform the communication
 $     PETSCSFWINDOW which uses MPI 2 one-sided operations to perform the communication, this may be more efficient,
 $                   but may not be available for all MPI distributions. In particular OpenMPI has bugs in its one-sided
 $                   operations that prevent its use.
+$     PETSCSFNEIGHBOR which uses MPI 3 neighborhood collectives on a distributed graph communicator, letting the MPI
+$                   implementation aggregate and schedule the messages of irregular communication patterns
 
 .seealso: PetscSFSetType(), PetscSF
 J*/
 typedef const char *PetscSFType;
 #define PETSCSFBASIC  "basic"
 #define PETSCSFWINDOW "window"
+#define PETSCSFNEIGHBOR "neighbor"
 
 /*E
     PetscSFWindowSyncType - Type of synchronization for PETSCSFWINDOW
@@ -95,6 +98,9 @@ PETSC_EXTERN PetscErrorCode PetscSFReduceBegin(PetscSF,MPI_Datatype,const void*,
   PetscAttrMPIPointerWithType(3,2) PetscAttrMPIPointerWithType(4,2);
 PETSC_EXTERN PetscErrorCode PetscSFReduceEnd(PetscSF,MPI_Datatype,const void*,void*,MPI_Op)
   PetscAttrMPIPointerWithType(3,2) PetscAttrMPIPointerWithType(4,2);
+/* Send the broadcasts and reductions started between them with one message per rank */
+PETSC_EXTERN PetscErrorCode PetscSFBatchBegin(PetscSF);
+PETSC_EXTERN PetscErrorCode PetscSFBatchEnd(PetscSF);
 /* Atomically modifies (using provided operation) rootdata using leafdata from each leaf, value at root at time of modification is returned in leafupdate. */
 PETSC_EXTERN PetscErrorCode PetscSFFetchAndOpBegin(PetscSF,MPI_Datatype,void*,const void*,void*,MPI_Op)
   PetscAttrMPIPointerWithType(3,2) PetscAttrMPIPointerWithType(4,2) PetscAttrMPIPointerWithType(5,2);
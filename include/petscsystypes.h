@@ -509,6 +509,8 @@ $  PETSC_BUILDTWOSIDED_IBARRIER - nonblocking algorithm based on MPI_Issend and
 $      Proved communication-optimal in Hoefler, Siebert, and Lumsdaine (2010). Requires MPI-3.
 $  PETSC_BUILDTWOSIDED_REDSCATTER - similar to above, but use more optimized function
 $      that only communicates the part of the reduction that is necessary.  Requires MPI-2.
+$  PETSC_BUILDTWOSIDED_NODE - node-aware algorithm that gathers the messages of each node on one leader rank,
+$      runs the rendezvous among the leaders only and scatters the messages back within the nodes. Requires MPI-3.
 
    Level: developer
 
@@ -518,7 +520,8 @@ typedef enum {
   PETSC_BUILDTWOSIDED_NOTSET = -1,
   PETSC_BUILDTWOSIDED_ALLREDUCE = 0,
   PETSC_BUILDTWOSIDED_IBARRIER = 1,
-  PETSC_BUILDTWOSIDED_REDSCATTER = 2
+  PETSC_BUILDTWOSIDED_REDSCATTER = 2,
+  PETSC_BUILDTWOSIDED_NODE = 3
   /* Updates here must be accompanied by updates in finclude/petscsys.h and the string array in mpits.c */
 } PetscBuildTwoSidedType;
 
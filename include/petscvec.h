@@ -105,6 +105,9 @@ typedef const char* VecType;
 #define VECCUDA        "cuda"       /* seqcuda on one process and mpicuda on several */
 #define VECNEST        "nest"
 #define VECNODE        "node"       /* use on-node shared memory */
+#define VECSEQSINGLE   "seqsingle"
+#define VECMPISINGLE   "mpisingle"
+#define VECSINGLE      "single"     /* seqsingle on one process and mpisingle on several, single precision storage */
 
 /*J
     VecScatterType - String with the name of a PETSc vector scatter type
@@ -118,6 +121,7 @@ typedef const char* VecScatterType;
 #define VECSCATTERMPI1      "mpi1"
 #define VECSCATTERMPI3      "mpi3"     /* use MPI3 on-node shared memory */
 #define VECSCATTERMPI3NODE  "mpi3node" /* use MPI3 on-node shared memory for vector type VECNODE */
+#define VECSCATTERSF        "sf"       /* use PetscSF, reusing the star forests of identical scatters */
 
 /* Dynamic creation and loading functions */
 PETSC_EXTERN PetscFunctionList VecScatterList;
@@ -132,6 +136,7 @@ PETSC_EXTERN PetscErrorCode VecScatterFinalizePackage(void);
 /* Logging support */
 #define    REAL_FILE_CLASSID 1211213
 #define    VEC_FILE_CLASSID 1211214
+#define    VEC_COMPRESSED_FILE_CLASSID 1211226
 PETSC_EXTERN PetscClassId VEC_CLASSID;
 PETSC_EXTERN PetscClassId VEC_SCATTER_CLASSID;
 
@@ -146,6 +151,7 @@ PETSC_EXTERN PetscErrorCode VecCreateSeqWithArray(MPI_Comm,PetscInt,PetscInt,con
 PETSC_EXTERN PetscErrorCode VecCreateMPIWithArray(MPI_Comm,PetscInt,PetscInt,PetscInt,const PetscScalar[],Vec*);
 PETSC_EXTERN PetscErrorCode VecCreateShared(MPI_Comm,PetscInt,PetscInt,Vec*);
 PETSC_EXTERN PetscErrorCode VecCreateNode(MPI_Comm,PetscInt,PetscInt,Vec*);
+PETSC_EXTERN PetscErrorCode VecCreateNodeGhost(MPI_Comm,PetscInt,PetscInt,PetscInt,const PetscInt[],Vec*);
 
 PETSC_EXTERN PetscErrorCode VecSetFromOptions(Vec);
 PETSC_STATIC_INLINE PetscErrorCode VecViewFromOptions(Vec A,PetscObject B,const char name[]) {return PetscObjectViewFromOptions((PetscObject)A,B,name);}
@@ -254,6 +260,9 @@ PETSC_EXTERN PetscErrorCode VecMAXPY(Vec,PetscInt,const PetscScalar[],Vec[]);
 PETSC_EXTERN PetscErrorCode VecAYPX(Vec,PetscScalar,Vec);
 PETSC_EXTERN PetscErrorCode VecWAXPY(Vec,PetscScalar,Vec,Vec);
 PETSC_EXTERN PetscErrorCode VecAXPBYPCZ(Vec,PetscScalar,PetscScalar,PetscScalar,Vec,Vec);
+PETSC_EXTERN PetscErrorCode VecAXPBYPCZDotNorm(Vec,PetscScalar,PetscScalar,PetscScalar,Vec,Vec,Vec,PetscScalar*,PetscReal*);
+PETSC_EXTERN PetscErrorCode VecAXPYNorm(Vec,PetscScalar,Vec,PetscReal*);
+PETSC_EXTERN PetscErrorCode VecWAXPYDot(Vec,PetscScalar,Vec,Vec,Vec,PetscScalar*);
 PETSC_EXTERN PetscErrorCode VecPointwiseMax(Vec,Vec,Vec);
 PETSC_EXTERN PetscErrorCode VecPointwiseMaxAbs(Vec,Vec,Vec);
 PETSC_EXTERN PetscErrorCode VecPointwiseMin(Vec,Vec,Vec);
@@ -345,6 +354,8 @@ PETSC_EXTERN PetscErrorCode VecScatterSetData(VecScatter,Vec,IS,Vec,IS);
 PETSC_EXTERN PetscErrorCode VecScatterCreate(MPI_Comm,VecScatter *);
 PETSC_EXTERN PetscErrorCode VecScatterBegin(VecScatter,Vec,Vec,InsertMode,ScatterMode);
 PETSC_EXTERN PetscErrorCode VecScatterEnd(VecScatter,Vec,Vec,InsertMode,ScatterMode);
+PETSC_EXTERN PetscErrorCode VecScatterBeginMulti(VecScatter,PetscInt,Vec[],Vec[],InsertMode,ScatterMode);
+PETSC_EXTERN PetscErrorCode VecScatterEndMulti(VecScatter,PetscInt,Vec[],Vec[],InsertMode,ScatterMode);
 PETSC_EXTERN PetscErrorCode VecScatterDestroy(VecScatter*);
 PETSC_EXTERN PetscErrorCode VecScatterSetUp(VecScatter);
 PETSC_EXTERN PetscErrorCode VecScatterCopy(VecScatter,VecScatter *);
@@ -435,6 +446,28 @@ PETSC_EXTERN PetscErrorCode VecMTDotBegin(Vec,PetscInt,const Vec[],PetscScalar[]
 PETSC_EXTERN PetscErrorCode VecMTDotEnd(Vec,PetscInt,const Vec[],PetscScalar[]);
 PETSC_EXTERN PetscErrorCode PetscCommSplitReductionBegin(MPI_Comm);
 
+/*S
+     VecReduction - Collects an arbitrary list of dot products, norms, maxima, minima and sums whose local parts
+       are computed in a single pass over the vectors and combined with one global reduction
+
+   Level: advanced
+
+.seealso:  VecReductionCreate(), VecReductionAddDot(), VecReductionAddNorm(), VecReductionBegin(), VecReductionEnd()
+S*/
+typedef struct _n_VecReduction* VecReduction;
+
+PETSC_EXTERN PetscErrorCode VecReductionCreate(MPI_Comm,VecReduction*);
+PETSC_EXTERN PetscErrorCode VecReductionAddDot(VecReduction,Vec,Vec,PetscScalar*);
+PETSC_EXTERN PetscErrorCode VecReductionAddTDot(VecReduction,Vec,Vec,PetscScalar*);
+PETSC_EXTERN PetscErrorCode VecReductionAddNorm(VecReduction,Vec,NormType,PetscReal*);
+PETSC_EXTERN PetscErrorCode VecReductionAddMax(VecReduction,Vec,PetscReal*);
+PETSC_EXTERN PetscErrorCode VecReductionAddMin(VecReduction,Vec,PetscReal*);
+PETSC_EXTERN PetscErrorCode VecReductionAddSum(VecReduction,Vec,PetscScalar*);
+PETSC_EXTERN PetscErrorCode VecReductionBegin(VecReduction);
+PETSC_EXTERN PetscErrorCode VecReductionEnd(VecReduction);
+PETSC_EXTERN PetscErrorCode VecReductionReset(VecReduction);
+PETSC_EXTERN PetscErrorCode VecReductionDestroy(VecReduction*);
+
 
 typedef enum {VEC_IGNORE_OFF_PROC_ENTRIES,VEC_IGNORE_NEGATIVE_INDICES,VEC_SUBSET_OFF_PROC_ENTRIES} VecOption;
 PETSC_EXTERN PetscErrorCode VecSetOption(Vec,VecOption,PetscBool );
@@ -56,6 +56,7 @@ PETSC_EXTERN PetscErrorCode PetscViewerBinaryGetUseMPIIO(PetscViewer,PetscBool *
 PETSC_EXTERN PetscErrorCode PetscViewerBinaryGetMPIIODescriptor(PetscViewer,MPI_File*);
 PETSC_EXTERN PetscErrorCode PetscViewerBinaryGetMPIIOOffset(PetscViewer,MPI_Offset*);
 PETSC_EXTERN PetscErrorCode PetscViewerBinaryAddMPIIOOffset(PetscViewer,MPI_Offset);
+PETSC_EXTERN PetscErrorCode PetscViewerBinaryMPIIOWriteAsync(PetscViewer,MPI_Offset,const void*,PetscMPIInt,MPI_Datatype);
 #endif
 
 PETSC_EXTERN PetscErrorCode PetscViewerSocketOpen(MPI_Comm,const char[],int,PetscViewer*);
@@ -213,6 +214,10 @@ PETSC_EXTERN PetscErrorCode PetscViewerBinarySetSkipOptions(PetscViewer,PetscBoo
 PETSC_EXTERN PetscErrorCode PetscViewerBinaryGetSkipOptions(PetscViewer,PetscBool *);
 PETSC_EXTERN PetscErrorCode PetscViewerBinarySetSkipHeader(PetscViewer,PetscBool);
 PETSC_EXTERN PetscErrorCode PetscViewerBinaryGetSkipHeader(PetscViewer,PetscBool*);
+PETSC_EXTERN PetscErrorCode PetscViewerBinarySetCompression(PetscViewer,PetscBool,PetscReal);
+PETSC_EXTERN PetscErrorCode PetscViewerBinaryGetCompression(PetscViewer,PetscBool*,PetscReal*);
+PETSC_EXTERN PetscErrorCode PetscViewerBinarySetAsync(PetscViewer,PetscBool);
+PETSC_EXTERN PetscErrorCode PetscViewerBinaryGetAsync(PetscViewer,PetscBool*);
 PETSC_EXTERN PetscErrorCode PetscViewerBinaryReadStringArray(PetscViewer,char***);
 PETSC_EXTERN PetscErrorCode PetscViewerBinaryWriteStringArray(PetscViewer,const char *const*);
 
@@ -0,0 +1,87 @@
+
+static char help[] = "Compares the time and memory of ISGlobalToLocalMappingApply() for the basic and hash mappings.\n\
+  -n <n>         : number of local indices of the mapping\n\
+  -spread <s>    : the global indices are spread over s*n global indices\n\
+  -nq <nq>       : number of global indices looked up\n\
+  -reps <r>      : number of times the lookup is repeated\n\n";
+
+#include <petscis.h>
+#include <petsctime.h>
+
+/* creates the mapping of the given type and returns the time and memory of its setup and the average time of the lookup */
+static PetscErrorCode TimeMapping(ISLocalToGlobalMappingType type,PetscInt n,const PetscInt idx[],PetscInt nq,const PetscInt q[],PetscInt reps,PetscInt out[],PetscLogDouble *tsetup,PetscLogDouble *tapply,PetscLogDouble *mem)
+{
+  ISLocalToGlobalMapping ltog;
+  PetscLogDouble         t1,t2,m1,m2;
+  PetscInt               i,nout;
+  PetscErrorCode         ierr;
+
+  PetscFunctionBegin;
+  ierr = ISLocalToGlobalMappingCreate(PETSC_COMM_SELF,1,n,idx,PETSC_COPY_VALUES,&ltog);CHKERRQ(ierr);
+  ierr = ISLocalToGlobalMappingSetType(ltog,type);CHKERRQ(ierr);
+  ierr = PetscMallocGetCurrentUsage(&m1);CHKERRQ(ierr);
+  /* the first call sets up the global to local data */
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  ierr = ISGlobalToLocalMappingApply(ltog,IS_GTOLM_MASK,1,q,NULL,out);CHKERRQ(ierr);
+  ierr = PetscTime(&t2);CHKERRQ(ierr);
+  ierr = PetscMallocGetCurrentUsage(&m2);CHKERRQ(ierr);
+  *tsetup = t2-t1;
+  *mem    = m2-m1;
+
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  for (i=0; i<reps; i++) {
+    ierr = ISGlobalToLocalMappingApply(ltog,IS_GTOLM_MASK,nq,q,&nout,out);CHKERRQ(ierr);
+  }
+  ierr = PetscTime(&t2);CHKERRQ(ierr);
+  *tapply = (t2-t1)/reps;
+  ierr = ISLocalToGlobalMappingDestroy(&ltog);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscInt       n = 100000,spread = 100,nq = 1000000,reps = 5,i,nb,*idx,*q,*outb,*outh;
+  PetscLogDouble tsb,tab,mb,tsh,tah,mh;
+  PetscRandom    rctx;
+  PetscReal      r;
+  PetscBool      same = PETSC_TRUE;
+
+  ierr = PetscInitialize(&argc,&argv,0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-spread",&spread,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nq",&nq,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-reps",&reps,NULL);CHKERRQ(ierr);
+
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rctx);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rctx);CHKERRQ(ierr);
+  ierr = PetscMalloc4(n,&idx,nq,&q,nq,&outb,nq,&outh);CHKERRQ(ierr);
+  /* ghost like indices: one index in each group of spread consecutive global indices */
+  for (i=0; i<n; i++) {
+    ierr   = PetscRandomGetValueReal(rctx,&r);CHKERRQ(ierr);
+    idx[i] = i*spread + (PetscInt)(r*spread);
+  }
+  /* half of the queried indices are in the mapping */
+  for (i=0; i<nq; i++) {
+    ierr = PetscRandomGetValueReal(rctx,&r);CHKERRQ(ierr);
+    q[i] = (i%2) ? idx[(PetscInt)(r*n)] : (PetscInt)(r*n*spread);
+  }
+
+  ierr = TimeMapping(ISLOCALTOGLOBALMAPPINGBASIC,n,idx,nq,q,reps,outb,&tsb,&tab,&mb);CHKERRQ(ierr);
+  ierr = TimeMapping(ISLOCALTOGLOBALMAPPINGHASH,n,idx,nq,q,reps,outh,&tsh,&tah,&mh);CHKERRQ(ierr);
+  /* the hash table is not allocated with PetscMalloc(); estimate it from its number of buckets, a power of two, each with a key, a value and 2 bits of flags */
+  for (nb=4; nb < n/3*4+4; nb *= 2) ;
+  mh   = nb*(2*sizeof(PetscInt) + 0.25);
+  for (i=0; i<nq; i++) if (outb[i] != outh[i]) same = PETSC_FALSE;
+
+  ierr = PetscPrintf(PETSC_COMM_SELF,"n %D spread %D lookups %D\n",n,spread,nq);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"          setup (s)    lookup (s)   lookups/s    memory (MB)\n");CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"basic     %-12g %-12g %-12g %-12g\n",tsb,tab,nq/tab,1.e-6*mb);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"hash      %-12g %-12g %-12g %-12g (estimated)\n",tsh,tah,nq/tah,1.e-6*mh);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"Results %s\n",same ? "agree" : "differ");CHKERRQ(ierr);
+
+  ierr = PetscFree4(idx,q,outb,outh);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rctx);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
@@ -0,0 +1,78 @@
+
+static char help[] = "Times VecMDot() and VecMAXPY() against the equivalent sequence of VecDot() and VecAXPY().\n\
+  -n <n>    : local length of the vectors\n\
+  -nv <nv>  : number of vectors, as in the Krylov basis of GMRES\n\
+  -reps <r> : number of times each operation is repeated\n\n";
+
+#include <petscvec.h>
+#include <petsctime.h>
+
+int main(int argc,char **argv)
+{
+  Vec            x,*y;
+  PetscScalar    *alpha;
+  PetscLogDouble t1,t2,tmdot,tdot,tmaxpy,taxpy,mbytes;
+  PetscErrorCode ierr;
+  PetscInt       n = 100000,nv = 30,reps = 10,i,j;
+  PetscRandom    rctx;
+
+  ierr = PetscInitialize(&argc,&argv,0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nv",&nv,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-reps",&reps,NULL);CHKERRQ(ierr);
+
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rctx);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rctx);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&x);CHKERRQ(ierr);
+  ierr = VecSetSizes(x,n,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(x);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(x,nv,&y);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rctx);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {ierr = VecSetRandom(y[j],rctx);CHKERRQ(ierr);}
+  ierr = PetscMalloc1(nv,&alpha);CHKERRQ(ierr);
+
+  /* warm up */
+  ierr = VecMDot(x,nv,y,alpha);CHKERRQ(ierr);
+
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  for (i=0; i<reps; i++) {ierr = VecMDot(x,nv,y,alpha);CHKERRQ(ierr);}
+  ierr  = PetscTime(&t2);CHKERRQ(ierr);
+  tmdot = (t2-t1)/reps;
+
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  for (i=0; i<reps; i++) {
+    for (j=0; j<nv; j++) {ierr = VecDot(x,y[j],&alpha[j]);CHKERRQ(ierr);}
+  }
+  ierr = PetscTime(&t2);CHKERRQ(ierr);
+  tdot = (t2-t1)/reps;
+
+  /* keep x bounded over the repetitions */
+  for (j=0; j<nv; j++) alpha[j] = 1.e-3;
+
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  for (i=0; i<reps; i++) {ierr = VecMAXPY(x,nv,alpha,y);CHKERRQ(ierr);}
+  ierr   = PetscTime(&t2);CHKERRQ(ierr);
+  tmaxpy = (t2-t1)/reps;
+
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  for (i=0; i<reps; i++) {
+    for (j=0; j<nv; j++) {ierr = VecAXPY(x,alpha[j],y[j]);CHKERRQ(ierr);}
+  }
+  ierr  = PetscTime(&t2);CHKERRQ(ierr);
+  taxpy = (t2-t1)/reps;
+
+  /* bytes of the vectors that have to be moved at least once per operation on each process */
+  mbytes = 1.e-6*(nv+1)*n*sizeof(PetscScalar);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"n %D nv %D\n",n,nv);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"VecMDot      Time %g (%g MB/s)\n",tmdot,mbytes/tmdot);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"VecDot x nv  Time %g (%g MB/s)\n",tdot,mbytes/tdot);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"VecMAXPY     Time %g (%g MB/s)\n",tmaxpy,(mbytes+1.e-6*n*sizeof(PetscScalar))/tmaxpy);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"VecAXPY x nv Time %g (%g MB/s)\n",taxpy,(mbytes+1.e-6*n*sizeof(PetscScalar))/taxpy);CHKERRQ(ierr);
+
+  ierr = PetscFree(alpha);CHKERRQ(ierr);
+  ierr = VecDestroyVecs(nv,&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rctx);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
@@ -0,0 +1,127 @@
+
+static char help[] = "Compares the time and accuracy of VecMDot(), VecMAXPY(), VecDot() and VecAXPY() for VECSINGLE vectors\n\
+against VECSTANDARD vectors holding the same values.\n\
+  -n <n>    : local length of the vectors\n\
+  -nv <nv>  : number of vectors, as in the Krylov basis of GMRES\n\
+  -reps <r> : number of times each operation is repeated\n\n";
+
+#include <petscvec.h>
+#include <petsctime.h>
+
+/* times the operations on x and y, and returns the results of one VecMDot() in dots and one VecMAXPY() in z */
+static PetscErrorCode TimeOps(Vec x,PetscInt nv,Vec *y,PetscInt reps,PetscScalar *dots,Vec z,PetscLogDouble t[])
+{
+  PetscErrorCode ierr;
+  PetscScalar    *alpha;
+  PetscLogDouble t1,t2;
+  PetscInt       i,j;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(nv,&alpha);CHKERRQ(ierr);
+  ierr = VecMDot(x,nv,y,dots);CHKERRQ(ierr);
+
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  for (i=0; i<reps; i++) {ierr = VecMDot(x,nv,y,alpha);CHKERRQ(ierr);}
+  ierr = PetscTime(&t2);CHKERRQ(ierr);
+  t[0] = (t2-t1)/reps;
+
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  for (i=0; i<reps; i++) {
+    for (j=0; j<nv; j++) {ierr = VecDot(x,y[j],&alpha[j]);CHKERRQ(ierr);}
+  }
+  ierr = PetscTime(&t2);CHKERRQ(ierr);
+  t[1] = (t2-t1)/reps;
+
+  for (j=0; j<nv; j++) alpha[j] = 1.0/(j+1);
+  ierr = VecCopy(x,z);CHKERRQ(ierr);
+  ierr = VecMAXPY(z,nv,alpha,y);CHKERRQ(ierr);
+
+  /* keep x bounded over the repetitions */
+  for (j=0; j<nv; j++) alpha[j] = 1.e-3;
+
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  for (i=0; i<reps; i++) {ierr = VecMAXPY(x,nv,alpha,y);CHKERRQ(ierr);}
+  ierr = PetscTime(&t2);CHKERRQ(ierr);
+  t[2] = (t2-t1)/reps;
+
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  for (i=0; i<reps; i++) {
+    for (j=0; j<nv; j++) {ierr = VecAXPY(x,alpha[j],y[j]);CHKERRQ(ierr);}
+  }
+  ierr = PetscTime(&t2);CHKERRQ(ierr);
+  t[3] = (t2-t1)/reps;
+  ierr = PetscFree(alpha);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Vec            xd,xs,zd,zs,*yd,*ys;
+  PetscScalar    *dotd,*dots;
+  PetscLogDouble td[4],ts[4],mbd,mbs;
+  PetscReal      errdot = 0.0,nrm,errmaxpy;
+  PetscErrorCode ierr;
+  PetscInt       n = 100000,nv = 30,reps = 10,j;
+  PetscRandom    rctx;
+  const char     *names[] = {"VecMDot     ","VecDot x nv ","VecMAXPY    ","VecAXPY x nv"};
+
+  ierr = PetscInitialize(&argc,&argv,0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nv",&nv,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-reps",&reps,NULL);CHKERRQ(ierr);
+
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rctx);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rctx);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&xd);CHKERRQ(ierr);
+  ierr = VecSetSizes(xd,n,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = VecSetType(xd,VECSTANDARD);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&xs);CHKERRQ(ierr);
+  ierr = VecSetSizes(xs,n,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = VecSetType(xs,VECSINGLE);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(xd,nv,&yd);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(xs,nv,&ys);CHKERRQ(ierr);
+  ierr = VecDuplicate(xd,&zd);CHKERRQ(ierr);
+  ierr = VecDuplicate(xs,&zs);CHKERRQ(ierr);
+
+  /* both sets of vectors hold the same (single precision representable) values */
+  ierr = VecSetRandom(xs,rctx);CHKERRQ(ierr);
+  ierr = VecCopy(xs,xd);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {
+    ierr = VecSetRandom(ys[j],rctx);CHKERRQ(ierr);
+    ierr = VecCopy(ys[j],yd[j]);CHKERRQ(ierr);
+  }
+  ierr = PetscMalloc2(nv,&dotd,nv,&dots);CHKERRQ(ierr);
+
+  ierr = TimeOps(xd,nv,yd,reps,dotd,zd,td);CHKERRQ(ierr);
+  ierr = TimeOps(xs,nv,ys,reps,dots,zs,ts);CHKERRQ(ierr);
+
+  /* the inner products are accumulated in double precision so they should agree to rounding */
+  for (j=0; j<nv; j++) errdot = PetscMax(errdot,PetscAbsScalar(dotd[j]-dots[j])/PetscAbsScalar(dotd[j]));
+  /* the updated vector is rounded to single precision when it is stored */
+  ierr = VecNorm(zd,NORM_INFINITY,&nrm);CHKERRQ(ierr);
+  ierr = VecCopy(zs,xd);CHKERRQ(ierr);
+  ierr = VecAXPY(xd,-1.0,zd);CHKERRQ(ierr);
+  ierr = VecNorm(xd,NORM_INFINITY,&errmaxpy);CHKERRQ(ierr);
+
+  /* bytes of the vectors that have to be moved at least once per operation on each process */
+  mbd  = 1.e-6*(nv+1)*n*sizeof(PetscScalar);
+  mbs  = 1.e-6*(nv+1)*n*sizeof(float);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"n %D nv %D\n",n,nv);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"                standard               single                 speedup\n");CHKERRQ(ierr);
+  for (j=0; j<4; j++) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%s    %-10g (%8.0f MB/s) %-10g (%8.0f MB/s) %5.2f\n",names[j],td[j],mbd/td[j],ts[j],mbs/ts[j],td[j]/ts[j]);CHKERRQ(ierr);
+  }
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Maximum relative difference of VecMDot() %g\n",(double)errdot);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Maximum relative difference of VecMAXPY() %g\n",(double)(errmaxpy/nrm));CHKERRQ(ierr);
+
+  ierr = PetscFree2(dotd,dots);CHKERRQ(ierr);
+  ierr = VecDestroyVecs(nv,&yd);CHKERRQ(ierr);
+  ierr = VecDestroyVecs(nv,&ys);CHKERRQ(ierr);
+  ierr = VecDestroy(&xd);CHKERRQ(ierr);
+  ierr = VecDestroy(&xs);CHKERRQ(ierr);
+  ierr = VecDestroy(&zd);CHKERRQ(ierr);
+  ierr = VecDestroy(&zs);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rctx);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
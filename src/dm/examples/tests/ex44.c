@@ -89,4 +89,10 @@ int main(int argc,char **argv)
    test:
       nsize: 3
 
+   test:
+      suffix: sf
+      nsize: 3
+      args: -vecscatter_type sf
+      output_file: output/ex44_1.out
+
 TEST*/
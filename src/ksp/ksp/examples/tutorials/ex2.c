@@ -224,6 +224,19 @@ int main(int argc,char **args)
       nsize: 2
       args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always
 
+   test:
+      suffix: gmres_single
+      nsize: 2
+      requires: double !complex
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_basis_vec_type single -ksp_gmres_restart 5
+
+   test:
+      suffix: gmres_single_variants
+      nsize: 2
+      requires: double !complex
+      args: -ksp_type {{fgmres lgmres dgmres pgmres}} -m 5 -n 5 -ksp_gmres_basis_vec_type single -ksp_view
+      filter: grep "basis vector type"
+
    test:
       suffix: 3
       args: -pc_type sor -pc_sor_symmetric -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always
@@ -364,6 +364,12 @@ int main(int argc,char **args)
       args: -pc_type asm -mat_type baij
       output_file: output/ex5_asm.out
 
+   test:
+      suffix: asm_sf
+      nsize: 4
+      args: -pc_type asm -vecscatter_type sf
+      output_file: output/ex5_asm.out
+
    test:
       suffix: redundant_0
       args: -m 1000 -pc_type redundant -pc_redundant_number 1 -redundant_ksp_type gmres -redundant_pc_type jacobi
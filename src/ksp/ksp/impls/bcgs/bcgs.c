@@ -52,10 +52,24 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
     ierr = VecSet(X,0.0);CHKERRQ(ierr);
   }
 
-  /* Test for nothing to do */
+  /* Make the initial Rp == R */
+  ierr = VecCopy(R,RP);CHKERRQ(ierr);
+
+  /* Test for nothing to do; since rp = r, rho <- (r,rp) is the square of the initial residual norm */
+  if (!bcgs->red) {
+    ierr = VecReductionCreate(PetscObjectComm((PetscObject)ksp),&bcgs->red);CHKERRQ(ierr);
+  }
+  ierr = VecReductionReset(bcgs->red);CHKERRQ(ierr);
+  if (ksp->normtype != KSP_NORM_NONE) {
+    ierr = VecReductionAddNorm(bcgs->red,R,NORM_2,&dp);CHKERRQ(ierr);
+  } else {
+    ierr = VecReductionAddDot(bcgs->red,R,RP,&rho);CHKERRQ(ierr);
+  }
+  ierr = VecReductionBegin(bcgs->red);CHKERRQ(ierr);
+  ierr = VecReductionEnd(bcgs->red);CHKERRQ(ierr);
   if (ksp->normtype != KSP_NORM_NONE) {
-    ierr = VecNorm(R,NORM_2,&dp);CHKERRQ(ierr);
     KSPCheckNorm(ksp,dp);
+    rho = dp*dp;
   }
   ierr       = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
   ksp->its   = 0;
@@ -71,9 +85,6 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
     PetscFunctionReturn(0);
   }
 
-  /* Make the initial Rp == R */
-  ierr = VecCopy(R,RP);CHKERRQ(ierr);
-
   rhoold   = 1.0;
   alpha    = 1.0;
   omegaold = 1.0;
@@ -82,7 +93,6 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
 
   i=0;
   do {
-    ierr = VecDot(R,RP,&rho);CHKERRQ(ierr);       /*   rho <- (r,rp)      */
     beta = (rho/rhoold) * (alpha/omegaold);
     ierr = VecAXPBYPCZ(P,1.0,-omegaold*beta,beta,R,V);CHKERRQ(ierr);  /* p <- r - omega * beta* v + beta * p */
     ierr = KSP_PCApplyBAorAB(ksp,P,V,T);CHKERRQ(ierr);  /*   v <- K p           */
@@ -119,15 +129,16 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
     }
     omega = d1 / d2;                               /*   w <- (t's) / (t't) */
     ierr  = VecAXPBYPCZ(X,alpha,omega,1.0,P,S);CHKERRQ(ierr); /* x <- alpha * p + omega * s + x */
-    ierr  = VecWAXPY(R,-omega,T,S);CHKERRQ(ierr);     /*   r <- s - w t       */
+    rhoold   = rho;
+    omegaold = omega;
+    /* the residual update, its norm and the next rho are computed in one pass with a single reduction */
     if (ksp->normtype != KSP_NORM_NONE && ksp->chknorm < i+2) {
-      ierr = VecNorm(R,NORM_2,&dp);CHKERRQ(ierr);
+      ierr = VecAXPBYPCZDotNorm(R,-omega,1.0,0.0,T,S,RP,&rho,&dp);CHKERRQ(ierr); /* r <- s - w t, rho <- (r,rp), dp <- ||r|| */
       KSPCheckNorm(ksp,dp);
+    } else {
+      ierr = VecWAXPYDot(R,-omega,T,S,RP,&rho);CHKERRQ(ierr);   /*   r <- s - w t, rho <- (r,rp) */
     }
 
-    rhoold   = rho;
-    omegaold = omega;
-
     ierr = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
     ksp->its++;
     ksp->rnorm = dp;
@@ -136,7 +147,7 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
     ierr = KSPMonitor(ksp,i+1,dp);CHKERRQ(ierr);
     ierr = (*ksp->converged)(ksp,i+1,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
     if (ksp->reason) break;
-    if (rho == 0.0) {
+    if (rhoold == 0.0) {
       ksp->reason = KSP_DIVERGED_BREAKDOWN;
       break;
     }
@@ -181,6 +192,7 @@ PetscErrorCode KSPReset_BCGS(KSP ksp)
 
   PetscFunctionBegin;
   ierr = VecDestroy(&cg->guess);CHKERRQ(ierr);
+  ierr = VecReductionDestroy(&cg->red);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1,6 +1,10 @@
 
 #include <petsc/private/kspimpl.h>
 
+typedef struct {
+  VecReduction red[2];  /* the reductions of the first iteration and of the following ones */
+} KSP_PIPECG;
+
 /*
      KSPSetUp_PIPECG - Sets up the workspace needed by the PIPECG method.
 
@@ -32,6 +36,7 @@ static PetscErrorCode  KSPSolve_PIPECG(KSP ksp)
   PetscReal      dp    = 0.0;
   Vec            X,B,Z,P,W,Q,U,M,N,R,S;
   Mat            Amat,Pmat;
+  VecReduction   *red = ((KSP_PIPECG*)ksp->data)->red;
   PetscBool      diagonalscale;
 
   PetscFunctionBegin;
@@ -95,31 +100,33 @@ static PetscErrorCode  KSPSolve_PIPECG(KSP ksp)
   ierr       = (*ksp->converged)(ksp,0,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr); /* test for convergence */
   if (ksp->reason) PetscFunctionReturn(0);
 
+  /* the reductions of the first iteration and of the following ones are queued once, red[1] also gets the residual norm */
+  for (i=0; i<2; i++) {
+    if (!red[i]) {
+      ierr = VecReductionCreate(PetscObjectComm((PetscObject)ksp),&red[i]);CHKERRQ(ierr);
+    }
+    ierr = VecReductionReset(red[i]);CHKERRQ(ierr);
+  }
+  if (ksp->normtype != KSP_NORM_NATURAL) {
+    ierr = VecReductionAddDot(red[0],R,U,&gamma);CHKERRQ(ierr);      /*   gamma <- u'*r   */
+  }
+  ierr = VecReductionAddDot(red[0],W,U,&delta);CHKERRQ(ierr);        /*   delta <- u'*w   */
+  if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
+    ierr = VecReductionAddNorm(red[1],R,NORM_2,&dp);CHKERRQ(ierr);
+  } else if (ksp->normtype == KSP_NORM_PRECONDITIONED) {
+    ierr = VecReductionAddNorm(red[1],U,NORM_2,&dp);CHKERRQ(ierr);
+  }
+  ierr = VecReductionAddDot(red[1],R,U,&gamma);CHKERRQ(ierr);
+  ierr = VecReductionAddDot(red[1],W,U,&delta);CHKERRQ(ierr);
+
   i = 0;
   do {
-    if (i > 0 && ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
-      ierr = VecNormBegin(R,NORM_2,&dp);CHKERRQ(ierr);
-    } else if (i > 0 && ksp->normtype == KSP_NORM_PRECONDITIONED) {
-      ierr = VecNormBegin(U,NORM_2,&dp);CHKERRQ(ierr);
-    }
-    if (!(i == 0 && ksp->normtype == KSP_NORM_NATURAL)) {
-      ierr = VecDotBegin(R,U,&gamma);CHKERRQ(ierr);
-    }
-    ierr = VecDotBegin(W,U,&delta);CHKERRQ(ierr);
-    ierr = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)R));CHKERRQ(ierr);
+    ierr = VecReductionBegin(red[i ? 1 : 0]);CHKERRQ(ierr);
 
     ierr = KSP_PCApply(ksp,W,M);CHKERRQ(ierr);           /*   m <- Bw       */
     ierr = KSP_MatMult(ksp,Amat,M,N);CHKERRQ(ierr);      /*   n <- Am       */
 
-    if (i > 0 && ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
-      ierr = VecNormEnd(R,NORM_2,&dp);CHKERRQ(ierr);
-    } else if (i > 0 && ksp->normtype == KSP_NORM_PRECONDITIONED) {
-      ierr = VecNormEnd(U,NORM_2,&dp);CHKERRQ(ierr);
-    }
-    if (!(i == 0 && ksp->normtype == KSP_NORM_NATURAL)) {
-      ierr = VecDotEnd(R,U,&gamma);CHKERRQ(ierr);
-    }
-    ierr = VecDotEnd(W,U,&delta);CHKERRQ(ierr);
+    ierr = VecReductionEnd(red[i ? 1 : 0]);CHKERRQ(ierr);
 
     if (i > 0) {
       if (ksp->normtype == KSP_NORM_NATURAL) dp = PetscSqrtReal(PetscAbsScalar(gamma));
@@ -166,6 +173,27 @@ static PetscErrorCode  KSPSolve_PIPECG(KSP ksp)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode KSPReset_PIPECG(KSP ksp)
+{
+  KSP_PIPECG     *pipecg = (KSP_PIPECG*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecReductionDestroy(&pipecg->red[0]);CHKERRQ(ierr);
+  ierr = VecReductionDestroy(&pipecg->red[1]);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPDestroy_PIPECG(KSP ksp)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPReset_PIPECG(ksp);CHKERRQ(ierr);
+  ierr = KSPDestroyDefault(ksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 
 /*MC
    KSPPIPECG - Pipelined conjugate gradient method.
@@ -192,9 +220,13 @@ static PetscErrorCode  KSPSolve_PIPECG(KSP ksp)
 M*/
 PETSC_EXTERN PetscErrorCode KSPCreate_PIPECG(KSP ksp)
 {
+  KSP_PIPECG     *pipecg;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  ierr      = PetscNewLog(ksp,&pipecg);CHKERRQ(ierr);
+  ksp->data = (void*)pipecg;
+
   ierr = KSPSetSupportedNorm(ksp,KSP_NORM_UNPRECONDITIONED,PC_LEFT,2);CHKERRQ(ierr);
   ierr = KSPSetSupportedNorm(ksp,KSP_NORM_PRECONDITIONED,PC_LEFT,2);CHKERRQ(ierr);
   ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NATURAL,PC_LEFT,2);CHKERRQ(ierr);
@@ -202,7 +234,8 @@ PETSC_EXTERN PetscErrorCode KSPCreate_PIPECG(KSP ksp)
 
   ksp->ops->setup          = KSPSetUp_PIPECG;
   ksp->ops->solve          = KSPSolve_PIPECG;
-  ksp->ops->destroy        = KSPDestroyDefault;
+  ksp->ops->destroy        = KSPDestroy_PIPECG;
+  ksp->ops->reset          = KSPReset_PIPECG;
   ksp->ops->view           = 0;
   ksp->ops->setfromoptions = 0;
   ksp->ops->buildsolution  = KSPBuildSolutionDefault;
@@ -467,7 +467,7 @@ static PetscErrorCode KSPDGMRESGetNewVectors(KSP ksp,PetscInt it)
 
   dgmres->vv_allocated += nalloc;
 
-  ierr = KSPCreateVecs(ksp,nalloc,&dgmres->user_work[nwork],0,NULL);CHKERRQ(ierr);
+  ierr = KSPGMRESCreateVecs_Private(ksp,nalloc,nalloc,&dgmres->user_work[nwork]);CHKERRQ(ierr);
   ierr = PetscLogObjectParents(ksp,nalloc,dgmres->user_work[nwork]);CHKERRQ(ierr);
 
   dgmres->mwork_alloc[nwork] = nalloc;
@@ -619,7 +619,7 @@ PetscErrorCode  KSPDGMRESComputeDeflationData_DGMRES(KSP ksp, PetscInt *ExtrNeig
   ierr =  KSPDGMRESComputeSchurForm(ksp, &neig);CHKERRQ(ierr);
   /* Form the extended Schur vectors X=VV*Sr */
   if (!XX) {
-    ierr = VecDuplicateVecs(VEC_VV(0), neig1, &XX);CHKERRQ(ierr);
+    ierr = VecDuplicateVecs(VEC_TEMP, neig1, &XX);CHKERRQ(ierr);
   }
   for (j = 0; j<neig; j++) {
     ierr = VecZeroEntries(XX[j]);CHKERRQ(ierr);
@@ -643,7 +643,7 @@ PetscErrorCode  KSPDGMRESComputeDeflationData_DGMRES(KSP ksp, PetscInt *ExtrNeig
   }
   /* Compute MX = M^{-1}*A*X */
   if (!MX) {
-    ierr = VecDuplicateVecs(VEC_VV(0), neig1, &MX);CHKERRQ(ierr);
+    ierr = VecDuplicateVecs(VEC_TEMP, neig1, &MX);CHKERRQ(ierr);
   }
   for (j = 0; j<neig; j++) {
     ierr = KSP_PCApplyBAorAB(ksp, XX[j], MX[j], VEC_TEMP_MATOP);CHKERRQ(ierr);
@@ -727,8 +727,8 @@ PetscErrorCode  KSPDGMRESComputeDeflationData_DGMRES(KSP ksp, PetscInt *ExtrNeig
 
   /* Save X in U and MX in MU for the next cycles and increase the size of the invariant subspace */
   if (!UU) {
-    ierr = VecDuplicateVecs(VEC_VV(0), max_neig, &UU);CHKERRQ(ierr);
-    ierr = VecDuplicateVecs(VEC_VV(0), max_neig, &MU);CHKERRQ(ierr);
+    ierr = VecDuplicateVecs(VEC_TEMP, max_neig, &UU);CHKERRQ(ierr);
+    ierr = VecDuplicateVecs(VEC_TEMP, max_neig, &MU);CHKERRQ(ierr);
   }
   for (j=0; j<neig; j++) {
     ierr = VecCopy(XX[j], UU[r-neig+j]);CHKERRQ(ierr);
@@ -1214,6 +1214,8 @@ PETSC_EXTERN PetscErrorCode KSPCreate_DGMRES(KSP ksp)
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetRestart_C",KSPGMRESSetRestart_GMRES);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetHapTol_C",KSPGMRESSetHapTol_GMRES);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetCGSRefinementType_C",KSPGMRESSetCGSRefinementType_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetBasisVecType_C",KSPGMRESSetBasisVecType_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESGetBasisVecType_C",KSPGMRESGetBasisVecType_GMRES);CHKERRQ(ierr);
   /* -- New functions defined in DGMRES -- */
   ierr = PetscObjectComposeFunction((PetscObject)ksp, "KSPDGMRESSetEigen_C",KSPDGMRESSetEigen_DGMRES);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp, "KSPDGMRESSetMaxEigen_C",KSPDGMRESSetMaxEigen_DGMRES);CHKERRQ(ierr);
@@ -34,6 +34,34 @@
 static PetscErrorCode KSPGMRESUpdateHessenberg(KSP,PetscInt,PetscBool,PetscReal*);
 static PetscErrorCode KSPGMRESBuildSoln(PetscScalar*,Vec,Vec,KSP,PetscInt);
 
+/*
+    Creates n work vectors like KSPCreateVecs(); when a basis vector type has been set the last nbasis of them,
+    which are used only for the Krylov basis, are created with that type instead.
+*/
+PetscErrorCode KSPGMRESCreateVecs_Private(KSP ksp,PetscInt n,PetscInt nbasis,Vec **vecs)
+{
+  KSP_GMRES      *gmres = (KSP_GMRES*)ksp->data;
+  PetscErrorCode ierr;
+  PetscInt       k,nloc,N,bs;
+  Vec            v;
+
+  PetscFunctionBegin;
+  ierr = KSPCreateVecs(ksp,n,vecs,0,NULL);CHKERRQ(ierr);
+  if (!gmres->basis_vectype || !n) PetscFunctionReturn(0);
+  ierr = VecGetLocalSize((*vecs)[0],&nloc);CHKERRQ(ierr);
+  ierr = VecGetSize((*vecs)[0],&N);CHKERRQ(ierr);
+  ierr = VecGetBlockSize((*vecs)[0],&bs);CHKERRQ(ierr);
+  for (k=n-nbasis; k<n; k++) {
+    ierr = VecCreate(PetscObjectComm((PetscObject)(*vecs)[k]),&v);CHKERRQ(ierr);
+    ierr = VecSetSizes(v,nloc,N);CHKERRQ(ierr);
+    ierr = VecSetBlockSize(v,bs);CHKERRQ(ierr);
+    ierr = VecSetType(v,gmres->basis_vectype);CHKERRQ(ierr);
+    ierr = VecDestroy(&(*vecs)[k]);CHKERRQ(ierr);
+    (*vecs)[k] = v;
+  }
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode    KSPSetUp_GMRES(KSP ksp)
 {
   PetscInt       hh,hes,rs,cc;
@@ -71,7 +99,7 @@ PetscErrorCode    KSPSetUp_GMRES(KSP ksp)
   if (gmres->q_preallocate) {
     gmres->vv_allocated = VEC_OFFSET + 2 + max_k;
 
-    ierr = KSPCreateVecs(ksp,gmres->vv_allocated,&gmres->user_work[0],0,NULL);CHKERRQ(ierr);
+    ierr = KSPGMRESCreateVecs_Private(ksp,gmres->vv_allocated,gmres->vv_allocated-VEC_OFFSET,&gmres->user_work[0]);CHKERRQ(ierr);
     ierr = PetscLogObjectParents(ksp,gmres->vv_allocated,gmres->user_work[0]);CHKERRQ(ierr);
 
     gmres->mwork_alloc[0] = gmres->vv_allocated;
@@ -82,7 +110,7 @@ PetscErrorCode    KSPSetUp_GMRES(KSP ksp)
   } else {
     gmres->vv_allocated = 5;
 
-    ierr = KSPCreateVecs(ksp,5,&gmres->user_work[0],0,NULL);CHKERRQ(ierr);
+    ierr = KSPGMRESCreateVecs_Private(ksp,5,5-VEC_OFFSET,&gmres->user_work[0]);CHKERRQ(ierr);
     ierr = PetscLogObjectParents(ksp,5,gmres->user_work[0]);CHKERRQ(ierr);
 
     gmres->mwork_alloc[0] = 5;
@@ -304,6 +332,7 @@ PetscErrorCode KSPDestroy_GMRES(KSP ksp)
 
   PetscFunctionBegin;
   ierr = KSPReset_GMRES(ksp);CHKERRQ(ierr);
+  ierr = PetscFree(((KSP_GMRES*)ksp->data)->basis_vectype);CHKERRQ(ierr);
   ierr = PetscFree(ksp->data);CHKERRQ(ierr);
   /* clear composed functions */
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetPreAllocateVectors_C",NULL);CHKERRQ(ierr);
@@ -314,6 +343,8 @@ PetscErrorCode KSPDestroy_GMRES(KSP ksp)
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetHapTol_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetCGSRefinementType_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESGetCGSRefinementType_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetBasisVecType_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESGetBasisVecType_C",NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 /*
@@ -455,7 +486,7 @@ PetscErrorCode KSPGMRESGetNewVectors(KSP ksp,PetscInt it)
 
   gmres->vv_allocated += nalloc;
 
-  ierr = KSPCreateVecs(ksp,nalloc,&gmres->user_work[nwork],0,NULL);CHKERRQ(ierr);
+  ierr = KSPGMRESCreateVecs_Private(ksp,nalloc,nalloc,&gmres->user_work[nwork]);CHKERRQ(ierr);
   ierr = PetscLogObjectParents(ksp,nalloc,gmres->user_work[nwork]);CHKERRQ(ierr);
 
   gmres->mwork_alloc[nwork] = nalloc;
@@ -522,6 +553,9 @@ PetscErrorCode KSPView_GMRES(KSP ksp,PetscViewer viewer)
   if (iascii) {
     ierr = PetscViewerASCIIPrintf(viewer,"  restart=%D, using %s\n",gmres->max_k,cstr);CHKERRQ(ierr);
     ierr = PetscViewerASCIIPrintf(viewer,"  happy breakdown tolerance %g\n",(double)gmres->haptol);CHKERRQ(ierr);
+    if (gmres->basis_vectype) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  Krylov basis vector type %s\n",gmres->basis_vectype);CHKERRQ(ierr);
+    }
   } else if (isstring) {
     ierr = PetscViewerStringSPrintf(viewer,"%s restart %D",cstr,gmres->max_k);CHKERRQ(ierr);
   }
@@ -578,6 +612,7 @@ PetscErrorCode KSPSetFromOptions_GMRES(PetscOptionItems *PetscOptionsObject,KSP
   PetscReal      haptol;
   KSP_GMRES      *gmres = (KSP_GMRES*)ksp->data;
   PetscBool      flg;
+  char           vtype[256];
 
   PetscFunctionBegin;
   ierr = PetscOptionsHead(PetscOptionsObject,"KSP GMRES Options");CHKERRQ(ierr);
@@ -592,6 +627,8 @@ PetscErrorCode KSPSetFromOptions_GMRES(PetscOptionItems *PetscOptionsObject,KSP
   if (flg) {ierr = KSPGMRESSetOrthogonalization(ksp,KSPGMRESClassicalGramSchmidtOrthogonalization);CHKERRQ(ierr);}
   ierr = PetscOptionsBoolGroupEnd("-ksp_gmres_modifiedgramschmidt","Modified Gram-Schmidt (slow,more stable)","KSPGMRESSetOrthogonalization",&flg);CHKERRQ(ierr);
   if (flg) {ierr = KSPGMRESSetOrthogonalization(ksp,KSPGMRESModifiedGramSchmidtOrthogonalization);CHKERRQ(ierr);}
+  ierr = PetscOptionsFList("-ksp_gmres_basis_vec_type","Vector type of the Krylov basis","KSPGMRESSetBasisVecType",VecList,gmres->basis_vectype,vtype,sizeof(vtype),&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPGMRESSetBasisVecType(ksp,vtype);CHKERRQ(ierr);}
   ierr = PetscOptionsEnum("-ksp_gmres_cgs_refinement_type","Type of iterative refinement for classical (unmodified) Gram-Schmidt","KSPGMRESSetCGSRefinementType",
                           KSPGMRESCGSRefinementTypes,(PetscEnum)gmres->cgstype,(PetscEnum*)&gmres->cgstype,&flg);CHKERRQ(ierr);
   flg  = PETSC_FALSE;
@@ -642,6 +679,33 @@ PetscErrorCode  KSPGMRESSetRestart_GMRES(KSP ksp,PetscInt max_k)
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode  KSPGMRESSetBasisVecType_GMRES(KSP ksp,VecType type)
+{
+  KSP_GMRES      *gmres = (KSP_GMRES*)ksp->data;
+  PetscBool      same = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (gmres->basis_vectype && type) {ierr = PetscStrcmp(gmres->basis_vectype,type,&same);CHKERRQ(ierr);}
+  if (same || (!gmres->basis_vectype && !type)) PetscFunctionReturn(0);
+  ierr = PetscFree(gmres->basis_vectype);CHKERRQ(ierr);
+  ierr = PetscStrallocpy(type,(char**)&gmres->basis_vectype);CHKERRQ(ierr);
+  if (ksp->setupstage) {
+    ksp->setupstage = KSP_SETUP_NEW;
+    /* free the work vectors of the variant, then create them again */
+    if (ksp->ops->reset) {ierr = (*ksp->ops->reset)(ksp);CHKERRQ(ierr);}
+    else {ierr = KSPReset_GMRES(ksp);CHKERRQ(ierr);}
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode  KSPGMRESGetBasisVecType_GMRES(KSP ksp,VecType *type)
+{
+  PetscFunctionBegin;
+  *type = ((KSP_GMRES*)ksp->data)->basis_vectype;
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode  KSPGMRESSetOrthogonalization_GMRES(KSP ksp,FCN fcn)
 {
   PetscFunctionBegin;
@@ -839,6 +903,73 @@ PetscErrorCode  KSPGMRESSetHapTol(KSP ksp,PetscReal tol)
   PetscFunctionReturn(0);
 }
 
+/*@C
+   KSPGMRESSetBasisVecType - Sets the vector type used for the Krylov basis vectors of GMRES.
+
+   Logically Collective on KSP
+
+   Input Parameters:
++  ksp - the Krylov space context
+-  type - the vector type, for example VECSINGLE, or NULL to use the type of the solution vector (the default)
+
+  Options Database:
+.  -ksp_gmres_basis_vec_type <type>
+
+   Notes:
+   Only the restart+1 basis vectors are created with this type, the solution, right hand side and the work vectors
+   used for the matrix-vector products keep the type of the solution vector. With VECSINGLE the basis is stored
+   in single precision, which halves the memory traffic of the orthogonalization, while the inner products and
+   vector updates are still computed in double precision. The type must have the same parallel layout as the
+   solution vector.
+
+   This applies to KSPGMRES, KSPFGMRES, KSPLGMRES, KSPDGMRES and KSPPGMRES; the preconditioned directions of FGMRES,
+   the augmentation vectors of LGMRES and the deflation space of DGMRES keep the type of the solution vector. Other
+   Krylov methods ignore it.
+
+   Level: advanced
+
+.keywords: KSP, GMRES, vector type, mixed precision
+
+.seealso: KSPGMRESGetBasisVecType(), KSPGMRESSetRestart(), VECSINGLE
+@*/
+PetscErrorCode  KSPGMRESSetBasisVecType(KSP ksp,VecType type)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  ierr = PetscTryMethod(ksp,"KSPGMRESSetBasisVecType_C",(KSP,VecType),(ksp,type));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   KSPGMRESGetBasisVecType - Gets the vector type used for the Krylov basis vectors of GMRES.
+
+   Not Collective
+
+   Input Parameter:
+.  ksp - the Krylov space context
+
+   Output Parameter:
+.  type - the vector type, NULL if the basis vectors have the type of the solution vector
+
+   Level: advanced
+
+.keywords: KSP, GMRES, vector type, mixed precision
+
+.seealso: KSPGMRESSetBasisVecType()
+@*/
+PetscErrorCode  KSPGMRESGetBasisVecType(KSP ksp,VecType *type)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidPointer(type,2);
+  ierr = PetscUseMethod(ksp,"KSPGMRESGetBasisVecType_C",(KSP,VecType*),(ksp,type));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*MC
      KSPGMRES - Implements the Generalized Minimal Residual method.
                 (Saad and Schultz, 1986) with restart
@@ -853,6 +984,7 @@ PetscErrorCode  KSPGMRESSetHapTol(KSP ksp,PetscReal tol)
 .   -ksp_gmres_modifiedgramschmidt - use modified Gram-Schmidt in the orthogonalization (more stable, but slower)
 .   -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always> - determine if iterative refinement is used to increase the
                                    stability of the classical Gram-Schmidt  orthogonalization.
+.   -ksp_gmres_basis_vec_type <type> - vector type of the Krylov basis, for example single to store it in single precision
 -   -ksp_gmres_krylov_monitor - plot the Krylov space generated
 
    Level: beginner
@@ -867,7 +999,8 @@ PetscErrorCode  KSPGMRESSetHapTol(KSP ksp,PetscReal tol)
 .seealso:  KSPCreate(), KSPSetType(), KSPType (for list of available types), KSP, KSPFGMRES, KSPLGMRES,
            KSPGMRESSetRestart(), KSPGMRESSetHapTol(), KSPGMRESSetPreAllocateVectors(), KSPGMRESSetOrthogonalization(), KSPGMRESGetOrthogonalization(),
            KSPGMRESClassicalGramSchmidtOrthogonalization(), KSPGMRESModifiedGramSchmidtOrthogonalization(),
-           KSPGMRESCGSRefinementType, KSPGMRESSetCGSRefinementType(), KSPGMRESGetCGSRefinementType(), KSPGMRESMonitorKrylov(), KSPSetPCSide()
+           KSPGMRESCGSRefinementType, KSPGMRESSetCGSRefinementType(), KSPGMRESGetCGSRefinementType(), KSPGMRESMonitorKrylov(), KSPSetPCSide(),
+           KSPGMRESSetBasisVecType()
 
 M*/
 
@@ -906,6 +1039,8 @@ PETSC_EXTERN PetscErrorCode KSPCreate_GMRES(KSP ksp)
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetHapTol_C",KSPGMRESSetHapTol_GMRES);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetCGSRefinementType_C",KSPGMRESSetCGSRefinementType_GMRES);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESGetCGSRefinementType_C",KSPGMRESGetCGSRefinementType_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetBasisVecType_C",KSPGMRESSetBasisVecType_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESGetBasisVecType_C",KSPGMRESGetBasisVecType_GMRES);CHKERRQ(ierr);
 
   gmres->haptol         = 1.0e-30;
   gmres->q_preallocate  = 0;
@@ -46,7 +46,8 @@
   PetscInt    it;              /* Current iteration: inside restart */  \
   PetscInt    fullcycle;       /* Current number of complete cycle */ \
   PetscScalar *nrs;            /* temp that holds the coefficients of the Krylov vectors that form the minimum residual solution */ \
-  Vec         sol_temp;        /* used to hold temporary solution */
+  Vec         sol_temp;        /* used to hold temporary solution */ \
+  VecType     basis_vectype;   /* if set the Krylov basis vectors are created with this type instead of the type of the solution */
 
 typedef struct {
   KSPGMRESHEADER
@@ -61,6 +62,7 @@ PETSC_INTERN PetscErrorCode KSPComputeRitz_GMRES(KSP,PetscBool,PetscBool,PetscIn
 PETSC_INTERN PetscErrorCode KSPReset_GMRES(KSP);
 PETSC_INTERN PetscErrorCode KSPDestroy_GMRES(KSP);
 PETSC_INTERN PetscErrorCode KSPGMRESGetNewVectors(KSP,PetscInt);
+PETSC_INTERN PetscErrorCode KSPGMRESCreateVecs_Private(KSP,PetscInt,PetscInt,Vec**);
 
 typedef PetscErrorCode (*FCN)(KSP,PetscInt); /* force argument to next function to not be extern C*/
 
@@ -68,6 +70,8 @@ PETSC_INTERN PetscErrorCode KSPGMRESSetHapTol_GMRES(KSP,PetscReal);
 PETSC_INTERN PetscErrorCode KSPGMRESSetPreAllocateVectors_GMRES(KSP);
 PETSC_INTERN PetscErrorCode KSPGMRESSetRestart_GMRES(KSP,PetscInt);
 PETSC_INTERN PetscErrorCode KSPGMRESGetRestart_GMRES(KSP,PetscInt*);
+PETSC_INTERN PetscErrorCode KSPGMRESSetBasisVecType_GMRES(KSP,VecType);
+PETSC_INTERN PetscErrorCode KSPGMRESGetBasisVecType_GMRES(KSP,VecType*);
 PETSC_INTERN PetscErrorCode KSPGMRESSetOrthogonalization_GMRES(KSP,FCN);
 PETSC_INTERN PetscErrorCode KSPGMRESGetOrthogonalization_GMRES(KSP,FCN*);
 PETSC_INTERN PetscErrorCode KSPGMRESSetCGSRefinementType_GMRES(KSP,KSPGMRESCGSRefinementType);
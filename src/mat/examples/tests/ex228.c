@@ -0,0 +1,113 @@
+static char help[] = "Tests the assembly of AIJ matrices that were not preallocated.\n\
+  -n <n> : number of rows of the matrix\n\n";
+
+#include <petscmat.h>
+
+/*
+   Sets the same entries on every process count: each process adds a stencil to rows spread over the whole matrix,
+   so that most rows get contributions from other processes and many entries are set more than once.
+*/
+static PetscErrorCode FillMatrix(Mat A,PetscInt n)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,k,l,row,cols[3];
+  PetscScalar    vals[3];
+  PetscMPIInt    rank,size;
+
+  PetscFunctionBeginUser;
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)A),&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)A),&size);CHKERRQ(ierr);
+  for (l=0; l<2; l++) {
+    for (i=l*n+rank; i<(l+1)*n; i+=size) {
+      row     = (7*i) % n;
+      cols[0] = (row+n-1) % n; cols[1] = row; cols[2] = (row+n/2) % n;
+      for (k=0; k<3; k++) vals[k] = (PetscScalar)(1+i%5+k);
+      /* with a block size of one the blocked setter must give the same entries */
+      if (l) {ierr = MatSetValuesBlocked(A,1,&row,3,cols,vals,ADD_VALUES);CHKERRQ(ierr);}
+      else   {ierr = MatSetValues(A,1,&row,3,cols,vals,ADD_VALUES);CHKERRQ(ierr);}
+    }
+    if (!l) {
+      ierr = MatAssemblyBegin(A,MAT_FLUSH_ASSEMBLY);CHKERRQ(ierr);
+      ierr = MatAssemblyEnd(A,MAT_FLUSH_ASSEMBLY);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A,B;
+  PetscInt       n = 40,row,col;
+  PetscScalar    one = 1.0,vals[4];
+  PetscBool      equal;
+  MatInfo        info;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+
+  /* A gets its entries without preallocation, B is preallocated generously and assembled the regular way */
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,n,n);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSetUp(A);CHKERRQ(ierr);
+  ierr = FillMatrix(A,n);CHKERRQ(ierr);
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&B);CHKERRQ(ierr);
+  ierr = MatSetSizes(B,PETSC_DECIDE,PETSC_DECIDE,n,n);CHKERRQ(ierr);
+  ierr = MatSetType(B,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(B,n,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(B,n,NULL,n,NULL);CHKERRQ(ierr);
+  ierr = MatSetOption(B,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = FillMatrix(B,n);CHKERRQ(ierr);
+
+  ierr = MatEqual(A,B,&equal);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Matrices are %s\n",equal ? "equal" : "different");CHKERRQ(ierr);
+  ierr = MatGetInfo(A,MAT_GLOBAL_SUM,&info);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Nonzeros %D, allocated %D\n",(PetscInt)info.nz_used,(PetscInt)info.nz_allocated);CHKERRQ(ierr);
+
+  /* the matrix assembled from the hash table still accepts new nonzeros in later assemblies */
+  row  = 0; col = n-2;
+  ierr = MatSetValues(A,1,&row,1,&col,&one,ADD_VALUES);CHKERRQ(ierr);
+  ierr = MatSetValues(B,1,&row,1,&col,&one,ADD_VALUES);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatEqual(A,B,&equal);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Matrices are %s after a new nonzero\n",equal ? "equal" : "different");CHKERRQ(ierr);
+
+  /* the row setter works on the structure built from the hash table */
+  ierr = MatGetOwnershipRange(A,&row,NULL);CHKERRQ(ierr);
+  for (col=0; col<4; col++) vals[col] = (PetscScalar)(col+2);
+  ierr = MatSetValuesRow(A,row,vals);CHKERRQ(ierr);
+  ierr = MatSetValuesRow(B,row,vals);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatEqual(A,B,&equal);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Matrices are %s after setting a row\n",equal ? "equal" : "different");CHKERRQ(ierr);
+
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 2 3}}
+      args: -mat_aij_hash
+      output_file: output/ex228_1.out
+
+   test:
+      suffix: 2
+      nsize: 2
+      output_file: output/ex228_2.out
+
+TEST*/
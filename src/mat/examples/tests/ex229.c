@@ -0,0 +1,118 @@
+static char help[] = "Tests MatSetPreallocationCOO() and MatSetValuesCOO().\n\
+  -n <n> : number of rows of the matrix\n\n";
+
+#include <petscmat.h>
+
+/*
+   Each process lists entries of rows spread over the whole matrix, with repeated entries and a few negative
+   indices that must be ignored. The values depend on the pass so that the reuse of the pattern is checked too.
+*/
+static PetscErrorCode BuildEntries(Mat A,PetscInt n,PetscInt pass,PetscInt *ncoo,PetscInt **coo_i,PetscInt **coo_j,PetscScalar **coo_v)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,k,c,row;
+  PetscMPIInt    rank,size;
+
+  PetscFunctionBeginUser;
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)A),&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)A),&size);CHKERRQ(ierr);
+  for (i=rank,c=0; i<2*n; i+=size) c += 3;
+  ierr = PetscMalloc3(c+1,coo_i,c+1,coo_j,c+1,coo_v);CHKERRQ(ierr);
+  for (i=rank,c=0; i<2*n; i+=size) {
+    row = (7*i) % n;
+    for (k=0; k<3; k++,c++) {
+      (*coo_i)[c] = row;
+      (*coo_j)[c] = k == 0 ? (row+n-1) % n : (k == 1 ? row : (row+n/2) % n);
+      (*coo_v)[c] = (PetscScalar)(1+(i+pass)%5+k);
+    }
+  }
+  /* an ignored entry */
+  (*coo_i)[c] = rank % 2 ? -1 : 0;
+  (*coo_j)[c] = rank % 2 ? 0 : -1;
+  (*coo_v)[c] = 100.0;
+  *ncoo       = c+1;
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A,B;
+  Vec            x,y,z;
+  PetscReal      nrm;
+  PetscInt       n = 40,ncoo,pass,k,*coo_i,*coo_j;
+  PetscScalar    *coo_v;
+  PetscBool      equal;
+  MatInfo        info;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,n,n);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = BuildEntries(A,n,0,&ncoo,&coo_i,&coo_j,&coo_v);CHKERRQ(ierr);
+  ierr = MatSetPreallocationCOO(A,ncoo,coo_i,coo_j);CHKERRQ(ierr);
+  ierr = PetscFree3(coo_i,coo_j,coo_v);CHKERRQ(ierr);
+  ierr = MatGetInfo(A,MAT_GLOBAL_SUM,&info);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Nonzeros %D\n",(PetscInt)info.nz_used);CHKERRQ(ierr);
+
+  /* B gets the same entries through MatSetValues() */
+  ierr = MatCreate(PETSC_COMM_WORLD,&B);CHKERRQ(ierr);
+  ierr = MatSetSizes(B,PETSC_DECIDE,PETSC_DECIDE,n,n);CHKERRQ(ierr);
+  ierr = MatSetType(B,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(B);CHKERRQ(ierr);
+  ierr = MatSetUp(B);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&z);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,NULL);CHKERRQ(ierr);
+  for (pass=0; pass<3; pass++) {
+    ierr = BuildEntries(A,n,pass,&ncoo,&coo_i,&coo_j,&coo_v);CHKERRQ(ierr);
+    /* the second pass adds to the values of the first one */
+    ierr = MatSetValuesCOO(A,coo_v,pass == 1 ? ADD_VALUES : INSERT_VALUES);CHKERRQ(ierr);
+    if (pass != 1) {ierr = MatZeroEntries(B);CHKERRQ(ierr);}
+    for (k=0; k<ncoo; k++) {
+      ierr = MatSetValues(B,1,&coo_i[k],1,&coo_j[k],&coo_v[k],ADD_VALUES);CHKERRQ(ierr);
+    }
+    ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = PetscFree3(coo_i,coo_j,coo_v);CHKERRQ(ierr);
+    ierr = MatEqual(A,B,&equal);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Pass %D: matrices are %s\n",pass,equal ? "equal" : "different");CHKERRQ(ierr);
+    /* derived formats keep their own copy of the values, which MatEqual() does not look at */
+    ierr = MatMult(A,x,y);CHKERRQ(ierr);
+    ierr = MatMult(B,x,z);CHKERRQ(ierr);
+    ierr = VecAXPY(y,-1.0,z);CHKERRQ(ierr);
+    ierr = VecNorm(y,NORM_INFINITY,&nrm);CHKERRQ(ierr);
+    if (nrm > 100*PETSC_MACHINE_EPSILON) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Pass %D: products differ by %g\n",pass,(double)nrm);CHKERRQ(ierr);}
+  }
+
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 2 3}}
+      output_file: output/ex229_1.out
+
+   test:
+      suffix: basic
+      nsize: 2
+      args: -mat_type baij
+      output_file: output/ex229_1.out
+
+   test:
+      suffix: crl
+      nsize: 2
+      args: -mat_type aijcrl
+      output_file: output/ex229_1.out
+
+TEST*/
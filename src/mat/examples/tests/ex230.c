@@ -0,0 +1,110 @@
+static char help[] = "Tests repeated assemblies with MAT_SAME_OFF_PROC_ENTRIES.\n\
+  -n <n> : number of rows of the matrix\n\n";
+
+#include <petscmat.h>
+
+/*
+   Each process sets a stencil in rows spread over the whole matrix, so that most rows get contributions from other
+   processes and many entries are set more than once. The entries are the same in every pass, the order in which they
+   are set and the values are not. With INSERT_VALUES the value only depends on the location so that repeated entries agree.
+*/
+static PetscErrorCode FillMatrix(Mat A,PetscInt n,PetscInt pass,PetscBool reverse,InsertMode mode)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,k,l,nl,row,cols[3];
+  PetscScalar    vals[3];
+  PetscMPIInt    rank,size;
+
+  PetscFunctionBeginUser;
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)A),&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)A),&size);CHKERRQ(ierr);
+  nl   = (2*n-rank+size-1)/size;
+  for (l=0; l<nl; l++) {
+    i       = rank + (reverse ? nl-1-l : l)*size;
+    row     = (7*i) % n;
+    cols[0] = (row+n-1) % n; cols[1] = row; cols[2] = (row+n/2) % n;
+    for (k=0; k<3; k++) vals[k] = mode == INSERT_VALUES ? (PetscScalar)(row+2*cols[k]+pass) : (PetscScalar)(1+(i+pass)%5+k);
+    ierr = MatSetValues(A,1,&row,3,cols,vals,mode);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A,B;
+  PetscInt       n = 40,pass,row,col,rstart,rend;
+  PetscScalar    one = 1.0;
+  PetscBool      equal;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+
+  /* A is assembled with MAT_SAME_OFF_PROC_ENTRIES, B the regular way */
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,n,n);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSetUp(A);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_SAME_OFF_PROC_ENTRIES,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&B);CHKERRQ(ierr);
+  ierr = MatSetSizes(B,PETSC_DECIDE,PETSC_DECIDE,n,n);CHKERRQ(ierr);
+  ierr = MatSetType(B,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(B);CHKERRQ(ierr);
+  ierr = MatSetUp(B);CHKERRQ(ierr);
+  ierr = MatSetOption(B,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+
+  /* pass 0 records the entries, pass 2 sets them in another order, pass 3 inserts, pass 4 adds a local nonzero */
+  for (pass=0; pass<6; pass++) {
+    InsertMode mode = pass == 3 ? INSERT_VALUES : ADD_VALUES;
+
+    if (pass) {
+      ierr = MatZeroEntries(A);CHKERRQ(ierr);
+      ierr = MatZeroEntries(B);CHKERRQ(ierr);
+    }
+    ierr = FillMatrix(A,n,pass,(PetscBool)(pass == 2),mode);CHKERRQ(ierr);
+    ierr = FillMatrix(B,n,pass,(PetscBool)(pass == 2),mode);CHKERRQ(ierr);
+    if (pass == 4 && rend > rstart) {
+      row  = rstart; col = (rstart+n/2+1) % n;
+      ierr = MatSetValues(A,1,&row,1,&col,&one,ADD_VALUES);CHKERRQ(ierr);
+      ierr = MatSetValues(B,1,&row,1,&col,&one,ADD_VALUES);CHKERRQ(ierr);
+      col  = (rstart+1) % n;
+      ierr = MatSetValues(A,1,&row,1,&col,&one,ADD_VALUES);CHKERRQ(ierr);
+      ierr = MatSetValues(B,1,&row,1,&col,&one,ADD_VALUES);CHKERRQ(ierr);
+    }
+    ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatEqual(A,B,&equal);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Pass %D: matrices are %s\n",pass,equal ? "equal" : "different");CHKERRQ(ierr);
+  }
+
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 2 3}}
+      output_file: output/ex230_1.out
+
+   test:
+      suffix: baij
+      nsize: 3
+      args: -mat_type baij
+      output_file: output/ex230_1.out
+
+   test:
+      suffix: legacy
+      nsize: 3
+      args: -matstash_legacy
+      output_file: output/ex230_1.out
+
+TEST*/
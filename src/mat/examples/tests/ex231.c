@@ -0,0 +1,158 @@
+static char help[] = "Tests and times the products of AIJ matrices with several threads.\n\
+  -m <m>     : the matrix is the Laplacian on an m x m grid, with a few long rows\n\
+  -its <its> : number of products that are timed\n\
+  -time      : print the time of each kind of product\n\n";
+
+/*
+   To compare processes and threads on a node with, say, 4 cores run
+
+     mpiexec -n 4 ./ex231 -m 1000 -time
+     mpiexec -n 1 ./ex231 -m 1000 -time -mat_aij_num_threads 4
+
+   with a PETSc configured --with-openmp and the threads bound to the cores, for example with OMP_PROC_BIND=true.
+   The products are also computed with a BAIJ copy of the matrix, which does not use threads, and compared.
+*/
+#include <petscmat.h>
+#include <petsctime.h>
+
+static PetscErrorCode CheckProducts(const char *name,Vec y,Vec z)
+{
+  PetscReal      nrm,nrmz;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = VecNorm(z,NORM_INFINITY,&nrmz);CHKERRQ(ierr);
+  ierr = VecAXPY(y,-1.0,z);CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_INFINITY,&nrm);CHKERRQ(ierr);
+  if (nrm > 100*PETSC_MACHINE_EPSILON*PetscMax(nrmz,1.0)) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%s products differ by %g\n",name,(double)nrm);CHKERRQ(ierr);
+  } else {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%s products agree\n",name);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A,B;
+  Vec            x,y,z,u,w,v;
+  PetscInt       m = 20,its = 10,N,Istart,Iend,row,col,i,j,k,*dnz,*onz;
+  PetscScalar    val;
+  PetscLogDouble t0,t1,t2,t3;
+  PetscBool      time = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-its",&its,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-time",&time,NULL);CHKERRQ(ierr);
+  N    = m*m;
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,N,N);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSetUp(A);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&Istart,&Iend);CHKERRQ(ierr);
+  ierr = PetscMalloc2(Iend-Istart,&dnz,Iend-Istart,&onz);CHKERRQ(ierr);
+  for (row=Istart; row<Iend; row++) {
+    dnz[row-Istart] = PetscMin(5,Iend-Istart);
+    onz[row-Istart] = PetscMin(5,N-(Iend-Istart));
+    if (!(row%m)) {
+      for (k=0; k<N; k+=3) {
+        if (k >= Istart && k < Iend) dnz[row-Istart]++;
+        else onz[row-Istart]++;
+      }
+      dnz[row-Istart] = PetscMin(dnz[row-Istart],Iend-Istart);
+      onz[row-Istart] = PetscMin(onz[row-Istart],N-(Iend-Istart));
+    }
+  }
+  ierr = MatSeqAIJSetPreallocation(A,0,dnz);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(A,0,dnz,0,onz);CHKERRQ(ierr);
+  ierr = PetscFree2(dnz,onz);CHKERRQ(ierr);
+  for (row=Istart; row<Iend; row++) {
+    i = row/m; j = row - i*m;
+    if (i>0)   {col = row - m; val = -1.0; ierr = MatSetValues(A,1,&row,1,&col,&val,ADD_VALUES);CHKERRQ(ierr);}
+    if (i<m-1) {col = row + m; val = -1.0; ierr = MatSetValues(A,1,&row,1,&col,&val,ADD_VALUES);CHKERRQ(ierr);}
+    if (j>0)   {col = row - 1; val = -1.0; ierr = MatSetValues(A,1,&row,1,&col,&val,ADD_VALUES);CHKERRQ(ierr);}
+    if (j<m-1) {col = row + 1; val = -1.0; ierr = MatSetValues(A,1,&row,1,&col,&val,ADD_VALUES);CHKERRQ(ierr);}
+    val  = 4.0 + (PetscScalar)(row%3);
+    ierr = MatSetValues(A,1,&row,1,&row,&val,ADD_VALUES);CHKERRQ(ierr);
+    /* every m-th row couples to the whole grid so that rows and nonzeros are not balanced together */
+    if (!(row%m)) {
+      for (k=0; k<N; k+=3) {
+        val  = 0.01*(PetscScalar)(k%7+1);
+        ierr = MatSetValues(A,1,&row,1,&k,&val,ADD_VALUES);CHKERRQ(ierr);
+      }
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatConvert(A,MATBAIJ,MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+
+  ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&z);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&w);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&u);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&v);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,NULL);CHKERRQ(ierr);
+  ierr = VecSetRandom(w,NULL);CHKERRQ(ierr);
+
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = MatMult(B,x,z);CHKERRQ(ierr);
+  ierr = CheckProducts("MatMult",y,z);CHKERRQ(ierr);
+  ierr = MatMultAdd(A,x,w,y);CHKERRQ(ierr);
+  ierr = MatMultAdd(B,x,w,z);CHKERRQ(ierr);
+  ierr = CheckProducts("MatMultAdd",y,z);CHKERRQ(ierr);
+  ierr = MatMultTranspose(A,w,u);CHKERRQ(ierr);
+  ierr = MatMultTranspose(B,w,v);CHKERRQ(ierr);
+  ierr = CheckProducts("MatMultTranspose",u,v);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd(A,w,x,u);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd(B,w,x,v);CHKERRQ(ierr);
+  ierr = CheckProducts("MatMultTransposeAdd",u,v);CHKERRQ(ierr);
+
+  if (time) {
+    ierr = PetscBarrier((PetscObject)A);CHKERRQ(ierr);
+    ierr = PetscTime(&t0);CHKERRQ(ierr);
+    for (k=0; k<its; k++) {ierr = MatMult(A,x,y);CHKERRQ(ierr);}
+    ierr = PetscBarrier((PetscObject)A);CHKERRQ(ierr);
+    ierr = PetscTime(&t1);CHKERRQ(ierr);
+    for (k=0; k<its; k++) {ierr = MatMultAdd(A,x,w,y);CHKERRQ(ierr);}
+    ierr = PetscBarrier((PetscObject)A);CHKERRQ(ierr);
+    ierr = PetscTime(&t2);CHKERRQ(ierr);
+    for (k=0; k<its; k++) {ierr = MatMultTranspose(A,w,u);CHKERRQ(ierr);}
+    ierr = PetscBarrier((PetscObject)A);CHKERRQ(ierr);
+    ierr = PetscTime(&t3);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Seconds per product: MatMult %g MatMultAdd %g MatMultTranspose %g\n",(t1-t0)/its,(t2-t1)/its,(t3-t2)/its);CHKERRQ(ierr);
+  }
+
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
+  ierr = VecDestroy(&u);CHKERRQ(ierr);
+  ierr = VecDestroy(&v);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 2}}
+      args: -mat_aij_num_threads {{1 3}}
+      output_file: output/ex231_1.out
+
+   test:
+      suffix: noinode
+      args: -mat_aij_num_threads 4 -mat_no_inode -m 13
+      output_file: output/ex231_1.out
+
+   test:
+      suffix: view
+      args: -mat_aij_num_threads 2 -mat_view ::ascii_info -m 10
+      filter: grep threads
+
+TEST*/
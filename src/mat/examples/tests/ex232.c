@@ -0,0 +1,154 @@
+static char help[] = "Tests the choice of the format of the products of AIJ matrices at assembly.\n\
+  -m <m>   : the matrix couples the points of an m x m grid with their neighbors\n\
+  -bs <bs> : number of unknowns at each point, coupled by dense blocks\n\
+  -view    : show which format was chosen\n\n";
+
+#include <petscmat.h>
+
+static PetscErrorCode FillMatrix(Mat A,PetscInt m,PetscInt bs,PetscInt pass)
+{
+  PetscErrorCode ierr;
+  PetscInt       rstart,rend,p,q,i,j,k,l,nb,nbrs[5];
+  PetscScalar    *vals;
+
+  PetscFunctionBeginUser;
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  ierr = PetscMalloc1(bs*bs,&vals);CHKERRQ(ierr);
+  for (p=rstart/bs; p<rend/bs; p++) {
+    i  = p/m; j = p - i*m; nb = 0;
+    nbrs[nb++] = p;
+    if (i>0)   nbrs[nb++] = p-m;
+    if (i<m-1) nbrs[nb++] = p+m;
+    if (j>0)   nbrs[nb++] = p-1;
+    if (j<m-1) nbrs[nb++] = p+1;
+    for (q=0; q<nb; q++) {
+      for (k=0; k<bs; k++) {
+        for (l=0; l<bs; l++) vals[k*bs+l] = q ? -1.0/(1+k+l) : (k == l ? 4.0+pass : 1.0/(1+k+l+pass));
+      }
+      ierr = MatSetValuesBlocked(A,1,&p,1,&nbrs[q],vals,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFree(vals);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CheckProducts(Mat A,Mat D,Vec x,Vec w,const char *when)
+{
+  Vec            y,z;
+  PetscReal      nrm,nrm2;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = VecDuplicate(w,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(w,&z);CHKERRQ(ierr);
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = MatMult(D,x,z);CHKERRQ(ierr);
+  ierr = VecAXPY(y,-1.0,z);CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_INFINITY,&nrm);CHKERRQ(ierr);
+  ierr = MatMultAdd(A,x,w,y);CHKERRQ(ierr);
+  ierr = MatMultAdd(D,x,w,z);CHKERRQ(ierr);
+  ierr = VecAXPY(y,-1.0,z);CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_INFINITY,&nrm2);CHKERRQ(ierr);
+  if (nrm > 1000*PETSC_MACHINE_EPSILON || nrm2 > 1000*PETSC_MACHINE_EPSILON) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Products %s differ by %g and %g\n",when,(double)nrm,(double)nrm2);CHKERRQ(ierr);
+  } else {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Products %s agree\n",when);CHKERRQ(ierr);
+  }
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A,D;
+  Vec            x,w;
+  PetscInt       m = 6,bs = 3;
+  PetscBool      view = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-view",&view,NULL);CHKERRQ(ierr);
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,m*m*bs,m*m*bs);CHKERRQ(ierr);
+  ierr = MatSetBlockSize(A,bs);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(A,5*bs,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(A,5*bs,NULL,4*bs,NULL);CHKERRQ(ierr);
+  ierr = FillMatrix(A,m,bs,0);CHKERRQ(ierr);
+  if (view) {
+    ierr = PetscViewerPushFormat(PETSC_VIEWER_STDOUT_WORLD,PETSC_VIEWER_ASCII_INFO);CHKERRQ(ierr);
+    ierr = MatView(A,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+    ierr = PetscViewerPopFormat(PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+  }
+
+  ierr = MatConvert(A,MATDENSE,MAT_INITIAL_MATRIX,&D);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&w);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,NULL);CHKERRQ(ierr);
+  ierr = VecSetRandom(w,NULL);CHKERRQ(ierr);
+  ierr = CheckProducts(A,D,x,w,"after assembly");CHKERRQ(ierr);
+
+  /* the copy in the chosen format follows changes of the values without assembly */
+  ierr = MatScale(A,2.0);CHKERRQ(ierr);
+  ierr = MatScale(D,2.0);CHKERRQ(ierr);
+  ierr = CheckProducts(A,D,x,w,"after scaling");CHKERRQ(ierr);
+
+  /* and new values set with the same nonzero pattern */
+  ierr = FillMatrix(A,m,bs,1);CHKERRQ(ierr);
+  ierr = MatDestroy(&D);CHKERRQ(ierr);
+  ierr = MatConvert(A,MATDENSE,MAT_INITIAL_MATRIX,&D);CHKERRQ(ierr);
+  ierr = CheckProducts(A,D,x,w,"after a new assembly");CHKERRQ(ierr);
+
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&D);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 2}}
+      args: -mat_aij_autotune
+      output_file: output/ex232_1.out
+
+   test:
+      suffix: structure
+      args: -mat_aij_autotune -bs {{1 3}separate output} -view
+      filter: grep "autotuned\|Products"
+
+   test:
+      suffix: time
+      nsize: {{1 2}}
+      args: -mat_aij_autotune -mat_aij_autotune_time
+      output_file: output/ex232_1.out
+
+   test:
+      suffix: aij
+      args: -mat_aij_autotune -mat_aij_autotune_formats aij -view
+      filter: grep "autotuned\|Products"
+
+   test:
+      suffix: inode
+      args: -mat_aij_autotune -mat_aij_autotune_formats inode -view
+      filter: grep "autotuned\|Products"
+
+   test:
+      suffix: sell
+      args: -mat_aij_autotune -mat_aij_autotune_formats sell -view
+      filter: grep "autotuned\|Products"
+
+   test:
+      suffix: baij
+      args: -mat_aij_autotune -mat_aij_autotune_formats baij -view -bs 2
+      filter: grep "autotuned\|Products"
+
+TEST*/
@@ -75,6 +75,7 @@
       PetscEnum MAT_SUBSET_OFF_PROC_ENTRIES
       PetscEnum MAT_SUBMAT_SINGLEIS
       PetscEnum MAT_STRUCTURE_ONLY
+      PetscEnum MAT_SAME_OFF_PROC_ENTRIES
       PetscEnum MAT_OPTION_MAX
 
       parameter(MAT_OPTION_MIN = -3)
@@ -102,7 +103,8 @@
       parameter(MAT_SUBSET_OFF_PROC_ENTRIES = 20)
       parameter(MAT_SUBMAT_SINGLEIS = 21)
       parameter(MAT_STRUCTURE_ONLY = 22)
-      parameter(MAT_OPTION_MAX = 23)
+      parameter(MAT_SAME_OFF_PROC_ENTRIES = 23)
+      parameter(MAT_OPTION_MAX = 24)
 !
 !  MatFactorShiftType
 !
@@ -641,6 +643,7 @@
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_SUBSET_OFF_PROC_ENTRIES
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_SUBMAT_SINGLEIS
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_STRUCTURE_ONLY
+!DEC$ ATTRIBUTES DLLEXPORT::MAT_SAME_OFF_PROC_ENTRIES
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_OPTION_MAX
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_SHIFT_NONE
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_SHIFT_NONZERO
@@ -777,6 +777,42 @@ PetscErrorCode MatAssemblyBegin_MPIAIJ(Mat mat,MatAssemblyType mode)
   PetscFunctionReturn(0);
 }
 
+/*
+   Locates in the diagonal and off-diagonal blocks the entries received by a stash frozen with MAT_SAME_OFF_PROC_ENTRIES,
+   so that the later assemblies add their values in place
+*/
+static PetscErrorCode MatSetUpFrozenStash_MPIAIJ(Mat mat)
+{
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)aij->A->data,*b = (Mat_SeqAIJ*)aij->B->data;
+  MatStash       *stash = &mat->stash;
+  PetscInt       rstart = mat->rmap->rstart,cstart = mat->cmap->rstart,cend = mat->cmap->rend,k,r,c,loc;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(aij->frozen_dest);CHKERRQ(ierr);
+  ierr = PetscMalloc1(stash->frozen_nrecv,&aij->frozen_dest);CHKERRQ(ierr);
+  for (k=0; k<stash->frozen_nrecv; k++) {
+    r = stash->frozen_recvrows[k] - rstart;
+    c = stash->frozen_recvcols[k];
+    if (c >= cstart && c < cend) {
+      ierr = PetscFindInt(c-cstart,a->ilen[r],a->j+a->i[r],&loc);CHKERRQ(ierr);
+      aij->frozen_dest[k] = loc < 0 ? -1 : a->i[r]+loc;
+    } else {
+      ierr = PetscFindInt(c,aij->B->cmap->n,aij->garray,&c);CHKERRQ(ierr);
+      loc  = -1;
+      if (c >= 0) {ierr = PetscFindInt(c,b->ilen[r],b->j+b->i[r],&loc);CHKERRQ(ierr);}
+      aij->frozen_dest[k] = loc < 0 ? -1 : -(b->i[r]+loc)-2;
+    }
+  }
+  aij->frozen_count  = stash->frozen_count;
+  aij->frozen_Astate = aij->A->nonzerostate;
+  aij->frozen_Bstate = aij->B->nonzerostate;
+  aij->frozen_Bid    = ((PetscObject)aij->B)->id;
+  ierr = PetscInfo1(mat,"Located the %D entries received by the frozen stash\n",stash->frozen_nrecv);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatAssemblyEnd_MPIAIJ(Mat mat,MatAssemblyType mode)
 {
   Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
@@ -785,13 +821,37 @@ PetscErrorCode MatAssemblyEnd_MPIAIJ(Mat mat,MatAssemblyType mode)
   PetscMPIInt    n;
   PetscInt       i,j,rstart,ncols,flg;
   PetscInt       *row,*col;
-  PetscBool      other_disassembled;
+  PetscBool      other_disassembled,frozen;
   PetscScalar    *val;
 
   /* do not use 'b = (Mat_SeqAIJ*)aij->B->data' as B can be reset in disassembly */
 
   PetscFunctionBegin;
-  if (!aij->donotstash && !mat->nooffprocentries) {
+  /* the locations of the entries received by a frozen stash are valid until the nonzero structure changes */
+  frozen = (PetscBool)(aij->frozen_dest && aij->frozen_count == mat->stash.frozen_count && aij->garray && aij->frozen_Bid == ((PetscObject)aij->B)->id &&
+                       aij->frozen_Astate == aij->A->nonzerostate && aij->frozen_Bstate == aij->B->nonzerostate);
+  if (!aij->donotstash && !mat->nooffprocentries && mat->stash.frozen_values && frozen) {
+    MatScalar *aa = a->a,*ba = ((Mat_SeqAIJ*)aij->B->data)->a;
+    PetscInt  offset,*dest;
+
+    while (1) {
+      ierr = MatStashScatterGetFrozenMesg_Private(&mat->stash,&n,&offset,&val,&flg);CHKERRQ(ierr);
+      if (!flg) break;
+      dest = aij->frozen_dest + offset;
+      if (mat->insertmode == INSERT_VALUES) {
+        for (i=0; i<n; i++) {
+          if (dest[i] >= 0)       aa[dest[i]]    = val[i];
+          else if (dest[i] < -1) ba[-dest[i]-2] = val[i];
+        }
+      } else {
+        for (i=0; i<n; i++) {
+          if (dest[i] >= 0)       aa[dest[i]]    += val[i];
+          else if (dest[i] < -1) ba[-dest[i]-2] += val[i];
+        }
+      }
+    }
+    ierr = MatStashScatterEnd_Private(&mat->stash);CHKERRQ(ierr);
+  } else if (!aij->donotstash && !mat->nooffprocentries) {
     while (1) {
       ierr = MatStashScatterGetMesg_Private(&mat->stash,&n,&row,&col,&val,&flg);CHKERRQ(ierr);
       if (!flg) break;
@@ -845,6 +905,11 @@ PetscErrorCode MatAssemblyEnd_MPIAIJ(Mat mat,MatAssemblyType mode)
     PetscObjectState state = aij->A->nonzerostate + aij->B->nonzerostate;
     ierr = MPIU_Allreduce(&state,&mat->nonzerostate,1,MPIU_INT64,MPI_SUM,PetscObjectComm((PetscObject)mat));CHKERRQ(ierr);
   }
+  if (mode == MAT_FINAL_ASSEMBLY && mat->stash.frozen) {
+    frozen = (PetscBool)(aij->frozen_dest && aij->frozen_count == mat->stash.frozen_count && aij->frozen_Bid == ((PetscObject)aij->B)->id &&
+                         aij->frozen_Astate == aij->A->nonzerostate && aij->frozen_Bstate == aij->B->nonzerostate);
+    if (!frozen) {ierr = MatSetUpFrozenStash_MPIAIJ(mat);CHKERRQ(ierr);}
+  }
   PetscFunctionReturn(0);
 }
 
@@ -1212,6 +1277,8 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   if (aij->Mvctx_mpi1) {ierr = VecScatterDestroy(&aij->Mvctx_mpi1);CHKERRQ(ierr);}
   ierr = PetscFree2(aij->rowvalues,aij->rowindices);CHKERRQ(ierr);
   ierr = PetscFree(aij->ld);CHKERRQ(ierr);
+  ierr = PetscFree(aij->frozen_dest);CHKERRQ(ierr);
+  ierr = MatResetPreallocationCOO_MPIAIJ(mat);CHKERRQ(ierr);
   ierr = PetscFree(mat->data);CHKERRQ(ierr);
 
   ierr = PetscObjectChangeTypeName((PetscObject)mat,0);CHKERRQ(ierr);
@@ -1220,6 +1287,8 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatIsTranspose_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMPIAIJSetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatResetPreallocation_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatSetPreallocationCOO_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatSetValuesCOO_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMPIAIJSetPreallocationCSR_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatDiagonalScaleLocal_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatConvert_mpiaij_mpisbaij_C",NULL);CHKERRQ(ierr);
@@ -2169,10 +2238,17 @@ PetscErrorCode MatCopy_MPIAIJ(Mat A,Mat B,MatStructure str)
 
 PetscErrorCode MatSetUp_MPIAIJ(Mat A)
 {
+  PetscBool      hash = PETSC_FALSE,ismpiaij;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  ierr = MatMPIAIJSetPreallocation(A,PETSC_DEFAULT,0,PETSC_DEFAULT,0);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATMPIAIJ,&ismpiaij);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(((PetscObject)A)->options,((PetscObject)A)->prefix,"-mat_aij_hash",&hash,NULL);CHKERRQ(ierr);
+  if (ismpiaij && hash && !A->structure_only) {
+    ierr = MatSetUp_MPIAIJ_Hash(A);CHKERRQ(ierr);
+  } else {
+    ierr = MatMPIAIJSetPreallocation(A,PETSC_DEFAULT,0,PETSC_DEFAULT,0);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -2753,6 +2829,7 @@ PetscErrorCode  MatMPIAIJSetPreallocation_MPIAIJ(Mat B,PetscInt d_nz,const Petsc
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  ierr = MatHashEnd_Private(B,NULL);CHKERRQ(ierr);
   ierr = PetscLayoutSetUp(B->rmap);CHKERRQ(ierr);
   ierr = PetscLayoutSetUp(B->cmap);CHKERRQ(ierr);
   b = (Mat_MPIAIJ*)B->data;
@@ -4320,7 +4397,11 @@ $     MatMPIAIJSetPreallocation(A,...);
 
    Options Database Keys:
 +  -mat_no_inode  - Do not use inodes
--  -mat_inode_limit <limit> - Sets inode limit (max limit=5)
+.  -mat_inode_limit <limit> - Sets inode limit (max limit=5)
+.  -mat_aij_num_threads <n> - Splits the rows in n blocks with about the same number of nonzeros, that are multiplied by different OpenMP threads
+.  -mat_aij_autotune - Chooses the format of the products from the nonzero structure at assembly
+.  -mat_aij_autotune_time - Times the products with the candidate formats instead and uses the fastest one
+-  -mat_aij_autotune_formats <aij,inode,sell,baij> - The candidate formats
 
 
 
@@ -5612,6 +5693,204 @@ PETSC_INTERN PetscErrorCode MatMatMult_MPIDense_MPIAIJ(Mat A,Mat B,MatReuse scal
   PetscFunctionReturn(0);
 }
 
+
+PetscErrorCode MatResetPreallocationCOO_MPIAIJ(Mat mat)
+{
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFDestroy(&aij->coo_sf);CHKERRQ(ierr);
+  ierr = PetscFree(aij->coo_sendperm);CHKERRQ(ierr);
+  ierr = PetscFree2(aij->coo_sendbuf,aij->coo_recvbuf);CHKERRQ(ierr);
+  ierr = PetscFree2(aij->coo_Ajmap,aij->coo_Bjmap);CHKERRQ(ierr);
+  ierr = PetscFree2(aij->coo_Aperm,aij->coo_Bperm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetPreallocationCOO_MPIAIJ(Mat mat,PetscInt n,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
+  Mat_SeqAIJ     *a,*b;
+  MPI_Comm       comm;
+  PetscMPIInt    owner,nto = 0,nfrom,*toranks,*fromranks;
+  PetscInt       m = mat->rmap->n,rstart = mat->rmap->rstart,rend = mat->rmap->rend,cstart = mat->cmap->rstart,cend = mat->cmap->rend;
+  PetscInt       nsend = 0,nrecv = 0,k,s,t,r,p,q,nA = 0,nB = 0;
+  PetscInt       *sendowner,*todata,*fromdata,*sendi,*sendj,*recvi,*recvj,*rows,*cols,*rowptr,*jcols,*perm,*dnnz,*onnz;
+  PetscSFNode    *iremote;
+  PetscBool      diag;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)mat,&comm);CHKERRQ(ierr);
+  ierr = MatResetPreallocationCOO_MPIAIJ(mat);CHKERRQ(ierr);
+
+  /* the entries of rows owned by other processes are sorted by owner, each owner learns how many it gets and where they start */
+  for (k=0; k<n; k++) {
+    if (coo_i[k] < 0 || coo_j[k] < 0) continue;
+#if defined(PETSC_USE_DEBUG)
+    if (coo_i[k] >= mat->rmap->N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Row too large: row %D max %D",coo_i[k],mat->rmap->N-1);
+    if (coo_j[k] >= mat->cmap->N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Column too large: col %D max %D",coo_j[k],mat->cmap->N-1);
+#endif
+    if (coo_i[k] < rstart || coo_i[k] >= rend) nsend++;
+  }
+  ierr = PetscMalloc1(nsend,&sendowner);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nsend,&aij->coo_sendperm);CHKERRQ(ierr);
+  for (k=0,s=0; k<n; k++) {
+    if (coo_i[k] < 0 || coo_j[k] < 0 || (coo_i[k] >= rstart && coo_i[k] < rend)) continue;
+    ierr = PetscLayoutFindOwner(mat->rmap,coo_i[k],&owner);CHKERRQ(ierr);
+    sendowner[s]            = owner;
+    aij->coo_sendperm[s++] = k;
+  }
+  ierr = PetscSortIntWithArray(nsend,sendowner,aij->coo_sendperm);CHKERRQ(ierr);
+  for (s=0; s<nsend; s++) if (!s || sendowner[s] != sendowner[s-1]) nto++;
+  ierr = PetscMalloc2(nto,&toranks,2*nto,&todata);CHKERRQ(ierr);
+  for (s=0,t=-1; s<nsend; s++) {
+    if (!s || sendowner[s] != sendowner[s-1]) {
+      t++;
+      toranks[t]     = (PetscMPIInt)sendowner[s];
+      todata[2*t]    = 0;
+      todata[2*t+1]  = s;
+    }
+    todata[2*t]++;
+  }
+  ierr = PetscFree(sendowner);CHKERRQ(ierr);
+  ierr = PetscCommBuildTwoSided(comm,2,MPIU_INT,nto,toranks,todata,&nfrom,&fromranks,&fromdata);CHKERRQ(ierr);
+  ierr = PetscFree2(toranks,todata);CHKERRQ(ierr);
+  for (t=0; t<nfrom; t++) nrecv += fromdata[2*t];
+  ierr = PetscMalloc1(nrecv,&iremote);CHKERRQ(ierr);
+  for (t=0,q=0; t<nfrom; t++) {
+    for (s=0; s<fromdata[2*t]; s++,q++) {
+      iremote[q].rank  = fromranks[t];
+      iremote[q].index = fromdata[2*t+1]+s;
+    }
+  }
+  ierr = PetscFree(fromranks);CHKERRQ(ierr);
+  ierr = PetscFree(fromdata);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm,&aij->coo_sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(aij->coo_sf,nsend,nrecv,NULL,PETSC_OWN_POINTER,iremote,PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(aij->coo_sf);CHKERRQ(ierr);
+  aij->coo_n     = n;
+  aij->coo_nsend = nsend;
+  ierr = PetscMalloc2(nsend,&aij->coo_sendbuf,nrecv,&aij->coo_recvbuf);CHKERRQ(ierr);
+
+  /* the owned entries and the received ones are listed together, a received entry r gets the index n+r */
+  ierr = PetscMalloc4(nsend,&sendi,nsend,&sendj,nrecv,&recvi,nrecv,&recvj);CHKERRQ(ierr);
+  for (s=0; s<nsend; s++) {
+    sendi[s] = coo_i[aij->coo_sendperm[s]];
+    sendj[s] = coo_j[aij->coo_sendperm[s]];
+  }
+  ierr = PetscSFBcastBegin(aij->coo_sf,MPIU_INT,sendi,recvi);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(aij->coo_sf,MPIU_INT,sendj,recvj);CHKERRQ(ierr);
+  ierr = PetscMalloc2(n+nrecv,&rows,n+nrecv,&cols);CHKERRQ(ierr);
+  for (k=0; k<n; k++) {
+    rows[k] = (coo_i[k] >= rstart && coo_i[k] < rend) ? coo_i[k]-rstart : -1;
+    cols[k] = coo_j[k];
+  }
+  ierr = PetscSFBcastEnd(aij->coo_sf,MPIU_INT,sendi,recvi);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(aij->coo_sf,MPIU_INT,sendj,recvj);CHKERRQ(ierr);
+  for (r=0; r<nrecv; r++) {
+    rows[n+r] = recvi[r]-rstart;
+    cols[n+r] = recvj[r];
+  }
+  ierr = PetscFree4(sendi,sendj,recvi,recvj);CHKERRQ(ierr);
+  ierr = MatCOOSortRows_Private(m,n+nrecv,rows,cols,&rowptr,&jcols,&perm);CHKERRQ(ierr);
+  ierr = PetscFree2(rows,cols);CHKERRQ(ierr);
+
+  /* within a row sorted by global column the diagonal block columns are contiguous, so both blocks come out sorted */
+  ierr = PetscCalloc2(m,&dnnz,m,&onnz);CHKERRQ(ierr);
+  for (r=0; r<m; r++) {
+    for (p=rowptr[r]; p<rowptr[r+1]; p++) {
+      if (p > rowptr[r] && jcols[p] == jcols[p-1]) continue;
+      if (jcols[p] >= cstart && jcols[p] < cend) dnnz[r]++;
+      else                                       onnz[r]++;
+    }
+  }
+  ierr = MatMPIAIJSetPreallocation(mat,0,dnnz,0,onnz);CHKERRQ(ierr);
+  ierr = PetscFree2(dnnz,onnz);CHKERRQ(ierr);
+  a    = (Mat_SeqAIJ*)aij->A->data;
+  b    = (Mat_SeqAIJ*)aij->B->data;
+  ierr = PetscMalloc2(a->i[m]+1,&aij->coo_Ajmap,b->i[m]+1,&aij->coo_Bjmap);CHKERRQ(ierr);
+  ierr = PetscMalloc2(rowptr[m],&aij->coo_Aperm,rowptr[m],&aij->coo_Bperm);CHKERRQ(ierr);
+  for (r=0; r<m; r++) {
+    for (p=rowptr[r]; p<rowptr[r+1]; p++) {
+      diag = (jcols[p] >= cstart && jcols[p] < cend) ? PETSC_TRUE : PETSC_FALSE;
+      if (p == rowptr[r] || jcols[p] != jcols[p-1]) {
+        if (diag) {
+          k                  = a->i[r] + a->ilen[r]++;
+          a->j[k]            = jcols[p]-cstart;
+          aij->coo_Ajmap[k]  = nA;
+        } else {
+          k                  = b->i[r] + b->ilen[r]++;
+          b->j[k]            = jcols[p];
+          aij->coo_Bjmap[k]  = nB;
+        }
+      }
+      if (diag) aij->coo_Aperm[nA++] = perm[p];
+      else      aij->coo_Bperm[nB++] = perm[p];
+    }
+  }
+  aij->coo_Ajmap[a->i[m]] = nA;
+  aij->coo_Bjmap[b->i[m]] = nB;
+  ierr = PetscMemzero(a->a,a->i[m]*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscMemzero(b->a,b->i[m]*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscFree(rowptr);CHKERRQ(ierr);
+  ierr = PetscFree(jcols);CHKERRQ(ierr);
+  ierr = PetscFree(perm);CHKERRQ(ierr);
+
+  /* the assembly compacts the columns of B in place, the positions of the nonzeros do not move */
+  ierr = MatAssemblyBegin(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  aij->coo_nzstate = mat->nonzerostate;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetValuesCOO_MPIAIJ(Mat mat,const PetscScalar v[],InsertMode imode)
+{
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)aij->A->data,*b = (Mat_SeqAIJ*)aij->B->data;
+  PetscInt       n = aij->coo_n,m = mat->rmap->n,k,p,q;
+  PetscScalar    sum;
+  PetscBool      mpiaij;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!aij->coo_Ajmap) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Must call MatSetPreallocationCOO() first");
+  if (mat->nonzerostate != aij->coo_nzstate) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"The nonzero structure changed since MatSetPreallocationCOO()");
+  for (k=0; k<aij->coo_nsend; k++) aij->coo_sendbuf[k] = v[aij->coo_sendperm[k]];
+  ierr = PetscSFBcastBegin(aij->coo_sf,MPIU_SCALAR,aij->coo_sendbuf,aij->coo_recvbuf);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(aij->coo_sf,MPIU_SCALAR,aij->coo_sendbuf,aij->coo_recvbuf);CHKERRQ(ierr);
+  for (k=0; k<a->i[m]; k++) {
+    for (sum=0.0,p=aij->coo_Ajmap[k]; p<aij->coo_Ajmap[k+1]; p++) {
+      q    = aij->coo_Aperm[p];
+      sum += q < n ? v[q] : aij->coo_recvbuf[q-n];
+    }
+    if (imode == INSERT_VALUES) a->a[k]  = sum;
+    else                        a->a[k] += sum;
+  }
+  for (k=0; k<b->i[m]; k++) {
+    for (sum=0.0,p=aij->coo_Bjmap[k]; p<aij->coo_Bjmap[k+1]; p++) {
+      q    = aij->coo_Bperm[p];
+      sum += q < n ? v[q] : aij->coo_recvbuf[q-n];
+    }
+    if (imode == INSERT_VALUES) b->a[k]  = sum;
+    else                        b->a[k] += sum;
+  }
+  a->idiagvalid  = PETSC_FALSE;
+  a->ibdiagvalid = PETSC_FALSE;
+  ierr = VecDestroy(&aij->diag);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)aij->A);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)aij->B);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)mat);CHKERRQ(ierr);
+  /* derived types keep their own copy of the values of the blocks, it is refreshed by the assembly */
+  ierr = PetscObjectTypeCompare((PetscObject)mat,MATMPIAIJ,&mpiaij);CHKERRQ(ierr);
+  if (!mpiaij) {
+    ierr = MatAssemblyBegin(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 /*MC
    MATMPIAIJ - MATMPIAIJ = "mpiaij" - A matrix type to be used for parallel sparse matrices.
 
@@ -5667,6 +5946,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatIsTranspose_C",MatIsTranspose_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMPIAIJSetPreallocation_C",MatMPIAIJSetPreallocation_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatResetPreallocation_C",MatResetPreallocation_MPIAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetPreallocationCOO_C",MatSetPreallocationCOO_MPIAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetValuesCOO_C",MatSetValuesCOO_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMPIAIJSetPreallocationCSR_C",MatMPIAIJSetPreallocationCSR_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatDiagonalScaleLocal_C",MatDiagonalScaleLocal_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpiaij_mpiaijperm_C",MatConvert_MPIAIJ_MPIAIJPERM);CHKERRQ(ierr);
@@ -76,6 +76,21 @@ typedef struct {
   /* used by MatMatMatMult() */
   Mat_MatMatMatMult *matmatmatmult;
 
+  /* Used with MAT_SAME_OFF_PROC_ENTRIES */
+  PetscInt         *frozen_dest;          /* location of each entry received by the frozen stash, k in A as k, in B as -(k+2), -1 if dropped */
+  PetscInt         frozen_count;          /* the stash recording that frozen_dest was computed for */
+  PetscObjectState frozen_Astate,frozen_Bstate;
+  PetscObjectId    frozen_Bid;            /* B is recreated when the matrix is disassembled */
+
+  /* Used by MatSetValuesCOO() */
+  PetscInt         coo_n;                 /* number of entries given to MatSetPreallocationCOO() */
+  PetscSF          coo_sf;                /* sends the entries of rows owned by other processes, roots are coo_sendbuf[] */
+  PetscInt         coo_nsend,*coo_sendperm;
+  PetscScalar      *coo_sendbuf,*coo_recvbuf;
+  PetscInt         *coo_Ajmap,*coo_Aperm;  /* the entries coo_Aperm[coo_Ajmap[k]:coo_Ajmap[k+1]] add up to the nonzero k of A, */
+  PetscInt         *coo_Bjmap,*coo_Bperm;  /* an entry q >= coo_n is coo_recvbuf[q-coo_n] */
+  PetscObjectState coo_nzstate;
+
   /* Used by MPICUSP and MPICUSPARSE classes */
   void * spptr;
 
@@ -84,6 +99,10 @@ typedef struct {
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat);
 
 PETSC_INTERN PetscErrorCode MatAssemblyEnd_MPIAIJ(Mat,MatAssemblyType);
+PETSC_INTERN PetscErrorCode MatSetUp_MPIAIJ_Hash(Mat);
+PETSC_INTERN PetscErrorCode MatResetPreallocationCOO_MPIAIJ(Mat);
+PETSC_INTERN PetscErrorCode MatSetPreallocationCOO_MPIAIJ(Mat,PetscInt,const PetscInt[],const PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSetValuesCOO_MPIAIJ(Mat,const PetscScalar[],InsertMode);
 
 PETSC_INTERN PetscErrorCode MatSetUpMultiply_MPIAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatDisAssemble_MPIAIJ(Mat);
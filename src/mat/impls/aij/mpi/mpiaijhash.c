@@ -0,0 +1,146 @@
+
+/*
+   Assembly of MPIAIJ matrices that were not preallocated, see aijhash.c for the sequential case.
+
+   The locally owned entries are kept in a hash table with their global (row,column) indices, the off-process entries
+   go through the stash as usual. The final assembly receives the stash into the table, splits the entries of each
+   row between the diagonal and off-diagonal blocks, preallocates both exactly and fills them in one sweep over the table.
+*/
+#include <../src/mat/impls/aij/mpi/mpiaij.h>   /*I "petscmat.h" I*/
+
+static PetscErrorCode MatSetValues_MPIAIJ_Hash(Mat mat,PetscInt m,const PetscInt im[],PetscInt n,const PetscInt in[],const PetscScalar v[],InsertMode addv)
+{
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
+  PetscBool      ignorezeroentries = ((Mat_SeqAIJ*)aij->A->data)->ignorezeroentries;
+  PetscInt       rstart = mat->rmap->rstart,rend = mat->rmap->rend,i,j;
+  PetscHashIJKey key;
+  PetscScalar    value;
+  PetscBool      missing;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<m; i++) {
+    if (im[i] < 0) continue;
+#if defined(PETSC_USE_DEBUG)
+    if (im[i] >= mat->rmap->N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Row too large: row %D max %D",im[i],mat->rmap->N-1);
+#endif
+    if (im[i] >= rstart && im[i] < rend) {
+      key.i = im[i];
+      for (j=0; j<n; j++) {
+        key.j = in[j];
+        if (key.j < 0) continue;
+#if defined(PETSC_USE_DEBUG)
+        if (key.j >= mat->cmap->N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Column too large: col %D max %D",key.j,mat->cmap->N-1);
+#endif
+        value = v ? (aij->roworiented ? v[i*n+j] : v[i+j*m]) : 0.0;
+        if (ignorezeroentries && value == 0.0 && addv == ADD_VALUES && key.i != key.j) continue;
+        if (addv == ADD_VALUES) {
+          ierr = PetscHMapIJVQueryAdd(mat->hash_ht,key,value,&missing);CHKERRQ(ierr);
+        } else {
+          ierr = PetscHMapIJVSet(mat->hash_ht,key,value);CHKERRQ(ierr);
+        }
+      }
+    } else {
+      if (mat->nooffprocentries) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Setting off process row %D even though MatSetOption(,MAT_NO_OFF_PROC_ENTRIES,PETSC_TRUE) was set",im[i]);
+      if (!aij->donotstash) {
+        mat->assembled = PETSC_FALSE;
+        if (aij->roworiented) {
+          ierr = MatStashValuesRow_Private(&mat->stash,im[i],n,in,v+i*n,(PetscBool)(ignorezeroentries && (addv == ADD_VALUES)));CHKERRQ(ierr);
+        } else {
+          ierr = MatStashValuesCol_Private(&mat->stash,im[i],n,in,v+i,m,(PetscBool)(ignorezeroentries && (addv == ADD_VALUES)));CHKERRQ(ierr);
+        }
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatAssemblyEnd_MPIAIJ_Hash(Mat mat,MatAssemblyType mode)
+{
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)aij->A->data,*b = (Mat_SeqAIJ*)aij->B->data;
+  PetscInt       rstart = mat->rmap->rstart,cstart = mat->cmap->rstart,cend = mat->cmap->rend;
+  PetscInt       i,j,k,ncols,flg,anonew,bnonew,*row,*col,*dnz,*onz;
+  PetscMPIInt    n;
+  PetscScalar    *val,value;
+  PetscBool      nooffprocentries;
+  PetscHMapIJV   ht;
+  PetscHashIter  hi;
+  PetscHashIJKey key;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!aij->donotstash && !mat->nooffprocentries) {
+    while (1) {
+      ierr = MatStashScatterGetMesg_Private(&mat->stash,&n,&row,&col,&val,&flg);CHKERRQ(ierr);
+      if (!flg) break;
+      for (i=0; i<n; ) {
+        for (j=i; j<n && row[j] == row[i]; j++) ;
+        ncols = j-i;
+        ierr  = MatSetValues_MPIAIJ_Hash(mat,1,row+i,ncols,col+i,val+i,mat->insertmode);CHKERRQ(ierr);
+        i     = j;
+      }
+    }
+    ierr = MatStashScatterEnd_Private(&mat->stash);CHKERRQ(ierr);
+  }
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(0);
+  ierr = MatHashEnd_Private(mat,&ht);CHKERRQ(ierr);
+
+  ierr = PetscCalloc2(mat->rmap->n,&dnz,mat->rmap->n,&onz);CHKERRQ(ierr);
+  PetscHashIterBegin(ht,hi);
+  while (!PetscHashIterAtEnd(ht,hi)) {
+    PetscHashIterGetKey(ht,hi,key);
+    if (key.j >= cstart && key.j < cend) dnz[key.i-rstart]++;
+    else                                 onz[key.i-rstart]++;
+    PetscHashIterNext(ht,hi);
+  }
+  /* keep the nonew flags set by MatSetUp(), as MatAssemblyEnd_SeqAIJ_Hash() does */
+  anonew = a->nonew; bnonew = b->nonew;
+  ierr   = MatSeqAIJSetPreallocation(aij->A,0,dnz);CHKERRQ(ierr);
+  ierr   = MatSeqAIJSetPreallocation(aij->B,0,onz);CHKERRQ(ierr);
+  a->nonew = anonew; b->nonew = bnonew;
+  ierr   = PetscFree2(dnz,onz);CHKERRQ(ierr);
+  PetscHashIterBegin(ht,hi);
+  while (!PetscHashIterAtEnd(ht,hi)) {
+    PetscHashIterGetKey(ht,hi,key);
+    PetscHashIterGetVal(ht,hi,value);
+    i = key.i-rstart;
+    if (key.j >= cstart && key.j < cend) {
+      k       = a->i[i] + a->ilen[i]++;
+      a->j[k] = key.j-cstart;
+      a->a[k] = value;
+    } else {
+      k       = b->i[i] + b->ilen[i]++;
+      b->j[k] = key.j;
+      b->a[k] = value;
+    }
+    PetscHashIterNext(ht,hi);
+  }
+  ierr = PetscHMapIJVDestroy(&ht);CHKERRQ(ierr);
+  ierr = MatSeqAIJSortRows_Private(aij->A);CHKERRQ(ierr);
+  ierr = MatSeqAIJSortRows_Private(aij->B);CHKERRQ(ierr);
+
+  /* the stash has been emptied above */
+  nooffprocentries      = mat->nooffprocentries;
+  mat->nooffprocentries = PETSC_TRUE;
+  ierr = (*mat->ops->assemblyend)(mat,mode);CHKERRQ(ierr);
+  mat->nooffprocentries = nooffprocentries;
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatSetUp_MPIAIJ_Hash - Sets up a MATMPIAIJ matrix that was not preallocated to collect its entries in a hash table
+   until the first final assembly
+*/
+PetscErrorCode MatSetUp_MPIAIJ_Hash(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMPIAIJSetPreallocation(A,0,NULL,0,NULL);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatHashBegin_Private(A);CHKERRQ(ierr);
+  A->ops->setvalues   = MatSetValues_MPIAIJ_Hash;
+  A->ops->assemblyend = MatAssemblyEnd_MPIAIJ_Hash;
+  PetscFunctionReturn(0);
+}
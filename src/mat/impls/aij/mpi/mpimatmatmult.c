@@ -379,6 +379,30 @@ PetscErrorCode MatMPIAIJ_MPIDenseDestroy(void *ctx)
 }
 
 #include <petsc/private/vecscatterimpl.h>
+
+/*
+   The MPIDense routines below work directly on the send and receive lists of an MPI1 scatter; when the
+   matrix-vector product uses another scatter type an MPI1 scatter is built on the side, as in MatGetBrowsOfAoCols_MPIAIJ()
+*/
+static PetscErrorCode MatMPIAIJGetScatterMPI1_Private(Mat A,VecScatter *ctx)
+{
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)A->data;
+  PetscErrorCode ierr;
+  PetscMPIInt    size;
+  PetscBool      mpi1;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)A),&size);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)aij->Mvctx,VECSCATTERMPI1,&mpi1);CHKERRQ(ierr);
+  if (mpi1 || size == 1) {*ctx = aij->Mvctx; PetscFunctionReturn(0);}
+  if (!aij->Mvctx_mpi1) {
+    aij->Mvctx_mpi1_flg = PETSC_TRUE;
+    ierr = MatSetUpMultiply_MPIAIJ(A);CHKERRQ(ierr);
+  }
+  *ctx = aij->Mvctx_mpi1;
+  PetscFunctionReturn(0);
+}
+
 /*
     This is a "dummy function" that handles the case where matrix C was created as a dense matrix
   directly by the user and passed to MatMatMult() with the MAT_REUSE_MATRIX option
@@ -397,9 +421,8 @@ PetscErrorCode MatMatMultNumeric_MPIDense(Mat A,Mat B,Mat C)
   PetscInt               nz   = aij->B->cmap->n;
   PetscContainer         container;
   MPIAIJ_MPIDense        *contents;
-  VecScatter             ctx   = aij->Mvctx;
-  VecScatter_MPI_General *from = (VecScatter_MPI_General*) ctx->fromdata;
-  VecScatter_MPI_General *to   = (VecScatter_MPI_General*) ctx->todata;
+  VecScatter             ctx;
+  VecScatter_MPI_General *from,*to;
 
   PetscFunctionBegin;
   ierr = PetscObjectTypeCompare((PetscObject)B,MATMPIDENSE,&flg);CHKERRQ(ierr);
@@ -408,6 +431,9 @@ PetscErrorCode MatMatMultNumeric_MPIDense(Mat A,Mat B,Mat C)
   /* Handle case where where user provided the final C matrix rather than calling MatMatMult() with MAT_INITIAL_MATRIX*/
   ierr = PetscObjectTypeCompare((PetscObject)A,MATMPIAIJ,&flg);CHKERRQ(ierr);
   if (!flg) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"First matrix must be MPIAIJ");
+  ierr = MatMPIAIJGetScatterMPI1_Private(A,&ctx);CHKERRQ(ierr);
+  from = (VecScatter_MPI_General*)ctx->fromdata;
+  to   = (VecScatter_MPI_General*)ctx->todata;
 
   C->ops->matmultnumeric = MatMatMultNumeric_MPIAIJ_MPIDense;
 
@@ -437,12 +463,14 @@ PetscErrorCode MatMatMultSymbolic_MPIAIJ_MPIDense(Mat A,Mat B,PetscReal fill,Mat
   PetscInt               nz   = aij->B->cmap->n;
   PetscContainer         container;
   MPIAIJ_MPIDense        *contents;
-  VecScatter             ctx   = aij->Mvctx;
-  VecScatter_MPI_General *from = (VecScatter_MPI_General*) ctx->fromdata;
-  VecScatter_MPI_General *to   = (VecScatter_MPI_General*) ctx->todata;
+  VecScatter             ctx;
+  VecScatter_MPI_General *from,*to;
   PetscInt               m     = A->rmap->n,n=B->cmap->n;
 
   PetscFunctionBegin;
+  ierr = MatMPIAIJGetScatterMPI1_Private(A,&ctx);CHKERRQ(ierr);
+  from = (VecScatter_MPI_General*)ctx->fromdata;
+  to   = (VecScatter_MPI_General*)ctx->todata;
   ierr = MatCreate(PetscObjectComm((PetscObject)B),C);CHKERRQ(ierr);
   ierr = MatSetSizes(*C,m,n,A->rmap->N,B->cmap->N);CHKERRQ(ierr);
   ierr = MatSetBlockSizesFromMats(*C,A,B);CHKERRQ(ierr);
@@ -479,21 +507,24 @@ PetscErrorCode MatMPIDenseScatter(Mat A,Mat B,Mat C,Mat *outworkB)
   Mat_MPIAIJ             *aij = (Mat_MPIAIJ*)A->data;
   PetscErrorCode         ierr;
   PetscScalar            *b,*w,*svalues,*rvalues;
-  VecScatter             ctx   = aij->Mvctx;
-  VecScatter_MPI_General *from = (VecScatter_MPI_General*) ctx->fromdata;
-  VecScatter_MPI_General *to   = (VecScatter_MPI_General*) ctx->todata;
+  VecScatter             ctx;
+  VecScatter_MPI_General *from,*to;
   PetscInt               i,j,k;
   PetscInt               *sindices,*sstarts,*rindices,*rstarts;
   PetscMPIInt            *sprocs,*rprocs,nrecvs;
   MPI_Request            *swaits,*rwaits;
   MPI_Comm               comm;
-  PetscMPIInt            tag  = ((PetscObject)ctx)->tag,ncols = B->cmap->N, nrows = aij->B->cmap->n,imdex,nrowsB = B->rmap->n;
+  PetscMPIInt            tag,ncols = B->cmap->N, nrows = aij->B->cmap->n,imdex,nrowsB = B->rmap->n;
   MPI_Status             status;
   MPIAIJ_MPIDense        *contents;
   PetscContainer         container;
   Mat                    workB;
 
   PetscFunctionBegin;
+  ierr = MatMPIAIJGetScatterMPI1_Private(A,&ctx);CHKERRQ(ierr);
+  from = (VecScatter_MPI_General*)ctx->fromdata;
+  to   = (VecScatter_MPI_General*)ctx->todata;
+  tag  = ((PetscObject)ctx)->tag;
   ierr = PetscObjectGetComm((PetscObject)A,&comm);CHKERRQ(ierr);
   ierr = PetscObjectQuery((PetscObject)C,"workB",(PetscObject*)&container);CHKERRQ(ierr);
   if (!container) SETERRQ(comm,PETSC_ERR_PLIB,"Container does not exist");
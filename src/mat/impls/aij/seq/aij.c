@@ -646,6 +646,12 @@ PetscErrorCode MatView_SeqAIJ_ASCII(Mat A,PetscViewer viewer)
     ierr = PetscViewerASCIIPrintf(viewer,"];\n %s = spconvert(zzz);\n",name);CHKERRQ(ierr);
     ierr = PetscViewerASCIIUseTabs(viewer,PETSC_TRUE);CHKERRQ(ierr);
   } else if (format == PETSC_VIEWER_ASCII_FACTOR_INFO || format == PETSC_VIEWER_ASCII_INFO) {
+    if (format == PETSC_VIEWER_ASCII_INFO && a->nthreads > 1) {
+      ierr = PetscViewerASCIIPrintf(viewer,"using %D threads for the products\n",a->nthreads);CHKERRQ(ierr);
+    }
+    if (format == PETSC_VIEWER_ASCII_INFO && a->autotune && a->tunedformat[0]) {
+      ierr = PetscViewerASCIIPrintf(viewer,"autotuned products use the %s format\n",a->tunedformat);CHKERRQ(ierr);
+    }
     PetscFunctionReturn(0);
   } else if (format == PETSC_VIEWER_ASCII_COMMON) {
     ierr = PetscViewerASCIIUseTabs(viewer,PETSC_FALSE);CHKERRQ(ierr);
@@ -978,6 +984,74 @@ PetscErrorCode MatView_SeqAIJ(Mat A,PetscViewer viewer)
   PetscFunctionReturn(0);
 }
 
+/*
+   Splits the rows, or the nonzero rows when the compressed row format is used, into a->nthreads blocks with about the
+   same number of nonzeros. When requested the a and j arrays are then copied block by block by the threads that
+   multiply with these blocks, so that on NUMA nodes their pages are placed close to these threads.
+*/
+static PetscErrorCode MatSeqAIJSetUpThreads_Private(Mat A,PetscBool firsttouch)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscInt       nt = a->nthreads,m = A->rmap->n,nz = a->nz,t,lo,hi,mid,target;
+  const PetscInt *ii = a->i;
+  PetscInt       *newi,*newj;
+  MatScalar      *newa = NULL;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (nt < 2) PetscFunctionReturn(0);
+  if (!a->rowsplit) {
+    ierr = PetscMalloc1(nt+1,&a->rowsplit);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)A,(nt+1)*sizeof(PetscInt));CHKERRQ(ierr);
+  }
+  a->rowsplitcprow = a->compressedrow.use;
+  if (a->rowsplitcprow) {
+    m  = a->compressedrow.nrows;
+    ii = a->compressedrow.i;
+  }
+  a->rowsplit[0]  = 0;
+  a->rowsplit[nt] = m;
+  for (t=1; t<nt; t++) {
+    target = (PetscInt)(((PetscInt64)nz*t)/nt);
+    lo     = a->rowsplit[t-1]; hi = m;
+    while (lo < hi) {
+      mid = lo + (hi-lo)/2;
+      if (ii[mid] < target) lo = mid+1;
+      else hi = mid;
+    }
+    a->rowsplit[t] = lo;
+  }
+  for (t=0,target=0; t<nt; t++) target = PetscMax(target,ii[a->rowsplit[t+1]]-ii[a->rowsplit[t]]);
+  ierr = PetscInfo3(A,"Using %D threads, the largest block of rows has %D of the %D nonzeros\n",nt,target,nz);CHKERRQ(ierr);
+
+  /* arrays provided by the user are kept */
+  if (!firsttouch || !nz || !a->free_a || !a->free_ij) PetscFunctionReturn(0);
+  ierr = PetscMalloc1(nz,&newj);CHKERRQ(ierr);
+  if (!A->structure_only) {ierr = PetscMalloc1(nz,&newa);CHKERRQ(ierr);}
+  ierr = PetscMalloc1(A->rmap->n+1,&newi);CHKERRQ(ierr);
+  ierr = PetscMemcpy(newi,a->i,(A->rmap->n+1)*sizeof(PetscInt));CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads((int)nt) schedule(static)
+#endif
+  for (t=0; t<nt; t++) {
+    PetscInt k;
+
+    for (k=ii[a->rowsplit[t]]; k<ii[a->rowsplit[t+1]]; k++) newj[k] = a->j[k];
+    if (newa) {
+      for (k=ii[a->rowsplit[t]]; k<ii[a->rowsplit[t+1]]; k++) newa[k] = a->a[k];
+    }
+  }
+  ierr = MatSeqXAIJFreeAIJ(A,&a->a,&a->j,&a->i);CHKERRQ(ierr);
+  a->a            = newa;
+  a->j            = newj;
+  a->i            = newi;
+  a->singlemalloc = PETSC_FALSE;
+  a->free_a       = newa ? PETSC_TRUE : PETSC_FALSE;
+  a->free_ij      = PETSC_TRUE;
+  a->maxnz        = nz;
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A,MatAssemblyType mode)
 {
   Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
@@ -1037,7 +1111,10 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A,MatAssemblyType mode)
   if (!A->structure_only) {
     ierr = MatCheckCompressedRow(A,a->nonzerorowcnt,&a->compressedrow,a->i,m,ratio);CHKERRQ(ierr);
   }
+  ierr = MatSeqAIJSetUpThreads_Private(A,(PetscBool)(a->firsttouchstate != A->nonzerostate));CHKERRQ(ierr);
+  a->firsttouchstate = A->nonzerostate;
   ierr = MatAssemblyEnd_SeqAIJ_Inode(A,mode);CHKERRQ(ierr);
+  if (a->autotune) {ierr = MatSeqAIJTune_Private(A);CHKERRQ(ierr);}
   ierr = MatSeqAIJInvalidateDiagonal(A);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -1102,6 +1179,11 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = ISColoringDestroy(&a->coloring);CHKERRQ(ierr);
   ierr = PetscFree2(a->compressedrow.i,a->compressedrow.rindex);CHKERRQ(ierr);
   ierr = PetscFree(a->matmult_abdense);CHKERRQ(ierr);
+  ierr = PetscFree(a->coo_jmap);CHKERRQ(ierr);
+  ierr = PetscFree(a->coo_perm);CHKERRQ(ierr);
+  ierr = PetscFree(a->rowsplit);CHKERRQ(ierr);
+  ierr = PetscFree(a->threadwork);CHKERRQ(ierr);
+  ierr = MatDestroy(&a->tuned);CHKERRQ(ierr);
 
   ierr = MatDestroy_SeqAIJ_Inode(A);CHKERRQ(ierr);
   ierr = PetscFree(A->data);CHKERRQ(ierr);
@@ -1127,6 +1209,8 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJSetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatResetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJSetPreallocationCSR_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSetPreallocationCOO_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSetValuesCOO_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatReorderForNonzeroDiagonal_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatPtAP_is_seqaij_C",NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -1222,6 +1306,121 @@ PetscErrorCode MatGetDiagonal_SeqAIJ(Mat A,Vec v)
 }
 
 #include <../src/mat/impls/aij/seq/ftn-kernels/fmult.h>
+/*
+   Row-partitioned products used when a->nthreads > 1; thread t works on the block t of a->rowsplit[] that it placed
+   in MatSeqAIJSetUpThreads_Private(). Without OpenMP the blocks are processed one after the other.
+*/
+static PetscErrorCode MatMultAdd_SeqAIJ_Threads(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *y = NULL,*z;
+  const PetscScalar *x;
+  const PetscInt    *ii = a->i,*ridx = NULL,*rowsplit = a->rowsplit;
+  PetscInt          m = A->rmap->n,t,nt = a->nthreads;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  if (yy) {
+    ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  } else {
+    ierr = VecGetArray(zz,&z);CHKERRQ(ierr);
+  }
+  if (a->rowsplitcprow) {
+    if (!yy) {
+      ierr = PetscMemzero(z,m*sizeof(PetscScalar));CHKERRQ(ierr);
+    } else if (zz != yy) {
+      ierr = PetscMemcpy(z,y,m*sizeof(PetscScalar));CHKERRQ(ierr);
+    }
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  }
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads((int)nt) schedule(static)
+#endif
+  for (t=0; t<nt; t++) {
+    const PetscInt  *aj;
+    const MatScalar *aa;
+    PetscInt        i,n,row;
+    PetscScalar     sum;
+
+    for (i=rowsplit[t]; i<rowsplit[t+1]; i++) {
+      row = ridx ? ridx[i] : i;
+      n   = ii[i+1] - ii[i];
+      aj  = a->j + ii[i];
+      aa  = a->a + ii[i];
+      sum = y ? y[row] : 0.0;
+      PetscSparseDensePlusDot(sum,x,aa,aj,n);
+      z[row] = sum;
+    }
+  }
+  ierr = PetscLogFlops(yy ? 2.0*a->nz : 2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  if (yy) {
+    ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  } else {
+    ierr = VecRestoreArray(zz,&z);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   The transpose product scatters each block of rows into its own buffer, the first block directly into y, and the
+   buffers are then added to y by blocks of columns
+*/
+static PetscErrorCode MatMultTransposeAdd_SeqAIJ_Threads(Mat A,Vec xx,Vec zz,Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *y,*work;
+  const PetscScalar *x;
+  const PetscInt    *ii = a->i,*ridx = a->rowsplitcprow ? a->compressedrow.rindex : NULL,*rowsplit = a->rowsplit;
+  PetscInt          n = A->cmap->n,t,nt = a->nthreads;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!a->threadwork) {
+    ierr = PetscMalloc1((nt-1)*n,&a->threadwork);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)A,(nt-1)*n*sizeof(PetscScalar));CHKERRQ(ierr);
+  }
+  work = a->threadwork;
+  if (zz != yy) {ierr = VecCopy(zz,yy);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  if (a->rowsplitcprow) ii = a->compressedrow.i;
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads((int)nt) schedule(static)
+#endif
+  for (t=0; t<nt; t++) {
+    PetscScalar     *w = t ? work + (t-1)*n : y,alpha;
+    const PetscInt  *idx;
+    const MatScalar *v;
+    PetscInt        i,j,nz;
+
+    if (t) {for (j=0; j<n; j++) w[j] = 0.0;}
+    for (i=rowsplit[t]; i<rowsplit[t+1]; i++) {
+      idx   = a->j + ii[i];
+      v     = a->a + ii[i];
+      nz    = ii[i+1] - ii[i];
+      alpha = x[ridx ? ridx[i] : i];
+      for (j=0; j<nz; j++) w[idx[j]] += alpha*v[j];
+    }
+  }
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads((int)nt) schedule(static)
+#endif
+  for (t=0; t<nt; t++) {
+    PetscInt j,s;
+
+    for (s=1; s<nt; s++) {
+      for (j=(t*n)/nt; j<((t+1)*n)/nt; j++) y[j] += work[(s-1)*n+j];
+    }
+  }
+  ierr = PetscLogFlops(2.0*a->nz + (nt-1)*n);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat A,Vec xx,Vec zz,Vec yy)
 {
   Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
@@ -1239,6 +1438,10 @@ PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat A,Vec xx,Vec zz,Vec yy)
 #endif
 
   PetscFunctionBegin;
+  if (a->nthreads > 1 && a->rowsplit && a->rowsplitcprow == a->compressedrow.use) {
+    ierr = MatMultTransposeAdd_SeqAIJ_Threads(A,xx,zz,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   if (zz != yy) {ierr = VecCopy(zz,yy);CHKERRQ(ierr);}
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
@@ -1301,6 +1504,10 @@ PetscErrorCode MatMult_SeqAIJ(Mat A,Vec xx,Vec yy)
 #endif
 
   PetscFunctionBegin;
+  if (a->nthreads > 1 && a->rowsplit && a->rowsplitcprow == usecprow) {
+    ierr = MatMultAdd_SeqAIJ_Threads(A,xx,NULL,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
   ii   = a->i;
@@ -1453,6 +1660,10 @@ PetscErrorCode MatMultAdd_SeqAIJ(Mat A,Vec xx,Vec yy,Vec zz)
   PetscBool         usecprow=a->compressedrow.use;
 
   PetscFunctionBegin;
+  if (a->nthreads > 1 && a->rowsplit && a->rowsplitcprow == usecprow) {
+    ierr = MatMultAdd_SeqAIJ_Threads(A,xx,yy,zz);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
   if (usecprow) { /* use compressed row format */
@@ -2839,10 +3050,17 @@ PetscErrorCode MatCopy_SeqAIJ(Mat A,Mat B,MatStructure str)
 
 PetscErrorCode MatSetUp_SeqAIJ(Mat A)
 {
+  PetscBool      hash = PETSC_FALSE,isseqaij;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  ierr =  MatSeqAIJSetPreallocation_SeqAIJ(A,PETSC_DEFAULT,0);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQAIJ,&isseqaij);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(((PetscObject)A)->options,((PetscObject)A)->prefix,"-mat_aij_hash",&hash,NULL);CHKERRQ(ierr);
+  if (isseqaij && hash && !A->structure_only) {
+    ierr = MatSetUp_SeqAIJ_Hash(A);CHKERRQ(ierr);
+  } else {
+    ierr = MatSeqAIJSetPreallocation_SeqAIJ(A,PETSC_DEFAULT,0);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -3621,7 +3839,11 @@ PetscErrorCode  MatRetrieveValues(Mat mat)
 
    Options Database Keys:
 +  -mat_no_inode  - Do not use inodes
--  -mat_inode_limit <limit> - Sets inode limit (max limit=5)
+.  -mat_inode_limit <limit> - Sets inode limit (max limit=5)
+.  -mat_aij_num_threads <n> - Splits the rows in n blocks with about the same number of nonzeros, that are multiplied by different OpenMP threads
+.  -mat_aij_autotune - Chooses the format of the products from the nonzero structure at assembly
+.  -mat_aij_autotune_time - Times the products with the candidate formats instead and uses the fastest one
+-  -mat_aij_autotune_formats <aij,inode,sell,baij> - The candidate formats
 
    Level: intermediate
 
@@ -3682,7 +3904,11 @@ PetscErrorCode  MatCreateSeqAIJ(MPI_Comm comm,PetscInt m,PetscInt n,PetscInt nz,
 
    Options Database Keys:
 +  -mat_no_inode  - Do not use inodes
--  -mat_inode_limit <limit> - Sets inode limit (max limit=5)
+.  -mat_inode_limit <limit> - Sets inode limit (max limit=5)
+.  -mat_aij_num_threads <n> - Splits the rows in n blocks with about the same number of nonzeros, that are multiplied by different OpenMP threads
+.  -mat_aij_autotune - Chooses the format of the products from the nonzero structure at assembly
+.  -mat_aij_autotune_time - Times the products with the candidate formats instead and uses the fastest one
+-  -mat_aij_autotune_formats <aij,inode,sell,baij> - The candidate formats
 
    Level: intermediate
 
@@ -3708,6 +3934,7 @@ PetscErrorCode  MatSeqAIJSetPreallocation_SeqAIJ(Mat B,PetscInt nz,const PetscIn
   PetscInt       i;
 
   PetscFunctionBegin;
+  ierr = MatHashEnd_Private(B,NULL);CHKERRQ(ierr);
   if (nz >= 0 || nnz) realalloc = PETSC_TRUE;
   if (nz == MAT_SKIP_ALLOCATION) {
     skipallocation = PETSC_TRUE;
@@ -3900,6 +4127,133 @@ PetscErrorCode  MatSeqAIJSetPreallocationCSR_SeqAIJ(Mat B,const PetscInt Ii[],co
   PetscFunctionReturn(0);
 }
 
+/*
+   MatCOOSortRows_Private - Buckets n entries in coordinate format by their local row, in [0,m), and sorts each row by column
+
+   Input Parameters:
++  m - number of local rows
+.  n - number of entries
+.  rows - local row of each entry, entries with a negative row or column are skipped
+-  cols - column of each entry
+
+   Output Parameters:
++  rowptr - the entries of row r are in positions rowptr[r] to rowptr[r+1] of jcols and perm
+.  jcols - the sorted columns, repeated columns are kept
+-  perm - index in rows[] and cols[] of each entry of jcols
+
+   The three arrays are freed by the caller with PetscFree().
+*/
+PetscErrorCode MatCOOSortRows_Private(PetscInt m,PetscInt n,const PetscInt rows[],const PetscInt cols[],PetscInt **rowptr,PetscInt **jcols,PetscInt **perm)
+{
+  PetscInt       *ptr,*next,*j,*p,k,r;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscCalloc1(m+1,&ptr);CHKERRQ(ierr);
+  for (k=0; k<n; k++) {
+    if (rows[k] < 0 || cols[k] < 0) continue;
+    ptr[rows[k]+1]++;
+  }
+  for (r=0; r<m; r++) ptr[r+1] += ptr[r];
+  ierr = PetscMalloc1(m,&next);CHKERRQ(ierr);
+  ierr = PetscMalloc1(ptr[m],&j);CHKERRQ(ierr);
+  ierr = PetscMalloc1(ptr[m],&p);CHKERRQ(ierr);
+  ierr = PetscMemcpy(next,ptr,m*sizeof(PetscInt));CHKERRQ(ierr);
+  for (k=0; k<n; k++) {
+    if (rows[k] < 0 || cols[k] < 0) continue;
+    r    = next[rows[k]]++;
+    j[r] = cols[k];
+    p[r] = k;
+  }
+  ierr = PetscFree(next);CHKERRQ(ierr);
+  for (r=0; r<m; r++) {
+    ierr = PetscSortIntWithArray(ptr[r+1]-ptr[r],j+ptr[r],p+ptr[r]);CHKERRQ(ierr);
+  }
+  *rowptr = ptr;
+  *jcols  = j;
+  *perm   = p;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetPreallocationCOO_SeqAIJ(Mat A,PetscInt n,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  Mat_SeqAIJ     *a;
+  PetscInt       m = A->rmap->n,*rowptr,*jcols,*perm,*nnz,*jmap,r,p,k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+#if defined(PETSC_USE_DEBUG)
+  for (k=0; k<n; k++) {
+    if (coo_i[k] >= m) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Row too large: row %D max %D",coo_i[k],m-1);
+    if (coo_j[k] >= A->cmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Column too large: col %D max %D",coo_j[k],A->cmap->n-1);
+  }
+#endif
+  ierr = MatCOOSortRows_Private(m,n,coo_i,coo_j,&rowptr,&jcols,&perm);CHKERRQ(ierr);
+  ierr = PetscCalloc1(m,&nnz);CHKERRQ(ierr);
+  for (r=0; r<m; r++) {
+    for (p=rowptr[r]; p<rowptr[r+1]; p++) {
+      if (p == rowptr[r] || jcols[p] != jcols[p-1]) nnz[r]++;
+    }
+  }
+  ierr = MatSeqAIJSetPreallocation(A,0,nnz);CHKERRQ(ierr);
+  ierr = PetscFree(nnz);CHKERRQ(ierr);
+
+  /* the entries adding up to the nonzero k are perm[jmap[k]] to perm[jmap[k+1]-1] */
+  a    = (Mat_SeqAIJ*)A->data;
+  ierr = PetscFree(a->coo_jmap);CHKERRQ(ierr);
+  ierr = PetscFree(a->coo_perm);CHKERRQ(ierr);
+  ierr = PetscMalloc1(a->i[m]+1,&jmap);CHKERRQ(ierr);
+  for (r=0; r<m; r++) {
+    for (p=rowptr[r]; p<rowptr[r+1]; p++) {
+      if (p == rowptr[r] || jcols[p] != jcols[p-1]) {
+        k       = a->i[r] + a->ilen[r]++;
+        a->j[k] = jcols[p];
+        jmap[k] = p;
+      }
+    }
+  }
+  jmap[a->i[m]] = rowptr[m];
+  ierr = PetscMemzero(a->a,a->i[m]*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscFree(rowptr);CHKERRQ(ierr);
+  ierr = PetscFree(jcols);CHKERRQ(ierr);
+  a->coo_jmap = jmap;
+  a->coo_perm = perm;
+
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  a->coo_nzstate = A->nonzerostate;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetValuesCOO_SeqAIJ(Mat A,const PetscScalar v[],InsertMode imode)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscInt       nz = a->i[A->rmap->n],k,p;
+  const PetscInt *jmap = a->coo_jmap,*perm = a->coo_perm;
+  PetscScalar    sum;
+  PetscBool      seqaij;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!jmap) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Must call MatSetPreallocationCOO() first");
+  if (A->nonzerostate != a->coo_nzstate) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"The nonzero structure changed since MatSetPreallocationCOO()");
+  for (k=0; k<nz; k++) {
+    for (sum=0.0,p=jmap[k]; p<jmap[k+1]; p++) sum += v[perm[p]];
+    if (imode == INSERT_VALUES) a->a[k]  = sum;
+    else                        a->a[k] += sum;
+  }
+  a->idiagvalid  = PETSC_FALSE;
+  a->ibdiagvalid = PETSC_FALSE;
+  ierr = PetscObjectStateIncrease((PetscObject)A);CHKERRQ(ierr);
+  /* derived types such as MATSEQAIJCRL keep their own copy of the values, it is refreshed by the assembly */
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQAIJ,&seqaij);CHKERRQ(ierr);
+  if (!seqaij) {
+    ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 #include <../src/mat/impls/dense/seq/dense.h>
 #include <petsc/private/kernels/petscaxpy.h>
 
@@ -4158,6 +4512,10 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   b->idiagvalid         = PETSC_FALSE;
   b->ibdiagvalid        = PETSC_FALSE;
   b->keepnonzeropattern = PETSC_FALSE;
+  b->nthreads           = 1;
+  b->firsttouchstate    = -1;
+  b->tuneformats        = 0xf;
+  b->tunednzstate       = -1;
 
   ierr = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJGetArray_C",MatSeqAIJGetArray_SeqAIJ);CHKERRQ(ierr);
@@ -4197,6 +4555,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJSetPreallocation_C",MatSeqAIJSetPreallocation_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatResetPreallocation_C",MatResetPreallocation_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJSetPreallocationCSR_C",MatSeqAIJSetPreallocationCSR_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetPreallocationCOO_C",MatSetPreallocationCOO_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetValuesCOO_C",MatSetValuesCOO_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatReorderForNonzeroDiagonal_C",MatReorderForNonzeroDiagonal_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMult_seqdense_seqaij_C",MatMatMult_SeqDense_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultSymbolic_seqdense_seqaij_C",MatMatMultSymbolic_SeqDense_SeqAIJ);CHKERRQ(ierr);
@@ -4294,6 +4654,11 @@ PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat C,Mat A,MatDuplicateOption cpvalu
   }
   c->nonzerorowcnt = a->nonzerorowcnt;
   C->nonzerostate  = A->nonzerostate;
+  c->nthreads      = a->nthreads;
+  c->autotune      = a->autotune;
+  c->tunetime      = a->tunetime;
+  c->tuneformats   = a->tuneformats;
+  if (mallocmatspace) {ierr = MatSeqAIJSetUpThreads_Private(C,PETSC_FALSE);CHKERRQ(ierr);}
 
   ierr = MatDuplicate_SeqAIJ_Inode(A,cpvalues,&C);CHKERRQ(ierr);
   ierr = PetscFunctionListDuplicate(((PetscObject)A)->qlist,&((PetscObject)C)->qlist);CHKERRQ(ierr);
@@ -103,6 +103,8 @@ PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Inode(Mat);
 PETSC_INTERN PetscErrorCode MatCreate_SeqAIJ_Inode(Mat);
 PETSC_INTERN PetscErrorCode MatSetOption_SeqAIJ_Inode(Mat,MatOption,PetscBool);
 PETSC_INTERN PetscErrorCode MatDuplicate_SeqAIJ_Inode(Mat,MatDuplicateOption,Mat*);
+PETSC_INTERN PetscErrorCode MatMult_SeqAIJ_Inode(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJ_Inode(Mat,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat,Mat,MatDuplicateOption,PetscBool);
 PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode_inplace(Mat,Mat,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat,Mat,const MatFactorInfo*);
@@ -127,6 +129,23 @@ typedef struct {
   Mat_RARt            *rart;               /* used by MatRARt() */
   Mat_MatMatTransMult *abt;                /* used by MatMatTransposeMult() */
   Mat_MatTransMatMult *atb;                /* used by MatTransposeMatMult() */
+
+  PetscInt            *coo_jmap,*coo_perm; /* used by MatSetValuesCOO(), the entries coo_perm[coo_jmap[k]:coo_jmap[k+1]] add up to the nonzero k */
+  PetscObjectState    coo_nzstate;         /* nonzero state set by MatSetPreallocationCOO() */
+
+  PetscInt            nthreads;            /* number of threads used by MatMult() and friends, set with -mat_aij_num_threads */
+  PetscInt            *rowsplit;           /* thread t multiplies with the rows rowsplit[t]:rowsplit[t+1] (of the compressed rows if used) */
+  PetscBool           rowsplitcprow;       /* rowsplit[] refers to the compressed rows */
+  PetscObjectState    firsttouchstate;     /* nonzero state for which the a and j arrays were placed by the threads */
+  PetscScalar         *threadwork;         /* buffers of threads 1:nthreads used by MatMultTransposeAdd() */
+
+  PetscBool           autotune;            /* choose the kernels of MatMult() at assembly, set with -mat_aij_autotune */
+  PetscBool           tunetime;            /* choose them by timing the candidates, set with -mat_aij_autotune_time */
+  PetscInt            tuneformats;         /* bit i set if MatSeqAIJTuneFormats[i] may be chosen */
+  PetscObjectState    tunednzstate;        /* nonzero state for which the kernels were chosen */
+  Mat                 tuned;               /* copy of the matrix in the chosen format, NULL if the AIJ storage is used */
+  PetscObjectState    tunedstate;          /* state of the matrix when the values of tuned were copied */
+  char                tunedformat[64];     /* the chosen format, shown by MatView() */
 } Mat_SeqAIJ;
 
 /*
@@ -214,6 +233,15 @@ PETSC_STATIC_INLINE PetscErrorCode MatSeqXAIJFreeAIJ(Mat AA,MatScalar **a,PetscI
   } \
 
 PETSC_INTERN PetscErrorCode MatSeqAIJSetPreallocation_SeqAIJ(Mat,PetscInt,const PetscInt*);
+PETSC_INTERN PetscErrorCode MatSetUp_SeqAIJ_Hash(Mat);
+PETSC_INTERN const char *const MatSeqAIJTuneFormats[];
+PETSC_INTERN PetscErrorCode MatSeqAIJTune_Private(Mat);
+PETSC_INTERN PetscErrorCode MatHashBegin_Private(Mat);
+PETSC_INTERN PetscErrorCode MatHashEnd_Private(Mat,PetscHMapIJV*);
+PETSC_INTERN PetscErrorCode MatSeqAIJSortRows_Private(Mat);
+PETSC_INTERN PetscErrorCode MatCOOSortRows_Private(PetscInt,PetscInt,const PetscInt[],const PetscInt[],PetscInt**,PetscInt**,PetscInt**);
+PETSC_INTERN PetscErrorCode MatSetPreallocationCOO_SeqAIJ(Mat,PetscInt,const PetscInt[],const PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSetValuesCOO_SeqAIJ(Mat,const PetscScalar[],InsertMode);
 PETSC_INTERN PetscErrorCode MatILUFactorSymbolic_SeqAIJ_inplace(Mat,Mat,IS,IS,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatILUFactorSymbolic_SeqAIJ(Mat,Mat,IS,IS,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatILUFactorSymbolic_SeqAIJ_ilu0(Mat,Mat,IS,IS,const MatFactorInfo*);
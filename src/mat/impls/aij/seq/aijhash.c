@@ -0,0 +1,224 @@
+
+/*
+   Assembly of AIJ matrices that were not preallocated.
+
+   With -mat_aij_hash, MatSetUp() without preallocation replaces MatSetValues() and the assembly with versions that keep
+   the entries in a hash table keyed by (row,column). The final assembly counts the entries of each row, preallocates
+   exactly, moves the entries into their rows in one sweep over the table and sorts the rows, then hands over to the
+   regular assembly. No malloc happens in MatSetValues() beyond the growth of the table, whatever the number of entries
+   per row.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>          /*I "petscmat.h" I*/
+
+static PetscErrorCode MatZeroEntries_Hash(Mat A)
+{
+  PetscHashIter hi;
+
+  PetscFunctionBegin;
+  PetscHashIterBegin(A->hash_ht,hi);
+  while (!PetscHashIterAtEnd(A->hash_ht,hi)) {
+    PetscHashIterSetVal(A->hash_ht,hi,0.0);
+    PetscHashIterNext(A->hash_ht,hi);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Sets the entries of the row already in the table, in the order of their columns as in the assembled matrix. The
+   columns of all the local rows are gathered and sorted in one sweep over the table, and reused until new entries
+   are inserted; entries are never removed from the table.
+*/
+static PetscErrorCode MatSetValuesRow_Hash(Mat A,PetscInt row,const PetscScalar v[])
+{
+  PetscHashIter  hi;
+  PetscHashIJKey key;
+  PetscInt       m = A->rmap->n,rstart = A->rmap->rstart,nz,i,k,*cnt;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscHMapIJVGetSize(A->hash_ht,&nz);CHKERRQ(ierr);
+  if (!A->hash_rowi || A->hash_rownz != nz) {
+    ierr = PetscFree2(A->hash_rowi,A->hash_rowj);CHKERRQ(ierr);
+    ierr = PetscMalloc2(m+1,&A->hash_rowi,nz,&A->hash_rowj);CHKERRQ(ierr);
+    ierr = PetscCalloc1(m,&cnt);CHKERRQ(ierr);
+    PetscHashIterBegin(A->hash_ht,hi);
+    while (!PetscHashIterAtEnd(A->hash_ht,hi)) {
+      PetscHashIterGetKey(A->hash_ht,hi,key);
+      cnt[key.i-rstart]++;
+      PetscHashIterNext(A->hash_ht,hi);
+    }
+    A->hash_rowi[0] = 0;
+    for (i=0; i<m; i++) {A->hash_rowi[i+1] = A->hash_rowi[i] + cnt[i]; cnt[i] = A->hash_rowi[i];}
+    PetscHashIterBegin(A->hash_ht,hi);
+    while (!PetscHashIterAtEnd(A->hash_ht,hi)) {
+      PetscHashIterGetKey(A->hash_ht,hi,key);
+      A->hash_rowj[cnt[key.i-rstart]++] = key.j;
+      PetscHashIterNext(A->hash_ht,hi);
+    }
+    for (i=0; i<m; i++) {ierr = PetscSortInt(A->hash_rowi[i+1]-A->hash_rowi[i],A->hash_rowj+A->hash_rowi[i]);CHKERRQ(ierr);}
+    ierr = PetscFree(cnt);CHKERRQ(ierr);
+    A->hash_rownz = nz;
+  }
+  key.i = row;
+  for (k=A->hash_rowi[row-rstart]; k<A->hash_rowi[row-rstart+1]; k++) {
+    key.j = A->hash_rowj[k];
+    ierr  = PetscHMapIJVSet(A->hash_ht,key,v[k-A->hash_rowi[row-rstart]]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDestroy_Hash(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatHashEnd_Private(A,NULL);CHKERRQ(ierr);
+  ierr = (*A->ops->destroy)(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatHashBegin_Private - Saves the operations of the matrix and replaces those that depend on the nonzero
+   structure, the caller then installs its MatSetValues() and MatAssemblyEnd()
+*/
+PetscErrorCode MatHashBegin_Private(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNew(&A->hash_ops);CHKERRQ(ierr);
+  ierr = PetscMemcpy(A->hash_ops,A->ops,sizeof(struct _MatOps));CHKERRQ(ierr);
+  ierr = PetscHMapIJVCreate(&A->hash_ht);CHKERRQ(ierr);
+  A->ops->setvaluesrow = MatSetValuesRow_Hash;
+  A->ops->zeroentries  = MatZeroEntries_Hash;
+  A->ops->destroy      = MatDestroy_Hash;
+  A->hash_active       = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatHashEnd_Private - Restores the operations of the matrix and returns the hash table in ht, or frees it if ht is NULL
+*/
+PetscErrorCode MatHashEnd_Private(Mat A,PetscHMapIJV *ht)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!A->hash_active) PetscFunctionReturn(0);
+  if (ht) *ht = A->hash_ht;
+  else {ierr = PetscHMapIJVDestroy(&A->hash_ht);CHKERRQ(ierr);}
+  A->hash_ht = NULL;
+  ierr = PetscFree2(A->hash_rowi,A->hash_rowj);CHKERRQ(ierr);
+  ierr = PetscMemcpy(A->ops,A->hash_ops,sizeof(struct _MatOps));CHKERRQ(ierr);
+  ierr = PetscFree(A->hash_ops);CHKERRQ(ierr);
+  A->hash_active = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatSeqAIJSortRows_Private - Sorts the columns of each row of a matrix whose rows were filled in any order
+*/
+PetscErrorCode MatSeqAIJSortRows_Private(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<A->rmap->n; i++) {
+    ierr = PetscSortIntWithScalarArray(a->ilen[i],a->j+a->i[i],a->a+a->i[i]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSetValues_SeqAIJ_Hash(Mat A,PetscInt m,const PetscInt im[],PetscInt n,const PetscInt in[],const PetscScalar v[],InsertMode is)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscHashIJKey key;
+  PetscScalar    value;
+  PetscInt       k,l;
+  PetscBool      missing;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (k=0; k<m; k++) {
+    key.i = im[k];
+    if (key.i < 0) continue;
+#if defined(PETSC_USE_DEBUG)
+    if (key.i >= A->rmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Row too large: row %D max %D",key.i,A->rmap->n-1);
+#endif
+    for (l=0; l<n; l++) {
+      key.j = in[l];
+      if (key.j < 0) continue;
+#if defined(PETSC_USE_DEBUG)
+      if (key.j >= A->cmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Column too large: col %D max %D",key.j,A->cmap->n-1);
+#endif
+      value = v ? (a->roworiented ? v[l + k*n] : v[k + l*m]) : 0.0;
+      if ((value == 0.0 && a->ignorezeroentries) && (is == ADD_VALUES) && key.i != key.j) continue;
+      if (is == ADD_VALUES) {
+        ierr = PetscHMapIJVQueryAdd(A->hash_ht,key,value,&missing);CHKERRQ(ierr);
+      } else {
+        ierr = PetscHMapIJVSet(A->hash_ht,key,value);CHKERRQ(ierr);
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatAssemblyEnd_SeqAIJ_Hash(Mat A,MatAssemblyType type)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscHMapIJV   ht;
+  PetscHashIter  hi;
+  PetscHashIJKey key;
+  PetscScalar    value;
+  PetscInt       *nnz,nonew,k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (type == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(0);
+  ierr = MatHashEnd_Private(A,&ht);CHKERRQ(ierr);
+
+  ierr = PetscCalloc1(A->rmap->n,&nnz);CHKERRQ(ierr);
+  PetscHashIterBegin(ht,hi);
+  while (!PetscHashIterAtEnd(ht,hi)) {
+    PetscHashIterGetKey(ht,hi,key);
+    nnz[key.i]++;
+    PetscHashIterNext(ht,hi);
+  }
+  /* the exact preallocation must not turn the mallocs allowed by MatSetUp() into errors for later assemblies */
+  nonew = a->nonew;
+  ierr  = MatSeqAIJSetPreallocation_SeqAIJ(A,0,nnz);CHKERRQ(ierr);
+  a->nonew = nonew;
+  ierr  = PetscFree(nnz);CHKERRQ(ierr);
+  PetscHashIterBegin(ht,hi);
+  while (!PetscHashIterAtEnd(ht,hi)) {
+    PetscHashIterGetKey(ht,hi,key);
+    PetscHashIterGetVal(ht,hi,value);
+    k        = a->i[key.i] + a->ilen[key.i]++;
+    a->j[k]  = key.j;
+    a->a[k]  = value;
+    PetscHashIterNext(ht,hi);
+  }
+  ierr = PetscHMapIJVDestroy(&ht);CHKERRQ(ierr);
+  ierr = MatSeqAIJSortRows_Private(A);CHKERRQ(ierr);
+  ierr = (*A->ops->assemblyend)(A,type);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatSetUp_SeqAIJ_Hash - Sets up a MATSEQAIJ matrix that was not preallocated to collect its entries in a hash table
+   until the first final assembly
+*/
+PetscErrorCode MatSetUp_SeqAIJ_Hash(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJSetPreallocation_SeqAIJ(A,0,NULL);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatHashBegin_Private(A);CHKERRQ(ierr);
+  A->ops->setvalues   = MatSetValues_SeqAIJ_Hash;
+  A->ops->assemblyend = MatAssemblyEnd_SeqAIJ_Hash;
+  PetscFunctionReturn(0);
+}
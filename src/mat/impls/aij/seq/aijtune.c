@@ -0,0 +1,283 @@
+
+/*
+   Selection at assembly of the kernels used by MatMult() and MatMultAdd() for SeqAIJ matrices, see -mat_aij_autotune.
+
+   The first final assembly with a given nonzero pattern looks at the structure of the matrix and takes the first of
+   the allowed formats that fits it: a BAIJ copy when the rows come in blocks, the inode kernels when inodes were found,
+   a SELL copy when sliced rows do not need too much padding, and the plain CSR kernels otherwise. The choice only
+   depends on the nonzero pattern, so it is the same on every run. With -mat_aij_autotune_time the candidates that fit
+   the structure instead perform a few products each and the fastest one is used.
+
+   The choice holds until the nonzero pattern changes. A copy in another format has the nonzero pattern of the matrix
+   and is refreshed from the AIJ values when its state is older than the state of the matrix, as MATSEQAIJSELL does
+   with its shadow matrix.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/baij/seq/baij.h>
+#include <../src/mat/impls/sell/seq/sell.h>
+#include <petsctime.h>
+
+const char *const MatSeqAIJTuneFormats[] = {"aij","inode","sell","baij"};
+
+/* a SELL copy is only tried when its slices of 8 rows need less than this many stored entries per nonzero */
+#define MAT_SEQAIJ_TUNE_MAX_PADDING 1.5
+
+/*
+   Returns the largest bs <= 8 such that each group of bs rows has the same columns made of complete aligned blocks of
+   bs columns, or 1
+*/
+static PetscErrorCode MatSeqAIJDetectBlockSize_Private(Mat A,PetscInt *rbs)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  const PetscInt *ai = a->i,*aj = a->j;
+  PetscInt       m = A->rmap->n,n = A->cmap->n,bs,ib,r,k,l,len;
+  PetscBool      match,flg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *rbs = 1;
+  for (bs=8; bs>1; bs--) {
+    if (m % bs || n % bs) continue;
+    match = PETSC_TRUE;
+    for (ib=0; ib<m/bs && match; ib++) {
+      len = ai[ib*bs+1] - ai[ib*bs];
+      if (len % bs) {match = PETSC_FALSE; break;}
+      for (k=ai[ib*bs]; k<ai[ib*bs+1] && match; k+=bs) {
+        if (aj[k] % bs) match = PETSC_FALSE;
+        for (l=1; l<bs && match; l++) if (aj[k+l] != aj[k]+l) match = PETSC_FALSE;
+      }
+      for (r=ib*bs+1; r<(ib+1)*bs && match; r++) {
+        if (ai[r+1] - ai[r] != len) {match = PETSC_FALSE; break;}
+        ierr = PetscMemcmp(aj+ai[r],aj+ai[ib*bs],len*sizeof(PetscInt),&flg);CHKERRQ(ierr);
+        if (!flg) match = PETSC_FALSE;
+      }
+    }
+    if (match) {*rbs = bs; break;}
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Copies the values of A into its copy in another format. The copy was assembled from the sorted rows of A, so the
+   k-th entry of a row of A is the k-th entry of the same row of the copy and the values are moved without any search.
+*/
+static PetscErrorCode MatSeqAIJUpdateTuned_Private(Mat A)
+{
+  Mat_SeqAIJ       *a = (Mat_SeqAIJ*)A->data;
+  PetscInt         i,k,r,c,m = A->rmap->n,bs = a->tuned->rmap->bs,bs2 = bs*bs,shift;
+  const MatScalar  *aa;
+  MatScalar        *ba;
+  PetscObjectState state;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectStateGet((PetscObject)A,&state);CHKERRQ(ierr);
+  if (a->tunedstate == state) PetscFunctionReturn(0);
+  ierr = PetscLogEventBegin(MAT_Convert,A,0,0,0);CHKERRQ(ierr);
+  if (bs > 1) {
+    Mat_SeqBAIJ *b = (Mat_SeqBAIJ*)a->tuned->data;
+
+    /* the blocks are stored by columns */
+    for (i=0; i<m/bs; i++) {
+      for (r=0; r<bs; r++) {
+        aa = a->a + a->i[i*bs+r];
+        ba = b->a + b->i[i]*bs2 + r;
+        for (k=0; k<b->i[i+1]-b->i[i]; k++) {
+          for (c=0; c<bs; c++) ba[k*bs2+c*bs] = aa[k*bs+c];
+        }
+      }
+    }
+  } else {
+    Mat_SeqSELL *b = (Mat_SeqSELL*)a->tuned->data;
+
+    /* the rows of a slice of 8 rows are interleaved */
+    for (i=0; i<m; i++) {
+      aa    = a->a + a->i[i];
+      shift = b->sliidx[i>>3] + (i&0x07);
+      for (k=0; k<a->i[i+1]-a->i[i]; k++) b->val[shift+8*k] = aa[k];
+    }
+  }
+  ierr = PetscObjectStateIncrease((PetscObject)a->tuned);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(MAT_Convert,A,0,0,0);CHKERRQ(ierr);
+  a->tunedstate = state;
+  PetscFunctionReturn(0);
+}
+
+/* Creates the copy of A in the SELL format, or in the BAIJ format with block size bs */
+static PetscErrorCode MatSeqAIJCreateTuned_Private(Mat A,PetscInt bs)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscInt       i,m = A->rmap->n,*nnz;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatDestroy(&a->tuned);CHKERRQ(ierr);
+  ierr = MatCreate(PETSC_COMM_SELF,&a->tuned);CHKERRQ(ierr);
+  ierr = MatSetSizes(a->tuned,m,A->cmap->n,m,A->cmap->n);CHKERRQ(ierr);
+  ierr = PetscMalloc1(m,&nnz);CHKERRQ(ierr);
+  if (bs > 1) {
+    for (i=0; i<m/bs; i++) nnz[i] = (a->i[i*bs+1]-a->i[i*bs])/bs;
+    ierr = MatSetType(a->tuned,MATSEQBAIJ);CHKERRQ(ierr);
+    ierr = MatSeqBAIJSetPreallocation(a->tuned,bs,0,nnz);CHKERRQ(ierr);
+  } else {
+    for (i=0; i<m; i++) nnz[i] = a->i[i+1]-a->i[i];
+    ierr = MatSetType(a->tuned,MATSEQSELL);CHKERRQ(ierr);
+    ierr = MatSeqSELLSetPreallocation(a->tuned,0,nnz);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(nnz);CHKERRQ(ierr);
+  ierr = PetscLogObjectParent((PetscObject)A,(PetscObject)a->tuned);CHKERRQ(ierr);
+  /* the first copy sets the nonzero pattern, the later ones only the values */
+  for (i=0; i<m; i++) {
+    ierr = MatSetValues(a->tuned,1,&i,a->i[i+1]-a->i[i],a->j+a->i[i],a->a+a->i[i],INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(a->tuned,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(a->tuned,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)A,&a->tunedstate);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMult_SeqAIJ_Tuned(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJUpdateTuned_Private(A);CHKERRQ(ierr);
+  ierr = (*a->tuned->ops->mult)(a->tuned,xx,yy);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMultAdd_SeqAIJ_Tuned(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJUpdateTuned_Private(A);CHKERRQ(ierr);
+  ierr = (*a->tuned->ops->multadd)(a->tuned,xx,yy,zz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Returns the time of one product with the given kernel, after a first product that is not timed */
+static PetscErrorCode MatSeqAIJTimeMult_Private(PetscErrorCode (*mult)(Mat,Vec,Vec),Mat A,Vec x,Vec y,PetscLogDouble *time)
+{
+  PetscInt       k,its = 3;
+  PetscLogDouble t0,t1;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = (*mult)(A,x,y);CHKERRQ(ierr);
+  ierr = PetscTime(&t0);CHKERRQ(ierr);
+  for (k=0; k<its; k++) {ierr = (*mult)(A,x,y);CHKERRQ(ierr);}
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  *time = (t1-t0)/its;
+  PetscFunctionReturn(0);
+}
+
+/* Whether the format i is allowed and fits the structure of the matrix */
+static PetscBool MatSeqAIJTuneFits_Private(Mat A,PetscInt i,PetscReal padding,PetscInt bs)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ*)A->data;
+
+  if (!(a->tuneformats & (1 << i))) return PETSC_FALSE;
+  switch (i) {
+  case 1:  return a->inode.size ? PETSC_TRUE : PETSC_FALSE;
+  case 2:  return padding <= MAT_SEQAIJ_TUNE_MAX_PADDING ? PETSC_TRUE : PETSC_FALSE;
+  case 3:  return bs > 1 ? PETSC_TRUE : PETSC_FALSE;
+  default: return PETSC_TRUE;
+  }
+}
+
+/*
+   MatSeqAIJTune_Private - Chooses the kernels of MatMult() and MatMultAdd() at the end of a final assembly, see the
+   comment at the top of this file
+*/
+PetscErrorCode MatSeqAIJTune_Private(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscInt       m = A->rmap->n,nz = a->nz,i,k,slicemax,sellnz = 0,bs,best = -1;
+  PetscReal      padding;
+  PetscLogDouble time,besttime = 0.0;
+  PetscBool      flg;
+  Vec            x,y;
+  Mat            copy = NULL;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQAIJ,&flg);CHKERRQ(ierr);
+  if (!flg || A->factortype || A->structure_only || !m || !nz) PetscFunctionReturn(0);
+  if (a->tunednzstate == A->nonzerostate) PetscFunctionReturn(0);
+  a->tunednzstate = A->nonzerostate;
+  ierr = MatDestroy(&a->tuned);CHKERRQ(ierr);
+
+  /* padding of the SELL format with slices of 8 rows */
+  for (i=0; i<m; i+=8) {
+    for (k=i,slicemax=0; k<PetscMin(i+8,m); k++) slicemax = PetscMax(slicemax,a->i[k+1]-a->i[k]);
+    sellnz += 8*slicemax;
+  }
+  padding = (PetscReal)sellnz/nz;
+  ierr    = MatSeqAIJDetectBlockSize_Private(A,&bs);CHKERRQ(ierr);
+  ierr    = PetscInfo5(A,"Rows: %D, mean length %g, max length %D, SELL padding %g, block size %D\n",m,(double)nz/m,a->rmax,(double)padding,bs);CHKERRQ(ierr);
+  ierr    = PetscInfo2(A,"Inodes: %D, mean size %g\n",a->inode.size ? a->inode.node_count : m,a->inode.size ? (double)m/a->inode.node_count : 1.0);CHKERRQ(ierr);
+
+  if (!a->tunetime) {
+    /* the formats are tried by decreasing reuse of the column indices: one per block, one per inode, one per entry */
+    if (MatSeqAIJTuneFits_Private(A,3,padding,bs))      best = 3;
+    else if (MatSeqAIJTuneFits_Private(A,1,padding,bs)) best = 1;
+    else if (MatSeqAIJTuneFits_Private(A,2,padding,bs)) best = 2;
+    else if (MatSeqAIJTuneFits_Private(A,0,padding,bs)) best = 0;
+    if (best > 1) {
+      ierr = MatSeqAIJCreateTuned_Private(A,best == 3 ? bs : 1);CHKERRQ(ierr);
+      copy     = a->tuned;
+      a->tuned = NULL;
+    }
+  } else {
+    ierr = VecCreateSeq(PETSC_COMM_SELF,A->cmap->n,&x);CHKERRQ(ierr);
+    ierr = VecCreateSeq(PETSC_COMM_SELF,m,&y);CHKERRQ(ierr);
+    ierr = VecSet(x,1.0);CHKERRQ(ierr);
+    for (i=0; i<4; i++) {
+      if (!MatSeqAIJTuneFits_Private(A,i,padding,bs)) continue;
+      if (i == 0) {
+        ierr = MatSeqAIJTimeMult_Private(MatMult_SeqAIJ,A,x,y,&time);CHKERRQ(ierr);
+      } else if (i == 1) {
+        ierr = MatSeqAIJTimeMult_Private(MatMult_SeqAIJ_Inode,A,x,y,&time);CHKERRQ(ierr);
+      } else {
+        ierr = MatSeqAIJCreateTuned_Private(A,i == 3 ? bs : 1);CHKERRQ(ierr);
+        ierr = MatSeqAIJTimeMult_Private(a->tuned->ops->mult,a->tuned,x,y,&time);CHKERRQ(ierr);
+      }
+      ierr = PetscInfo2(A,"Format %s takes %g seconds per product\n",MatSeqAIJTuneFormats[i],time);CHKERRQ(ierr);
+      if (best < 0 || time < besttime) {
+        best     = i;
+        besttime = time;
+        ierr     = MatDestroy(&copy);CHKERRQ(ierr);
+        copy     = a->tuned;
+        a->tuned = NULL;
+      } else {
+        ierr = MatDestroy(&a->tuned);CHKERRQ(ierr);
+      }
+    }
+    ierr = VecDestroy(&x);CHKERRQ(ierr);
+    ierr = VecDestroy(&y);CHKERRQ(ierr);
+  }
+
+  /* no allowed format fits, keep the kernels set by the assembly */
+  if (best < 0) best = a->inode.size ? 1 : 0;
+  if (best == 0) {
+    A->ops->mult    = MatMult_SeqAIJ;
+    A->ops->multadd = MatMultAdd_SeqAIJ;
+  } else if (best == 1) {
+    A->ops->mult    = MatMult_SeqAIJ_Inode;
+    A->ops->multadd = MatMultAdd_SeqAIJ_Inode;
+  } else {
+    a->tuned        = copy;
+    A->ops->mult    = MatMult_SeqAIJ_Tuned;
+    A->ops->multadd = MatMultAdd_SeqAIJ_Tuned;
+  }
+  if (best == 3) {
+    ierr = PetscSNPrintf(a->tunedformat,sizeof(a->tunedformat),"%s with block size %D",MatSeqAIJTuneFormats[best],bs);CHKERRQ(ierr);
+  } else {
+    ierr = PetscStrncpy(a->tunedformat,MatSeqAIJTuneFormats[best],sizeof(a->tunedformat));CHKERRQ(ierr);
+  }
+  ierr = PetscInfo1(A,"Using the %s format for the products\n",a->tunedformat);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -59,7 +59,9 @@ PetscErrorCode MatCreate_SeqAIJ_Inode(Mat B)
 {
   Mat_SeqAIJ     *b=(Mat_SeqAIJ*)B->data;
   PetscErrorCode ierr;
-  PetscBool      no_inode,no_unroll;
+  PetscBool      no_inode,no_unroll,flg,found;
+  char           *formats[4];
+  PetscInt       i,k,nformats;
 
   PetscFunctionBegin;
   no_inode             = PETSC_FALSE;
@@ -82,7 +84,22 @@ PetscErrorCode MatCreate_SeqAIJ_Inode(Mat B)
     ierr = PetscInfo(B,"Not using Inode routines due to -mat_no_inode\n");CHKERRQ(ierr);
   }
   ierr = PetscOptionsInt("-mat_inode_limit","Do not use inodes larger then this value",NULL,b->inode.limit,&b->inode.limit,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_aij_num_threads","Number of threads used by the matrix-vector products",NULL,b->nthreads,&b->nthreads,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_aij_autotune","Choose the format of the matrix-vector products from the structure at assembly",NULL,b->autotune,&b->autotune,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_aij_autotune_time","Choose the format of -mat_aij_autotune by timing the products",NULL,b->tunetime,&b->tunetime,NULL);CHKERRQ(ierr);
+  nformats = 4;
+  ierr = PetscOptionsStringArray("-mat_aij_autotune_formats","Formats tried by -mat_aij_autotune","aij,inode,sell,baij",formats,&nformats,&flg);CHKERRQ(ierr);
+  if (flg) {
+    b->tuneformats = 0;
+    for (i=0; i<nformats; i++) {
+      ierr = PetscEListFind(4,MatSeqAIJTuneFormats,formats[i],&k,&found);CHKERRQ(ierr);
+      if (!found) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_UNKNOWN_TYPE,"Unknown format %s for -mat_aij_autotune_formats",formats[i]);
+      b->tuneformats |= 1 << k;
+      ierr = PetscFree(formats[i]);CHKERRQ(ierr);
+    }
+  }
   ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  if (b->nthreads < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of threads %D must be positive",b->nthreads);
 
   b->inode.use = (PetscBool)(!(no_unroll || no_inode));
   if (b->inode.limit > b->inode.max_limit) b->inode.limit = b->inode.max_limit;
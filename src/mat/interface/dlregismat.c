@@ -25,6 +25,8 @@ const char       *MatOptions_Shifted[] = {"UNUSED_NONZERO_LOCATION_ERR",
                                   "NEW_NONZERO_ALLOCATION_ERR",
                                   "MAT_SUBSET_OFF_PROC_ENTRIES",
                                   "MAT_SUBMAT_SINGLEIS",
+                                  "STRUCTURE_ONLY",
+                                  "SAME_OFF_PROC_ENTRIES",
                                   "MatOption","MAT_",0};
 const char *const* MatOptions = MatOptions_Shifted+2;
 const char *const MatFactorShiftTypes[] = {"NONE","NONZERO","POSITIVE_DEFINITE","INBLOCKS","MatFactorShiftType","PC_FACTOR_",0};
@@ -199,6 +201,8 @@ PetscErrorCode  MatInitializePackage(void)
   ierr = PetscLogEventRegister("MatAssemblyBegin", MAT_CLASSID,&MAT_AssemblyBegin);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("MatAssemblyEnd",   MAT_CLASSID,&MAT_AssemblyEnd);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("MatSetValues",     MAT_CLASSID,&MAT_SetValues);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("MatSetPreallCOO",  MAT_CLASSID,&MAT_PreallCOO);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("MatSetValuesCOO",  MAT_CLASSID,&MAT_SetVCOO);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("MatGetValues",     MAT_CLASSID,&MAT_GetValues);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("MatGetRow",        MAT_CLASSID,&MAT_GetRow);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("MatGetRowIJ",      MAT_CLASSID,&MAT_GetRowIJ);CHKERRQ(ierr);
@@ -33,6 +33,7 @@ PetscLogEvent MAT_GetBrowsOfAocols, MAT_Getlocalmat, MAT_Getlocalmatcondensed, M
 PetscLogEvent MAT_Applypapt, MAT_Applypapt_numeric, MAT_Applypapt_symbolic, MAT_GetSequentialNonzeroStructure;
 PetscLogEvent MAT_GetMultiProcBlock;
 PetscLogEvent MAT_CUSPARSECopyToGPU, MAT_SetValuesBatch;
+PetscLogEvent MAT_PreallCOO, MAT_SetVCOO;
 PetscLogEvent MAT_ViennaCLCopyToGPU;
 PetscLogEvent MAT_Merge,MAT_Residual,MAT_SetRandom;
 PetscLogEvent MATCOLORING_Apply,MATCOLORING_Comm,MATCOLORING_Local,MATCOLORING_ISCreate,MATCOLORING_SetUp,MATCOLORING_Weights;
@@ -853,8 +854,14 @@ PetscErrorCode MatResetPreallocation(Mat A)
    Input Parameters:
 .  A - the Mat context
 
+   Options Database Keys:
+.  -mat_aij_hash <false> - MATSEQAIJ and MATMPIAIJ matrices that were not preallocated collect their entries in a hash table until the first final assembly
+
    Notes:
    If the user has not set preallocation for this matrix then a default preallocation that is likely to be inefficient is used.
+   With -mat_aij_hash MATSEQAIJ and MATMPIAIJ matrices instead keep the entries set before their first MAT_FINAL_ASSEMBLY in a hash
+   table and are then preallocated exactly, so the cost of the assembly does not depend on the number of nonzeros per row. Later
+   assemblies that add new nonzeros still allocate as needed.
 
    If a suitable preallocation routine is used, this function does not need to be called.
 
@@ -5514,9 +5521,12 @@ PetscErrorCode MatAssemblyEnd(Mat mat,MatAssemblyType type)
 .    MAT_NO_OFF_PROC_ENTRIES - you know each process will only set values for its own rows, will generate an error if
         any process sets values for another process. This avoids all reductions in the MatAssembly routines and thus improves
         performance for very large process counts.
--    MAT_SUBSET_OFF_PROC_ENTRIES - you know that the first assembly after setting this flag will set a superset
+.    MAT_SUBSET_OFF_PROC_ENTRIES - you know that the first assembly after setting this flag will set a superset
         of the off-process entries required for all subsequent assemblies. This avoids a rendezvous step in the MatAssembly
         functions, instead sending only neighbor messages.
+-    MAT_SAME_OFF_PROC_ENTRIES - you know that all the assemblies after setting this flag will set exactly the same
+        off-process entries as the first one. The first assembly records them, the later ones only send the values,
+        and matrices such as MATMPIAIJ add them directly where they belong instead of calling MatSetValues() for each one.
 
    Notes:
    Except for MAT_UNUSED_NONZERO_LOCATION_ERR and  MAT_ROW_ORIENTED all processes that share the matrix must pass the same value in flg!
@@ -5529,6 +5539,12 @@ PetscErrorCode MatAssemblyEnd(Mat mat,MatAssemblyType type)
    use the column-oriented option (or convert to the row-oriented
    format).
 
+   MAT_SAME_OFF_PROC_ENTRIES lets each process set its off-process entries in any order and any number of times, but
+   the set of (row,column) locations must not change and every assembly, including MAT_FLUSH_ASSEMBLY ones, counts.
+   An error is generated otherwise. Zero values skipped with MAT_IGNORE_ZERO_ENTRIES change the set, so the two options
+   do not mix. An assembly with the flag set to PETSC_FALSE discards the recorded entries, so that the next one with the flag
+   set records them again. The option is ignored with -matstash_legacy.
+
    MAT_NEW_NONZERO_LOCATIONS set to PETSC_FALSE indicates that any add or insertion
    that would generate a new entry in the nonzero structure is instead
    ignored.  Thus, if memory has not alredy been allocated for this particular
@@ -5607,6 +5623,9 @@ PetscErrorCode MatSetOption(Mat mat,MatOption op,PetscBool flg)
   case MAT_SUBSET_OFF_PROC_ENTRIES:
     mat->subsetoffprocentries = flg;
     PetscFunctionReturn(0);
+  case MAT_SAME_OFF_PROC_ENTRIES:
+    mat->sameoffprocentries = flg;
+    PetscFunctionReturn(0);
   case MAT_NO_OFF_PROC_ZERO_ROWS:
     mat->nooffproczerorows = flg;
     PetscFunctionReturn(0);
@@ -328,6 +328,149 @@ PetscErrorCode MatXAIJSetPreallocation(Mat A,PetscInt bs,const PetscInt dnnz[],c
   PetscFunctionReturn(0);
 }
 
+/*
+   MatSetPreallocationCOO_Basic - Keeps the indices for MatSetValuesCOO_Basic(), which goes through MatSetValues()
+*/
+static PetscErrorCode MatSetPreallocationCOO_Basic(Mat A,PetscInt n,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  PetscContainer c;
+  PetscInt       *ij,k;
+  PetscScalar    zero = 0.0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  /* the container holds n followed by the row and the column indices */
+  ierr = PetscMalloc1(2*n+1,&ij);CHKERRQ(ierr);
+  ij[0] = n;
+  ierr = PetscMemcpy(ij+1,coo_i,n*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscMemcpy(ij+1+n,coo_j,n*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscContainerCreate(PETSC_COMM_SELF,&c);CHKERRQ(ierr);
+  ierr = PetscContainerSetPointer(c,ij);CHKERRQ(ierr);
+  ierr = PetscContainerSetUserDestroy(c,PetscContainerUserDestroyDefault);CHKERRQ(ierr);
+  ierr = PetscObjectCompose((PetscObject)A,"__PETSc_coo_ij",(PetscObject)c);CHKERRQ(ierr);
+  ierr = PetscContainerDestroy(&c);CHKERRQ(ierr);
+
+  /* set the nonzero structure with zero values */
+  ierr = MatSetUp(A);CHKERRQ(ierr);
+  for (k=0; k<n; k++) {
+    ierr = MatSetValues(A,1,coo_i+k,1,coo_j+k,&zero,ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSetValuesCOO_Basic(Mat A,const PetscScalar coo_v[],InsertMode imode)
+{
+  PetscContainer c;
+  PetscInt       *ij,n,k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectQuery((PetscObject)A,"__PETSc_coo_ij",(PetscObject*)&c);CHKERRQ(ierr);
+  if (!c) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_ORDER,"Must call MatSetPreallocationCOO() first");
+  ierr = PetscContainerGetPointer(c,(void**)&ij);CHKERRQ(ierr);
+  n    = ij[0];
+  ij++;
+  if (imode == INSERT_VALUES) {
+    ierr = MatZeroEntries(A);CHKERRQ(ierr);
+  }
+  for (k=0; k<n; k++) {
+    ierr = MatSetValues(A,1,ij+k,1,ij+n+k,coo_v+k,ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   MatSetPreallocationCOO - set preallocation for a matrix whose entries are given in coordinate (COO) format
+
+   Collective on Mat
+
+   Input Arguments:
++  A - matrix being preallocated
+.  n - number of entries given by this process
+.  coo_i - global row index of each entry
+-  coo_j - global column index of each entry
+
+   Notes:
+   The entries may belong to rows owned by other processes and the same (row,column) pair may appear several times, the
+   values given for it by MatSetValuesCOO() are then added. Entries with a negative row or column index are ignored.
+
+   The nonzero structure is computed once: the entries are sorted, the repeated ones merged, and for parallel matrices the
+   rows owned by other processes are sent once to set up the communication pattern used by every MatSetValuesCOO().
+   The matrix is assembled with zero values on return and the arrays may be freed.
+
+   MATSEQAIJ and MATMPIAIJ provide a direct implementation, other types go through MatSetValues().
+
+   Level: beginner
+
+.seealso: MatSetValuesCOO(), MatSeqAIJSetPreallocation(), MatMPIAIJSetPreallocation(), MatXAIJSetPreallocation()
+@*/
+PetscErrorCode MatSetPreallocationCOO(Mat A,PetscInt n,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  PetscErrorCode (*f)(Mat,PetscInt,const PetscInt[],const PetscInt[]) = NULL;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidType(A,1);
+  if (n) {
+    PetscValidIntPointer(coo_i,3);
+    PetscValidIntPointer(coo_j,4);
+  }
+  ierr = PetscLayoutSetUp(A->rmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(A->cmap);CHKERRQ(ierr);
+  ierr = PetscObjectQueryFunction((PetscObject)A,"MatSetPreallocationCOO_C",&f);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(MAT_PreallCOO,A,0,0,0);CHKERRQ(ierr);
+  if (f) {
+    ierr = (*f)(A,n,coo_i,coo_j);CHKERRQ(ierr);
+  } else {
+    ierr = MatSetPreallocationCOO_Basic(A,n,coo_i,coo_j);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventEnd(MAT_PreallCOO,A,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   MatSetValuesCOO - set the values of a matrix preallocated with MatSetPreallocationCOO()
+
+   Collective on Mat
+
+   Input Arguments:
++  A - matrix being assembled
+.  coo_v - the value of each entry, in the order of the coo_i[] and coo_j[] arrays given to MatSetPreallocationCOO()
+-  imode - INSERT_VALUES to replace the values of the matrix or ADD_VALUES to add to them
+
+   Notes:
+   The values of repeated entries are added. The matrix is assembled on return, there is no need to call MatAssemblyBegin()
+   and MatAssemblyEnd(). The nonzero structure must not have changed since MatSetPreallocationCOO().
+
+   Level: beginner
+
+.seealso: MatSetPreallocationCOO(), MatSetValues()
+@*/
+PetscErrorCode MatSetValuesCOO(Mat A,const PetscScalar coo_v[],InsertMode imode)
+{
+  PetscErrorCode (*f)(Mat,const PetscScalar[],InsertMode) = NULL;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidType(A,1);
+  if (imode != INSERT_VALUES && imode != ADD_VALUES) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_OUTOFRANGE,"Only INSERT_VALUES and ADD_VALUES are supported");
+  ierr = PetscObjectQueryFunction((PetscObject)A,"MatSetValuesCOO_C",&f);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(MAT_SetVCOO,A,0,0,0);CHKERRQ(ierr);
+  if (f) {
+    ierr = (*f)(A,coo_v,imode);CHKERRQ(ierr);
+  } else {
+    ierr = MatSetValuesCOO_Basic(A,coo_v,imode);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventEnd(MAT_SetVCOO,A,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
         Merges some information from Cs header to A; the C object is then destroyed
 
@@ -643,6 +643,46 @@ PetscErrorCode MatStashScatterGetMesg_Private(MatStash *stash,PetscMPIInt *nvals
   PetscFunctionReturn(0);
 }
 
+/*
+   MatStashScatterGetFrozenMesg_Private - Gets the next message of an exchange that carries values only, see
+   MAT_SAME_OFF_PROC_ENTRIES. It is used instead of MatStashScatterGetMesg_Private() when stash->frozen_values is set.
+
+   Output Parameters:
+   nvals  - number of entries (or blocks) in the message
+   offset - location of the first of them among the entries received in the recording assembly, their rows and
+            columns are stash->frozen_recvrows[offset] and stash->frozen_recvcols[offset]
+   vals   - the values
+   flg    - 0 when there are no messages left
+*/
+PetscErrorCode MatStashScatterGetFrozenMesg_Private(MatStash *stash,PetscMPIInt *nvals,PetscInt *offset,PetscScalar **vals,PetscInt *flg)
+{
+#if !defined(PETSC_HAVE_MPIUNI)
+  PetscErrorCode ierr;
+  PetscMPIInt    i;
+  PetscInt       bs2 = stash->bs*stash->bs;
+  PetscScalar    *v;
+  InsertMode     addv;
+#endif
+
+  PetscFunctionBegin;
+  *flg = 0;
+  if (!stash->frozen_values) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"The stash does not exchange values only");
+#if !defined(PETSC_HAVE_MPIUNI)
+  if (stash->recvcount == stash->nrecvranks) PetscFunctionReturn(0);
+  ierr = MPI_Waitany(stash->nrecvranks,stash->recvreqs,&i,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  stash->recvcount++;
+  *offset = stash->frozen_recvoffset[i];
+  *nvals  = (PetscMPIInt)(stash->frozen_recvoffset[i+1]-stash->frozen_recvoffset[i]);
+  v       = stash->frozen_recvvals + stash->frozen_recvoffset[i]*bs2 + i;
+  addv    = PetscRealPart(v[*nvals*bs2]) != 0.0 ? INSERT_VALUES : ADD_VALUES;
+  if (PetscUnlikely(*stash->insertmode == NOT_SET_VALUES)) *stash->insertmode = addv;
+  if (PetscUnlikely(*stash->insertmode != addv)) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Assembling %s, but rank %d requested otherwise",*stash->insertmode == INSERT_VALUES ? "INSERT_VALUES" : "ADD_VALUES",stash->recvranks[i]);
+  *vals = v;
+  *flg  = 1;
+#endif
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode MatStashScatterGetMesg_Ref(MatStash *stash,PetscMPIInt *nvals,PetscInt **rows,PetscInt **cols,PetscScalar **vals,PetscInt *flg)
 {
   PetscErrorCode ierr;
@@ -827,6 +867,144 @@ static PetscErrorCode MatStashBTSRecv_Private(MPI_Comm comm,const PetscMPIInt ta
   PetscFunctionReturn(0);
 }
 
+/*
+   Records the entries stashed in the first assembly with MAT_SAME_OFF_PROC_ENTRIES, both in stashing order and as sorted,
+   compressed and packed in sendblocks[] for each of the sendranks[]
+*/
+static PetscErrorCode MatStashFrozenRecordSends_Private(MatStash *stash,size_t nblocks,char *sendblocks)
+{
+  PetscErrorCode     ierr;
+  PetscInt           bs2 = stash->bs*stash->bs,nsend = (PetscInt)nblocks,i,k,r,lo,hi,mid,row,col,*sendidx;
+  PetscMatStashSpace space;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(2*nsend,&sendidx);CHKERRQ(ierr);
+  for (i=0; i<nsend; i++) {
+    MatStashBlock *block = (MatStashBlock*)&sendblocks[i*stash->blocktype_size];
+    sendidx[2*i]   = block->row;
+    sendidx[2*i+1] = block->col;
+  }
+  ierr = PetscMalloc1(stash->nsendranks+1,&stash->frozen_sendoffset);CHKERRQ(ierr);
+  stash->frozen_sendoffset[0] = 0;
+  for (i=0; i<stash->nsendranks; i++) stash->frozen_sendoffset[i+1] = stash->frozen_sendoffset[i] + stash->sendhdr[i].count;
+
+  /* locate each stashed entry among the ones sent */
+  ierr = PetscMalloc2(2*stash->n,&stash->frozen_idx,stash->n,&stash->frozen_map);CHKERRQ(ierr);
+  for (space=stash->space_head,k=0; space; space=space->next) {
+    for (i=0; i<space->local_used; i++,k++) {
+      row = space->idx[i];
+      col = space->idy[i];
+      for (lo=0,hi=nsend-1; lo<hi; ) {
+        mid = (lo+hi)/2;
+        if (sendidx[2*mid] < row || (sendidx[2*mid] == row && sendidx[2*mid+1] < col)) lo = mid+1;
+        else hi = mid;
+      }
+      ierr = PetscFindInt(lo,stash->nsendranks+1,stash->frozen_sendoffset,&r);CHKERRQ(ierr);
+      if (r < 0) r = -(r+2);
+      stash->frozen_idx[2*k]   = row;
+      stash->frozen_idx[2*k+1] = col;
+      stash->frozen_map[k]     = lo*bs2 + r;
+    }
+  }
+  stash->frozen_n       = stash->n;
+  stash->frozen_nsend   = nsend;
+  stash->frozen_sendidx = sendidx;
+  ierr = PetscMalloc1(nsend*bs2+stash->nsendranks,&stash->frozen_sendvals);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Records the entries received in the first assembly with MAT_SAME_OFF_PROC_ENTRIES, in the order of recvranks[]
+*/
+static PetscErrorCode MatStashFrozenRecordRecvs_Private(MatStash *stash)
+{
+  PetscErrorCode ierr;
+  PetscInt       bs2 = stash->bs*stash->bs,i,k,nrecv;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(stash->nrecvranks+1,&stash->frozen_recvoffset);CHKERRQ(ierr);
+  stash->frozen_recvoffset[0] = 0;
+  for (i=0; i<stash->nrecvranks; i++) stash->frozen_recvoffset[i+1] = stash->frozen_recvoffset[i] + stash->recvframes[i].count;
+  nrecv = stash->frozen_recvoffset[stash->nrecvranks];
+  ierr  = PetscMalloc2(nrecv,&stash->frozen_recvrows,nrecv,&stash->frozen_recvcols);CHKERRQ(ierr);
+  for (i=0; i<stash->nrecvranks; i++) {
+    for (k=0; k<stash->recvframes[i].count; k++) {
+      MatStashBlock *block = (MatStashBlock*)&((char*)stash->recvframes[i].buffer)[k*stash->blocktype_size];
+      stash->frozen_recvrows[stash->frozen_recvoffset[i]+k] = block->row < 0 ? -(block->row+1) : block->row;
+      stash->frozen_recvcols[stash->frozen_recvoffset[i]+k] = block->col;
+    }
+  }
+  ierr = PetscMalloc1(nrecv*bs2+stash->nrecvranks,&stash->frozen_recvvals);CHKERRQ(ierr);
+  stash->frozen_nrecv  = nrecv;
+  stash->frozen_record = PETSC_FALSE;
+  stash->frozen        = PETSC_TRUE;
+  stash->frozen_count++;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Sends the values of the entries recorded by MatStashFrozenRecordSends_Private(). When the entries were stashed in the
+   same order as in the recording assembly they go straight to their place in the messages, otherwise they are sorted and
+   compressed as usual and compared with the recorded ones.
+*/
+static PetscErrorCode MatStashScatterBegin_Frozen(Mat mat,MatStash *stash)
+{
+  PetscErrorCode     ierr;
+  PetscInt           bs2 = stash->bs*stash->bs,i,k,l,r;
+  PetscScalar        *sendvals = stash->frozen_sendvals,*v;
+  PetscMatStashSpace space;
+  PetscBool          same = (PetscBool)(stash->n == stash->frozen_n);
+  PetscMPIInt        tag;
+
+  PetscFunctionBegin;
+  for (space=stash->space_head,k=0; same && space; space=space->next) {
+    for (i=0; i<space->local_used; i++,k++) {
+      if (space->idx[i] != stash->frozen_idx[2*k] || space->idy[i] != stash->frozen_idx[2*k+1]) {same = PETSC_FALSE; break;}
+    }
+  }
+  if (same) {
+    if (mat->insertmode == ADD_VALUES) {ierr = PetscMemzero(sendvals,(stash->frozen_nsend*bs2+stash->nsendranks)*sizeof(PetscScalar));CHKERRQ(ierr);}
+    for (space=stash->space_head,k=0; space; space=space->next) {
+      for (i=0; i<space->local_used; i++,k++) {
+        v = sendvals + stash->frozen_map[k];
+        if (mat->insertmode == ADD_VALUES) for (l=0; l<bs2; l++) v[l] += space->val[i*bs2+l];
+        else                               for (l=0; l<bs2; l++) v[l]  = space->val[i*bs2+l];
+      }
+    }
+  } else {
+    size_t nblocks;
+    char   *sendblocks;
+
+    ierr = MatStashSortCompress_Private(stash,mat->insertmode);CHKERRQ(ierr);
+    ierr = PetscSegBufferGetSize(stash->segsendblocks,&nblocks);CHKERRQ(ierr);
+    ierr = PetscSegBufferExtractInPlace(stash->segsendblocks,&sendblocks);CHKERRQ(ierr);
+    if ((PetscInt)nblocks != stash->frozen_nsend) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"MAT_SAME_OFF_PROC_ENTRIES set, but %D off-process entries were set instead of %D",(PetscInt)nblocks,stash->frozen_nsend);
+    for (r=0; r<stash->nsendranks; r++) {
+      for (k=stash->frozen_sendoffset[r]; k<stash->frozen_sendoffset[r+1]; k++) {
+        MatStashBlock *block = (MatStashBlock*)&sendblocks[k*stash->blocktype_size];
+        if (block->row != stash->frozen_sendidx[2*k] || block->col != stash->frozen_sendidx[2*k+1]) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"MAT_SAME_OFF_PROC_ENTRIES set, but entry (%D,%D) was not set in the first assembly",block->row,block->col);
+        ierr = PetscMemcpy(sendvals+k*bs2+r,block->vals,bs2*sizeof(PetscScalar));CHKERRQ(ierr);
+      }
+    }
+  }
+  /* Encode insertmode at the end of the outgoing messages */
+  for (r=0; r<stash->nsendranks; r++) sendvals[stash->frozen_sendoffset[r+1]*bs2+r] = mat->insertmode == INSERT_VALUES ? 1.0 : 0.0;
+
+  ierr = PetscCommGetNewTag(stash->comm,&tag);CHKERRQ(ierr);
+  for (r=0; r<stash->nrecvranks; r++) {
+    PetscMPIInt count = (PetscMPIInt)((stash->frozen_recvoffset[r+1]-stash->frozen_recvoffset[r])*bs2+1);
+    ierr = MPI_Irecv(stash->frozen_recvvals+stash->frozen_recvoffset[r]*bs2+r,count,MPIU_SCALAR,stash->recvranks[r],tag,stash->comm,&stash->recvreqs[r]);CHKERRQ(ierr);
+  }
+  for (r=0; r<stash->nsendranks; r++) {
+    PetscMPIInt count = (PetscMPIInt)((stash->frozen_sendoffset[r+1]-stash->frozen_sendoffset[r])*bs2+1);
+    ierr = MPI_Isend(sendvals+stash->frozen_sendoffset[r]*bs2+r,count,MPIU_SCALAR,stash->sendranks[r],tag,stash->comm,&stash->sendreqs[r]);CHKERRQ(ierr);
+  }
+  stash->frozen_values = PETSC_TRUE;
+  stash->recvcount     = 0;
+  stash->insertmode    = &mat->insertmode;
+  PetscFunctionReturn(0);
+}
+
 /*
  * owners[] contains the ownership ranges; may be indexed by either blocks or scalars
  */
@@ -845,9 +1023,16 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat,MatStash *stash,PetscInt
   }
 #endif
 
-  if (stash->subset_off_proc && !mat->subsetoffprocentries) { /* We won't use the old scatter context. */
+  if (stash->frozen && mat->sameoffprocentries) {
+    ierr = MatStashScatterBegin_Frozen(mat,stash);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  /* We won't use the old scatter context. The assembly that records the entries for MAT_SAME_OFF_PROC_ENTRIES needs a full
+   * rendezvous to learn the exact counts received. */
+  if ((stash->subset_off_proc && (!mat->subsetoffprocentries || mat->sameoffprocentries)) || stash->frozen) {
     ierr = MatStashScatterDestroy_BTS(stash);CHKERRQ(ierr);
   }
+  stash->frozen_record = mat->sameoffprocentries;
 
   ierr = MatStashBlockTypeSetUp(stash);CHKERRQ(ierr);
   ierr = MatStashSortCompress_Private(stash,mat->insertmode);CHKERRQ(ierr);
@@ -907,6 +1092,7 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat,MatStash *stash,PetscInt
     }
     if (sendno != stash->nsendranks) SETERRQ2(stash->comm,PETSC_ERR_PLIB,"BTS counted %D sendranks, but %D sends",stash->nsendranks,sendno);
   }
+  if (stash->frozen_record) {ierr = MatStashFrozenRecordSends_Private(stash,nblocks,sendblocks);CHKERRQ(ierr);}
 
   /* Encode insertmode on the outgoing messages. If we want to support more than two options, we would need a new
    * message or a dummy entry of some sort. */
@@ -953,6 +1139,16 @@ static PetscErrorCode MatStashScatterGetMesg_BTS(MatStash *stash,PetscMPIInt *n,
   MatStashBlock *block;
 
   PetscFunctionBegin;
+  if (stash->frozen_values) {
+    PetscInt offset;
+
+    ierr = MatStashScatterGetFrozenMesg_Private(stash,n,&offset,val,flg);CHKERRQ(ierr);
+    if (*flg) {
+      *row = stash->frozen_recvrows + offset;
+      *col = stash->frozen_recvcols + offset;
+    }
+    PetscFunctionReturn(0);
+  }
   *flg = 0;
   while (!stash->recvframe_active || stash->recvframe_i == stash->recvframe_count) {
     if (stash->some_i == stash->some_count) {
@@ -992,7 +1188,13 @@ static PetscErrorCode MatStashScatterEnd_BTS(MatStash *stash)
 
   PetscFunctionBegin;
   ierr = MPI_Waitall(stash->nsendranks,stash->sendreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
-  if (stash->subset_off_proc) { /* Reuse the communication contexts, so consolidate and reset segrecvblocks  */
+  if (stash->frozen_values) {   /* Values were received in place, the communication contexts are kept */
+    stash->frozen_values = PETSC_FALSE;
+  } else if (stash->frozen_record) { /* Record what was received, then keep the communication contexts */
+    void *dummy;
+    ierr = MatStashFrozenRecordRecvs_Private(stash);CHKERRQ(ierr);
+    ierr = PetscSegBufferExtractInPlace(stash->segrecvblocks,&dummy);CHKERRQ(ierr);
+  } else if (stash->subset_off_proc) { /* Reuse the communication contexts, so consolidate and reset segrecvblocks  */
     void *dummy;
     ierr = PetscSegBufferExtractInPlace(stash->segrecvblocks,&dummy);CHKERRQ(ierr);
   } else {                      /* No reuse, so collect everything. */
@@ -1040,6 +1242,20 @@ static PetscErrorCode MatStashScatterDestroy_BTS(MatStash *stash)
   ierr = PetscFree(stash->recvranks);CHKERRQ(ierr);
   ierr = PetscFree(stash->recvhdr);CHKERRQ(ierr);
   ierr = PetscFree2(stash->some_indices,stash->some_statuses);CHKERRQ(ierr);
+  stash->subset_off_proc = PETSC_FALSE;
+  stash->frozen          = PETSC_FALSE;
+  stash->frozen_record   = PETSC_FALSE;
+  stash->frozen_values   = PETSC_FALSE;
+  stash->frozen_n        = 0;
+  stash->frozen_nsend    = 0;
+  stash->frozen_nrecv    = 0;
+  ierr = PetscFree2(stash->frozen_idx,stash->frozen_map);CHKERRQ(ierr);
+  ierr = PetscFree(stash->frozen_sendidx);CHKERRQ(ierr);
+  ierr = PetscFree(stash->frozen_sendoffset);CHKERRQ(ierr);
+  ierr = PetscFree(stash->frozen_recvoffset);CHKERRQ(ierr);
+  ierr = PetscFree2(stash->frozen_recvrows,stash->frozen_recvcols);CHKERRQ(ierr);
+  ierr = PetscFree(stash->frozen_sendvals);CHKERRQ(ierr);
+  ierr = PetscFree(stash->frozen_recvvals);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 #endif
@@ -15,6 +15,10 @@ typedef struct  {
   MPI_File      mfdes;                /* ignored unless using MPI IO */
   MPI_File      mfsub;                /* subviewer support */
   MPI_Offset    moff;
+  MPI_File      mfasync;              /* second handle used for the nonblocking writes of the asynchronous mode */
+  PetscInt      nasync,maxasync;      /* number of pending nonblocking writes and size of the arrays below */
+  MPI_Request   *asyncreqs;           /* requests of the pending nonblocking writes */
+  void          **asyncbufs;          /* staging buffers of the pending nonblocking writes */
 #endif
   PetscFileMode btype;                /* read or write? */
   FILE          *fdes_info;           /* optional file containing info on binary file*/
@@ -27,6 +31,9 @@ typedef struct  {
   PetscBool     skipheader;           /* don't write header, only raw data */
   PetscBool     matlabheaderwritten;  /* if format is PETSC_VIEWER_BINARY_MATLAB has the MATLAB .info header been written yet */
   PetscBool     setfromoptionscalled;
+  PetscBool     compress;             /* compress blocks of vector entries when writing */
+  PetscReal     compresstol;          /* absolute error allowed by the compression, 0 for lossless */
+  PetscBool     async;                /* write vectors with nonblocking MPI-IO, completed by PetscViewerFlush() */
 } PetscViewer_Binary;
 
 static PetscErrorCode PetscViewerGetSubViewer_Binary(PetscViewer viewer,MPI_Comm comm,PetscViewer *outviewer)
@@ -63,9 +70,15 @@ static PetscErrorCode PetscViewerGetSubViewer_Binary(PetscViewer viewer,MPI_Comm
       ierr = MPI_File_open(PETSC_COMM_SELF,vbinary->filename,amode,MPI_INFO_NULL,&vbinary->mfsub);CHKERRQ(ierr);
     }
     /* Subviewer gets the MPI file handle on PETSC_COMM_SELF */
-    obinary->mfdes = vbinary->mfsub;
-    obinary->mfsub = MPI_FILE_NULL;
-    obinary->moff  = vbinary->moff;
+    obinary->mfdes     = vbinary->mfsub;
+    obinary->mfsub     = MPI_FILE_NULL;
+    obinary->moff      = vbinary->moff;
+    obinary->async     = PETSC_FALSE;
+    obinary->mfasync   = MPI_FILE_NULL;
+    obinary->nasync    = 0;
+    obinary->maxasync  = 0;
+    obinary->asyncreqs = NULL;
+    obinary->asyncbufs = NULL;
   }
 #endif
   PetscFunctionReturn(0);
@@ -172,6 +185,86 @@ PetscErrorCode PetscViewerBinaryAddMPIIOOffset(PetscViewer viewer,MPI_Offset off
   PetscFunctionReturn(0);
 }
 
+/*@C
+    PetscViewerBinaryMPIIOWriteAsync - Starts writing data at a given offset of the file with nonblocking MPI-IO
+
+    Collective on PetscViewer the first time it is called, not collective afterwards
+
+    Input Parameters:
++   viewer - PetscViewer context, obtained from PetscViewerBinaryOpen()
+.   off - the offset in bytes from the beginning of the file
+.   data - the entries to write
+.   count - the number of entries
+-   dtype - the MPI datatype of the entries
+
+    Level: developer
+
+    Notes:
+    The entries are copied into a staging buffer, so data may be changed or freed as soon as this routine returns.
+    The write is completed by PetscViewerFlush() or when the viewer is destroyed; the file contents at off
+    are undefined until then. The offset of the viewer is not changed, use PetscViewerBinaryAddMPIIOOffset().
+
+    Fortran Note:
+    This routine is not supported in Fortran.
+
+.seealso: PetscViewerBinarySetAsync(), PetscViewerFlush(), PetscViewerBinaryGetMPIIOOffset(), PetscViewerBinaryAddMPIIOOffset()
+@*/
+PetscErrorCode PetscViewerBinaryMPIIOWriteAsync(PetscViewer viewer,MPI_Offset off,const void *data,PetscMPIInt count,MPI_Datatype dtype)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary*)viewer->data;
+  PetscDataType      pdtype;
+  size_t             dsize;
+  void               *buf;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  if (vbinary->mfdes == MPI_FILE_NULL) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Viewer file is not open for MPI-IO");
+  if (vbinary->mfasync == MPI_FILE_NULL) {
+    /* a handle of its own keeps the file view of the blocking writes independent of the pending writes */
+    ierr = MPI_File_open(PetscObjectComm((PetscObject)viewer),vbinary->filename,MPI_MODE_WRONLY,MPI_INFO_NULL,&vbinary->mfasync);CHKERRQ(ierr);
+    ierr = MPI_File_set_view(vbinary->mfasync,0,MPI_BYTE,MPI_BYTE,(char*)"native",MPI_INFO_NULL);CHKERRQ(ierr);
+  }
+  if (vbinary->nasync == vbinary->maxasync) {
+    MPI_Request *reqs;
+    void        **bufs;
+    PetscInt    maxasync = PetscMax(2*vbinary->maxasync,8);
+
+    ierr = PetscMalloc2(maxasync,&reqs,maxasync,&bufs);CHKERRQ(ierr);
+    ierr = PetscMemcpy(reqs,vbinary->asyncreqs,vbinary->nasync*sizeof(MPI_Request));CHKERRQ(ierr);
+    ierr = PetscMemcpy(bufs,vbinary->asyncbufs,vbinary->nasync*sizeof(void*));CHKERRQ(ierr);
+    ierr = PetscFree2(vbinary->asyncreqs,vbinary->asyncbufs);CHKERRQ(ierr);
+    vbinary->asyncreqs = reqs;
+    vbinary->asyncbufs = bufs;
+    vbinary->maxasync  = maxasync;
+  }
+  ierr = PetscMPIDataTypeToPetscDataType(dtype,&pdtype);CHKERRQ(ierr);
+  ierr = PetscDataTypeGetSize(pdtype,&dsize);CHKERRQ(ierr);
+  ierr = PetscMalloc(PetscMax(count*dsize,1),&buf);CHKERRQ(ierr);
+  ierr = PetscMemcpy(buf,data,count*dsize);CHKERRQ(ierr);
+#if !defined(PETSC_WORDS_BIGENDIAN)
+  ierr = PetscByteSwap(buf,pdtype,count);CHKERRQ(ierr);
+#endif
+  ierr = MPI_File_iwrite_at(vbinary->mfasync,off,buf,count,dtype,&vbinary->asyncreqs[vbinary->nasync]);CHKERRQ(ierr);
+  vbinary->asyncbufs[vbinary->nasync++] = buf;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscViewerBinaryMPIIOWaitAsync(PetscViewer viewer)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary*)viewer->data;
+  PetscInt           i;
+  PetscMPIInt        nasync;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  if (!vbinary->nasync) PetscFunctionReturn(0);
+  ierr = PetscMPIIntCast(vbinary->nasync,&nasync);CHKERRQ(ierr);
+  ierr = MPI_Waitall(nasync,vbinary->asyncreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  for (i=0; i<vbinary->nasync; i++) {ierr = PetscFree(vbinary->asyncbufs[i]);CHKERRQ(ierr);}
+  vbinary->nasync = 0;
+  PetscFunctionReturn(0);
+}
+
 /*@C
     PetscViewerBinaryGetMPIIODescriptor - Extracts the MPI IO file descriptor from a PetscViewer.
 
@@ -319,6 +412,178 @@ PetscErrorCode  PetscViewerBinarySetFlowControl(PetscViewer viewer,PetscInt fc)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PetscViewerBinarySetCompression_Binary(PetscViewer viewer,PetscBool compress,PetscReal tol)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary*)viewer->data;
+
+  PetscFunctionBegin;
+  if (tol < 0.0) SETERRQ1(PetscObjectComm((PetscObject)viewer),PETSC_ERR_ARG_OUTOFRANGE,"Compression tolerance must be nonnegative, %g was set",(double)tol);
+  vbinary->compress    = compress;
+  vbinary->compresstol = tol;
+  PetscFunctionReturn(0);
+}
+
+/*@
+    PetscViewerBinarySetCompression - Compresses the entries of vectors written to the binary file
+
+    Logically Collective on PetscViewer
+
+    Input Parameters:
++   viewer - PetscViewer context, obtained from PetscViewerBinaryOpen()
+.   compress - PETSC_TRUE to compress
+-   tol - the absolute error allowed in each entry, or 0.0 for lossless compression
+
+    Options Database Keys:
++   -viewer_binary_compression - compress vectors
+-   -viewer_binary_compression_tol <tol> - the absolute error allowed in each entry
+
+    Level: advanced
+
+    Notes:
+    Each process compresses blocks of its local entries: the bytes of the entries are shuffled so that bytes of the same
+    significance are stored together, after taking the difference with the previous entry, and the result is compressed
+    with a byte oriented LZ77 coder. With a positive tol the entries are first rounded to multiples of 2*tol.
+    VecLoad() recognizes compressed vectors and decompresses them in parallel, so nothing needs to be set for reading.
+
+    The compression is ignored when the header is skipped with PetscViewerBinarySetSkipHeader() or when MPI-IO is used.
+    It is not related to the gzip compression of files whose name ends with .gz.
+
+.seealso: PetscViewerBinaryOpen(), PetscViewerBinaryGetCompression(), VecView(), VecLoad()
+@*/
+PetscErrorCode PetscViewerBinarySetCompression(PetscViewer viewer,PetscBool compress,PetscReal tol)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  PetscValidLogicalCollectiveBool(viewer,compress,2);
+  PetscValidLogicalCollectiveReal(viewer,tol,3);
+  ierr = PetscTryMethod(viewer,"PetscViewerBinarySetCompression_C",(PetscViewer,PetscBool,PetscReal),(viewer,compress,tol));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscViewerBinaryGetCompression_Binary(PetscViewer viewer,PetscBool *compress,PetscReal *tol)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary*)viewer->data;
+
+  PetscFunctionBegin;
+  if (compress) *compress = vbinary->compress;
+  if (tol) *tol = vbinary->compresstol;
+  PetscFunctionReturn(0);
+}
+
+/*@
+    PetscViewerBinaryGetCompression - Gets whether the entries of vectors written to the binary file are compressed
+
+    Not Collective
+
+    Input Parameter:
+.   viewer - PetscViewer context, obtained from PetscViewerBinaryOpen()
+
+    Output Parameters:
++   compress - PETSC_TRUE if vectors are compressed
+-   tol - the absolute error allowed in each entry, 0.0 for lossless compression
+
+    Level: advanced
+
+.seealso: PetscViewerBinaryOpen(), PetscViewerBinarySetCompression()
+@*/
+PetscErrorCode PetscViewerBinaryGetCompression(PetscViewer viewer,PetscBool *compress,PetscReal *tol)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  if (compress) *compress = PETSC_FALSE;
+  if (tol) *tol = 0.0;
+  ierr = PetscTryMethod(viewer,"PetscViewerBinaryGetCompression_C",(PetscViewer,PetscBool*,PetscReal*),(viewer,compress,tol));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscViewerBinarySetAsync_Binary(PetscViewer viewer,PetscBool flg)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary*)viewer->data;
+
+  PetscFunctionBegin;
+  vbinary->async = flg;
+  PetscFunctionReturn(0);
+}
+
+/*@
+    PetscViewerBinarySetAsync - Writes vectors to the binary file without waiting for the file system
+
+    Logically Collective on PetscViewer
+
+    Input Parameters:
++   viewer - PetscViewer context, obtained from PetscViewerBinaryOpen()
+-   flg - PETSC_TRUE to write asynchronously
+
+    Options Database Key:
+.   -viewer_binary_async - write vectors asynchronously
+
+    Level: advanced
+
+    Notes:
+    VecView() copies the local entries into a staging buffer, starts a nonblocking MPI-IO write of the buffer and
+    returns, so the vector can be changed right away while the file system drains the data. PetscViewerFlush()
+    waits for all the pending writes, PetscViewerDestroy() does so as well. This is useful to overlap the output
+    of checkpoints with the following time steps, at the cost of one extra copy of the local entries per pending write.
+
+    The asynchronous mode only applies with MPI-IO, see PetscViewerBinarySetUseMPIIO(), and is ignored otherwise.
+
+.seealso: PetscViewerBinaryOpen(), PetscViewerBinaryGetAsync(), PetscViewerBinarySetUseMPIIO(), PetscViewerFlush(), VecView()
+@*/
+PetscErrorCode PetscViewerBinarySetAsync(PetscViewer viewer,PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  PetscValidLogicalCollectiveBool(viewer,flg,2);
+  ierr = PetscTryMethod(viewer,"PetscViewerBinarySetAsync_C",(PetscViewer,PetscBool),(viewer,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscViewerBinaryGetAsync_Binary(PetscViewer viewer,PetscBool *flg)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary*)viewer->data;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_MPIIO)
+  *flg = (PetscBool)(vbinary->async && vbinary->usempiio);
+#else
+  *flg = PETSC_FALSE;
+#endif
+  PetscFunctionReturn(0);
+}
+
+/*@
+    PetscViewerBinaryGetAsync - Gets whether vectors are written to the binary file asynchronously
+
+    Not Collective
+
+    Input Parameter:
+.   viewer - PetscViewer context, obtained from PetscViewerBinaryOpen()
+
+    Output Parameter:
+.   flg - PETSC_TRUE if vectors are written asynchronously with MPI-IO
+
+    Level: advanced
+
+.seealso: PetscViewerBinaryOpen(), PetscViewerBinarySetAsync(), PetscViewerFlush()
+@*/
+PetscErrorCode PetscViewerBinaryGetAsync(PetscViewer viewer,PetscBool *flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  PetscValidPointer(flg,2);
+  *flg = PETSC_FALSE;
+  ierr = PetscTryMethod(viewer,"PetscViewerBinaryGetAsync_C",(PetscViewer,PetscBool*),(viewer,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@C
     PetscViewerBinaryGetDescriptor - Extracts the file descriptor from a PetscViewer.
 
@@ -730,6 +995,12 @@ static PetscErrorCode PetscViewerFileClose_BinaryMPIIO(PetscViewer v)
   PetscErrorCode     ierr;
 
   PetscFunctionBegin;
+  ierr = PetscViewerBinaryMPIIOWaitAsync(v);CHKERRQ(ierr);
+  ierr = PetscFree2(vbinary->asyncreqs,vbinary->asyncbufs);CHKERRQ(ierr);
+  vbinary->maxasync = 0;
+  if (vbinary->mfasync != MPI_FILE_NULL) {
+    ierr = MPI_File_close(&vbinary->mfasync);CHKERRQ(ierr);
+  }
   if (vbinary->mfdes != MPI_FILE_NULL) {
     ierr = MPI_File_close(&vbinary->mfdes);CHKERRQ(ierr);
   }
@@ -744,6 +1015,19 @@ static PetscErrorCode PetscViewerFileClose_BinaryMPIIO(PetscViewer v)
 }
 #endif
 
+static PetscErrorCode PetscViewerFlush_Binary(PetscViewer v)
+{
+#if defined(PETSC_HAVE_MPIIO)
+  PetscErrorCode ierr;
+#endif
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_MPIIO)
+  ierr = PetscViewerBinaryMPIIOWaitAsync(v);CHKERRQ(ierr);
+#endif
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PetscViewerDestroy_Binary(PetscViewer v)
 {
   PetscViewer_Binary *vbinary = (PetscViewer_Binary*)v->data;
@@ -1386,11 +1670,15 @@ static PetscErrorCode PetscViewerSetFromOptions_Binary(PetscOptionItems *PetscOp
   ierr = PetscOptionsBool("-viewer_binary_skip_info","Skip writing/reading .info file","PetscViewerBinarySetSkipInfo",PETSC_FALSE,&binary->skipinfo,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-viewer_binary_skip_options","Skip parsing vec load options","PetscViewerBinarySetSkipOptions",PETSC_TRUE,&binary->skipoptions,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-viewer_binary_skip_header","Skip writing/reading header information","PetscViewerBinarySetSkipHeader",PETSC_FALSE,&binary->skipheader,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-viewer_binary_compression","Compress the entries of vectors","PetscViewerBinarySetCompression",binary->compress,&binary->compress,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsReal("-viewer_binary_compression_tol","Absolute error allowed by the compression, 0 for lossless","PetscViewerBinarySetCompression",binary->compresstol,&binary->compresstol,NULL);CHKERRQ(ierr);
+  if (binary->compresstol < 0.0) SETERRQ1(PetscObjectComm((PetscObject)v),PETSC_ERR_ARG_OUTOFRANGE,"Compression tolerance must be nonnegative, %g was set",(double)binary->compresstol);
 #if defined(PETSC_HAVE_MPIIO)
   ierr = PetscOptionsBool("-viewer_binary_mpiio","Use MPI-IO functionality to write/read binary file","PetscViewerBinarySetUseMPIIO",PETSC_FALSE,&binary->usempiio,NULL);CHKERRQ(ierr);
 #elif defined(PETSC_HAVE_MPIUNI)
   ierr = PetscOptionsBool("-viewer_binary_mpiio","Use MPI-IO functionality to write/read binary file","PetscViewerBinarySetUseMPIIO",PETSC_FALSE,NULL,NULL);CHKERRQ(ierr);  
 #endif
+  ierr = PetscOptionsBool("-viewer_binary_async","Write vectors with nonblocking MPI-IO, completed by PetscViewerFlush()","PetscViewerBinarySetAsync",binary->async,&binary->async,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   binary->setfromoptionscalled = PETSC_TRUE;
   PetscFunctionReturn(0);
@@ -1421,17 +1709,25 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_Binary(PetscViewer v)
   v->ops->destroy          = PetscViewerDestroy_Binary;
   v->ops->view             = PetscViewerView_Binary;
   v->ops->setup            = PetscViewerSetUp_Binary;
-  v->ops->flush            = NULL;
+  v->ops->flush            = PetscViewerFlush_Binary;
   vbinary->fdes            = 0;
 #if defined(PETSC_HAVE_MPIIO)
   vbinary->mfdes           = MPI_FILE_NULL;
   vbinary->mfsub           = MPI_FILE_NULL;
+  vbinary->mfasync         = MPI_FILE_NULL;
+  vbinary->nasync          = 0;
+  vbinary->maxasync        = 0;
+  vbinary->asyncreqs       = NULL;
+  vbinary->asyncbufs       = NULL;
 #endif
   vbinary->fdes_info       = 0;
   vbinary->skipinfo        = PETSC_FALSE;
   vbinary->skipoptions     = PETSC_TRUE;
   vbinary->skipheader      = PETSC_FALSE;
   vbinary->setfromoptionscalled = PETSC_FALSE;
+  vbinary->compress        = PETSC_FALSE;
+  vbinary->compresstol     = 0.0;
+  vbinary->async           = PETSC_FALSE;
   v->ops->getsubviewer     = PetscViewerGetSubViewer_Binary;
   v->ops->restoresubviewer = PetscViewerRestoreSubViewer_Binary;
   v->ops->read             = PetscViewerBinaryRead;
@@ -1445,6 +1741,10 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_Binary(PetscViewer v)
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinarySetFlowControl_C",PetscViewerBinarySetFlowControl_Binary);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinarySetSkipHeader_C",PetscViewerBinarySetSkipHeader_Binary);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinaryGetSkipHeader_C",PetscViewerBinaryGetSkipHeader_Binary);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinarySetCompression_C",PetscViewerBinarySetCompression_Binary);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinaryGetCompression_C",PetscViewerBinaryGetCompression_Binary);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinarySetAsync_C",PetscViewerBinarySetAsync_Binary);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinaryGetAsync_C",PetscViewerBinaryGetAsync_Binary);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinaryGetSkipOptions_C",PetscViewerBinaryGetSkipOptions_Binary);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinarySetSkipOptions_C",PetscViewerBinarySetSkipOptions_Binary);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinaryGetSkipInfo_C",PetscViewerBinaryGetSkipInfo_Binary);CHKERRQ(ierr);
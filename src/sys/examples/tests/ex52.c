@@ -0,0 +1,109 @@
+
+static char help[] = "Tests PetscSortInt(), PetscSortIntWithArray() and PetscSortIntWithArrayPair() on small and large arrays.\n\
+  -time : compares the time of PetscSortInt() with that of a quicksort\n\n";
+
+#include <petscsys.h>
+#include <petsctime.h>
+
+/* the quicksort that PetscSortInt() uses for small arrays, used here as the reference */
+static void QuickSort(PetscInt *v,PetscInt right)
+{
+  PetscInt i,vl,last,tmp;
+
+  if (right <= 1) {
+    if (right == 1 && v[0] > v[1]) {tmp = v[0]; v[0] = v[1]; v[1] = tmp;}
+    return;
+  }
+  tmp = v[0]; v[0] = v[right/2]; v[right/2] = tmp;
+  vl   = v[0];
+  last = 0;
+  for (i=1; i<=right; i++) {
+    if (v[i] < vl) {last++; tmp = v[last]; v[last] = v[i]; v[i] = tmp;}
+  }
+  tmp = v[0]; v[0] = v[last]; v[last] = tmp;
+  QuickSort(v,last-1);
+  QuickSort(v+last+1,right-(last+1));
+}
+
+/* a reproducible sequence of integers in [-range,range], with the extreme integers mixed in when range is PETSC_MAX_INT */
+static void FillArray(PetscInt n,PetscInt range,unsigned long long *seed,PetscInt *v)
+{
+  PetscInt i;
+
+  for (i=0; i<n; i++) {
+    *seed = *seed*6364136223846793005ULL + 1442695040888963407ULL;
+    if (range == PETSC_MAX_INT && !(i%7)) v[i] = (i%14) ? PETSC_MAX_INT : -PETSC_MAX_INT;
+    else v[i] = (PetscInt)((long long)((*seed >> 17) % (2*(unsigned long long)range+1)) - range);
+  }
+}
+
+static PetscErrorCode CheckSort(PetscInt n,PetscInt range,unsigned long long *seed,PetscBool dotime)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,*orig,*ref,*v,*J,*K;
+  PetscBool      *seen,ok = PETSC_TRUE;
+  PetscLogDouble t0,t1,t2;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc5(n,&orig,n,&ref,n,&v,n,&J,n,&K);CHKERRQ(ierr);
+  ierr = PetscCalloc1(n,&seen);CHKERRQ(ierr);
+  FillArray(n,range,seed,orig);
+
+  ierr = PetscMemcpy(ref,orig,n*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscTime(&t0);CHKERRQ(ierr);
+  QuickSort(ref,n-1);
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  ierr = PetscMemcpy(v,orig,n*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscSortInt(n,v);CHKERRQ(ierr);
+  ierr = PetscTime(&t2);CHKERRQ(ierr);
+  for (i=0; i<n; i++) if (v[i] != ref[i]) ok = PETSC_FALSE;
+  if (!ok) {ierr = PetscPrintf(PETSC_COMM_SELF,"n %D range %D: PetscSortInt() failed\n",n,range);CHKERRQ(ierr);}
+
+  /* the companion arrays must be permuted with the integers */
+  ierr = PetscMemcpy(v,orig,n*sizeof(PetscInt));CHKERRQ(ierr);
+  for (i=0; i<n; i++) J[i] = i;
+  ierr = PetscSortIntWithArray(n,v,J);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    if (v[i] != ref[i] || J[i] < 0 || J[i] >= n || seen[J[i]] || orig[J[i]] != v[i]) {ok = PETSC_FALSE; break;}
+    seen[J[i]] = PETSC_TRUE;
+  }
+  if (!ok) {ierr = PetscPrintf(PETSC_COMM_SELF,"n %D range %D: PetscSortIntWithArray() failed\n",n,range);CHKERRQ(ierr);}
+
+  ierr = PetscMemcpy(v,orig,n*sizeof(PetscInt));CHKERRQ(ierr);
+  for (i=0; i<n; i++) {J[i] = i; K[i] = -i;}
+  ierr = PetscSortIntWithArrayPair(n,v,J,K);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    if (v[i] != ref[i] || J[i] < 0 || J[i] >= n || K[i] != -J[i] || orig[J[i]] != v[i]) {ok = PETSC_FALSE; break;}
+  }
+  if (!ok) {ierr = PetscPrintf(PETSC_COMM_SELF,"n %D range %D: PetscSortIntWithArrayPair() failed\n",n,range);CHKERRQ(ierr);}
+
+  if (ok) {ierr = PetscPrintf(PETSC_COMM_SELF,"n %D range %D: sorted\n",n,range);CHKERRQ(ierr);}
+  if (dotime) {ierr = PetscPrintf(PETSC_COMM_SELF,"  quicksort %g PetscSortInt() %g\n",t1-t0,t2-t1);CHKERRQ(ierr);}
+  ierr = PetscFree5(orig,ref,v,J,K);CHKERRQ(ierr);
+  ierr = PetscFree(seen);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode     ierr;
+  PetscInt           i,j,sizes[] = {5,100,1023,1024,5000,100000},ranges[] = {10,100000,PETSC_MAX_INT};
+  PetscBool          dotime = PETSC_FALSE;
+  unsigned long long seed = 12345;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetBool(NULL,NULL,"-time",&dotime,NULL);CHKERRQ(ierr);
+  for (i=0; i<(PetscInt)(sizeof(sizes)/sizeof(sizes[0])); i++) {
+    for (j=0; j<(PetscInt)(sizeof(ranges)/sizeof(ranges[0])); j++) {
+      ierr = CheckSort(sizes[i],ranges[j],&seed,dotime);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+
+TEST*/
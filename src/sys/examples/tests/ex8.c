@@ -205,4 +205,16 @@ int main(int argc,char **argv)
       args: -verbose -build_twosided redscatter
       output_file: output/ex8_1.out
 
+   test:
+      suffix: node
+      nsize: 4
+      args: -verbose -build_twosided node
+      output_file: output/ex8_1.out
+
+   test:
+      suffix: f_node
+      nsize: 4
+      args: -verbose -build_twosided_f -build_twosided node
+      output_file: output/ex8_1.out
+
 TEST*/
@@ -228,9 +228,11 @@
       PetscEnum PETSC_BUILDTWOSIDED_ALLREDUCE
       PetscEnum PETSC_BUILDTWOSIDED_IBARRIER
       PetscEnum PETSC_BUILDTWOSIDED_REDSCATTER
+      PetscEnum PETSC_BUILDTWOSIDED_NODE
       parameter (PETSC_BUILDTWOSIDED_ALLREDUCE = 0)
       parameter (PETSC_BUILDTWOSIDED_IBARRIER = 1)
       parameter (PETSC_BUILDTWOSIDED_REDSCATTER = 2)
+      parameter (PETSC_BUILDTWOSIDED_NODE = 3)
 !
 !     PetscSubcommType
 !
@@ -291,6 +293,7 @@
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_BUILDTWOSIDED_ALLREDUCE
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_BUILDTWOSIDED_IBARRIER
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_BUILDTWOSIDED_REDSCATTER
+!DEC$ ATTRIBUTES DLLEXPORT::PETSC_BUILDTWOSIDED_NODE
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_SUBCOMM_GENERAL
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_SUBCOMM_CONTIGUOUS
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_SUBCOMM_INTERLACED
@@ -5,6 +5,10 @@ struct _n_PetscShmComm {
   PetscMPIInt *globranks;       /* global ranks of each rank in the shared memory communicator */
   PetscMPIInt shmsize;          /* size of the shared memory communicator */
   MPI_Comm    globcomm,shmcomm; /* global communicator and shared memory communicator (a sub-communicator of the former) */
+  MPI_Comm    leadercomm;       /* rank 0 of every shared memory communicator, MPI_COMM_NULL on the other ranks; created on demand */
+  PetscMPIInt *leaderof;        /* on the leaders, the rank in leadercomm of the leader of each global rank */
+  PetscMPIInt *localrank;       /* on the leaders, the rank of each global rank in its shared memory communicator */
+  PetscBool   hasleaders;       /* have leadercomm, leaderof and localrank been created */
 };
 
 /*
@@ -23,6 +27,8 @@ PETSC_EXTERN PetscMPIInt MPIAPI Petsc_DelComm_Shm(MPI_Comm comm,PetscMPIInt keyv
   PetscFunctionBegin;
   ierr = PetscInfo1(0,"Deleting shared memory subcommunicator in a MPI_Comm %ld\n",(long)comm);CHKERRMPI(ierr);
   ierr = MPI_Comm_free(&p->shmcomm);CHKERRMPI(ierr);
+  if (p->leadercomm != MPI_COMM_NULL) {ierr = MPI_Comm_free(&p->leadercomm);CHKERRMPI(ierr);}
+  ierr = PetscFree2(p->leaderof,p->localrank);CHKERRMPI(ierr);
   ierr = PetscFree(p->globranks);CHKERRMPI(ierr);
   ierr = PetscFree(val);CHKERRMPI(ierr);
   PetscFunctionReturn(MPI_SUCCESS);
@@ -66,7 +72,8 @@ PetscErrorCode PetscShmCommGet(MPI_Comm globcomm,PetscShmComm *pshmcomm)
   if (flg) PetscFunctionReturn(0);
 
   ierr        = PetscNew(pshmcomm);CHKERRQ(ierr);
-  (*pshmcomm)->globcomm = globcomm;
+  (*pshmcomm)->globcomm   = globcomm;
+  (*pshmcomm)->leadercomm = MPI_COMM_NULL;
 
   ierr = MPI_Comm_split_type(globcomm, MPI_COMM_TYPE_SHARED,0, MPI_INFO_NULL,&(*pshmcomm)->shmcomm);CHKERRQ(ierr);
 
@@ -186,6 +193,59 @@ PetscErrorCode PetscShmCommGetMpiShmComm(PetscShmComm pshmcomm,MPI_Comm *comm)
   PetscFunctionReturn(0);
 }
 
+/*
+    PetscShmCommGetLeaderComm - Returns the communicator of the leaders, one rank per shared memory communicator,
+    with the leader of the node and the rank within the node of every global rank
+
+    Collective on the global communicator the first time it is called
+
+    Input Parameter:
+.   pshmcomm - PetscShmComm object obtained with PetscShmCommGet()
+
+    Output Parameters:
++   leadercomm - the communicator of the leaders, MPI_COMM_NULL on the ranks that are not leaders
+.   leaderof - on the leaders, the rank in leadercomm of the leader of each global rank, NULL on the other ranks
+-   localrank - on the leaders, the rank of each global rank in its shared memory communicator, NULL on the other ranks
+
+    Notes:
+    The leader of a node is rank 0 of its shared memory communicator. The arrays have the size of the global
+    communicator but are only allocated on the leaders. They belong to pshmcomm and must not be freed.
+*/
+PetscErrorCode PetscShmCommGetLeaderComm(PetscShmComm pshmcomm,MPI_Comm *leadercomm,const PetscMPIInt **leaderof,const PetscMPIInt **localrank)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    globrank,globsize,shmrank,nleaders,i,j,*sizes,*displs,*ranks;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(pshmcomm->shmcomm,&shmrank);CHKERRQ(ierr);
+  if (!pshmcomm->hasleaders) {
+    ierr = MPI_Comm_rank(pshmcomm->globcomm,&globrank);CHKERRQ(ierr);
+    ierr = MPI_Comm_size(pshmcomm->globcomm,&globsize);CHKERRQ(ierr);
+    ierr = MPI_Comm_split(pshmcomm->globcomm,shmrank ? MPI_UNDEFINED : 0,globrank,&pshmcomm->leadercomm);CHKERRQ(ierr);
+    if (!shmrank) {
+      ierr = MPI_Comm_size(pshmcomm->leadercomm,&nleaders);CHKERRQ(ierr);
+      ierr = PetscMalloc3(nleaders,&sizes,nleaders+1,&displs,globsize,&ranks);CHKERRQ(ierr);
+      ierr = MPI_Allgather(&pshmcomm->shmsize,1,MPI_INT,sizes,1,MPI_INT,pshmcomm->leadercomm);CHKERRQ(ierr);
+      for (i=0,displs[0]=0; i<nleaders; i++) displs[i+1] = displs[i] + sizes[i];
+      if (displs[nleaders] != globsize) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Shared memory communicators have %d ranks, not %d",displs[nleaders],globsize);
+      ierr = MPI_Allgatherv(pshmcomm->globranks,pshmcomm->shmsize,MPI_INT,ranks,sizes,displs,MPI_INT,pshmcomm->leadercomm);CHKERRQ(ierr);
+      ierr = PetscMalloc2(globsize,&pshmcomm->leaderof,globsize,&pshmcomm->localrank);CHKERRQ(ierr);
+      for (i=0; i<nleaders; i++) {
+        for (j=displs[i]; j<displs[i+1]; j++) {
+          pshmcomm->leaderof[ranks[j]]  = i;
+          pshmcomm->localrank[ranks[j]] = j-displs[i];
+        }
+      }
+      ierr = PetscFree3(sizes,displs,ranks);CHKERRQ(ierr);
+    }
+    pshmcomm->hasleaders = PETSC_TRUE;
+  }
+  *leadercomm = pshmcomm->leadercomm;
+  *leaderof   = pshmcomm->leaderof;
+  *localrank  = pshmcomm->localrank;
+  PetscFunctionReturn(0);
+}
+
 #if defined(PETSC_HAVE_OPENMP_SUPPORT)
 #include <pthread.h>
 #include <hwloc.h>
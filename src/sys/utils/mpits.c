@@ -8,6 +8,7 @@ const char *const PetscBuildTwoSidedTypes[] = {
   "ALLREDUCE",
   "IBARRIER",
   "REDSCATTER",
+  "NODE",
   "PetscBuildTwoSidedType",
   "PETSC_BUILDTWOSIDED_",
   0
@@ -238,6 +239,164 @@ static PetscErrorCode PetscCommBuildTwoSided_RedScatter(MPI_Comm comm,PetscMPIIn
 }
 #endif
 
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+/*
+   Node-aware rendezvous: the messages of the ranks of a node are gathered on the leader of the node, the leaders
+   discover each other with a flat algorithm and exchange the messages bucketed by destination node, then each leader
+   scatters the messages it holds to the ranks of its node. Only the leaders take part in the rendezvous, whose cost
+   then grows with the number of nodes instead of the number of ranks.
+
+   Messages travel as records {destination rank, source rank, data} of recbytes bytes.
+*/
+static PetscErrorCode PetscCommBuildTwoSided_Node(MPI_Comm comm,PetscMPIInt count,MPI_Datatype dtype,PetscMPIInt nto,const PetscMPIInt *toranks,const void *todata,PetscMPIInt *nfrom,PetscMPIInt **fromranks,void *fromdata)
+{
+  PetscErrorCode    ierr;
+  PetscShmComm      pshmcomm;
+  MPI_Comm          shmcomm,leadercomm;
+  const PetscMPIInt *leaderof,*localrank;
+  PetscMPIInt       rank,shmrank,shmsize,sendbytes,recvbytes,nrecs,i,*counts = NULL,*displs = NULL,*franks,hdr[2];
+  MPI_Aint          lb,unitbytes;
+  size_t            databytes,recbytes;
+  char              *tdata,*fdata,*sendrecs,*noderecs = NULL,*recvrecs;
+
+  PetscFunctionBegin;
+  ierr = PetscCommDuplicate(comm,&comm,NULL);CHKERRQ(ierr);
+  ierr = MPI_Type_get_extent(dtype,&lb,&unitbytes);CHKERRQ(ierr);
+  if (lb != 0) SETERRQ1(comm,PETSC_ERR_SUP,"Datatype with nonzero lower bound %ld\n",(long)lb);
+  databytes = count*unitbytes;
+  recbytes  = sizeof(hdr) + databytes;
+  ierr = PetscShmCommGet(comm,&pshmcomm);CHKERRQ(ierr);
+  ierr = PetscShmCommGetMpiShmComm(pshmcomm,&shmcomm);CHKERRQ(ierr);
+  ierr = PetscShmCommGetLeaderComm(pshmcomm,&leadercomm,&leaderof,&localrank);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(shmcomm,&shmrank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(shmcomm,&shmsize);CHKERRQ(ierr);
+
+  /* gather the records of the node on its leader */
+  tdata = (char*)todata;
+  ierr  = PetscMPIIntCast((PetscInt)(nto*recbytes),&sendbytes);CHKERRQ(ierr);
+  ierr  = PetscMalloc(sendbytes,&sendrecs);CHKERRQ(ierr);
+  for (i=0; i<nto; i++) {
+    hdr[0] = toranks[i];
+    hdr[1] = rank;
+    ierr   = PetscMemcpy(sendrecs+i*recbytes,hdr,sizeof(hdr));CHKERRQ(ierr);
+    ierr   = PetscMemcpy(sendrecs+i*recbytes+sizeof(hdr),tdata+i*databytes,databytes);CHKERRQ(ierr);
+  }
+  if (!shmrank) {ierr = PetscMalloc2(shmsize,&counts,shmsize+1,&displs);CHKERRQ(ierr);}
+  ierr = MPI_Gather(&sendbytes,1,MPI_INT,counts,1,MPI_INT,0,shmcomm);CHKERRQ(ierr);
+  if (!shmrank) {
+    for (i=0,displs[0]=0; i<shmsize; i++) displs[i+1] = displs[i] + counts[i];
+    ierr = PetscMalloc(displs[shmsize],&noderecs);CHKERRQ(ierr);
+  }
+  ierr = MPI_Gatherv(sendrecs,sendbytes,MPI_BYTE,noderecs,counts,displs,MPI_BYTE,0,shmcomm);CHKERRQ(ierr);
+  ierr = PetscFree(sendrecs);CHKERRQ(ierr);
+
+  if (!shmrank) {
+    MPI_Comm    lcomm;
+    MPI_Request *reqs;
+    PetscMPIInt lrank,nleaders,ltag,nto_l,nfrom_l,*toleaders,*tolens,*fromleaders,*fromlens,*lcounts,*loffsets,*cursor,nrecv,j;
+    char        *sortedrecs;
+
+    /* bucket the records of the node by the leader of their destination */
+    nrecs = (PetscMPIInt)(displs[shmsize]/recbytes);
+    ierr  = MPI_Comm_rank(leadercomm,&lrank);CHKERRQ(ierr);
+    ierr  = MPI_Comm_size(leadercomm,&nleaders);CHKERRQ(ierr);
+    ierr  = PetscCalloc3(nleaders,&lcounts,nleaders+1,&loffsets,nleaders,&cursor);CHKERRQ(ierr);
+    for (i=0; i<nrecs; i++) {
+      ierr = PetscMemcpy(hdr,noderecs+i*recbytes,sizeof(hdr));CHKERRQ(ierr);
+      lcounts[leaderof[hdr[0]]]++;
+    }
+    for (j=0,nto_l=0; j<nleaders; j++) {
+      loffsets[j+1] = loffsets[j] + lcounts[j];
+      cursor[j]     = loffsets[j];
+      if (lcounts[j] && j != lrank) nto_l++;
+    }
+    ierr = PetscMalloc(nrecs*recbytes,&sortedrecs);CHKERRQ(ierr);
+    for (i=0; i<nrecs; i++) {
+      ierr = PetscMemcpy(hdr,noderecs+i*recbytes,sizeof(hdr));CHKERRQ(ierr);
+      ierr = PetscMemcpy(sortedrecs+(cursor[leaderof[hdr[0]]]++)*recbytes,noderecs+i*recbytes,recbytes);CHKERRQ(ierr);
+    }
+    ierr = PetscFree(noderecs);CHKERRQ(ierr);
+
+    /* rendezvous among the leaders on the number of records, then exchange the records */
+    ierr = PetscMalloc2(nto_l,&toleaders,nto_l,&tolens);CHKERRQ(ierr);
+    for (j=0,nto_l=0; j<nleaders; j++) {
+      if (lcounts[j] && j != lrank) {
+        toleaders[nto_l] = j;
+        tolens[nto_l++]  = lcounts[j];
+      }
+    }
+#if defined(PETSC_HAVE_MPI_IBARRIER) && !(defined(PETSC_HAVE_MPICH_CH3_SOCK) && !defined(PETSC_HAVE_MPICH_CH3_SOCK_FIXED_NBC_PROGRESS))
+    ierr = PetscCommBuildTwoSided_Ibarrier(leadercomm,1,MPI_INT,nto_l,toleaders,tolens,&nfrom_l,&fromleaders,&fromlens);CHKERRQ(ierr);
+#else
+    ierr = PetscCommBuildTwoSided_Allreduce(leadercomm,1,MPI_INT,nto_l,toleaders,tolens,&nfrom_l,&fromleaders,&fromlens);CHKERRQ(ierr);
+#endif
+    for (j=0,nrecv=lcounts[lrank]; j<nfrom_l; j++) nrecv += fromlens[j];
+    ierr = PetscMalloc(nrecv*recbytes,&recvrecs);CHKERRQ(ierr);
+    ierr = PetscMemcpy(recvrecs,sortedrecs+loffsets[lrank]*recbytes,lcounts[lrank]*recbytes);CHKERRQ(ierr);
+    ierr = PetscCommDuplicate(leadercomm,&lcomm,&ltag);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nfrom_l+nto_l,&reqs);CHKERRQ(ierr);
+    for (j=0,nrecv=lcounts[lrank]; j<nfrom_l; j++) {
+      ierr   = MPI_Irecv(recvrecs+nrecv*recbytes,(PetscMPIInt)(fromlens[j]*recbytes),MPI_BYTE,fromleaders[j],ltag,lcomm,reqs+j);CHKERRQ(ierr);
+      nrecv += fromlens[j];
+    }
+    for (j=0; j<nto_l; j++) {
+      ierr = MPI_Isend(sortedrecs+loffsets[toleaders[j]]*recbytes,(PetscMPIInt)(tolens[j]*recbytes),MPI_BYTE,toleaders[j],ltag,lcomm,reqs+nfrom_l+j);CHKERRQ(ierr);
+    }
+    ierr = MPI_Waitall(nfrom_l+nto_l,reqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+    ierr = PetscCommDestroy(&lcomm);CHKERRQ(ierr);
+    ierr = PetscFree(reqs);CHKERRQ(ierr);
+    ierr = PetscFree2(toleaders,tolens);CHKERRQ(ierr);
+    ierr = PetscFree(fromleaders);CHKERRQ(ierr);
+    ierr = PetscFree(fromlens);CHKERRQ(ierr);
+    ierr = PetscFree(sortedrecs);CHKERRQ(ierr);
+    ierr = PetscFree3(lcounts,loffsets,cursor);CHKERRQ(ierr);
+
+    /* bucket the records received by the node by their destination rank */
+    ierr = PetscMemzero(counts,shmsize*sizeof(PetscMPIInt));CHKERRQ(ierr);
+    for (i=0; i<nrecv; i++) {
+      ierr = PetscMemcpy(hdr,recvrecs+i*recbytes,sizeof(hdr));CHKERRQ(ierr);
+      counts[localrank[hdr[0]]]++;
+    }
+    for (i=0,displs[0]=0; i<shmsize; i++) {
+      displs[i+1] = displs[i] + counts[i];
+      counts[i]   = displs[i];
+    }
+    ierr = PetscMalloc(nrecv*recbytes,&noderecs);CHKERRQ(ierr);
+    for (i=0; i<nrecv; i++) {
+      ierr = PetscMemcpy(hdr,recvrecs+i*recbytes,sizeof(hdr));CHKERRQ(ierr);
+      ierr = PetscMemcpy(noderecs+(counts[localrank[hdr[0]]]++)*recbytes,recvrecs+i*recbytes,recbytes);CHKERRQ(ierr);
+    }
+    ierr = PetscFree(recvrecs);CHKERRQ(ierr);
+    for (i=0; i<=shmsize; i++) displs[i] *= (PetscMPIInt)recbytes;
+    for (i=0; i<shmsize; i++) counts[i] = displs[i+1] - displs[i];
+  }
+
+  /* scatter the records to their destination ranks of the node */
+  ierr = MPI_Scatter(counts,1,MPI_INT,&recvbytes,1,MPI_INT,0,shmcomm);CHKERRQ(ierr);
+  ierr = PetscMalloc(recvbytes,&recvrecs);CHKERRQ(ierr);
+  ierr = MPI_Scatterv(noderecs,counts,displs,MPI_BYTE,recvrecs,recvbytes,MPI_BYTE,0,shmcomm);CHKERRQ(ierr);
+  ierr = PetscFree(noderecs);CHKERRQ(ierr);
+  ierr = PetscFree2(counts,displs);CHKERRQ(ierr);
+
+  nrecs = (PetscMPIInt)(recvbytes/recbytes);
+  ierr  = PetscMalloc1(nrecs,&franks);CHKERRQ(ierr);
+  ierr  = PetscMalloc(nrecs*databytes,&fdata);CHKERRQ(ierr);
+  for (i=0; i<nrecs; i++) {
+    ierr     = PetscMemcpy(hdr,recvrecs+i*recbytes,sizeof(hdr));CHKERRQ(ierr);
+    franks[i] = hdr[1];
+    ierr     = PetscMemcpy(fdata+i*databytes,recvrecs+i*recbytes+sizeof(hdr),databytes);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(recvrecs);CHKERRQ(ierr);
+  ierr = PetscCommDestroy(&comm);CHKERRQ(ierr);
+
+  *nfrom            = nrecs;
+  *fromranks        = franks;
+  *(void**)fromdata = fdata;
+  PetscFunctionReturn(0);
+}
+#endif
+
 /*@C
    PetscCommBuildTwoSided - discovers communicating ranks given one-sided information, moving constant-sized data in the process (often message lengths)
 
@@ -259,7 +418,7 @@ static PetscErrorCode PetscCommBuildTwoSided_RedScatter(MPI_Comm comm,PetscMPIIn
    Level: developer
 
    Options Database Keys:
-.  -build_twosided <allreduce|ibarrier|redscatter> - algorithm to set up two-sided communication
+.  -build_twosided <allreduce|ibarrier|redscatter|node> - algorithm to set up two-sided communication
 
    Notes:
    This memory-scalable interface is an alternative to calling PetscGatherNumberOfMessages() and
@@ -298,6 +457,13 @@ PetscErrorCode PetscCommBuildTwoSided(MPI_Comm comm,PetscMPIInt count,MPI_Dataty
     ierr = PetscCommBuildTwoSided_RedScatter(comm,count,dtype,nto,toranks,todata,nfrom,fromranks,fromdata);CHKERRQ(ierr);
 #else
     SETERRQ(comm,PETSC_ERR_PLIB,"MPI implementation does not provide MPI_Reduce_scatter_block (part of MPI-2.2)");
+#endif
+    break;
+  case PETSC_BUILDTWOSIDED_NODE:
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+    ierr = PetscCommBuildTwoSided_Node(comm,count,dtype,nto,toranks,todata,nfrom,fromranks,fromdata);CHKERRQ(ierr);
+#else
+    SETERRQ(comm,PETSC_ERR_PLIB,"MPI implementation does not provide MPI_Comm_split_type (part of MPI-3)");
 #endif
     break;
   default: SETERRQ(comm,PETSC_ERR_PLIB,"Unknown method for building two-sided communication");
@@ -565,6 +731,7 @@ PetscErrorCode PetscCommBuildTwoSidedFReq(MPI_Comm comm,PetscMPIInt count,MPI_Da
     break;
   case PETSC_BUILDTWOSIDED_ALLREDUCE:
   case PETSC_BUILDTWOSIDED_REDSCATTER:
+  case PETSC_BUILDTWOSIDED_NODE:
     f = PetscCommBuildTwoSidedFReq_Reference;
     break;
   default: SETERRQ(comm,PETSC_ERR_PLIB,"Unknown method for building two-sided communication");
@@ -19,6 +19,72 @@
 
 /* -----------------------------------------------------------------------*/
 
+/*
+   Arrays of at least this many integers are sorted with a least significant digit radix sort, which needs
+   about 2 passes over the data for each byte of max-min instead of O(log n) passes, but needs a work array
+*/
+#define PETSC_SORT_RADIX_MIN 1024
+#define PETSC_SORT_RADIX_BITS 8
+
+#if defined(PETSC_USE_64BIT_INDICES)
+typedef unsigned long long PetscSortUInt;
+#else
+typedef unsigned int PetscSortUInt;
+#endif
+
+/*
+   Stable LSD radix sort of v[] on the digits of v[i]-min, which is nonnegative, so negative integers are
+   handled and only the digits in which the values differ are sorted on. J[] and K[] (which may be NULL) are
+   permuted in the same way.
+*/
+static PetscErrorCode PetscSortIntRadix_Private(PetscInt n,PetscInt *v,PetscInt *J,PetscInt *K)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,min,max,pos,count[1<<PETSC_SORT_RADIX_BITS];
+  PetscInt       *v0 = v,*J0 = J,*K0 = K,*wv,*wJ,*wK,*tv,*tJ,*tK,*t;
+  PetscSortUInt  range,d,mask = (1<<PETSC_SORT_RADIX_BITS)-1;
+  int            shift;
+
+  PetscFunctionBegin;
+  min = max = v[0];
+  for (i=1; i<n; i++) {
+    if (v[i] < min) min = v[i];
+    else if (v[i] > max) max = v[i];
+  }
+  if (min == max) PetscFunctionReturn(0);
+  range = (PetscSortUInt)max - (PetscSortUInt)min;
+  ierr  = PetscMalloc3(n,&wv,J ? n : 0,&wJ,K ? n : 0,&wK);CHKERRQ(ierr);
+  tv    = wv; tJ = wJ; tK = wK;
+  for (shift=0; shift<(int)(8*sizeof(PetscSortUInt)) && (range >> shift); shift+=PETSC_SORT_RADIX_BITS) {
+    ierr = PetscMemzero(count,sizeof(count));CHKERRQ(ierr);
+    for (i=0; i<n; i++) count[(((PetscSortUInt)v[i]-(PetscSortUInt)min) >> shift) & mask]++;
+    /* all values have the same digit */
+    if (count[(((PetscSortUInt)v[0]-(PetscSortUInt)min) >> shift) & mask] == n) continue;
+    for (d=0,pos=0; d<=mask; d++) {
+      i        = count[d];
+      count[d] = pos;
+      pos     += i;
+    }
+    for (i=0; i<n; i++) {
+      pos     = count[(((PetscSortUInt)v[i]-(PetscSortUInt)min) >> shift) & mask]++;
+      tv[pos] = v[i];
+      if (J) tJ[pos] = J[i];
+      if (K) tK[pos] = K[i];
+    }
+    t = v; v = tv; tv = t;
+    t = J; J = tJ; tJ = t;
+    t = K; K = tK; tK = t;
+  }
+  /* the sorted values are in the work array after an odd number of passes */
+  if (v != v0) {
+    ierr = PetscMemcpy(v0,v,n*sizeof(PetscInt));CHKERRQ(ierr);
+    if (J) {ierr = PetscMemcpy(J0,J,n*sizeof(PetscInt));CHKERRQ(ierr);}
+    if (K) {ierr = PetscMemcpy(K0,K,n*sizeof(PetscInt));CHKERRQ(ierr);}
+  }
+  ierr = PetscFree3(wv,wJ,wK);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
    A simple version of quicksort; taken from Kernighan and Ritchie, page 87.
    Assumes 0 origin for v, number of elements = right+1 (right is index of
@@ -57,6 +123,9 @@ static void PetscSortInt_Private(PetscInt *v,PetscInt right)
 +  n  - number of values
 -  i  - array of integers
 
+   Notes:
+   Large arrays are sorted with a radix sort, which allocates a work array of the same size.
+
    Level: intermediate
 
    Concepts: sorting^ints
@@ -65,7 +134,8 @@ static void PetscSortInt_Private(PetscInt *v,PetscInt right)
 @*/
 PetscErrorCode  PetscSortInt(PetscInt n,PetscInt i[])
 {
-  PetscInt j,k,tmp,ik;
+  PetscErrorCode ierr;
+  PetscInt       j,k,tmp,ik;
 
   PetscFunctionBegin;
   if (n<8) {
@@ -78,7 +148,10 @@ PetscErrorCode  PetscSortInt(PetscInt n,PetscInt i[])
         }
       }
     }
-  } else PetscSortInt_Private(i,n-1);
+  } else if (n < PETSC_SORT_RADIX_MIN) PetscSortInt_Private(i,n-1);
+  else {
+    ierr = PetscSortIntRadix_Private(n,i,NULL,NULL);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -258,6 +331,10 @@ static PetscErrorCode PetscSortIntWithArray_Private(PetscInt *v,PetscInt *V,Pets
 .  i  - array of integers
 -  I - second array of integers
 
+   Notes:
+   Large arrays are sorted with a radix sort, which allocates work arrays of the same size and keeps
+   entries with equal integers in their original order.
+
    Level: intermediate
 
    Concepts: sorting^ints with array
@@ -280,8 +357,10 @@ PetscErrorCode  PetscSortIntWithArray(PetscInt n,PetscInt i[],PetscInt Ii[])
         }
       }
     }
-  } else {
+  } else if (n < PETSC_SORT_RADIX_MIN) {
     ierr = PetscSortIntWithArray_Private(i,Ii,n-1);CHKERRQ(ierr);
+  } else {
+    ierr = PetscSortIntRadix_Private(n,i,Ii,NULL);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
@@ -330,6 +409,10 @@ static PetscErrorCode PetscSortIntWithArrayPair_Private(PetscInt *L,PetscInt *J,
 .  J  - second array of integers (first array of the pair)
 -  K  - third array of integers  (second array of the pair)
 
+   Notes:
+   Large arrays are sorted with a radix sort, which allocates work arrays of the same size and keeps
+   entries with equal integers in their original order.
+
    Level: intermediate
 
    Concepts: sorting^ints with array pair
@@ -352,8 +435,10 @@ PetscErrorCode  PetscSortIntWithArrayPair(PetscInt n,PetscInt L[],PetscInt J[],
         }
       }
     }
-  } else {
+  } else if (n < PETSC_SORT_RADIX_MIN) {
     ierr = PetscSortIntWithArrayPair_Private(L,J,K,n-1);CHKERRQ(ierr);
+  } else {
+    ierr = PetscSortIntRadix_Private(n,L,J,K);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
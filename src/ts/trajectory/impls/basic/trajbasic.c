@@ -34,11 +34,18 @@ static PetscErrorCode TSTrajectorySet_Basic(TSTrajectory tj,TS ts,PetscInt stepn
 
 static PetscErrorCode TSTrajectorySetFromOptions_Basic(PetscOptionItems *PetscOptionsObject,TSTrajectory tj)
 {
-  PetscErrorCode ierr;
+  TSTrajectory_Basic *tjbasic = (TSTrajectory_Basic*)tj->data;
+  PetscBool          compress;
+  PetscReal          tol;
+  PetscErrorCode     ierr;
 
   PetscFunctionBegin;
+  ierr = PetscViewerBinaryGetCompression(tjbasic->viewer,&compress,&tol);CHKERRQ(ierr);
   ierr = PetscOptionsHead(PetscOptionsObject,"TS trajectory options for Basic type");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-ts_trajectory_compression","Compress the stored solutions","PetscViewerBinarySetCompression",compress,&compress,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsReal("-ts_trajectory_compression_tol","Absolute error allowed in the stored solutions, 0 for lossless","PetscViewerBinarySetCompression",tol,&tol,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsTail();CHKERRQ(ierr);
+  ierr = PetscViewerBinarySetCompression(tjbasic->viewer,compress,tol);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -117,6 +124,10 @@ static PetscErrorCode TSTrajectoryDestroy_Basic(TSTrajectory tj)
 
       This version saves the solutions at all the stages
 
+  Options Database Keys:
++  -ts_trajectory_compression - compress the stored solutions, see PetscViewerBinarySetCompression()
+-  -ts_trajectory_compression_tol <tol> - the absolute error allowed in the stored solutions, 0 for lossless compression
+
       $PETSC_DIR/share/petsc/matlab/PetscReadBinaryTrajectory.m can read in files created with this format
 
   Level: intermediate
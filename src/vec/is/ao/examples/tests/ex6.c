@@ -0,0 +1,101 @@
+static char help[] = "Tests AOApplicationToPetscISs() and AOPetscToApplicationISs() with a memory scalable AO.\n\n";
+
+#include <petscao.h>
+
+/* checks that the index sets have the same indices on every process */
+static PetscErrorCode CheckISs(const char *name,PetscInt nis,IS is[],IS isb[])
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+  PetscBool      same = PETSC_TRUE,flg,gsame;
+
+  PetscFunctionBegin;
+  for (i=0; i<nis; i++) {
+    ierr = ISEqualUnsorted(is[i],isb[i],&flg);CHKERRQ(ierr);
+    if (!flg) same = PETSC_FALSE;
+  }
+  ierr = MPIU_Allreduce(&same,&gsame,1,MPIU_BOOL,MPI_LAND,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"%-22s %s\n",name,gsame ? "ok" : "differ");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    rank,size;
+  PetscInt       n = 7,N,nis,i,j,k,rstart,*app,*idx;
+  AO             ao,aob;
+  IS             is[4],isb[4],is0[4];
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+
+  /* the application ordering numbers the indices backwards within each group of 5 */
+  N      = n*size;
+  rstart = n*rank;
+  ierr   = PetscMalloc1(n,&app);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    j      = rstart + i;
+    app[i] = (j/5)*5 + 4 - j%5;
+    if (app[i] >= N) app[i] = j;
+  }
+  ierr = AOCreateMemoryScalable(PETSC_COMM_WORLD,n,app,NULL,&ao);CHKERRQ(ierr);
+  ierr = AOCreateBasic(PETSC_COMM_WORLD,n,app,NULL,&aob);CHKERRQ(ierr);
+  ierr = PetscFree(app);CHKERRQ(ierr);
+
+  /* index sets with indices owned by all processes, negative and out of range ones */
+  nis = 3;
+  for (k=0; k<nis; k++) {
+    ierr = PetscMalloc1(N+2,&idx);CHKERRQ(ierr);
+    for (i=0; i<N; i++) idx[i] = (i*(2*k+3) + rank) % N;
+    idx[N]   = -1;
+    idx[N+1] = N + k;
+    ierr = ISCreateGeneral(PETSC_COMM_WORLD,N+2-k,idx,PETSC_OWN_POINTER,&is[k]);CHKERRQ(ierr);
+    ierr = ISDuplicate(is[k],&isb[k]);CHKERRQ(ierr);
+    ierr = ISDuplicate(is[k],&is0[k]);CHKERRQ(ierr);
+  }
+
+  for (j=0; j<2; j++) {
+    /* the second time the communication pattern of the first is reused */
+    ierr = AOApplicationToPetscISs(ao,nis,is);CHKERRQ(ierr);
+    for (k=0; k<nis; k++) {ierr = AOApplicationToPetscIS(aob,isb[k]);CHKERRQ(ierr);}
+    ierr = CheckISs("AOApplicationToPetsc",nis,is,isb);CHKERRQ(ierr);
+    ierr = AOPetscToApplicationISs(ao,nis,is);CHKERRQ(ierr);
+    for (k=0; k<nis; k++) {ierr = AOPetscToApplicationIS(aob,isb[k]);CHKERRQ(ierr);}
+    ierr = CheckISs("AOPetscToApplication",nis,is,isb);CHKERRQ(ierr);
+  }
+  /* out of range indices are mapped to -1, otherwise the round trip gives back the original indices */
+  for (k=0; k<nis; k++) {
+    ierr = ISDestroy(&isb[k]);CHKERRQ(ierr);
+    ierr = ISGetIndices(is0[k],(const PetscInt**)&idx);CHKERRQ(ierr);
+    ierr = ISGetLocalSize(is0[k],&i);CHKERRQ(ierr);
+    ierr = ISCreateGeneral(PETSC_COMM_WORLD,i,idx,PETSC_COPY_VALUES,&isb[k]);CHKERRQ(ierr);
+    ierr = ISRestoreIndices(is0[k],(const PetscInt**)&idx);CHKERRQ(ierr);
+    ierr = ISGetIndices(isb[k],(const PetscInt**)&idx);CHKERRQ(ierr);
+    for (j=0; j<i; j++) if (idx[j] >= N) idx[j] = -1;
+    ierr = ISRestoreIndices(isb[k],(const PetscInt**)&idx);CHKERRQ(ierr);
+  }
+  ierr = CheckISs("round trip",nis,is,isb);CHKERRQ(ierr);
+
+  for (k=0; k<nis; k++) {
+    ierr = ISDestroy(&is[k]);CHKERRQ(ierr);
+    ierr = ISDestroy(&isb[k]);CHKERRQ(ierr);
+    ierr = ISDestroy(&is0[k]);CHKERRQ(ierr);
+  }
+  ierr = AODestroy(&ao);CHKERRQ(ierr);
+  ierr = AODestroy(&aob);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+
+   test:
+      suffix: 2
+      nsize: 3
+
+TEST*/
@@ -6,12 +6,40 @@
 
 #include <../src/vec/is/ao/aoimpl.h>          /*I  "petscao.h"   I*/
 
+/*
+   Communication pattern of a query; it is reused by the next query in the same direction if that has the same pattern on all processes
+*/
+typedef struct {
+  PetscBool   set;         /* a pattern is stored */
+  PetscMPIInt nto;         /* number of processes queried */
+  PetscMPIInt *toranks;    /* the processes queried, in increasing order */
+  PetscMPIInt *tolens;     /* number of indices sent to each of them */
+  PetscMPIInt nfrom;       /* number of processes that queried this process */
+  PetscMPIInt *fromranks;  /* the processes that queried this process */
+  PetscMPIInt *fromlens;   /* number of indices received from each of them */
+} AOMemoryScalablePlan;
+
 typedef struct {
-  PetscInt    *app_loc;    /* app_loc[i] is the partner for the ith local PETSc slot */
-  PetscInt    *petsc_loc;  /* petsc_loc[j] is the partner for the jth local app slot */
-  PetscLayout map;         /* determines the local sizes of ao */
+  PetscInt             *app_loc;    /* app_loc[i] is the partner for the ith local PETSc slot */
+  PetscInt             *petsc_loc;  /* petsc_loc[j] is the partner for the jth local app slot */
+  PetscLayout          map;         /* determines the local sizes of ao */
+  AOMemoryScalablePlan plan[2];     /* patterns of the last PETSc to application and application to PETSc queries */
 } AO_MemoryScalable;
 
+static PetscErrorCode AOMemoryScalablePlanReset_Private(AOMemoryScalablePlan *plan)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree2(plan->toranks,plan->tolens);CHKERRQ(ierr);
+  ierr = PetscFree(plan->fromranks);CHKERRQ(ierr);
+  ierr = PetscFree(plan->fromlens);CHKERRQ(ierr);
+  plan->set   = PETSC_FALSE;
+  plan->nto   = 0;
+  plan->nfrom = 0;
+  PetscFunctionReturn(0);
+}
+
 /*
        All processors ship the data to process 0 to be printed; note that this is not scalable because
        process 0 allocates space for all the orderings entry across all the processes
@@ -79,6 +107,8 @@ PetscErrorCode AODestroy_MemoryScalable(AO ao)
 
   PetscFunctionBegin;
   ierr = PetscFree2(aomems->app_loc,aomems->petsc_loc);CHKERRQ(ierr);
+  ierr = AOMemoryScalablePlanReset_Private(&aomems->plan[0]);CHKERRQ(ierr);
+  ierr = AOMemoryScalablePlanReset_Private(&aomems->plan[1]);CHKERRQ(ierr);
   ierr = PetscLayoutDestroy(&aomems->map);CHKERRQ(ierr);
   ierr = PetscFree(aomems);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -89,158 +119,118 @@ PetscErrorCode AODestroy_MemoryScalable(AO ao)
 +   ao - the application ordering context
 .   n  - the number of integers in ia[]
 .   ia - the integers; these are replaced with their mapped value
--   maploc - app_loc or petsc_loc in struct "AO_MemoryScalable"
+.   maploc - app_loc or petsc_loc in struct "AO_MemoryScalable"
+-   plan - the communication pattern of the last query in the same direction
 
    Output Parameter:
 .   ia - the mapped interges
+
+   Each index is sent to the process that owns its slot, mapped there and sent back. Which processes query
+   which is found with PetscCommBuildTwoSided(); if on every process the query goes to the same processes with
+   the same number of indices as the last one, as when translating the same or similar index sets again, this is skipped.
  */
-PetscErrorCode AOMap_MemoryScalable_private(AO ao,PetscInt n,PetscInt *ia,const PetscInt *maploc)
+PetscErrorCode AOMap_MemoryScalable_private(AO ao,PetscInt n,PetscInt *ia,const PetscInt *maploc,AOMemoryScalablePlan *plan)
 {
   PetscErrorCode    ierr;
   AO_MemoryScalable *aomems = (AO_MemoryScalable*)ao->data;
   MPI_Comm          comm;
-  PetscMPIInt       rank,size,tag1,tag2;
-  PetscInt          *owner,*start,*sizes,nsends,nreceives;
-  PetscInt          nmax,count,*sindices,*rindices,i,j,idx,lastidx,*sindices2,*rindices2;
+  PetscMPIInt       rank,size,tag1,tag2,nto,nfrom,j;
+  PetscInt          i,k,o = 0,nrecv,*owner,*counts,*start,*sbuf,*sbuf2,*rbuf;
   const PetscInt    *owners = aomems->map->range;
-  MPI_Request       *send_waits,*recv_waits,*send_waits2,*recv_waits2;
-  MPI_Status        recv_status;
-  PetscMPIInt       nindices,source,widx;
-  PetscInt          *rbuf,*sbuf;
-  MPI_Status        *send_status,*send_status2;
+  MPI_Request       *reqs;
+  PetscBool         same,gsame;
 
   PetscFunctionBegin;
   ierr = PetscObjectGetComm((PetscObject)ao,&comm);CHKERRQ(ierr);
   ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
   ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
 
-  /*  first count number of contributors to each processor */
-  ierr = PetscMalloc2(2*size,&sizes,size,&start);CHKERRQ(ierr);
-  ierr = PetscMemzero(sizes,2*size*sizeof(PetscInt));CHKERRQ(ierr);
-  ierr = PetscCalloc1(n,&owner);CHKERRQ(ierr);
-
-  j       = 0;
-  lastidx = -1;
+  /* find the owner of each index and count the indices for each process */
+  ierr = PetscMalloc1(n,&owner);CHKERRQ(ierr);
+  ierr = PetscCalloc2(size,&counts,size,&start);CHKERRQ(ierr);
   for (i=0; i<n; i++) {
-    if (ia[i] < 0) owner[i] = -1; /* mark negative entries (which are not to be mapped) with a special negative value */
-    if (ia[i] >= ao->N) owner[i] = -2; /* mark out of range entries with special negative value */
+    if (ia[i] < 0) owner[i] = -1;           /* negative entries are not mapped */
+    else if (ia[i] >= ao->N) owner[i] = -2; /* out of range entries are mapped to -1 */
     else {
-      /* if indices are NOT locally sorted, need to start search at the beginning */
-      if (lastidx > (idx = ia[i])) j = 0;
-      lastidx = idx;
-      for (; j<size; j++) {
-        if (idx >= owners[j] && idx < owners[j+1]) {
-          sizes[2*j]++;     /* num of indices to be sent */
-          sizes[2*j+1] = 1; /* send to proc[j] */
-          owner[i]     = j;
-          break;
-        }
-      }
+      /* the indices are often sorted, so try the owner of the previous one first */
+      if (ia[i] < owners[o] || ia[i] >= owners[o+1]) {ierr = PetscLayoutFindOwner(aomems->map,ia[i],&o);CHKERRQ(ierr);}
+      owner[i] = o;
+      counts[o]++;
     }
   }
-  sizes[2*rank]=sizes[2*rank+1]=0; /* do not receive from self! */
-  nsends        = 0;
-  for (i=0; i<size; i++) nsends += sizes[2*i+1];
-
-  /* inform other processors of number of messages and max length*/
-  ierr = PetscMaxSum(comm,sizes,&nmax,&nreceives);CHKERRQ(ierr);
+  counts[rank] = 0; /* mapped locally */
+  for (j=0,nto=0; j<size; j++) if (counts[j]) nto++;
+
+  /* reuse the pattern of the last query if it is the same on all processes */
+  same = (PetscBool)(plan->set && nto == plan->nto);
+  for (j=0,k=0; same && j<size; j++) {
+    if (!counts[j]) continue;
+    if (plan->toranks[k] != j || plan->tolens[k] != counts[j]) same = PETSC_FALSE;
+    k++;
+  }
+  ierr = MPIU_Allreduce(&same,&gsame,1,MPIU_BOOL,MPI_LAND,comm);CHKERRQ(ierr);
+  if (!gsame) {
+    ierr = AOMemoryScalablePlanReset_Private(plan);CHKERRQ(ierr);
+    ierr = PetscMalloc2(nto,&plan->toranks,nto,&plan->tolens);CHKERRQ(ierr);
+    for (j=0,k=0; j<size; j++) {
+      if (!counts[j]) continue;
+      plan->toranks[k] = j;
+      ierr = PetscMPIIntCast(counts[j],&plan->tolens[k]);CHKERRQ(ierr);
+      k++;
+    }
+    plan->nto = nto;
+    ierr      = PetscCommBuildTwoSided(comm,1,MPI_INT,plan->nto,plan->toranks,plan->tolens,&plan->nfrom,&plan->fromranks,&plan->fromlens);CHKERRQ(ierr);
+    plan->set = PETSC_TRUE;
+  }
+  nfrom = plan->nfrom;
+  for (j=0,nrecv=0; j<nfrom; j++) nrecv += plan->fromlens[j];
 
-  /* allocate arrays */
+  /* the queries go out in the order of the processes, start[j] is the first one for process j */
+  for (j=0,k=0; j<size; j++) {start[j] = k; k += counts[j];}
+  ierr = PetscMalloc3(k,&sbuf,k,&sbuf2,nrecv,&rbuf);CHKERRQ(ierr);
+  ierr = PetscMalloc1(2*(nto+nfrom),&reqs);CHKERRQ(ierr);
   ierr = PetscObjectGetNewTag((PetscObject)ao,&tag1);CHKERRQ(ierr);
   ierr = PetscObjectGetNewTag((PetscObject)ao,&tag2);CHKERRQ(ierr);
 
-  ierr = PetscMalloc2(nreceives*nmax,&rindices,nreceives,&recv_waits);CHKERRQ(ierr);
-  ierr = PetscMalloc2(nsends*nmax,&rindices2,nsends,&recv_waits2);CHKERRQ(ierr);
-
-  ierr = PetscMalloc3(n,&sindices,nsends,&send_waits,nsends,&send_status);CHKERRQ(ierr);
-  ierr = PetscMalloc3(n,&sindices2,nreceives,&send_waits2,nreceives,&send_status2);CHKERRQ(ierr);
-
-  /* post 1st receives: receive others requests
-     since we don't know how long each individual message is we
-     allocate the largest needed buffer for each receive. Potentially
-     this is a lot of wasted space.
-  */
-  for (i=0,count=0; i<nreceives; i++) {
-    ierr = MPI_Irecv(rindices+nmax*i,nmax,MPIU_INT,MPI_ANY_SOURCE,tag1,comm,recv_waits+count++);CHKERRQ(ierr);
+  /* post the receives for the queries of the other processes and for the answers to ours */
+  for (j=0,k=0; j<nfrom; j++) {
+    ierr = MPI_Irecv(rbuf+k,plan->fromlens[j],MPIU_INT,plan->fromranks[j],tag1,comm,&reqs[j]);CHKERRQ(ierr);
+    k   += plan->fromlens[j];
   }
-
-  /* do 1st sends:
-      1) starts[i] gives the starting index in svalues for stuff going to
-         the ith processor
-  */
-  start[0] = 0;
-  for (i=1; i<size; i++) start[i] = start[i-1] + sizes[2*i-2];
-  for (i=0; i<n; i++) {
-    j = owner[i];
-    if (j == -1) continue; /* do not remap negative entries in ia[] */
-    else if (j == -2) { /* out of range entries get mapped to -1 */
-      ia[i] = -1;
-      continue; 
-    } else if (j != rank) {
-      sindices[start[j]++]  = ia[i];
-    } else { /* compute my own map */
-      ia[i] = maploc[ia[i]-owners[rank]];
-    }
+  for (j=0; j<nto; j++) {
+    ierr = MPI_Irecv(sbuf2+start[plan->toranks[j]],plan->tolens[j],MPIU_INT,plan->toranks[j],tag2,comm,&reqs[nfrom+j]);CHKERRQ(ierr);
   }
 
-  start[0] = 0;
-  for (i=1; i<size; i++) start[i] = start[i-1] + sizes[2*i-2];
-  for (i=0,count=0; i<size; i++) {
-    if (sizes[2*i+1]) {
-      /* send my request to others */
-      ierr = MPI_Isend(sindices+start[i],sizes[2*i],MPIU_INT,i,tag1,comm,send_waits+count);CHKERRQ(ierr);
-      /* post receive for the answer of my request */
-      ierr = MPI_Irecv(sindices2+start[i],sizes[2*i],MPIU_INT,i,tag2,comm,recv_waits2+count);CHKERRQ(ierr);
-      count++;
-    }
+  /* pack and send the queries while mapping the local indices */
+  for (i=0; i<n; i++) {
+    if (owner[i] == -1) continue;
+    else if (owner[i] == -2) ia[i] = -1;
+    else if (owner[i] == rank) ia[i] = maploc[ia[i]-owners[rank]];
+    else sbuf[start[owner[i]]++] = ia[i];
   }
-  if (nsends != count) SETERRQ2(comm,PETSC_ERR_SUP,"nsends %d != count %d",nsends,count);
-
-  /* wait on 1st sends */
-  if (nsends) {
-    ierr = MPI_Waitall(nsends,send_waits,send_status);CHKERRQ(ierr);
+  for (j=0; j<size; j++) start[j] -= counts[j];
+  for (j=0; j<nto; j++) {
+    ierr = MPI_Isend(sbuf+start[plan->toranks[j]],plan->tolens[j],MPIU_INT,plan->toranks[j],tag1,comm,&reqs[nfrom+nto+j]);CHKERRQ(ierr);
   }
 
-  /* 1st recvs: other's requests */
-  for (j=0; j< nreceives; j++) {
-    ierr   = MPI_Waitany(nreceives,recv_waits,&widx,&recv_status);CHKERRQ(ierr); /* idx: index of handle for operation that completed */
-    ierr   = MPI_Get_count(&recv_status,MPIU_INT,&nindices);CHKERRQ(ierr);
-    rbuf   = rindices+nmax*widx; /* global index */
-    source = recv_status.MPI_SOURCE;
-
-    /* compute mapping */
-    sbuf = rbuf;
-    for (i=0; i<nindices; i++) sbuf[i] = maploc[rbuf[i]-owners[rank]];
-
-    /* send mapping back to the sender */
-    ierr = MPI_Isend(sbuf,nindices,MPIU_INT,source,tag2,comm,send_waits2+widx);CHKERRQ(ierr);
-  }
-
-  /* wait on 2nd sends */
-  if (nreceives) {
-    ierr = MPI_Waitall(nreceives,send_waits2,send_status2);CHKERRQ(ierr);
+  /* answer the queries of the other processes */
+  ierr = MPI_Waitall(nfrom,reqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  for (k=0; k<nrecv; k++) rbuf[k] = maploc[rbuf[k]-owners[rank]];
+  for (j=0,k=0; j<nfrom; j++) {
+    ierr = MPI_Isend(rbuf+k,plan->fromlens[j],MPIU_INT,plan->fromranks[j],tag2,comm,&reqs[nfrom+2*nto+j]);CHKERRQ(ierr);
+    k   += plan->fromlens[j];
   }
+  ierr = MPI_Waitall(2*nto+nfrom,reqs+nfrom,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
 
-  /* 2nd recvs: for the answer of my request */
-  for (j=0; j< nsends; j++) {
-    ierr   = MPI_Waitany(nsends,recv_waits2,&widx,&recv_status);CHKERRQ(ierr);
-    ierr   = MPI_Get_count(&recv_status,MPIU_INT,&nindices);CHKERRQ(ierr);
-    source = recv_status.MPI_SOURCE;
-    /* pack output ia[] */
-    rbuf  = sindices2+start[source];
-    count = 0;
-    for (i=0; i<n; i++) {
-      if (source == owner[i]) ia[i] = rbuf[count++];
-    }
+  /* unpack the answers */
+  for (i=0; i<n; i++) {
+    if (owner[i] >= 0 && owner[i] != rank) ia[i] = sbuf2[start[owner[i]]++];
   }
 
-  /* free arrays */
-  ierr = PetscFree2(sizes,start);CHKERRQ(ierr);
+  ierr = PetscFree(reqs);CHKERRQ(ierr);
+  ierr = PetscFree3(sbuf,sbuf2,rbuf);CHKERRQ(ierr);
+  ierr = PetscFree2(counts,start);CHKERRQ(ierr);
   ierr = PetscFree(owner);CHKERRQ(ierr);
-  ierr = PetscFree2(rindices,recv_waits);CHKERRQ(ierr);
-  ierr = PetscFree2(rindices2,recv_waits2);CHKERRQ(ierr);
-  ierr = PetscFree3(sindices,send_waits,send_status);CHKERRQ(ierr);
-  ierr = PetscFree3(sindices2,send_waits2,send_status2);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -251,7 +241,7 @@ PetscErrorCode AOPetscToApplication_MemoryScalable(AO ao,PetscInt n,PetscInt *ia
   PetscInt          *app_loc = aomems->app_loc;
 
   PetscFunctionBegin;
-  ierr = AOMap_MemoryScalable_private(ao,n,ia,app_loc);CHKERRQ(ierr);
+  ierr = AOMap_MemoryScalable_private(ao,n,ia,app_loc,&aomems->plan[0]);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -262,7 +252,7 @@ PetscErrorCode AOApplicationToPetsc_MemoryScalable(AO ao,PetscInt n,PetscInt *ia
   PetscInt          *petsc_loc = aomems->petsc_loc;
 
   PetscFunctionBegin;
-  ierr = AOMap_MemoryScalable_private(ao,n,ia,petsc_loc);CHKERRQ(ierr);
+  ierr = AOMap_MemoryScalable_private(ao,n,ia,petsc_loc,&aomems->plan[1]);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
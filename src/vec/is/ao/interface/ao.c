@@ -187,6 +187,119 @@ PetscErrorCode  AOApplicationToPetscIS(AO ao,IS is)
   PetscFunctionReturn(0);
 }
 
+/*
+   Maps the indices of several index sets with one call of the AO operation, so that
+   AOMEMORYSCALABLE communicates once for all of them
+*/
+static PetscErrorCode AOMapISs_Private(AO ao,PetscInt nis,IS is[],PetscErrorCode (*map)(AO,PetscInt,PetscInt[]))
+{
+  PetscErrorCode ierr;
+  PetscInt       i,n,cnt,*ia,*idx;
+
+  PetscFunctionBegin;
+  for (i=0,cnt=0; i<nis; i++) {
+    PetscValidHeaderSpecific(is[i],IS_CLASSID,3);
+    ierr = ISToGeneral(is[i]);CHKERRQ(ierr);
+    ierr = ISGetLocalSize(is[i],&n);CHKERRQ(ierr);
+    cnt += n;
+  }
+  ierr = PetscMalloc1(cnt,&ia);CHKERRQ(ierr);
+  for (i=0,cnt=0; i<nis; i++) {
+    ierr = ISGetLocalSize(is[i],&n);CHKERRQ(ierr);
+    ierr = ISGetIndices(is[i],(const PetscInt**)&idx);CHKERRQ(ierr);
+    ierr = PetscMemcpy(ia+cnt,idx,n*sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = ISRestoreIndices(is[i],(const PetscInt**)&idx);CHKERRQ(ierr);
+    cnt += n;
+  }
+  ierr = (*map)(ao,cnt,ia);CHKERRQ(ierr);
+  /* we cheat because we know the index sets are general and that we can change the indices */
+  for (i=0,cnt=0; i<nis; i++) {
+    ierr = ISGetLocalSize(is[i],&n);CHKERRQ(ierr);
+    ierr = ISGetIndices(is[i],(const PetscInt**)&idx);CHKERRQ(ierr);
+    ierr = PetscMemcpy(idx,ia+cnt,n*sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = ISRestoreIndices(is[i],(const PetscInt**)&idx);CHKERRQ(ierr);
+    /* updated cached values (sorted, min, max, etc.)*/
+    ierr = ISSetUp_General(is[i]);CHKERRQ(ierr);
+    cnt += n;
+  }
+  ierr = PetscFree(ia);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   AOPetscToApplicationISs - Maps several index sets in the PETSc ordering to
+   the application-defined ordering.
+
+   Collective on AO and IS
+
+   Input Parameters:
++  ao - the application ordering context
+.  nis - the number of index sets
+-  is - the index sets; these are replaced with their mapped values
+
+   Output Parameter:
+.  is - the mapped index sets
+
+   Level: intermediate
+
+   Notes:
+   This gives the same result as calling AOPetscToApplicationIS() for each index set but all of the index
+   sets are mapped at once; for AOMEMORYSCALABLE this needs one round of communication instead of one per index set.
+
+   The index sets cannot be of type stride or block
+
+.keywords: application ordering, mapping
+
+.seealso: AOPetscToApplicationIS(), AOApplicationToPetscISs(), AOPetscToApplication()
+@*/
+PetscErrorCode  AOPetscToApplicationISs(AO ao,PetscInt nis,IS is[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ao,AO_CLASSID,1);
+  if (nis) PetscValidPointer(is,3);
+  ierr = AOMapISs_Private(ao,nis,is,ao->ops->petsctoapplication);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   AOApplicationToPetscISs - Maps several index sets in the application-defined
+   ordering to the PETSc ordering.
+
+   Collective on AO and IS
+
+   Input Parameters:
++  ao - the application ordering context
+.  nis - the number of index sets
+-  is - the index sets; these are replaced with their mapped values
+
+   Output Parameter:
+.  is - the mapped index sets
+
+   Level: intermediate
+
+   Notes:
+   This gives the same result as calling AOApplicationToPetscIS() for each index set but all of the index
+   sets are mapped at once; for AOMEMORYSCALABLE this needs one round of communication instead of one per index set.
+
+   The index sets cannot be of type stride or block
+
+.keywords: application ordering, mapping
+
+.seealso: AOApplicationToPetscIS(), AOPetscToApplicationISs(), AOApplicationToPetsc()
+@*/
+PetscErrorCode  AOApplicationToPetscISs(AO ao,PetscInt nis,IS is[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ao,AO_CLASSID,1);
+  if (nis) PetscValidPointer(is,3);
+  ierr = AOMapISs_Private(ao,nis,is,ao->ops->applicationtopetsc);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
    AOPetscToApplication - Maps a set of integers in the PETSc ordering to
    the application-defined ordering.
@@ -0,0 +1,119 @@
+static char help[] = "Tests PetscParallelSortInt().\n\
+  -n <n> : the number of keys on the first process; process p has (p+1)*n keys\n\
+  -range <r> : the keys are in [-r,r]\n\n";
+
+#include <petscis.h>
+
+/* gathers the keys of all processes on the first process */
+static PetscErrorCode GatherKeys(PetscLayout map,const PetscInt keys[],PetscInt all[])
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    size,rank,p,n,*counts = NULL,*displs = NULL;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_size(map->comm,&size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(map->comm,&rank);CHKERRQ(ierr);
+  ierr = PetscMPIIntCast(map->n,&n);CHKERRQ(ierr);
+  if (!rank) {
+    ierr = PetscMalloc2(size,&counts,size,&displs);CHKERRQ(ierr);
+    for (p=0; p<size; p++) {
+      counts[p] = (PetscMPIInt)(map->range[p+1]-map->range[p]);
+      displs[p] = (PetscMPIInt)map->range[p];
+    }
+  }
+  ierr = MPI_Gatherv((void*)keys,n,MPIU_INT,all,counts,displs,MPIU_INT,0,map->comm);CHKERRQ(ierr);
+  if (!rank) {ierr = PetscFree2(counts,displs);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/* checks the parallel sort against PetscSortInt() of all the keys on the first process */
+static PetscErrorCode CheckSort(const char *name,PetscLayout mapin,PetscLayout mapout,const PetscInt keysin[],const PetscInt keysout[])
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    rank;
+  PetscInt       i,N = mapin->N,*ref = NULL,*sorted = NULL;
+  PetscBool      ok = PETSC_TRUE;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(mapin->comm,&rank);CHKERRQ(ierr);
+  if (!rank) {ierr = PetscMalloc2(N,&ref,N,&sorted);CHKERRQ(ierr);}
+  ierr = GatherKeys(mapin,keysin,ref);CHKERRQ(ierr);
+  ierr = GatherKeys(mapout,keysout,sorted);CHKERRQ(ierr);
+  if (!rank) {
+    ierr = PetscSortInt(N,ref);CHKERRQ(ierr);
+    for (i=0; i<N; i++) if (ref[i] != sorted[i]) {ok = PETSC_FALSE; break;}
+    if (ok) {
+      ierr = PetscPrintf(PETSC_COMM_SELF,"%s: %D keys sorted, from %D to %D\n",name,N,N ? sorted[0] : 0,N ? sorted[N-1] : 0);CHKERRQ(ierr);
+    } else {
+      ierr = PetscPrintf(PETSC_COMM_SELF,"%s: key %D is %D instead of %D\n",name,i,sorted[i],ref[i]);CHKERRQ(ierr);
+    }
+    ierr = PetscFree2(ref,sorted);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    rank;
+  PetscInt       n = 100,range = 1000,nlocal,i,*keysin,*keysout,*keys;
+  PetscLayout    mapin,mapout;
+  PetscRandom    rnd;
+  PetscReal      r;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-range",&range,NULL);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rnd);CHKERRQ(ierr);
+  ierr = PetscRandomSetSeed(rnd,(unsigned long)(rank+1));CHKERRQ(ierr);
+  ierr = PetscRandomSeed(rnd);CHKERRQ(ierr);
+  ierr = PetscRandomSetInterval(rnd,0.0,1.0);CHKERRQ(ierr);
+
+  /* the processes have different numbers of keys, the sorted keys are evenly distributed */
+  nlocal = (rank+1)*n;
+  ierr = PetscLayoutCreate(PETSC_COMM_WORLD,&mapin);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(mapin,nlocal);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(mapin);CHKERRQ(ierr);
+  ierr = PetscLayoutCreate(PETSC_COMM_WORLD,&mapout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(mapout,mapin->N);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(mapout);CHKERRQ(ierr);
+
+  ierr = PetscMalloc3(nlocal,&keysin,mapout->n,&keysout,nlocal,&keys);CHKERRQ(ierr);
+  for (i=0; i<nlocal; i++) {
+    ierr      = PetscRandomGetValueReal(rnd,&r);CHKERRQ(ierr);
+    keysin[i] = (PetscInt)(r*(2*range+1)) - range;
+  }
+  ierr = PetscParallelSortInt(mapin,mapout,keysin,keysout);CHKERRQ(ierr);
+  ierr = CheckSort("redistributed",mapin,mapout,keysin,keysout);CHKERRQ(ierr);
+
+  /* sort in place, the same number of keys stays on each process */
+  ierr = PetscMemcpy(keys,keysin,nlocal*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscParallelSortInt(mapin,mapin,keys,keys);CHKERRQ(ierr);
+  ierr = CheckSort("in place",mapin,mapin,keysin,keys);CHKERRQ(ierr);
+
+  ierr = PetscFree3(keysin,keysout,keys);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&mapin);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&mapout);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rnd);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      args: -n 10
+
+   test:
+      suffix: 2
+      nsize: 3
+      args: -n 500
+
+   test:
+      suffix: 3
+      nsize: 4
+      args: -n 2000 -range 3
+
+TEST*/
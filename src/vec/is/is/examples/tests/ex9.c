@@ -0,0 +1,168 @@
+static char help[] = "Tests ISINTERVAL index sets against ISGENERAL index sets with the same indices.\n\n";
+
+#include <petscis.h>
+#include <petscviewer.h>
+
+/* checks that an index set has the same local indices as a general index set, on every process */
+static PetscErrorCode CheckIS(const char *name,IS is,IS isg)
+{
+  PetscErrorCode ierr;
+  PetscInt       n,ng,N,Ng,i;
+  const PetscInt *idx,*idxg;
+  PetscBool      same,gsame;
+
+  PetscFunctionBegin;
+  ierr = ISGetLocalSize(is,&n);CHKERRQ(ierr);
+  ierr = ISGetLocalSize(isg,&ng);CHKERRQ(ierr);
+  ierr = ISGetSize(is,&N);CHKERRQ(ierr);
+  ierr = ISGetSize(isg,&Ng);CHKERRQ(ierr);
+  same = (PetscBool)(n == ng && N == Ng);
+  if (same) {
+    ierr = ISGetIndices(is,&idx);CHKERRQ(ierr);
+    ierr = ISGetIndices(isg,&idxg);CHKERRQ(ierr);
+    for (i=0; i<n; i++) if (idx[i] != idxg[i]) same = PETSC_FALSE;
+    ierr = ISRestoreIndices(is,&idx);CHKERRQ(ierr);
+    ierr = ISRestoreIndices(isg,&idxg);CHKERRQ(ierr);
+  }
+  ierr = MPIU_Allreduce(&same,&gsame,1,MPIU_BOOL,MPI_LAND,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"%-12s %s size %D\n",name,gsame ? "ok" : "differs",N);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* checks ISLocate() for every key in [lo,hi) */
+static PetscErrorCode CheckLocate(IS is,IS isg,PetscInt lo,PetscInt hi)
+{
+  PetscErrorCode ierr;
+  PetscInt       key,loc,locg;
+  PetscBool      same = PETSC_TRUE,gsame;
+
+  PetscFunctionBegin;
+  for (key=lo; key<hi; key++) {
+    ierr = ISLocate(is,key,&loc);CHKERRQ(ierr);
+    ierr = ISLocate(isg,key,&locg);CHKERRQ(ierr);
+    if ((loc < 0) != (locg < 0)) same = PETSC_FALSE;
+  }
+  ierr = MPIU_Allreduce(&same,&gsame,1,MPIU_BOOL,MPI_LAND,PetscObjectComm((PetscObject)is));CHKERRQ(ierr);
+  ierr = PetscPrintf(PetscObjectComm((PetscObject)is),"%-12s %s\n","locate",gsame ? "ok" : "differs");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    rank;
+  PetscInt       i,o,n;
+  /* sorted and disjoint */
+  PetscInt       s1[] = {0,10,12,30},l1[] = {5,1,6,3};
+  /* unsorted and overlapping */
+  PetscInt       s2[] = {20,3,14,4,-2},l2[] = {4,8,2,2,3};
+  /* unsorted and disjoint */
+  PetscInt       s3[] = {25,2,11},l3[] = {3,6,4};
+  PetscInt       *idx;
+  IS             is1,is2,is3,isg1,isg2,isg3,r,rg,s,sg,sum,sumg;
+  PetscBool      flg;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+
+  /* every process has the same intervals shifted by 40*rank */
+  o = 40*rank;
+  for (i=0; i<4; i++) s1[i] += o;
+  for (i=0; i<5; i++) s2[i] += o;
+  for (i=0; i<3; i++) s3[i] += o;
+  ierr = ISCreateInterval(PETSC_COMM_WORLD,4,s1,l1,&is1);CHKERRQ(ierr);
+  ierr = ISCreateInterval(PETSC_COMM_WORLD,5,s2,l2,&is2);CHKERRQ(ierr);
+  ierr = ISCreateInterval(PETSC_COMM_WORLD,3,s3,l3,&is3);CHKERRQ(ierr);
+  ierr = ISDuplicate(is1,&isg1);CHKERRQ(ierr);
+  ierr = ISToGeneral(isg1);CHKERRQ(ierr);
+  ierr = ISDuplicate(is2,&isg2);CHKERRQ(ierr);
+  ierr = ISToGeneral(isg2);CHKERRQ(ierr);
+  ierr = ISDuplicate(is3,&isg3);CHKERRQ(ierr);
+  ierr = ISToGeneral(isg3);CHKERRQ(ierr);
+  ierr = ISView(is2,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+
+  ierr = CheckIS("indices",is2,isg2);CHKERRQ(ierr);
+  ierr = CheckLocate(is1,isg1,o-3,o+40);CHKERRQ(ierr);
+  ierr = CheckLocate(is2,isg2,o-3,o+40);CHKERRQ(ierr);
+  ierr = CheckLocate(is3,isg3,o-3,o+40);CHKERRQ(ierr);
+
+  /* set operations on the intervals, the results are compared with the ones of the general index sets */
+  ierr = ISDifference(is2,is1,&r);CHKERRQ(ierr);
+  ierr = ISDifference(isg2,isg1,&rg);CHKERRQ(ierr);
+  ierr = CheckIS("difference",r,rg);CHKERRQ(ierr);
+  ierr = ISDestroy(&r);CHKERRQ(ierr);
+  ierr = ISDestroy(&rg);CHKERRQ(ierr);
+  ierr = ISDifference(is1,is3,&r);CHKERRQ(ierr);
+  ierr = ISDifference(isg1,isg3,&rg);CHKERRQ(ierr);
+  ierr = CheckIS("difference",r,rg);CHKERRQ(ierr);
+  ierr = ISDestroy(&r);CHKERRQ(ierr);
+  ierr = ISDestroy(&rg);CHKERRQ(ierr);
+
+  ierr = ISExpand(is1,is3,&r);CHKERRQ(ierr);
+  ierr = ISExpand(isg1,isg3,&rg);CHKERRQ(ierr);
+  ierr = CheckIS("expand",r,rg);CHKERRQ(ierr);
+  ierr = ISDestroy(&r);CHKERRQ(ierr);
+  ierr = ISDestroy(&rg);CHKERRQ(ierr);
+  ierr = ISExpand(is3,is2,&r);CHKERRQ(ierr);
+  ierr = ISExpand(isg3,isg2,&rg);CHKERRQ(ierr);
+  ierr = CheckIS("expand",r,rg);CHKERRQ(ierr);
+  ierr = ISDestroy(&r);CHKERRQ(ierr);
+  ierr = ISDestroy(&rg);CHKERRQ(ierr);
+
+  ierr = ISSort(is3);CHKERRQ(ierr);
+  ierr = ISSort(isg3);CHKERRQ(ierr);
+  ierr = CheckIS("sort",is3,isg3);CHKERRQ(ierr);
+  /* ISSum() is only for sequential index sets */
+  ierr = ISOnComm(is1,PETSC_COMM_SELF,PETSC_COPY_VALUES,&s);CHKERRQ(ierr);
+  ierr = ISOnComm(isg1,PETSC_COMM_SELF,PETSC_COPY_VALUES,&sg);CHKERRQ(ierr);
+  ierr = ISOnComm(is3,PETSC_COMM_SELF,PETSC_COPY_VALUES,&r);CHKERRQ(ierr);
+  ierr = ISOnComm(isg3,PETSC_COMM_SELF,PETSC_COPY_VALUES,&rg);CHKERRQ(ierr);
+  ierr = ISSum(s,r,&sum);CHKERRQ(ierr);
+  ierr = ISSum(sg,rg,&sumg);CHKERRQ(ierr);
+  ierr = CheckIS("sum",sum,sumg);CHKERRQ(ierr);
+  ierr = ISDestroy(&sum);CHKERRQ(ierr);
+  ierr = ISDestroy(&sumg);CHKERRQ(ierr);
+  ierr = ISDestroy(&s);CHKERRQ(ierr);
+  ierr = ISDestroy(&sg);CHKERRQ(ierr);
+  ierr = ISDestroy(&r);CHKERRQ(ierr);
+  ierr = ISDestroy(&rg);CHKERRQ(ierr);
+
+  ierr = ISSort(is2);CHKERRQ(ierr);
+  ierr = ISSort(isg2);CHKERRQ(ierr);
+  ierr = CheckIS("sort",is2,isg2);CHKERRQ(ierr);
+  ierr = ISSortRemoveDups(is2);CHKERRQ(ierr);
+  ierr = ISSortRemoveDups(isg2);CHKERRQ(ierr);
+  ierr = CheckIS("removedups",is2,isg2);CHKERRQ(ierr);
+  ierr = ISView(is2,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+
+  /* encode an explicit list */
+  n    = 10;
+  ierr = PetscMalloc1(n,&idx);CHKERRQ(ierr);
+  for (i=0; i<n; i++) idx[i] = o + (i < 6 ? i : 2*i);
+  ierr = ISIntervalSetIndices(is1,n,idx);CHKERRQ(ierr);
+  ierr = ISDestroy(&isg1);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PETSC_COMM_WORLD,n,idx,PETSC_OWN_POINTER,&isg1);CHKERRQ(ierr);
+  ierr = CheckIS("setindices",is1,isg1);CHKERRQ(ierr);
+  ierr = ISIntervalGetIntervals(is1,&n,NULL,NULL);CHKERRQ(ierr);
+  ierr = ISSorted(is1,&flg);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"%D intervals sorted %d\n",n,(int)flg);CHKERRQ(ierr);
+
+  ierr = ISDestroy(&is1);CHKERRQ(ierr);
+  ierr = ISDestroy(&is2);CHKERRQ(ierr);
+  ierr = ISDestroy(&is3);CHKERRQ(ierr);
+  ierr = ISDestroy(&isg1);CHKERRQ(ierr);
+  ierr = ISDestroy(&isg2);CHKERRQ(ierr);
+  ierr = ISDestroy(&isg3);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+
+   test:
+      suffix: 2
+      nsize: 2
+
+TEST*/
@@ -0,0 +1,799 @@
+/*
+       Index sets stored as a list of intervals of consecutive integers,
+    each given by its first index and its length.
+*/
+#include <petsc/private/isimpl.h>             /*I   "petscis.h"   I*/
+#include <petscviewer.h>
+
+typedef struct {
+  PetscInt  nr;        /* number of intervals */
+  PetscInt  *start;    /* first index of each interval */
+  PetscInt  *off;      /* interval r holds the entries off[r] to off[r+1]-1 of the index set */
+  PetscInt  *sstart;   /* if the intervals are not sorted, their starts in increasing order */
+  PetscInt  *sperm;    /* the interval that starts at sstart[r] */
+  PetscBool sorted;    /* the indices are nondecreasing */
+  PetscBool disjoint;  /* no index appears more than once */
+} IS_Interval;
+
+#define ISIntervalLen(sub,r) ((sub)->off[(r)+1]-(sub)->off[r])
+
+/*
+   Stores the intervals, dropping empty ones and merging an interval into the previous one when it continues it,
+   then determines the bounds and whether the set is sorted and disjoint. The layout is not changed, since that
+   is collective; callers that change the number of indices use ISIntervalSetUpLayout_Private().
+*/
+static PetscErrorCode ISIntervalSetIntervals_Private(IS is,PetscInt nr,const PetscInt start[],const PetscInt len[])
+{
+  IS_Interval    *sub = (IS_Interval*)is->data;
+  PetscInt       r,m,last = 0,*s,*o,min = PETSC_MAX_INT,max = PETSC_MIN_INT;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (r=0,m=0; r<nr; r++) {
+    if (len[r] < 0) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Interval %D has negative length %D",r,len[r]);
+    if (!len[r]) continue;
+    if (!m || start[r] != last) m++;
+    last = start[r] + len[r];
+  }
+  ierr = PetscMalloc2(m,&s,m+1,&o);CHKERRQ(ierr);
+  o[0] = 0;
+  for (r=0,m=0; r<nr; r++) {
+    if (!len[r]) continue;
+    if (m && s[m-1]+(o[m]-o[m-1]) == start[r]) {
+      o[m] += len[r];
+    } else {
+      s[m]   = start[r];
+      o[m+1] = o[m] + len[r];
+      m++;
+    }
+    min = PetscMin(min,start[r]);
+    max = PetscMax(max,start[r]+len[r]-1);
+  }
+  ierr = PetscFree2(sub->start,sub->off);CHKERRQ(ierr);
+  ierr = PetscFree2(sub->sstart,sub->sperm);CHKERRQ(ierr);
+  sub->nr    = m;
+  sub->start = s;
+  sub->off   = o;
+
+  is->min        = min;
+  is->max        = max;
+  is->isperm     = PETSC_FALSE;
+  is->isidentity = PETSC_FALSE;
+
+  sub->sorted = sub->disjoint = PETSC_TRUE;
+  for (r=1; r<m; r++) {
+    if (s[r] < s[r-1]+ISIntervalLen(sub,r-1)-1) sub->sorted = PETSC_FALSE;
+    if (s[r] < s[r-1]+ISIntervalLen(sub,r-1)) sub->disjoint = PETSC_FALSE;
+  }
+  if (!sub->sorted) {
+    /* order the intervals by their start so that ISLocate() can use bisection */
+    ierr = PetscMalloc2(m,&sub->sstart,m,&sub->sperm);CHKERRQ(ierr);
+    for (r=0; r<m; r++) {
+      sub->sstart[r] = s[r];
+      sub->sperm[r]  = r;
+    }
+    ierr = PetscSortIntWithArray(m,sub->sstart,sub->sperm);CHKERRQ(ierr);
+    sub->disjoint = PETSC_TRUE;
+    for (r=1; r<m; r++) {
+      if (sub->sstart[r] < sub->sstart[r-1]+ISIntervalLen(sub,sub->sperm[r-1])) {sub->disjoint = PETSC_FALSE; break;}
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ISIntervalSetUpLayout_Private(IS is)
+{
+  IS_Interval    *sub = (IS_Interval*)is->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLayoutSetLocalSize(is->map,sub->off[sub->nr]);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(is->map,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(is->map);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* stores the runs of consecutive integers of the list */
+static PetscErrorCode ISIntervalSetIndices_Private(IS is,PetscInt n,const PetscInt idx[])
+{
+  PetscInt       i,nr = 0,*s,*len;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) if (!i || idx[i] != idx[i-1]+1) nr++;
+  ierr = PetscMalloc2(nr,&s,nr,&len);CHKERRQ(ierr);
+  for (i=0,nr=0; i<n; i++) {
+    if (!i || idx[i] != idx[i-1]+1) {
+      s[nr]   = idx[i];
+      len[nr] = 0;
+      nr++;
+    }
+    len[nr-1]++;
+  }
+  ierr = ISIntervalSetIntervals_Private(is,nr,s,len);CHKERRQ(ierr);
+  ierr = PetscFree2(s,len);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* the lengths of the intervals, to be freed by the caller */
+static PetscErrorCode ISIntervalGetLengths_Private(IS_Interval *sub,PetscInt **len)
+{
+  PetscInt       r;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(sub->nr,len);CHKERRQ(ierr);
+  for (r=0; r<sub->nr; r++) (*len)[r] = ISIntervalLen(sub,r);
+  PetscFunctionReturn(0);
+}
+
+/*
+   The nonnegative indices of the set as a sorted list of disjoint, nonadjacent intervals [us[i],ue[i]), to be freed with PetscFree2()
+*/
+static PetscErrorCode ISIntervalGetUnion_Private(IS_Interval *sub,PetscInt *nu,PetscInt **us,PetscInt **ue)
+{
+  PetscInt       i,r,m = 0,s,e;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc2(sub->nr,us,sub->nr,ue);CHKERRQ(ierr);
+  for (i=0; i<sub->nr; i++) {
+    r = sub->sorted ? i : sub->sperm[i];
+    s = PetscMax(sub->start[r],0);
+    e = sub->start[r]+ISIntervalLen(sub,r);
+    if (e <= s) continue;
+    if (m && s <= (*ue)[m-1]) {
+      (*ue)[m-1] = PetscMax((*ue)[m-1],e);
+    } else {
+      (*us)[m] = s;
+      (*ue)[m] = e;
+      m++;
+    }
+  }
+  *nu = m;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ISGetSize_Interval(IS is,PetscInt *size)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLayoutGetSize(is->map,size);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ISGetLocalSize_Interval(IS is,PetscInt *size)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLayoutGetLocalSize(is->map,size);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+     The indices are only created when requested, they are freed again by ISRestoreIndices()
+*/
+static PetscErrorCode ISGetIndices_Interval(IS is,const PetscInt *idx[])
+{
+  IS_Interval    *sub = (IS_Interval*)is->data;
+  PetscInt       r,i,s,*dx;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(sub->off[sub->nr],&dx);CHKERRQ(ierr);
+  for (r=0; r<sub->nr; r++) {
+    s = sub->start[r] - sub->off[r];
+    for (i=sub->off[r]; i<sub->off[r+1]; i++) dx[i] = s + i;
+  }
+  *idx = dx;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ISRestoreIndices_Interval(IS is,const PetscInt *idx[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(*(void**)idx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ISInvertPermutation_Interval(IS is,PetscInt nlocal,IS *perm)
+{
+  IS             tmp;
+  const PetscInt *indices;
+  PetscInt       n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = ISGetLocalSize(is,&n);CHKERRQ(ierr);
+  ierr = ISGetIndices(is,&indices);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PetscObjectComm((PetscObject)is),n,indices,PETSC_COPY_VALUES,&tmp);CHKERRQ(ierr);
+  ierr = ISSetPermutation(tmp);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(is,&indices);CHKERRQ(ierr);
+  ierr = ISInvertPermutation(tmp,nlocal,perm);CHKERRQ(ierr);
+  ierr = ISDestroy(&tmp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ISSort_Interval(IS is)
+{
+  IS_Interval    *sub = (IS_Interval*)is->data;
+  PetscInt       r,n,*s,*len,*idx;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (sub->sorted) PetscFunctionReturn(0);
+  if (sub->disjoint) {
+    /* sorting the intervals sorts the indices */
+    ierr = PetscMalloc2(sub->nr,&s,sub->nr,&len);CHKERRQ(ierr);
+    for (r=0; r<sub->nr; r++) {
+      s[r]   = sub->sstart[r];
+      len[r] = ISIntervalLen(sub,sub->sperm[r]);
+    }
+    ierr = ISIntervalSetIntervals_Private(is,sub->nr,s,len);CHKERRQ(ierr);
+    ierr = PetscFree2(s,len);CHKERRQ(ierr);
+  } else {
+    /* overlapping intervals are split by the sort; encode the sorted indices again */
+    ierr = ISGetLocalSize(is,&n);CHKERRQ(ierr);
+    ierr = ISGetIndices(is,(const PetscInt**)&idx);CHKERRQ(ierr);
+    ierr = PetscSortInt(n,idx);CHKERRQ(ierr);
+    ierr = ISIntervalSetIndices_Private(is,n,idx);CHKERRQ(ierr);
+    ierr = PetscFree(idx);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ISSortRemoveDups_Interval(IS is)
+{
+  IS_Interval    *sub = (IS_Interval*)is->data;
+  PetscInt       r,q,m = 0,s,e,*us,*len;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!sub->sorted || !sub->disjoint) {
+    /* the union of the intervals, unlike ISIntervalGetUnion_Private() keeping negative indices */
+    ierr = PetscMalloc2(sub->nr,&us,sub->nr,&len);CHKERRQ(ierr);
+    for (r=0; r<sub->nr; r++) {
+      q = sub->sorted ? r : sub->sperm[r];
+      s = sub->start[q];
+      e = s + ISIntervalLen(sub,q);
+      if (m && s <= us[m-1]+len[m-1]) {
+        len[m-1] = PetscMax(us[m-1]+len[m-1],e) - us[m-1];
+      } else {
+        us[m]  = s;
+        len[m] = e - s;
+        m++;
+      }
+    }
+    ierr = ISIntervalSetIntervals_Private(is,m,us,len);CHKERRQ(ierr);
+    ierr = PetscFree2(us,len);CHKERRQ(ierr);
+  }
+  ierr = ISIntervalSetUpLayout_Private(is);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ISSorted_Interval(IS is,PetscBool *flg)
+{
+  IS_Interval *sub = (IS_Interval*)is->data;
+
+  PetscFunctionBegin;
+  *flg = sub->sorted;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ISDuplicate_Interval(IS is,IS *newIS)
+{
+  IS_Interval    *sub = (IS_Interval*)is->data;
+  PetscInt       *len;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = ISIntervalGetLengths_Private(sub,&len);CHKERRQ(ierr);
+  ierr = ISCreateInterval(PetscObjectComm((PetscObject)is),sub->nr,sub->start,len,newIS);CHKERRQ(ierr);
+  ierr = PetscFree(len);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ISDestroy_Interval(IS is)
+{
+  IS_Interval    *sub = (IS_Interval*)is->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree2(sub->start,sub->off);CHKERRQ(ierr);
+  ierr = PetscFree2(sub->sstart,sub->sperm);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)is,"ISIntervalSetIntervals_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)is,"ISIntervalSetIndices_C",NULL);CHKERRQ(ierr);
+  ierr = PetscFree(is->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ISView_Interval(IS is,PetscViewer viewer)
+{
+  IS_Interval       *sub = (IS_Interval*)is->data;
+  PetscInt          r,n = sub->off[sub->nr];
+  PetscMPIInt       rank,size;
+  PetscBool         iascii;
+  PetscViewerFormat fmt;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  ierr = PetscViewerGetFormat(viewer,&fmt);CHKERRQ(ierr);
+  if (iascii && fmt != PETSC_VIEWER_ASCII_MATLAB) {
+    ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)is),&rank);CHKERRQ(ierr);
+    ierr = MPI_Comm_size(PetscObjectComm((PetscObject)is),&size);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPushSynchronized(viewer);CHKERRQ(ierr);
+    if (size > 1) {
+      ierr = PetscViewerASCIISynchronizedPrintf(viewer,"[%d] Number of indices in (interval) set %D in %D intervals\n",rank,n,sub->nr);CHKERRQ(ierr);
+      for (r=0; r<sub->nr; r++) {
+        ierr = PetscViewerASCIISynchronizedPrintf(viewer,"[%d] %D %D : %D\n",rank,sub->off[r],sub->start[r],sub->start[r]+ISIntervalLen(sub,r)-1);CHKERRQ(ierr);
+      }
+    } else {
+      ierr = PetscViewerASCIISynchronizedPrintf(viewer,"Number of indices in (interval) set %D in %D intervals\n",n,sub->nr);CHKERRQ(ierr);
+      for (r=0; r<sub->nr; r++) {
+        ierr = PetscViewerASCIISynchronizedPrintf(viewer,"%D %D : %D\n",sub->off[r],sub->start[r],sub->start[r]+ISIntervalLen(sub,r)-1);CHKERRQ(ierr);
+      }
+    }
+    ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPopSynchronized(viewer);CHKERRQ(ierr);
+  } else {
+    /* other viewers get the explicit indices, so the result can be loaded as an ISGENERAL */
+    IS             is_general;
+    const PetscInt *idx;
+    const char     *name;
+
+    ierr = ISGetIndices(is,&idx);CHKERRQ(ierr);
+    ierr = ISCreateGeneral(PetscObjectComm((PetscObject)is),n,idx,PETSC_USE_POINTER,&is_general);CHKERRQ(ierr);
+    ierr = PetscObjectGetName((PetscObject)is,&name);CHKERRQ(ierr);
+    ierr = PetscObjectSetName((PetscObject)is_general,name);CHKERRQ(ierr);
+    ierr = ISView(is_general,viewer);CHKERRQ(ierr);
+    ierr = ISDestroy(&is_general);CHKERRQ(ierr);
+    ierr = ISRestoreIndices(is,&idx);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ISIdentity_Interval(IS is,PetscBool *ident)
+{
+  IS_Interval *sub = (IS_Interval*)is->data;
+
+  PetscFunctionBegin;
+  *ident         = (PetscBool)(!sub->nr || (sub->nr == 1 && !sub->start[0]));
+  is->isidentity = *ident;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ISCopy_Interval(IS is,IS isy)
+{
+  IS_Interval    *sub = (IS_Interval*)is->data;
+  PetscInt       n,N,ny,Ny,*len;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)isy,ISINTERVAL,&flg);CHKERRQ(ierr);
+  if (!flg) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"Index sets must both be of type ISINTERVAL");
+  ierr = PetscLayoutGetLocalSize(is->map,&n);CHKERRQ(ierr);
+  ierr = PetscLayoutGetSize(is->map,&N);CHKERRQ(ierr);
+  ierr = PetscLayoutGetLocalSize(isy->map,&ny);CHKERRQ(ierr);
+  ierr = PetscLayoutGetSize(isy->map,&Ny);CHKERRQ(ierr);
+  if (n != ny || N != Ny) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"Index sets incompatible");
+  ierr = ISIntervalGetLengths_Private(sub,&len);CHKERRQ(ierr);
+  ierr = ISIntervalSetIntervals_Private(isy,sub->nr,sub->start,len);CHKERRQ(ierr);
+  ierr = PetscFree(len);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ISToGeneral_Interval(IS is)
+{
+  const PetscInt *idx;
+  PetscInt       n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = ISGetLocalSize(is,&n);CHKERRQ(ierr);
+  ierr = ISGetIndices(is,&idx);CHKERRQ(ierr);
+  ierr = ISSetType(is,ISGENERAL);CHKERRQ(ierr);
+  ierr = ISGeneralSetIndices(is,n,idx,PETSC_OWN_POINTER);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ISOnComm_Interval(IS is,MPI_Comm comm,PetscCopyMode mode,IS *newis)
+{
+  IS_Interval    *sub = (IS_Interval*)is->data;
+  PetscInt       *len;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = ISIntervalGetLengths_Private(sub,&len);CHKERRQ(ierr);
+  ierr = ISCreateInterval(comm,sub->nr,sub->start,len,newis);CHKERRQ(ierr);
+  ierr = PetscFree(len);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ISSetBlockSize_Interval(IS is,PetscInt bs)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLayoutSetBlockSize(is->map,bs);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ISContiguousLocal_Interval(IS is,PetscInt gstart,PetscInt gend,PetscInt *start,PetscBool *contig)
+{
+  IS_Interval *sub = (IS_Interval*)is->data;
+
+  PetscFunctionBegin;
+  if (!sub->nr) {
+    *start  = 0;
+    *contig = PETSC_TRUE;
+  } else if (sub->nr == 1 && sub->start[0] >= gstart && sub->start[0]+sub->off[1] <= gend) {
+    *start  = sub->start[0] - gstart;
+    *contig = PETSC_TRUE;
+  } else {
+    *start  = -1;
+    *contig = PETSC_FALSE;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+     Bisection over the intervals ordered by their start; when intervals overlap the key can be in an interval
+   that starts before the one found, so those sets are searched linearly.
+*/
+static PetscErrorCode ISLocate_Interval(IS is,PetscInt key,PetscInt *location)
+{
+  IS_Interval    *sub = (IS_Interval*)is->data;
+  const PetscInt *s = sub->sorted ? sub->start : sub->sstart;
+  PetscInt       lo = 0,hi = sub->nr,mid,r;
+
+  PetscFunctionBegin;
+  *location = -1;
+  if (!sub->nr || key < is->min || key > is->max) PetscFunctionReturn(0);
+  if (sub->sorted || sub->disjoint) {
+    while (hi - lo > 1) {
+      mid = (lo + hi)/2;
+      if (key < s[mid]) hi = mid;
+      else lo = mid;
+    }
+    r = sub->sorted ? lo : sub->sperm[lo];
+    if (key >= sub->start[r] && key < sub->start[r]+ISIntervalLen(sub,r)) *location = sub->off[r] + key - sub->start[r];
+  } else {
+    for (r=0; r<sub->nr; r++) {
+      if (key >= sub->start[r] && key < sub->start[r]+ISIntervalLen(sub,r)) {
+        *location = sub->off[r] + key - sub->start[r];
+        break;
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static struct _ISOps myops = { ISGetSize_Interval,
+                               ISGetLocalSize_Interval,
+                               ISGetIndices_Interval,
+                               ISRestoreIndices_Interval,
+                               ISInvertPermutation_Interval,
+                               ISSort_Interval,
+                               ISSortRemoveDups_Interval,
+                               ISSorted_Interval,
+                               ISDuplicate_Interval,
+                               ISDestroy_Interval,
+                               ISView_Interval,
+                               ISLoad_Default,
+                               ISIdentity_Interval,
+                               ISCopy_Interval,
+                               ISToGeneral_Interval,
+                               ISOnComm_Interval,
+                               ISSetBlockSize_Interval,
+                               ISContiguousLocal_Interval,
+                               ISLocate_Interval};
+
+/*
+   The set operations of isdiff.c for two ISINTERVAL; they work on the intervals and never create the indices
+*/
+PetscErrorCode ISDifference_Interval(IS is1,IS is2,IS *isout)
+{
+  PetscInt       n1,n2,i1,i2,m = 0,s,e,*u1s,*u1e,*u2s,*u2e,*os,*ol;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = ISIntervalGetUnion_Private((IS_Interval*)is1->data,&n1,&u1s,&u1e);CHKERRQ(ierr);
+  ierr = ISIntervalGetUnion_Private((IS_Interval*)is2->data,&n2,&u2s,&u2e);CHKERRQ(ierr);
+  /* every interval of is2 splits at most one interval of is1 into two */
+  ierr = PetscMalloc2(n1+n2,&os,n1+n2,&ol);CHKERRQ(ierr);
+  for (i1=0,i2=0; i1<n1; i1++) {
+    s = u1s[i1];
+    e = u1e[i1];
+    while (i2 < n2 && u2e[i2] <= s) i2++;
+    while (i2 < n2 && u2s[i2] < e) {
+      if (u2s[i2] > s) {os[m] = s; ol[m] = u2s[i2] - s; m++;}
+      s = PetscMax(s,u2e[i2]);
+      if (u2e[i2] > e) break;
+      i2++;
+    }
+    if (s < e) {os[m] = s; ol[m] = e - s; m++;}
+  }
+  ierr = ISCreateInterval(PetscObjectComm((PetscObject)is1),m,os,ol,isout);CHKERRQ(ierr);
+  ierr = PetscFree2(os,ol);CHKERRQ(ierr);
+  ierr = PetscFree2(u1s,u1e);CHKERRQ(ierr);
+  ierr = PetscFree2(u2s,u2e);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* only handles sets without repeated indices, otherwise flg is PETSC_FALSE and the caller uses the indices */
+PetscErrorCode ISSum_Interval(IS is1,IS is2,PetscBool *flg,IS *is3)
+{
+  IS_Interval    *sub1 = (IS_Interval*)is1->data,*sub2 = (IS_Interval*)is2->data;
+  PetscInt       i1,i2,m = 0,s,e,*os,*ol;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *flg = (PetscBool)(sub1->disjoint && sub2->disjoint);
+  if (!*flg) PetscFunctionReturn(0);
+  ierr = PetscMalloc2(sub1->nr+sub2->nr,&os,sub1->nr+sub2->nr,&ol);CHKERRQ(ierr);
+  for (i1=0,i2=0; i1<sub1->nr || i2<sub2->nr;) {
+    if (i2 == sub2->nr || (i1 < sub1->nr && sub1->start[i1] <= sub2->start[i2])) {
+      s = sub1->start[i1]; e = s + ISIntervalLen(sub1,i1); i1++;
+    } else {
+      s = sub2->start[i2]; e = s + ISIntervalLen(sub2,i2); i2++;
+    }
+    if (m && s <= os[m-1]+ol[m-1]) {
+      ol[m-1] = PetscMax(os[m-1]+ol[m-1],e) - os[m-1];
+    } else {
+      os[m] = s; ol[m] = e - s; m++;
+    }
+  }
+  ierr = ISCreateInterval(PetscObjectComm((PetscObject)is1),m,os,ol,is3);CHKERRQ(ierr);
+  ierr = PetscFree2(os,ol);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* only handles sets without repeated indices, otherwise flg is PETSC_FALSE and the caller uses the indices */
+PetscErrorCode ISExpand_Interval(IS is1,IS is2,PetscBool *flg,IS *isout)
+{
+  IS_Interval    *sub1 = (IS_Interval*)is1->data,*sub2 = (IS_Interval*)is2->data;
+  PetscInt       r,n1,i,lo,hi,mid,m = 0,s,e,*u1s,*u1e,*os,*ol;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *flg = (PetscBool)(sub1->disjoint && sub2->disjoint);
+  if (!*flg) PetscFunctionReturn(0);
+  ierr = ISIntervalGetUnion_Private(sub1,&n1,&u1s,&u1e);CHKERRQ(ierr);
+  ierr = PetscMalloc2(sub1->nr+n1+sub2->nr,&os,sub1->nr+n1+sub2->nr,&ol);CHKERRQ(ierr);
+  /* is1 in its own order without the negative indices */
+  for (r=0; r<sub1->nr; r++) {
+    s = PetscMax(sub1->start[r],0);
+    e = sub1->start[r] + ISIntervalLen(sub1,r);
+    if (s < e) {os[m] = s; ol[m] = e - s; m++;}
+  }
+  /* then each interval of is2 without the indices of is1 */
+  for (r=0; r<sub2->nr; r++) {
+    s = PetscMax(sub2->start[r],0);
+    e = sub2->start[r] + ISIntervalLen(sub2,r);
+    if (s >= e) continue;
+    /* first interval of is1 that ends after s */
+    lo = 0; hi = n1;
+    while (lo < hi) {
+      mid = (lo + hi)/2;
+      if (u1e[mid] <= s) lo = mid + 1;
+      else hi = mid;
+    }
+    for (i=lo; i<n1 && u1s[i] < e; i++) {
+      if (u1s[i] > s) {os[m] = s; ol[m] = u1s[i] - s; m++;}
+      s = u1e[i];
+      if (s >= e) break;
+    }
+    if (s < e) {os[m] = s; ol[m] = e - s; m++;}
+  }
+  ierr = ISCreateInterval(PetscObjectComm((PetscObject)is1),m,os,ol,isout);CHKERRQ(ierr);
+  ierr = PetscFree2(os,ol);CHKERRQ(ierr);
+  ierr = PetscFree2(u1s,u1e);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   ISIntervalGetIntervals - Returns the intervals of an ISINTERVAL index set
+
+   Not Collective
+
+   Input Parameter:
+.  is - the index set
+
+   Output Parameters:
++  nr - the number of intervals
+.  start - the first index of each interval
+-  off - interval r holds the entries off[r] to off[r+1]-1 of the index set, so off[r+1]-off[r] is its length (nr+1 entries)
+
+   Notes:
+   The arrays are owned by the index set and must not be changed. Empty intervals are dropped and an
+   interval that continues the previous one is merged with it, so nr may be smaller than the number of intervals
+   that were set.
+
+   Level: intermediate
+
+   Concepts: index sets^intervals
+   Concepts: IS^intervals
+
+.seealso: ISCreateInterval(), ISIntervalSetIntervals(), ISLocate()
+@*/
+PetscErrorCode ISIntervalGetIntervals(IS is,PetscInt *nr,const PetscInt *start[],const PetscInt *off[])
+{
+  IS_Interval    *sub;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(is,IS_CLASSID,1);
+  ierr = PetscObjectTypeCompare((PetscObject)is,ISINTERVAL,&flg);CHKERRQ(ierr);
+  if (!flg) SETERRQ(PetscObjectComm((PetscObject)is),PETSC_ERR_ARG_WRONG,"IS must be of type ISINTERVAL");
+  sub = (IS_Interval*)is->data;
+  if (nr)    *nr    = sub->nr;
+  if (start) *start = sub->start;
+  if (off)   *off   = sub->off;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ISIntervalSetIntervals_Interval(IS is,PetscInt nr,const PetscInt start[],const PetscInt len[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = ISIntervalSetIntervals_Private(is,nr,start,len);CHKERRQ(ierr);
+  ierr = ISIntervalSetUpLayout_Private(is);CHKERRQ(ierr);
+  ierr = ISViewFromOptions(is,NULL,"-is_view");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ISIntervalSetIndices_Interval(IS is,PetscInt n,const PetscInt idx[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = ISIntervalSetIndices_Private(is,n,idx);CHKERRQ(ierr);
+  ierr = ISIntervalSetUpLayout_Private(is);CHKERRQ(ierr);
+  ierr = ISViewFromOptions(is,NULL,"-is_view");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   ISIntervalSetIntervals - Sets the intervals of an ISINTERVAL index set
+
+   Collective on IS
+
+   Input Parameters:
++  is - the index set
+.  nr - the number of intervals
+.  start - the first index of each interval
+-  len - the length of each interval
+
+   Notes:
+   The index set holds start[0], start[0]+1, ..., start[0]+len[0]-1, start[1], ... in this order.
+   The arrays are copied.
+
+   Level: intermediate
+
+   Concepts: index sets^intervals
+   Concepts: IS^intervals
+
+.seealso: ISCreateInterval(), ISIntervalSetIndices(), ISIntervalGetIntervals()
+@*/
+PetscErrorCode ISIntervalSetIntervals(IS is,PetscInt nr,const PetscInt start[],const PetscInt len[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(is,IS_CLASSID,1);
+  if (nr < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Negative number of intervals %D",nr);
+  if (nr) {
+    PetscValidIntPointer(start,3);
+    PetscValidIntPointer(len,4);
+  }
+  ierr = PetscUseMethod(is,"ISIntervalSetIntervals_C",(IS,PetscInt,const PetscInt[],const PetscInt[]),(is,nr,start,len));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   ISIntervalSetIndices - Sets the indices of an ISINTERVAL index set from an explicit list, which is stored
+   as the runs of consecutive integers it contains
+
+   Collective on IS
+
+   Input Parameters:
++  is - the index set
+.  n - the number of indices
+-  idx - the indices
+
+   Notes:
+   The list is not kept, the memory used by the index set is proportional to the number of runs in it.
+
+   Level: intermediate
+
+   Concepts: index sets^intervals
+   Concepts: IS^intervals
+
+.seealso: ISCreateInterval(), ISIntervalSetIntervals(), ISCreateGeneral()
+@*/
+PetscErrorCode ISIntervalSetIndices(IS is,PetscInt n,const PetscInt idx[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(is,IS_CLASSID,1);
+  if (n < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Negative length %D",n);
+  if (n) PetscValidIntPointer(idx,3);
+  ierr = PetscUseMethod(is,"ISIntervalSetIndices_C",(IS,PetscInt,const PetscInt[]),(is,n,idx));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   ISCreateInterval - Creates a data structure for an index set made of intervals of
+   consecutive integers
+
+   Collective on MPI_Comm
+
+   Input Parameters:
++  comm - the MPI communicator
+.  nr - the number of locally owned intervals
+.  start - the first index of each interval
+-  len - the length of each interval
+
+   Output Parameter:
+.  is - the new index set
+
+   Notes:
+   The memory and the time of ISLocate(), ISSort(), ISDifference(), ISSum() and ISExpand() scale with the
+   number of intervals rather than the number of indices. ISGetIndices() creates the explicit list of indices
+   each time it is called and ISRestoreIndices() frees it.
+
+   Use ISIntervalSetIndices() to store an existing list of indices this way.
+
+   Level: intermediate
+
+  Concepts: IS^interval
+  Concepts: index sets^interval
+  Concepts: interval^index set
+
+.seealso: ISCreateGeneral(), ISCreateStride(), ISIntervalSetIntervals(), ISIntervalSetIndices(), ISIntervalGetIntervals(), ISINTERVAL
+@*/
+PetscErrorCode ISCreateInterval(MPI_Comm comm,PetscInt nr,const PetscInt start[],const PetscInt len[],IS *is)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = ISCreate(comm,is);CHKERRQ(ierr);
+  ierr = ISSetType(*is,ISINTERVAL);CHKERRQ(ierr);
+  ierr = ISIntervalSetIntervals(*is,nr,start,len);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   ISINTERVAL - An index set made of intervals of consecutive integers, each stored by its first index and length
+
+   Level: intermediate
+
+.seealso: ISCreateInterval(), ISIntervalSetIndices(), ISGENERAL, ISSTRIDE, ISSetType()
+M*/
+
+PETSC_EXTERN PetscErrorCode ISCreate_Interval(IS is)
+{
+  IS_Interval    *sub;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNewLog(is,&sub);CHKERRQ(ierr);
+  is->data = (void*)sub;
+  ierr = PetscMemcpy(is->ops,&myops,sizeof(myops));CHKERRQ(ierr);
+  ierr = PetscMalloc2(0,&sub->start,1,&sub->off);CHKERRQ(ierr);
+  sub->off[0]   = 0;
+  sub->sorted   = PETSC_TRUE;
+  sub->disjoint = PETSC_TRUE;
+  ierr = PetscObjectComposeFunction((PetscObject)is,"ISIntervalSetIntervals_C",ISIntervalSetIntervals_Interval);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)is,"ISIntervalSetIndices_C",ISIntervalSetIndices_Interval);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -3,6 +3,7 @@
 PETSC_EXTERN PetscErrorCode ISCreate_General(IS);
 PETSC_EXTERN PetscErrorCode ISCreate_Stride(IS);
 PETSC_EXTERN PetscErrorCode ISCreate_Block(IS);
+PETSC_EXTERN PetscErrorCode ISCreate_Interval(IS);
 
 /*@C
   ISRegisterAll - Registers all of the index set components in the IS package.
@@ -25,6 +26,7 @@ PetscErrorCode  ISRegisterAll(void)
   ierr = ISRegister(ISGENERAL, ISCreate_General);CHKERRQ(ierr);
   ierr = ISRegister(ISSTRIDE,  ISCreate_Stride);CHKERRQ(ierr);
   ierr = ISRegister(ISBLOCK,   ISCreate_Block);CHKERRQ(ierr);
+  ierr = ISRegister(ISINTERVAL,ISCreate_Interval);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -19,6 +19,9 @@
    that are not in is1. This requires O(imax-imin) memory and O(imax-imin)
    work, where imin and imax are the bounds on the indices in is1.
 
+   If both index sets are ISINTERVAL the work is proportional to the number of intervals
+   and the result is an ISINTERVAL.
+
    Level: intermediate
 
    Concepts: index sets^difference
@@ -34,12 +37,20 @@ PetscErrorCode  ISDifference(IS is1,IS is2,IS *isout)
   const PetscInt *i1,*i2;
   PetscBT        mask;
   MPI_Comm       comm;
+  PetscBool      f1,f2;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(is1,IS_CLASSID,1);
   PetscValidHeaderSpecific(is2,IS_CLASSID,2);
   PetscValidPointer(isout,3);
 
+  ierr = PetscObjectTypeCompare((PetscObject)is1,ISINTERVAL,&f1);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)is2,ISINTERVAL,&f2);CHKERRQ(ierr);
+  if (f1 && f2) {
+    ierr = ISDifference_Interval(is1,is2,isout);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
   ierr = ISGetIndices(is1,&i1);CHKERRQ(ierr);
   ierr = ISGetLocalSize(is1,&n1);CHKERRQ(ierr);
 
@@ -106,6 +117,9 @@ PetscErrorCode  ISDifference(IS is1,IS is2,IS *isout)
 
    Both index sets need to be sorted on input.
 
+   If both index sets are ISINTERVAL without repeated indices the work is proportional to the
+   number of intervals and the result is an ISINTERVAL.
+
    Level: intermediate
 
 .seealso: ISDestroy(), ISView(), ISDifference(), ISExpand()
@@ -134,6 +148,12 @@ PetscErrorCode  ISSum(IS is1,IS is2,IS *is3)
   if (!f) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"Arg 1 is not sorted");
   ierr = ISSorted(is2,&f);CHKERRQ(ierr);
   if (!f) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"Arg 2 is not sorted");
+  ierr = PetscObjectTypeCompare((PetscObject)is1,ISINTERVAL,&f);CHKERRQ(ierr);
+  if (f) {ierr = PetscObjectTypeCompare((PetscObject)is2,ISINTERVAL,&f);CHKERRQ(ierr);}
+  if (f) {
+    ierr = ISSum_Interval(is1,is2,&f,is3);CHKERRQ(ierr);
+    if (f) PetscFunctionReturn(0);
+  }
 
   ierr = ISGetLocalSize(is1,&n1);CHKERRQ(ierr);
   ierr = ISGetLocalSize(is2,&n2);CHKERRQ(ierr);
@@ -233,6 +253,9 @@ PetscErrorCode  ISSum(IS is1,IS is2,IS *is3)
 
    The IS's do not need to be sorted.
 
+   If both index sets are ISINTERVAL without repeated indices the work is proportional to the
+   number of intervals and the result is an ISINTERVAL.
+
    Level: intermediate
 
 .seealso: ISDestroy(), ISView(), ISDifference(), ISSum()
@@ -248,6 +271,7 @@ PetscErrorCode ISExpand(IS is1,IS is2,IS *isout)
   const PetscInt *i1,*i2;
   PetscBT        mask;
   MPI_Comm       comm;
+  PetscBool      f;
 
   PetscFunctionBegin;
   if (is1) PetscValidHeaderSpecific(is1,IS_CLASSID,1);
@@ -257,6 +281,12 @@ PetscErrorCode ISExpand(IS is1,IS is2,IS *isout)
   if (!is1 && !is2) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Both arguments cannot be NULL");
   if (!is1) {ierr = ISDuplicate(is2, isout);CHKERRQ(ierr);PetscFunctionReturn(0);}
   if (!is2) {ierr = ISDuplicate(is1, isout);CHKERRQ(ierr);PetscFunctionReturn(0);}
+  ierr = PetscObjectTypeCompare((PetscObject)is1,ISINTERVAL,&f);CHKERRQ(ierr);
+  if (f) {ierr = PetscObjectTypeCompare((PetscObject)is2,ISINTERVAL,&f);CHKERRQ(ierr);}
+  if (f) {
+    ierr = ISExpand_Interval(is1,is2,&f,isout);CHKERRQ(ierr);
+    if (f) PetscFunctionReturn(0);
+  }
   ierr = ISGetIndices(is1,&i1);CHKERRQ(ierr);
   ierr = ISGetLocalSize(is1,&n1);CHKERRQ(ierr);
   ierr = ISGetIndices(is2,&i2);CHKERRQ(ierr);
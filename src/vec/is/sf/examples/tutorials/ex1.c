@@ -414,6 +414,86 @@ int main(int argc,char **argv)
       args: -test_bcast -sf_type basic
       output_file: output/ex1_1_basic.out
 
+   test:
+      suffix: basic_persistent
+      nsize: 4
+      filter: grep -v "persistent"
+      args: -test_bcast -sf_type basic -sf_use_persistent
+      output_file: output/ex1_1_basic.out
+
+   test:
+      suffix: 2_basic_persistent
+      nsize: 4
+      filter: grep -v "persistent"
+      args: -test_reduce -sf_type basic -sf_use_persistent
+      output_file: output/ex1_2_basic.out
+
+   test:
+      suffix: 4_basic_persistent
+      nsize: 4
+      filter: grep -v "persistent"
+      args: -test_gather -sf_type basic -sf_use_persistent
+      output_file: output/ex1_4_basic.out
+
+   test:
+      suffix: 2_basic_indexed
+      nsize: 4
+      args: -test_reduce -sf_type basic -sf_use_pack_optimization 0
+      output_file: output/ex1_2_basic.out
+
+   test:
+      suffix: 4_stride_indexed
+      nsize: 4
+      args: -test_gather -sf_type basic -stride 2 -sf_use_pack_optimization 0
+      output_file: output/ex1_4_stride.out
+
+   test:
+      suffix: basic_view_packing
+      nsize: 4
+      args: -test_bcast -sf_type basic -sf_view_packing
+
+   test:
+      suffix: basic_shared
+      nsize: 4
+      filter: grep -v "shared memory"
+      args: -test_bcast -sf_type basic -sf_use_shared_memory
+      requires: define(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+      output_file: output/ex1_1_basic.out
+
+   test:
+      suffix: 2_basic_shared
+      nsize: 4
+      filter: grep -v "shared memory"
+      args: -test_reduce -sf_type basic -sf_use_shared_memory -sf_shared_memory_slots 1
+      requires: define(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+      output_file: output/ex1_2_basic.out
+
+   test:
+      suffix: 4_basic_shared
+      nsize: 4
+      filter: grep -v "shared memory"
+      args: -test_gather -sf_type basic -sf_use_shared_memory
+      requires: define(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+      output_file: output/ex1_4_basic.out
+
+   test:
+      suffix: 1_neighbor
+      nsize: 4
+      args: -test_bcast -sf_type neighbor
+      requires: define(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+
+   test:
+      suffix: 2_neighbor
+      nsize: 4
+      args: -test_reduce -sf_type neighbor
+      requires: define(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+
+   test:
+      suffix: 4_neighbor
+      nsize: 4
+      args: -test_gather -sf_type neighbor
+      requires: define(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+
    test:
       suffix: 8
       nsize: 3
@@ -1,4 +1,5 @@
-static const char help[] = "Test overlapped communication on a single star forest (PetscSF)\n\n";
+static const char help[] = "Test overlapped communication on a single star forest (PetscSF)\n\n\
+  -batch : coalesce the broadcasts, and then the reductions, with PetscSFBatchBegin() and PetscSFBatchEnd()\n\n";
 
 #include <petscvec.h>
 #include <petscsf.h>
@@ -19,12 +20,15 @@ int main(int argc, char **argv)
   PetscInt    i;
   PetscInt    *ilocal;
   PetscSFNode *iremote;
+  PetscBool   batch = PETSC_FALSE;
+  PetscScalar rootA,rootSum;
 
   ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
   ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
   ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
 
   if (size != 2) SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Only coded for two MPI processes\n");
+  ierr = PetscOptionsGetBool(NULL,NULL,"-batch",&batch,NULL);CHKERRQ(ierr);
 
   ierr = PetscSFCreate(PETSC_COMM_WORLD,&sf);CHKERRQ(ierr);
   ierr = PetscSFSetFromOptions(sf);CHKERRQ(ierr);
@@ -73,10 +77,26 @@ int main(int argc, char **argv)
   ierr = VecGetArrayRead(B,(const PetscScalar**)&bufB);CHKERRQ(ierr);
   ierr = VecGetArray(Aout,&bufAout);CHKERRQ(ierr);
   ierr = VecGetArray(Bout,&bufBout);CHKERRQ(ierr);
+  if (batch) {ierr = PetscSFBatchBegin(sf);CHKERRQ(ierr);}
   ierr = PetscSFBcastBegin(sf,MPIU_SCALAR,(const void*)bufA,(void *)bufAout);CHKERRQ(ierr);
   ierr = PetscSFBcastBegin(sf,MPIU_SCALAR,(const void*)bufB,(void *)bufBout);CHKERRQ(ierr);
+  if (batch) {ierr = PetscSFBatchEnd(sf);CHKERRQ(ierr);}
   ierr = PetscSFBcastEnd(sf,MPIU_SCALAR,(const void*)bufA,(void *)bufAout);CHKERRQ(ierr);
   ierr = PetscSFBcastEnd(sf,MPIU_SCALAR,(const void*)bufB,(void *)bufBout);CHKERRQ(ierr);
+
+  /* reductions back to the roots, each root has a leaf on both processes and the last two reductions add into the same root */
+  rootA   = 0.0;
+  rootSum = 100.0*(rank+1);
+  if (batch) {ierr = PetscSFBatchBegin(sf);CHKERRQ(ierr);}
+  ierr = PetscSFReduceBegin(sf,MPIU_SCALAR,(const void*)bufAout,(void*)&rootA,MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sf,MPIU_SCALAR,(const void*)bufAout,(void*)&rootSum,MPI_SUM);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sf,MPIU_SCALAR,(const void*)bufBout,(void*)&rootSum,MPI_SUM);CHKERRQ(ierr);
+  if (batch) {ierr = PetscSFBatchEnd(sf);CHKERRQ(ierr);}
+  ierr = PetscSFReduceEnd(sf,MPIU_SCALAR,(const void*)bufAout,(void*)&rootA,MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf,MPIU_SCALAR,(const void*)bufAout,(void*)&rootSum,MPI_SUM);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf,MPIU_SCALAR,(const void*)bufBout,(void*)&rootSum,MPI_SUM);CHKERRQ(ierr);
+  ierr = PetscSynchronizedPrintf(PETSC_COMM_WORLD,"[%d] root replaced by %g, sum %g\n",rank,(double)PetscRealPart(rootA),(double)PetscRealPart(rootSum));CHKERRQ(ierr);
+  ierr = PetscSynchronizedFlush(PETSC_COMM_WORLD,PETSC_STDOUT);CHKERRQ(ierr);
   ierr = VecRestoreArrayRead(A,(const PetscScalar**)&bufA);CHKERRQ(ierr);
   ierr = VecRestoreArrayRead(B,(const PetscScalar**)&bufB);CHKERRQ(ierr);
   ierr = VecRestoreArray(Aout,&bufAout);CHKERRQ(ierr);
@@ -102,6 +122,27 @@ int main(int argc, char **argv)
       nsize: 2
       args: -sf_type basic
 
+   test:
+      suffix: basic_persistent
+      nsize: 2
+      filter: grep -v "persistent"
+      args: -sf_type basic -sf_use_persistent
+      output_file: output/ex2_basic.out
+
+   test:
+      suffix: basic_batch
+      nsize: 2
+      args: -sf_type basic -batch
+      output_file: output/ex2_basic.out
+
+   test:
+      suffix: basic_shared
+      nsize: 2
+      filter: grep -v "shared memory"
+      args: -sf_type basic -sf_use_shared_memory
+      requires: define(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+      output_file: output/ex2_basic.out
+
    test:
       suffix: window
       nsize: 2
@@ -1,57 +1,5 @@
 
-#include <petsc/private/sfimpl.h> /*I "petscsf.h" I*/
-
-typedef struct _n_PetscSFBasicPack *PetscSFBasicPack;
-struct _n_PetscSFBasicPack {
-  void (*Pack)(PetscInt,PetscInt,const PetscInt*,const void*,void*);
-  void (*UnpackInsert)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
-  void (*UnpackAdd)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
-  void (*UnpackMin)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
-  void (*UnpackMax)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
-  void (*UnpackMinloc)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
-  void (*UnpackMaxloc)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
-  void (*UnpackMult)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*UnpackLAND)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*UnpackBAND)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*UnpackLOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*UnpackBOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*UnpackLXOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*UnpackBXOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*FetchAndInsert)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndAdd)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndMin)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndMax)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndMinloc)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndMaxloc)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndMult)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndLAND)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndBAND)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndLOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndBOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndLXOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndBXOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-
-  MPI_Datatype     unit;
-  size_t           unitbytes;   /* Number of bytes in a unit */
-  PetscInt         bs;          /* Number of basic units in a unit */
-  const void       *key;        /* Array used as key for operation */
-  char             **root;      /* Packed root data, indexed by leaf rank */
-  char             **leaf;      /* Packed leaf data, indexed by root rank */
-  MPI_Request      *requests;   /* Array of root requests followed by leaf requests */
-  PetscSFBasicPack next;
-};
-
-typedef struct {
-  PetscMPIInt      tag;
-  PetscMPIInt      niranks;     /* Number of incoming ranks (ranks accessing my roots) */
-  PetscMPIInt      ndiranks;    /* Number of incoming ranks (ranks accessing my roots) in distinguished set */
-  PetscMPIInt      *iranks;     /* Array of ranks that reference my roots */
-  PetscInt         itotal;      /* Total number of graph edges referencing my roots */
-  PetscInt         *ioffset;    /* Array of length niranks+1 holding offset in irootloc[] for each rank */
-  PetscInt         *irootloc;   /* Incoming roots referenced by ranks starting at ioffset[rank] */
-  PetscSFBasicPack avail;       /* One or more entries per MPI Datatype, lazily constructed */
-  PetscSFBasicPack inuse;       /* Buffers being used for transactions that have not yet completed */
-} PetscSF_Basic;
+#include <../src/vec/is/sf/impls/basic/sfbasic.h> /*I "petscsf.h" I*/
 
 #if !defined(PETSC_HAVE_MPI_TYPE_DUP)
 PETSC_STATIC_INLINE int MPI_Type_dup(MPI_Datatype datatype,MPI_Datatype *newtype)
@@ -115,6 +63,10 @@ PETSC_STATIC_INLINE int MPI_Type_dup(MPI_Datatype datatype,MPI_Datatype *newtype
     type *u = (type*)unpacked;                                          \
     const type *p = (const type*)packed;                                \
     PetscInt i,j,k;                                                     \
+    if (!idx) {                                                         \
+      for (i=0; i<n*bs; i++) u[i] += p[i];                              \
+      return;                                                           \
+    }                                                                   \
     for (i=0; i<n; i++)                                                 \
       for (j=0; j<bs; j+=BS)                                            \
         for (k=j; k<j+BS; k++)                                          \
@@ -432,6 +384,13 @@ PETSC_STATIC_INLINE int MPI_Type_dup(MPI_Datatype datatype,MPI_Datatype *newtype
     PairType(type1,type2) *u = (PairType(type1,type2)*)unpacked;       \
     const PairType(type1,type2) *p = (const PairType(type1,type2)*)packed; \
     PetscInt i;                                                         \
+    if (!idx) {                                                         \
+      for (i=0; i<n; i++) {                                             \
+        u[i].a += p[i].a;                                               \
+        u[i].b += p[i].b;                                               \
+      }                                                                 \
+      return;                                                           \
+    }                                                                   \
     for (i=0; i<n; i++) {                                               \
       u[idx[i]].a += p[i].a;                                            \
       u[idx[i]].b += p[i].b;                                            \
@@ -531,7 +490,53 @@ DEF_Block(int,6)
 DEF_Block(int,7)
 DEF_Block(int,8)
 
-static PetscErrorCode PetscSFSetUp_Basic(PetscSF sf)
+/* Minimum average number of consecutive indices per block for block copies to be used instead of indexed access */
+#define PETSCSF_BASIC_PACK_MINBLOCK 8
+
+/* Split the indices loc[] of each rank into blocks of consecutive indices */
+static PetscErrorCode PetscSFBasicPackOptCreate(PetscInt nranks,const PetscInt *offset,const PetscInt *loc,PetscSFBasicPackOpt *opt)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,j,k;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(nranks+1,&opt->offset);CHKERRQ(ierr);
+  opt->offset[0] = 0;
+  for (i=0; i<nranks; i++) {
+    PetscInt n = offset[i+1] - offset[i],nblocks = n ? 1 : 0;
+    for (j=offset[i]+1; j<offset[i+1]; j++) if (loc[j] != loc[j-1]+1) nblocks++;
+    if (n < nblocks*PETSCSF_BASIC_PACK_MINBLOCK && nblocks > 1) nblocks = 0;
+    opt->offset[i+1] = opt->offset[i] + nblocks;
+  }
+  ierr = PetscMalloc2(opt->offset[nranks],&opt->start,opt->offset[nranks],&opt->len);CHKERRQ(ierr);
+  for (i=0; i<nranks; i++) {
+    if (opt->offset[i+1] == opt->offset[i]) continue;
+    k = opt->offset[i];
+    opt->start[k] = loc[offset[i]];
+    opt->len[k]   = 1;
+    for (j=offset[i]+1; j<offset[i+1]; j++) {
+      if (loc[j] == loc[j-1]+1) opt->len[k]++;
+      else {
+        k++;
+        opt->start[k] = loc[j];
+        opt->len[k]   = 1;
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFBasicPackOptDestroy(PetscSFBasicPackOpt *opt)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(opt->offset);CHKERRQ(ierr);
+  ierr = PetscFree2(opt->start,opt->len);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscSFSetUp_Basic(PetscSF sf)
 {
   PetscSF_Basic *bas = (PetscSF_Basic*)sf->data;
   PetscErrorCode ierr;
@@ -547,6 +552,7 @@ static PetscErrorCode PetscSFSetUp_Basic(PetscSF sf)
   ierr = MPI_Group_free(&group);CHKERRQ(ierr);
   ierr = PetscObjectGetComm((PetscObject)sf,&comm);CHKERRQ(ierr);
   ierr = PetscObjectGetNewTag((PetscObject)sf,&bas->tag);CHKERRQ(ierr);
+  ierr = PetscObjectGetNewTag((PetscObject)sf,&bas->batchtag);CHKERRQ(ierr);
   ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
   /*
    * Inform roots about how many leaves and from which ranks
@@ -598,6 +604,11 @@ static PetscErrorCode PetscSFSetUp_Basic(PetscSF sf)
   ierr = MPI_Waitall(bas->niranks-bas->ndiranks,rootreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
   ierr = MPI_Waitall(sf->nranks-sf->ndranks,leafreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
   ierr = PetscFree2(rootreqs,leafreqs);CHKERRQ(ierr);
+
+  /* Detect contiguous and blocked index patterns, common for structured grids, so packing can use block copies */
+  ierr = PetscSFBasicPackOptCreate(bas->niranks,bas->ioffset,bas->irootloc,&bas->rootpackopt);CHKERRQ(ierr);
+  ierr = PetscSFBasicPackOptCreate(sf->nranks,sf->roffset,sf->rmine,&bas->leafpackopt);CHKERRQ(ierr);
+  if (bas->useshm) {ierr = PetscSFBasicShmSetUp(sf);CHKERRQ(ierr);}
   PetscFunctionReturn(0);
 }
 
@@ -702,7 +713,7 @@ static PetscErrorCode PetscSFBasicPackGetUnpackOp(PetscSF sf,PetscSFBasicPack li
   else *UnpackOp = NULL;
   PetscFunctionReturn(0);
 }
-static PetscErrorCode PetscSFBasicPackGetFetchAndOp(PetscSF sf,PetscSFBasicPack link,MPI_Op op,void (**FetchAndOp)(PetscInt,PetscInt,const PetscInt*,void*,void*))
+PetscErrorCode PetscSFBasicPackGetFetchAndOp(PetscSF sf,PetscSFBasicPack link,MPI_Op op,void (**FetchAndOp)(PetscInt,PetscInt,const PetscInt*,void*,void*))
 {
   PetscFunctionBegin;
   *FetchAndOp = NULL;
@@ -723,51 +734,300 @@ static PetscErrorCode PetscSFBasicPackGetFetchAndOp(PetscSF sf,PetscSFBasicPack
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFBasicPackGetReqs(PetscSF sf,PetscSFBasicPack link,MPI_Request **rootreqs,MPI_Request **leafreqs)
+PetscErrorCode PetscSFBasicGetRootInfo(PetscSF sf,PetscInt *nrootranks,PetscInt *ndrootranks,const PetscMPIInt **rootranks,const PetscInt **rootoffset,const PetscInt **rootloc)
 {
   PetscSF_Basic *bas = (PetscSF_Basic*)sf->data;
 
   PetscFunctionBegin;
-  if (rootreqs) *rootreqs = link->requests;
-  if (leafreqs) *leafreqs = link->requests + (bas->niranks - bas->ndiranks);
+  if (nrootranks)  *nrootranks  = bas->niranks;
+  if (ndrootranks) *ndrootranks = bas->ndiranks;
+  if (rootranks)   *rootranks   = bas->iranks;
+  if (rootoffset)  *rootoffset  = bas->ioffset;
+  if (rootloc)     *rootloc     = bas->irootloc;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscSFBasicGetLeafInfo(PetscSF sf,PetscInt *nleafranks,PetscInt *ndleafranks,const PetscMPIInt **leafranks,const PetscInt **leafoffset,const PetscInt **leafloc)
+{
+  PetscFunctionBegin;
+  if (nleafranks)  *nleafranks  = sf->nranks;
+  if (ndleafranks) *ndleafranks = sf->ndranks;
+  if (leafranks)   *leafranks   = sf->ranks;
+  if (leafoffset)  *leafoffset  = sf->roffset;
+  if (leafloc)     *leafloc     = sf->rmine;
+  PetscFunctionReturn(0);
+}
+
+/* Pack the n units of data at indices idx[] into buf, copying whole blocks when the layout of rank i is known */
+static PetscErrorCode PetscSFBasicPackRank_Private(PetscSFBasicPack link,const PetscSFBasicPackOpt *opt,PetscInt i,PetscInt n,const PetscInt *idx,const void *data,void *buf)
+{
+  PetscErrorCode ierr;
+  PetscInt       j;
+  char           *p = (char*)buf;
+
+  PetscFunctionBegin;
+  if (opt && opt->offset[i+1] > opt->offset[i]) {
+    for (j=opt->offset[i]; j<opt->offset[i+1]; j++) {
+      ierr = PetscMemcpy(p,(const char*)data+opt->start[j]*link->unitbytes,opt->len[j]*link->unitbytes);CHKERRQ(ierr);
+      p   += opt->len[j]*link->unitbytes;
+    }
+  } else (*link->Pack)(n,link->bs,idx,data,buf);
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFBasicPackWaitall(PetscSF sf,PetscSFBasicPack link)
+/* Unpack the n units in buf into data at indices idx[] with UnpackOp, a block at a time for insertion and addition when the layout of rank i is known */
+static PetscErrorCode PetscSFBasicUnpackRank_Private(PetscSFBasicPack link,const PetscSFBasicPackOpt *opt,PetscInt i,PetscInt n,const PetscInt *idx,void *data,const void *buf,void (*UnpackOp)(PetscInt,PetscInt,const PetscInt*,void*,const void*))
+{
+  PetscErrorCode ierr;
+  PetscInt       j;
+  const char     *p = (const char*)buf;
+
+  PetscFunctionBegin;
+  if (opt && opt->offset[i+1] > opt->offset[i] && (UnpackOp == link->UnpackInsert || UnpackOp == link->UnpackAdd)) {
+    for (j=opt->offset[i]; j<opt->offset[i+1]; j++) {
+      char *u = (char*)data + opt->start[j]*link->unitbytes;
+      if (UnpackOp == link->UnpackInsert) {ierr = PetscMemcpy(u,p,opt->len[j]*link->unitbytes);CHKERRQ(ierr);}
+      else (*UnpackOp)(opt->len[j],link->bs,NULL,u,p);
+      p += opt->len[j]*link->unitbytes;
+    }
+  } else (*UnpackOp)(n,link->bs,idx,data,buf);
+  PetscFunctionReturn(0);
+}
+
+/* Pack the root data referenced by root rank i into link->root[i] */
+PetscErrorCode PetscSFBasicPackRootRank(PetscSF sf,PetscSFBasicPack link,PetscInt i,const void *rootdata)
 {
   PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  ierr = MPI_Waitall(bas->niranks+sf->nranks-(bas->ndiranks+sf->ndranks),link->requests,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  ierr = PetscSFBasicPackRank_Private(link,bas->usepackopt ? &bas->rootpackopt : NULL,i,bas->ioffset[i+1]-bas->ioffset[i],bas->irootloc+bas->ioffset[i],rootdata,link->root[i]);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFBasicGetRootInfo(PetscSF sf,PetscInt *nrootranks,PetscInt *ndrootranks,const PetscMPIInt **rootranks,const PetscInt **rootoffset,const PetscInt **rootloc)
+/* Pack the leaf data referencing leaf rank i into link->leaf[i] */
+PetscErrorCode PetscSFBasicPackLeafRank(PetscSF sf,PetscSFBasicPack link,PetscInt i,const void *leafdata)
 {
-  PetscSF_Basic *bas = (PetscSF_Basic*)sf->data;
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
+  PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  if (nrootranks)  *nrootranks  = bas->niranks;
-  if (ndrootranks) *ndrootranks = bas->ndiranks;
-  if (rootranks)   *rootranks   = bas->iranks;
-  if (rootoffset)  *rootoffset  = bas->ioffset;
-  if (rootloc)     *rootloc     = bas->irootloc;
+  ierr = PetscSFBasicPackRank_Private(link,bas->usepackopt ? &bas->leafpackopt : NULL,i,sf->roffset[i+1]-sf->roffset[i],sf->rmine+sf->roffset[i],leafdata,link->leaf[i]);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFBasicGetLeafInfo(PetscSF sf,PetscInt *nleafranks,PetscInt *ndleafranks,const PetscMPIInt **leafranks,const PetscInt **leafoffset,const PetscInt **leafloc)
+/* Insert the data received from leaf rank i in link->leaf[i] into leafdata */
+PetscErrorCode PetscSFBasicUnpackLeafRank(PetscSF sf,PetscSFBasicPack link,PetscInt i,void *leafdata)
 {
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
+  PetscErrorCode ierr;
+
   PetscFunctionBegin;
-  if (nleafranks)  *nleafranks  = sf->nranks;
-  if (ndleafranks) *ndleafranks = sf->ndranks;
-  if (leafranks)   *leafranks   = sf->ranks;
-  if (leafoffset)  *leafoffset  = sf->roffset;
-  if (leafloc)     *leafloc     = sf->rmine;
+  ierr = PetscSFBasicUnpackRank_Private(link,bas->usepackopt ? &bas->leafpackopt : NULL,i,sf->roffset[i+1]-sf->roffset[i],sf->rmine+sf->roffset[i],leafdata,link->leaf[i],link->UnpackInsert);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFBasicGetPack(PetscSF sf,MPI_Datatype unit,const void *key,PetscSFBasicPack *mylink)
+/* Returns the requests of a link used for communication in the given direction, creating persistent requests on first use */
+static PetscErrorCode PetscSFBasicPackGetReqs(PetscSF sf,PetscSFBasicPack link,PetscSFBasicDirection direction,MPI_Request **rootreqs,MPI_Request **leafreqs)
+{
+  PetscSF_Basic     *bas = (PetscSF_Basic*)sf->data;
+  PetscErrorCode    ierr;
+  MPI_Request       *reqs = link->requests;
+  PetscInt          i,nrootranks,ndrootranks,nleafranks,ndleafranks;
+  const PetscInt    *rootoffset,*leafoffset;
+  const PetscMPIInt *rootranks,*leafranks;
+  MPI_Comm          comm;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,NULL);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,NULL);CHKERRQ(ierr);
+  if (bas->persistent) {
+    if (!link->persistent[direction]) {
+      ierr = PetscObjectGetComm((PetscObject)sf,&comm);CHKERRQ(ierr);
+      ierr = PetscMalloc1(nrootranks-ndrootranks+nleafranks-ndleafranks,&link->persistent[direction]);CHKERRQ(ierr);
+      reqs = link->persistent[direction];
+      for (i=ndrootranks; i<nrootranks; i++) {
+        PetscMPIInt n = rootoffset[i+1] - rootoffset[i];
+        if (direction == PETSCSF_BASIC_BCAST) {ierr = MPI_Send_init(link->root[i],n,link->unit,rootranks[i],bas->tag,comm,&reqs[i-ndrootranks]);CHKERRQ(ierr);}
+        else {ierr = MPI_Recv_init(link->root[i],n,link->unit,rootranks[i],bas->tag,comm,&reqs[i-ndrootranks]);CHKERRQ(ierr);}
+      }
+      reqs += nrootranks - ndrootranks;
+      for (i=ndleafranks; i<nleafranks; i++) {
+        PetscMPIInt n = leafoffset[i+1] - leafoffset[i];
+        if (direction == PETSCSF_BASIC_BCAST) {ierr = MPI_Recv_init(link->leaf[i],n,link->unit,leafranks[i],bas->tag,comm,&reqs[i-ndleafranks]);CHKERRQ(ierr);}
+        else {ierr = MPI_Send_init(link->leaf[i],n,link->unit,leafranks[i],bas->tag,comm,&reqs[i-ndleafranks]);CHKERRQ(ierr);}
+      }
+    }
+    reqs = link->persistent[direction];
+  }
+  if (rootreqs) *rootreqs = reqs;
+  if (leafreqs) *leafreqs = reqs + (nrootranks - ndrootranks);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFBasicBatchAddPack(PetscSF sf,PetscSFBasicPack link,PetscSFBasicDirection direction)
+{
+  PetscSF_Basic     *bas = (PetscSF_Basic*)sf->data;
+  PetscSFBasicBatch *batch = &bas->batch;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (batch->nlinks && batch->direction != direction) SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_ARG_WRONGSTATE,"A PetscSF batch cannot mix broadcasts and reductions");
+  if (batch->nlinks == batch->maxlinks) {
+    PetscSFBasicPack *links;
+
+    batch->maxlinks = PetscMax(2*batch->maxlinks,4);
+    ierr = PetscMalloc1(batch->maxlinks,&links);CHKERRQ(ierr);
+    ierr = PetscMemcpy(links,batch->links,batch->nlinks*sizeof(PetscSFBasicPack));CHKERRQ(ierr);
+    ierr = PetscFree(batch->links);CHKERRQ(ierr);
+    batch->links = links;
+  }
+  batch->direction               = direction;
+  batch->links[batch->nlinks++] = link;
+  link->batched                  = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/* Wait for the coalesced messages and copy each link's slice into its own buffers */
+static PetscErrorCode PetscSFBasicBatchComplete(PetscSF sf)
+{
+  PetscSF_Basic     *bas = (PetscSF_Basic*)sf->data;
+  PetscSFBasicBatch *batch = &bas->batch;
+  PetscErrorCode    ierr;
+  PetscInt          i,k,nrecvranks,ndrecvranks;
+  const PetscInt    *recvoffset;
+  char              *recvbuf,*p;
+
+  PetscFunctionBegin;
+  if (!batch->inflight) PetscFunctionReturn(0);
+  ierr = MPI_Waitall(bas->niranks+sf->nranks-(bas->ndiranks+sf->ndranks),batch->requests,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  if (batch->direction == PETSCSF_BASIC_BCAST) {
+    ierr    = PetscSFBasicGetLeafInfo(sf,&nrecvranks,&ndrecvranks,NULL,&recvoffset,NULL);CHKERRQ(ierr);
+    recvbuf = batch->leafbuf;
+  } else {
+    ierr    = PetscSFBasicGetRootInfo(sf,&nrecvranks,&ndrecvranks,NULL,&recvoffset,NULL);CHKERRQ(ierr);
+    recvbuf = batch->rootbuf;
+  }
+  for (i=ndrecvranks; i<nrecvranks; i++) {
+    PetscInt n = recvoffset[i+1] - recvoffset[i];
+
+    p = recvbuf + (recvoffset[i]-recvoffset[ndrecvranks])*batch->unitbytes;
+    for (k=0; k<batch->nlinks; k++) {
+      PetscSFBasicPack link   = batch->links[k];
+      char             *dest  = batch->direction == PETSCSF_BASIC_BCAST ? link->leaf[i] : link->root[i];
+
+      ierr = PetscMemcpy(dest,p,n*link->unitbytes);CHKERRQ(ierr);
+      p   += n*link->unitbytes;
+    }
+  }
+  batch->nlinks   = 0;
+  batch->inflight = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFBatchBegin_Basic(PetscSF sf)
+{
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (bas->batch.active) SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_ARG_WRONGSTATE,"PetscSFBatchBegin() has already been called");
+  ierr = PetscSFBasicBatchComplete(sf);CHKERRQ(ierr);
+  bas->batch.active = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFBatchEnd_Basic(PetscSF sf)
+{
+  PetscSF_Basic     *bas = (PetscSF_Basic*)sf->data;
+  PetscSFBasicBatch *batch = &bas->batch;
+  PetscErrorCode    ierr;
+  PetscInt          i,k,nrootranks,ndrootranks,nleafranks,ndleafranks,nsendranks,ndsendranks,nrecvranks,ndrecvranks;
+  const PetscInt    *rootoffset,*leafoffset,*sendoffset,*recvoffset;
+  const PetscMPIInt *rootranks,*leafranks,*sendranks,*recvranks;
+  size_t            rootlen,leaflen;
+  char              *sendbuf,*recvbuf,*p;
+  MPI_Request       *recvreqs,*sendreqs;
+  MPI_Comm          comm;
+
+  PetscFunctionBegin;
+  if (!batch->active) SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_ARG_WRONGSTATE,"Must call PetscSFBatchBegin() first");
+  batch->active = PETSC_FALSE;
+  if (!batch->nlinks) PetscFunctionReturn(0);
+  ierr = PetscObjectGetComm((PetscObject)sf,&comm);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,NULL);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,NULL);CHKERRQ(ierr);
+
+  /* The buffers are kept between batches, since the same fields are usually exchanged over and over */
+  for (k=0,batch->unitbytes=0; k<batch->nlinks; k++) batch->unitbytes += batch->links[k]->unitbytes;
+  rootlen = (rootoffset[nrootranks]-rootoffset[ndrootranks])*batch->unitbytes;
+  leaflen = (leafoffset[nleafranks]-leafoffset[ndleafranks])*batch->unitbytes;
+  if (rootlen > batch->rootlen) {
+    ierr = PetscFree(batch->rootbuf);CHKERRQ(ierr);
+    ierr = PetscMalloc(rootlen,&batch->rootbuf);CHKERRQ(ierr);
+    batch->rootlen = rootlen;
+  }
+  if (leaflen > batch->leaflen) {
+    ierr = PetscFree(batch->leafbuf);CHKERRQ(ierr);
+    ierr = PetscMalloc(leaflen,&batch->leafbuf);CHKERRQ(ierr);
+    batch->leaflen = leaflen;
+  }
+  if (!batch->requests) {ierr = PetscMalloc1(nrootranks-ndrootranks+nleafranks-ndleafranks,&batch->requests);CHKERRQ(ierr);}
+
+  if (batch->direction == PETSCSF_BASIC_BCAST) {
+    nsendranks = nrootranks; ndsendranks = ndrootranks; sendranks = rootranks; sendoffset = rootoffset; sendbuf = batch->rootbuf;
+    nrecvranks = nleafranks; ndrecvranks = ndleafranks; recvranks = leafranks; recvoffset = leafoffset; recvbuf = batch->leafbuf;
+  } else {
+    nsendranks = nleafranks; ndsendranks = ndleafranks; sendranks = leafranks; sendoffset = leafoffset; sendbuf = batch->leafbuf;
+    nrecvranks = nrootranks; ndrecvranks = ndrootranks; recvranks = rootranks; recvoffset = rootoffset; recvbuf = batch->rootbuf;
+  }
+  recvreqs = batch->requests;
+  sendreqs = batch->requests + (nrecvranks-ndrecvranks);
+  for (i=ndrecvranks; i<nrecvranks; i++) {
+    PetscMPIInt n;
+
+    ierr = PetscMPIIntCast((recvoffset[i+1]-recvoffset[i])*batch->unitbytes,&n);CHKERRQ(ierr);
+    ierr = MPI_Irecv(recvbuf+(recvoffset[i]-recvoffset[ndrecvranks])*batch->unitbytes,n,MPI_BYTE,recvranks[i],bas->batchtag,comm,&recvreqs[i-ndrecvranks]);CHKERRQ(ierr);
+  }
+  /* Data of distinguished ranks is already in place, since their leaf buffers alias the root buffers */
+  for (i=ndsendranks; i<nsendranks; i++) {
+    PetscInt    n = sendoffset[i+1] - sendoffset[i];
+    PetscMPIInt len;
+
+    p = sendbuf + (sendoffset[i]-sendoffset[ndsendranks])*batch->unitbytes;
+    for (k=0; k<batch->nlinks; k++) {
+      PetscSFBasicPack link = batch->links[k];
+      const char       *src = batch->direction == PETSCSF_BASIC_BCAST ? link->root[i] : link->leaf[i];
+
+      ierr = PetscMemcpy(p,src,n*link->unitbytes);CHKERRQ(ierr);
+      p   += n*link->unitbytes;
+    }
+    ierr = PetscMPIIntCast(n*batch->unitbytes,&len);CHKERRQ(ierr);
+    ierr = MPI_Isend(sendbuf+(sendoffset[i]-sendoffset[ndsendranks])*batch->unitbytes,len,MPI_BYTE,sendranks[i],bas->batchtag,comm,&sendreqs[i-ndsendranks]);CHKERRQ(ierr);
+  }
+  batch->inflight = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFBasicPackWaitall(PetscSF sf,PetscSFBasicPack link,PetscSFBasicDirection direction)
+{
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
+  PetscErrorCode ierr;
+  MPI_Request    *reqs;
+
+  PetscFunctionBegin;
+  if (link->batched) {
+    if (bas->batch.active) SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_ARG_WRONGSTATE,"Must call PetscSFBatchEnd() before completing a batched operation");
+    ierr = PetscSFBasicBatchComplete(sf);CHKERRQ(ierr);
+    link->batched = PETSC_FALSE;
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscSFBasicPackGetReqs(sf,link,direction,&reqs,NULL);CHKERRQ(ierr);
+  ierr = MPI_Waitall(bas->niranks+sf->nranks-(bas->ndiranks+sf->ndranks),reqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscSFBasicGetPack(PetscSF sf,MPI_Datatype unit,const void *key,PetscSFBasicPack *mylink)
 {
   PetscSF_Basic    *bas = (PetscSF_Basic*)sf->data;
   PetscErrorCode   ierr;
@@ -792,18 +1052,19 @@ static PetscErrorCode PetscSFBasicGetPack(PetscSF sf,MPI_Datatype unit,const voi
   ierr = PetscNew(&link);CHKERRQ(ierr);
   ierr = PetscSFBasicPackTypeSetup(link,unit);CHKERRQ(ierr);
   ierr = PetscMalloc2(nrootranks,&link->root,nleafranks,&link->leaf);CHKERRQ(ierr);
-  for (i=0; i<nrootranks; i++) {
-    ierr = PetscMalloc((rootoffset[i+1]-rootoffset[i])*link->unitbytes,&link->root[i]);CHKERRQ(ierr);
-  }
+  /* Buffers for all ranks are slices of one allocation so that they can also be addressed by displacement */
+  ierr = PetscMalloc(rootoffset[nrootranks]*link->unitbytes,&link->rootbuf);CHKERRQ(ierr);
+  ierr = PetscMalloc((leafoffset[nleafranks]-leafoffset[ndleafranks])*link->unitbytes,&link->leafbuf);CHKERRQ(ierr);
+  for (i=0; i<nrootranks; i++) link->root[i] = link->rootbuf + rootoffset[i]*link->unitbytes;
   for (i=0; i<nleafranks; i++) {
     if (i < ndleafranks) {      /* Leaf buffers for distinguished ranks are pointers directly into root buffers */
       if (ndrootranks != 1) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Cannot match distinguished ranks");
       link->leaf[i] = link->root[0];
       continue;
     }
-    ierr = PetscMalloc((leafoffset[i+1]-leafoffset[i])*link->unitbytes,&link->leaf[i]);CHKERRQ(ierr);
+    link->leaf[i] = link->leafbuf + (leafoffset[i]-leafoffset[ndleafranks])*link->unitbytes;
   }
-  ierr = PetscCalloc1(nrootranks+nleafranks,&link->requests);CHKERRQ(ierr);
+  ierr = PetscCalloc1(PetscMax(nrootranks+nleafranks,1),&link->requests);CHKERRQ(ierr); /* Neighborhood collectives need a request even without neighbors */
 
 found:
   link->key  = key;
@@ -814,7 +1075,7 @@ found:
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFBasicGetPackInUse(PetscSF sf,MPI_Datatype unit,const void *key,PetscCopyMode cmode,PetscSFBasicPack *mylink)
+PetscErrorCode PetscSFBasicGetPackInUse(PetscSF sf,MPI_Datatype unit,const void *key,PetscCopyMode cmode,PetscSFBasicPack *mylink)
 {
   PetscSF_Basic    *bas = (PetscSF_Basic*)sf->data;
   PetscErrorCode   ierr;
@@ -839,7 +1100,7 @@ static PetscErrorCode PetscSFBasicGetPackInUse(PetscSF sf,MPI_Datatype unit,cons
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFBasicReclaimPack(PetscSF sf,PetscSFBasicPack *link)
+PetscErrorCode PetscSFBasicReclaimPack(PetscSF sf,PetscSFBasicPack *link)
 {
   PetscSF_Basic *bas = (PetscSF_Basic*)sf->data;
 
@@ -853,15 +1114,22 @@ static PetscErrorCode PetscSFBasicReclaimPack(PetscSF sf,PetscSFBasicPack *link)
 
 static PetscErrorCode PetscSFSetFromOptions_Basic(PetscOptionItems *PetscOptionsObject,PetscSF sf)
 {
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   ierr = PetscOptionsHead(PetscOptionsObject,"PetscSF Basic options");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-sf_use_persistent","Use persistent MPI requests (MPI_Send_init/MPI_Recv_init) built once per pack","None",bas->persistent,&bas->persistent,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-sf_use_pack_optimization","Pack contiguous and blocked index ranges with block copies instead of indexed access","None",bas->usepackopt,&bas->usepackopt,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-sf_view_packing","Report in PetscSFView() how the data of each rank is packed","None",bas->viewpackopt,&bas->viewpackopt,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-sf_use_shared_memory","Exchange data with ranks on the same node through MPI-3 shared memory windows","None",bas->useshm,&bas->useshm,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-sf_shared_memory_slots","Number of operations that can use shared memory at the same time","None",bas->shm.nslots,&bas->shm.nslots,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-sf_shared_memory_unit_bytes","Largest unit size in bytes communicated through shared memory","None",bas->shm.unitbytes,&bas->shm.unitbytes,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFReset_Basic(PetscSF sf)
+PetscErrorCode PetscSFReset_Basic(PetscSF sf)
 {
   PetscSF_Basic    *bas = (PetscSF_Basic*)sf->data;
   PetscErrorCode   ierr;
@@ -871,17 +1139,31 @@ static PetscErrorCode PetscSFReset_Basic(PetscSF sf)
   if (bas->inuse) SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_ARG_WRONGSTATE,"Outstanding operation has not been completed");
   ierr = PetscFree2(bas->iranks,bas->ioffset);CHKERRQ(ierr);
   ierr = PetscFree(bas->irootloc);CHKERRQ(ierr);
+  ierr = PetscSFBasicPackOptDestroy(&bas->rootpackopt);CHKERRQ(ierr);
+  ierr = PetscSFBasicPackOptDestroy(&bas->leafpackopt);CHKERRQ(ierr);
+  ierr = PetscFree(bas->batch.links);CHKERRQ(ierr);
+  ierr = PetscFree(bas->batch.rootbuf);CHKERRQ(ierr);
+  ierr = PetscFree(bas->batch.leafbuf);CHKERRQ(ierr);
+  ierr = PetscFree(bas->batch.requests);CHKERRQ(ierr);
+  ierr = PetscMemzero(&bas->batch,sizeof(bas->batch));CHKERRQ(ierr);
   for (link=bas->avail; link; link=next) {
-    PetscInt i;
+    PetscInt i,j;
     next = link->next;
+    for (j=0; j<2; j++) {
+      if (!link->persistent[j]) continue;
+      for (i=0; i<bas->niranks+sf->nranks-(bas->ndiranks+sf->ndranks); i++) {ierr = MPI_Request_free(&link->persistent[j][i]);CHKERRQ(ierr);}
+      ierr = PetscFree(link->persistent[j]);CHKERRQ(ierr);
+    }
     ierr = MPI_Type_free(&link->unit);CHKERRQ(ierr);
-    for (i=0; i<bas->niranks; i++) {ierr = PetscFree(link->root[i]);CHKERRQ(ierr);}
-    for (i=sf->ndranks; i<sf->nranks; i++) {ierr = PetscFree(link->leaf[i]);CHKERRQ(ierr);} /* Free only non-distinguished leaf buffers */
+    ierr = PetscFree(link->rootbuf);CHKERRQ(ierr);
+    ierr = PetscFree(link->leafbuf);CHKERRQ(ierr);
     ierr = PetscFree2(link->root,link->leaf);CHKERRQ(ierr);
     ierr = PetscFree(link->requests);CHKERRQ(ierr);
+    ierr = PetscSFBasicShmPackDestroy(sf,link);CHKERRQ(ierr);
     ierr = PetscFree(link);CHKERRQ(ierr);
   }
   bas->avail = NULL;
+  ierr = PetscSFBasicShmReset(sf);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -895,9 +1177,9 @@ static PetscErrorCode PetscSFDestroy_Basic(PetscSF sf)
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFView_Basic(PetscSF sf,PetscViewer viewer)
+PetscErrorCode PetscSFView_Basic(PetscSF sf,PetscViewer viewer)
 {
-  /* PetscSF_Basic *bas = (PetscSF_Basic*)sf->data; */
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
   PetscErrorCode ierr;
   PetscBool      iascii;
 
@@ -905,6 +1187,31 @@ static PetscErrorCode PetscSFView_Basic(PetscSF sf,PetscViewer viewer)
   ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
   if (iascii) {
     ierr = PetscViewerASCIIPrintf(viewer,"  sort=%s\n",sf->rankorder ? "rank-order" : "unordered");CHKERRQ(ierr);
+    if (bas->persistent) {ierr = PetscViewerASCIIPrintf(viewer,"  using persistent requests\n");CHKERRQ(ierr);}
+    if (bas->useshm) {ierr = PetscViewerASCIIPrintf(viewer,"  using shared memory for on-node ranks\n");CHKERRQ(ierr);}
+    if (bas->viewpackopt && bas->usepackopt && bas->rootpackopt.offset) {
+      PetscMPIInt rank;
+      PetscInt    i,j,count[2][3];
+      const PetscSFBasicPackOpt *opt[2] = {&bas->rootpackopt,&bas->leafpackopt};
+      const PetscInt            nranks[2] = {bas->niranks,sf->nranks},*offset[2] = {bas->ioffset,sf->roffset};
+
+      /* Count the ranks packed by a single copy, by block copies and by indexed access */
+      ierr = PetscMemzero(count,sizeof(count));CHKERRQ(ierr);
+      for (j=0; j<2; j++) {
+        for (i=0; i<nranks[j]; i++) {
+          PetscInt nblocks = opt[j]->offset[i+1] - opt[j]->offset[i];
+          if (nblocks == 1) count[j][0]++;
+          else if (nblocks > 1) count[j][1]++;
+          else if (offset[j][i+1] > offset[j][i]) count[j][2]++;
+        }
+      }
+      ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)sf),&rank);CHKERRQ(ierr);
+      ierr = PetscViewerASCIIPushSynchronized(viewer);CHKERRQ(ierr);
+      ierr = PetscViewerASCIISynchronizedPrintf(viewer,"[%d] Packing root ranks: %D contiguous, %D blocked, %D indexed\n",rank,count[0][0],count[0][1],count[0][2]);CHKERRQ(ierr);
+      ierr = PetscViewerASCIISynchronizedPrintf(viewer,"[%d] Packing leaf ranks: %D contiguous, %D blocked, %D indexed\n",rank,count[1][0],count[1][1],count[1][2]);CHKERRQ(ierr);
+      ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
+      ierr = PetscViewerASCIIPopSynchronized(viewer);CHKERRQ(ierr);
+    }
   }
   PetscFunctionReturn(0);
 }
@@ -916,29 +1223,48 @@ static PetscErrorCode PetscSFBcastBegin_Basic(PetscSF sf,MPI_Datatype unit,const
   PetscErrorCode    ierr;
   PetscSFBasicPack  link;
   PetscInt          i,nrootranks,ndrootranks,nleafranks,ndleafranks;
-  const PetscInt    *rootoffset,*leafoffset,*rootloc,*leafloc;
+  const PetscInt    *rootoffset,*leafoffset;
   const PetscMPIInt *rootranks,*leafranks;
   MPI_Request       *rootreqs,*leafreqs;
 
   PetscFunctionBegin;
-  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,&rootloc);CHKERRQ(ierr);
-  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,&leafloc);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,NULL);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,NULL);CHKERRQ(ierr);
   ierr = PetscSFBasicGetPack(sf,unit,rootdata,&link);CHKERRQ(ierr);
 
-  ierr = PetscSFBasicPackGetReqs(sf,link,&rootreqs,&leafreqs);CHKERRQ(ierr);
+  if (bas->batch.active) {
+    for (i=0; i<nrootranks; i++) {
+      ierr = PetscSFBasicPackRootRank(sf,link,i,rootdata);CHKERRQ(ierr);
+    }
+    ierr = PetscSFBasicBatchAddPack(sf,link,PETSCSF_BASIC_BCAST);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscSFBasicPackGetReqs(sf,link,PETSCSF_BASIC_BCAST,&rootreqs,&leafreqs);CHKERRQ(ierr);
+  if (bas->persistent) {
+    /* Requests are bound to the pack buffers, so we only need to pack before starting the sends */
+    ierr = MPI_Startall(nleafranks-ndleafranks,leafreqs);CHKERRQ(ierr);
+    for (i=0; i<nrootranks; i++) {
+      ierr = PetscSFBasicPackRootRank(sf,link,i,rootdata);CHKERRQ(ierr);
+    }
+    ierr = MPI_Startall(nrootranks-ndrootranks,rootreqs);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscSFBasicShmBegin(sf,link,PETSCSF_BASIC_BCAST,leafreqs);CHKERRQ(ierr);
   /* Eagerly post leaf receives, but only from non-distinguished ranks -- distinguished ranks will receive via shared memory */
   for (i=ndleafranks; i<nleafranks; i++) {
     PetscMPIInt n = leafoffset[i+1] - leafoffset[i];
+    if (PetscSFBasicShmOnNode(link,bas->shm.leafpeers,i)) continue; /* posted by PetscSFBasicShmBegin() */
     ierr = MPI_Irecv(link->leaf[i],n,unit,leafranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&leafreqs[i-ndleafranks]);CHKERRQ(ierr);
   }
   /* Pack and send root data */
   for (i=0; i<nrootranks; i++) {
     PetscMPIInt n          = rootoffset[i+1] - rootoffset[i];
     void        *packstart = link->root[i];
-    (*link->Pack)(n,link->bs,rootloc+rootoffset[i],rootdata,packstart);
-    if (i < ndrootranks) continue; /* shared memory */
+    ierr = PetscSFBasicPackRootRank(sf,link,i,rootdata);CHKERRQ(ierr);
+    if (i < ndrootranks || PetscSFBasicShmOnNode(link,bas->shm.rootpeers,i)) continue; /* shared memory */
     ierr = MPI_Isend(packstart,n,unit,rootranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&rootreqs[i-ndrootranks]);CHKERRQ(ierr);
   }
+  ierr = PetscSFBasicShmNotify(sf,link,PETSCSF_BASIC_BCAST,rootreqs);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -946,68 +1272,92 @@ PetscErrorCode PetscSFBcastEnd_Basic(PetscSF sf,MPI_Datatype unit,const void *ro
 {
   PetscErrorCode   ierr;
   PetscSFBasicPack link;
-  PetscInt         i,nleafranks,ndleafranks;
-  const PetscInt   *leafoffset,*leafloc;
+  PetscInt         i,nleafranks;
 
   PetscFunctionBegin;
   ierr = PetscSFBasicGetPackInUse(sf,unit,rootdata,PETSC_OWN_POINTER,&link);CHKERRQ(ierr);
-  ierr = PetscSFBasicPackWaitall(sf,link);CHKERRQ(ierr);
-  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,NULL,&leafoffset,&leafloc);CHKERRQ(ierr);
+  ierr = PetscSFBasicPackWaitall(sf,link,PETSCSF_BASIC_BCAST);CHKERRQ(ierr);
+  ierr = PetscSFBasicShmComplete(sf,link,PETSCSF_BASIC_BCAST);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
   for (i=0; i<nleafranks; i++) {
-    PetscMPIInt n          = leafoffset[i+1] - leafoffset[i];
-    const void  *packstart = link->leaf[i];
-    (*link->UnpackInsert)(n,link->bs,leafloc+leafoffset[i],leafdata,packstart);
+    ierr = PetscSFBasicUnpackLeafRank(sf,link,i,leafdata);CHKERRQ(ierr);
   }
+  ierr = PetscSFBasicShmEnd(sf,link,PETSCSF_BASIC_BCAST);CHKERRQ(ierr);
   ierr = PetscSFBasicReclaimPack(sf,&link);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
-/* leaf -> root with reduction */
-PetscErrorCode PetscSFReduceBegin_Basic(PetscSF sf,MPI_Datatype unit,const void *leafdata,void *rootdata,MPI_Op op)
+/* leaf -> root with reduction, on-node ranks go through shared memory if useshm is set */
+static PetscErrorCode PetscSFBasicReduceBegin_Private(PetscSF sf,MPI_Datatype unit,const void *leafdata,void *rootdata,MPI_Op op,PetscBool useshm)
 {
   PetscSF_Basic     *bas = (PetscSF_Basic*)sf->data;
   PetscSFBasicPack  link;
   PetscErrorCode    ierr;
   PetscInt          i,nrootranks,ndrootranks,nleafranks,ndleafranks;
-  const PetscInt    *rootoffset,*leafoffset,*rootloc,*leafloc;
+  const PetscInt    *rootoffset,*leafoffset;
   const PetscMPIInt *rootranks,*leafranks;
   MPI_Request       *rootreqs,*leafreqs;
 
   PetscFunctionBegin;
-  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,&rootloc);CHKERRQ(ierr);
-  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,&leafloc);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,NULL);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,NULL);CHKERRQ(ierr);
   ierr = PetscSFBasicGetPack(sf,unit,rootdata,&link);CHKERRQ(ierr);
 
-  ierr = PetscSFBasicPackGetReqs(sf,link,&rootreqs,&leafreqs);CHKERRQ(ierr);
+  if (bas->batch.active) {
+    for (i=0; i<nleafranks; i++) {
+      ierr = PetscSFBasicPackLeafRank(sf,link,i,leafdata);CHKERRQ(ierr);
+    }
+    ierr = PetscSFBasicBatchAddPack(sf,link,PETSCSF_BASIC_REDUCE);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscSFBasicPackGetReqs(sf,link,PETSCSF_BASIC_REDUCE,&rootreqs,&leafreqs);CHKERRQ(ierr);
+  if (bas->persistent) {
+    ierr = MPI_Startall(nrootranks-ndrootranks,rootreqs);CHKERRQ(ierr);
+    for (i=0; i<nleafranks; i++) {
+      ierr = PetscSFBasicPackLeafRank(sf,link,i,leafdata);CHKERRQ(ierr);
+    }
+    ierr = MPI_Startall(nleafranks-ndleafranks,leafreqs);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (useshm) {ierr = PetscSFBasicShmBegin(sf,link,PETSCSF_BASIC_REDUCE,rootreqs);CHKERRQ(ierr);}
   /* Eagerly post root receives for non-distinguished ranks */
   for (i=ndrootranks; i<nrootranks; i++) {
     PetscMPIInt n = rootoffset[i+1] - rootoffset[i];
+    if (PetscSFBasicShmOnNode(link,bas->shm.rootpeers,i)) continue; /* posted by PetscSFBasicShmBegin() */
     ierr = MPI_Irecv(link->root[i],n,unit,rootranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&rootreqs[i-ndrootranks]);CHKERRQ(ierr);
   }
   /* Pack and send leaf data */
   for (i=0; i<nleafranks; i++) {
     PetscMPIInt n          = leafoffset[i+1] - leafoffset[i];
     void        *packstart = link->leaf[i];
-    (*link->Pack)(n,link->bs,leafloc+leafoffset[i],leafdata,packstart);
-    if (i < ndleafranks) continue; /* shared memory */
+    ierr = PetscSFBasicPackLeafRank(sf,link,i,leafdata);CHKERRQ(ierr);
+    if (i < ndleafranks || PetscSFBasicShmOnNode(link,bas->shm.leafpeers,i)) continue; /* shared memory */
     ierr = MPI_Isend(packstart,n,unit,leafranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&leafreqs[i-ndleafranks]);CHKERRQ(ierr);
   }
+  ierr = PetscSFBasicShmNotify(sf,link,PETSCSF_BASIC_REDUCE,leafreqs);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFReduceEnd_Basic(PetscSF sf,MPI_Datatype unit,const void *leafdata,void *rootdata,MPI_Op op)
+PetscErrorCode PetscSFReduceBegin_Basic(PetscSF sf,MPI_Datatype unit,const void *leafdata,void *rootdata,MPI_Op op)
 {
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicReduceBegin_Private(sf,unit,leafdata,rootdata,op,PETSC_TRUE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Reduce packed root data that has arrived in the buffers of link into rootdata */
+PetscErrorCode PetscSFBasicUnpackRootsAndOp(PetscSF sf,PetscSFBasicPack link,MPI_Datatype unit,void *rootdata,MPI_Op op)
+{
+  PetscSF_Basic    *bas = (PetscSF_Basic*)sf->data;
   void             (*UnpackOp)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
   PetscErrorCode   ierr;
-  PetscSFBasicPack link;
   PetscInt         i,nrootranks;
   PetscMPIInt      typesize = -1;
   const PetscInt   *rootoffset,*rootloc;
 
   PetscFunctionBegin;
-  ierr = PetscSFBasicGetPackInUse(sf,unit,rootdata,PETSC_OWN_POINTER,&link);CHKERRQ(ierr);
-  /* This implementation could be changed to unpack as receives arrive, at the cost of non-determinism */
-  ierr = PetscSFBasicPackWaitall(sf,link);CHKERRQ(ierr);
   ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,NULL,NULL,&rootoffset,&rootloc);CHKERRQ(ierr);
   ierr = PetscSFBasicPackGetUnpackOp(sf,link,op,&UnpackOp);CHKERRQ(ierr);
   if (UnpackOp) {
@@ -1021,7 +1371,7 @@ static PetscErrorCode PetscSFReduceEnd_Basic(PetscSF sf,MPI_Datatype unit,const
     char *packstart = (char *) link->root[i];
 
     if (UnpackOp) {
-      (*UnpackOp)(n,link->bs,rootloc+rootoffset[i],rootdata,(const void *)packstart);
+      ierr = PetscSFBasicUnpackRank_Private(link,bas->usepackopt ? &bas->rootpackopt : NULL,i,n,rootloc+rootoffset[i],rootdata,(const void *)packstart,UnpackOp);CHKERRQ(ierr);
     }
 #if defined(PETSC_HAVE_MPI_REDUCE_LOCAL)
     else if (n) { /* the op should be defined to operate on the whole datatype, so we ignore link->bs */
@@ -1037,6 +1387,21 @@ static PetscErrorCode PetscSFReduceEnd_Basic(PetscSF sf,MPI_Datatype unit,const
     }
 #endif
   }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFReduceEnd_Basic(PetscSF sf,MPI_Datatype unit,const void *leafdata,void *rootdata,MPI_Op op)
+{
+  PetscErrorCode   ierr;
+  PetscSFBasicPack link;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetPackInUse(sf,unit,rootdata,PETSC_OWN_POINTER,&link);CHKERRQ(ierr);
+  /* This implementation could be changed to unpack as receives arrive, at the cost of non-determinism */
+  ierr = PetscSFBasicPackWaitall(sf,link,PETSCSF_BASIC_REDUCE);CHKERRQ(ierr);
+  ierr = PetscSFBasicShmComplete(sf,link,PETSCSF_BASIC_REDUCE);CHKERRQ(ierr);
+  ierr = PetscSFBasicUnpackRootsAndOp(sf,link,unit,rootdata,op);CHKERRQ(ierr);
+  ierr = PetscSFBasicShmEnd(sf,link,PETSCSF_BASIC_REDUCE);CHKERRQ(ierr);
   ierr = PetscSFBasicReclaimPack(sf,&link);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -1046,7 +1411,8 @@ static PetscErrorCode PetscSFFetchAndOpBegin_Basic(PetscSF sf,MPI_Datatype unit,
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  ierr = PetscSFReduceBegin_Basic(sf,unit,leafdata,rootdata,op);CHKERRQ(ierr);
+  /* The root data is updated in place and sent back, which the shared memory slots do not support */
+  ierr = PetscSFBasicReduceBegin_Private(sf,unit,leafdata,rootdata,op,PETSC_FALSE);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1057,21 +1423,24 @@ static PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF sf,MPI_Datatype unit,vo
   PetscErrorCode    ierr;
   PetscSFBasicPack  link;
   PetscInt          i,nrootranks,ndrootranks,nleafranks,ndleafranks;
-  const PetscInt    *rootoffset,*leafoffset,*rootloc,*leafloc;
+  const PetscInt    *rootoffset,*leafoffset,*rootloc;
   const PetscMPIInt *rootranks,*leafranks;
   MPI_Request       *rootreqs,*leafreqs;
 
   PetscFunctionBegin;
   ierr = PetscSFBasicGetPackInUse(sf,unit,rootdata,PETSC_OWN_POINTER,&link);CHKERRQ(ierr);
   /* This implementation could be changed to unpack as receives arrive, at the cost of non-determinism */
-  ierr      = PetscSFBasicPackWaitall(sf,link);CHKERRQ(ierr);
+  ierr      = PetscSFBasicPackWaitall(sf,link,PETSCSF_BASIC_REDUCE);CHKERRQ(ierr);
   ierr      = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,&rootloc);CHKERRQ(ierr);
-  ierr      = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,&leafloc);CHKERRQ(ierr);
-  ierr      = PetscSFBasicPackGetReqs(sf,link,&rootreqs,&leafreqs);CHKERRQ(ierr);
+  ierr      = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,NULL);CHKERRQ(ierr);
+  ierr      = PetscSFBasicPackGetReqs(sf,link,PETSCSF_BASIC_BCAST,&rootreqs,&leafreqs);CHKERRQ(ierr);
   /* Post leaf receives */
-  for (i=ndleafranks; i<nleafranks; i++) {
-    PetscMPIInt n = leafoffset[i+1] - leafoffset[i];
-    ierr = MPI_Irecv(link->leaf[i],n,unit,leafranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&leafreqs[i-ndleafranks]);CHKERRQ(ierr);
+  if (bas->persistent) {ierr = MPI_Startall(nleafranks-ndleafranks,leafreqs);CHKERRQ(ierr);}
+  else {
+    for (i=ndleafranks; i<nleafranks; i++) {
+      PetscMPIInt n = leafoffset[i+1] - leafoffset[i];
+      ierr = MPI_Irecv(link->leaf[i],n,unit,leafranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&leafreqs[i-ndleafranks]);CHKERRQ(ierr);
+    }
   }
   /* Process local fetch-and-op, post root sends */
   ierr = PetscSFBasicPackGetFetchAndOp(sf,link,op,&FetchAndOp);CHKERRQ(ierr);
@@ -1080,14 +1449,13 @@ static PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF sf,MPI_Datatype unit,vo
     void        *packstart = link->root[i];
 
     (*FetchAndOp)(n,link->bs,rootloc+rootoffset[i],rootdata,packstart);
-    if (i < ndrootranks) continue; /* shared memory */
+    if (i < ndrootranks || bas->persistent) continue; /* shared memory or started below */
     ierr = MPI_Isend(packstart,n,unit,rootranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&rootreqs[i-ndrootranks]);CHKERRQ(ierr);
   }
-  ierr = PetscSFBasicPackWaitall(sf,link);CHKERRQ(ierr);
+  if (bas->persistent) {ierr = MPI_Startall(nrootranks-ndrootranks,rootreqs);CHKERRQ(ierr);}
+  ierr = PetscSFBasicPackWaitall(sf,link,PETSCSF_BASIC_BCAST);CHKERRQ(ierr);
   for (i=0; i<nleafranks; i++) {
-    PetscMPIInt n          = leafoffset[i+1] - leafoffset[i];
-    const void  *packstart = link->leaf[i];
-    (*link->UnpackInsert)(n,link->bs,leafloc+leafoffset[i],leafupdate,packstart);
+    ierr = PetscSFBasicUnpackLeafRank(sf,link,i,leafupdate);CHKERRQ(ierr);
   }
   ierr = PetscSFBasicReclaimPack(sf,&link);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -1110,8 +1478,13 @@ PETSC_EXTERN PetscErrorCode PetscSFCreate_Basic(PetscSF sf)
   sf->ops->ReduceEnd       = PetscSFReduceEnd_Basic;
   sf->ops->FetchAndOpBegin = PetscSFFetchAndOpBegin_Basic;
   sf->ops->FetchAndOpEnd   = PetscSFFetchAndOpEnd_Basic;
+  sf->ops->BatchBegin      = PetscSFBatchBegin_Basic;
+  sf->ops->BatchEnd        = PetscSFBatchEnd_Basic;
 
   ierr = PetscNewLog(sf,&bas);CHKERRQ(ierr);
+  bas->usepackopt    = PETSC_TRUE;
+  bas->shm.nslots    = 4;
+  bas->shm.unitbytes = 2*sizeof(PetscScalar);
   sf->data = (void*)bas;
   PetscFunctionReturn(0);
 }
@@ -0,0 +1,153 @@
+#if !defined(__SFBASIC_H)
+#define __SFBASIC_H
+
+#include <petsc/private/sfimpl.h>
+
+typedef struct _n_PetscSFBasicPack *PetscSFBasicPack;
+struct _n_PetscSFBasicPack {
+  void (*Pack)(PetscInt,PetscInt,const PetscInt*,const void*,void*);
+  void (*UnpackInsert)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+  void (*UnpackAdd)(PetscInt,PetscInt,const PetscInt*,void*,const void*); /* Accepts NULL indices for consecutive entries */
+  void (*UnpackMin)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+  void (*UnpackMax)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+  void (*UnpackMinloc)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+  void (*UnpackMaxloc)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+  void (*UnpackMult)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*UnpackLAND)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*UnpackBAND)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*UnpackLOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*UnpackBOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*UnpackLXOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*UnpackBXOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*FetchAndInsert)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndAdd)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndMin)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndMax)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndMinloc)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndMaxloc)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndMult)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndLAND)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndBAND)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndLOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndBOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndLXOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndBXOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+
+  MPI_Datatype     unit;
+  size_t           unitbytes;   /* Number of bytes in a unit */
+  PetscInt         bs;          /* Number of basic units in a unit */
+  const void       *key;        /* Array used as key for operation */
+  char             *rootbuf;    /* Contiguous storage for all packed root data */
+  char             *leafbuf;    /* Contiguous storage for packed leaf data of non-distinguished ranks */
+  char             **root;      /* Packed root data, indexed by leaf rank */
+  char             **leaf;      /* Packed leaf data, indexed by root rank */
+  MPI_Request      *requests;   /* Array of root requests followed by leaf requests */
+  MPI_Request      *persistent[2]; /* Persistent root requests followed by leaf requests for each direction, lazily constructed */
+  PetscBool        batched;     /* Communication is done by a batch, until the operation is completed */
+  PetscBool        shm;         /* Data of on-node ranks goes through shared memory in the current operation */
+  PetscInt         shmslot;     /* Slot of the shared memory window written by this operation, or -1 */
+  char             *shmbuf;     /* Messages to and from on-node ranks: a header holding the slot, followed by the data if there is no slot */
+  MPI_Request      *shmreqs;    /* Outstanding header sends and acknowledgments, for on-node root ranks followed by on-node leaf ranks */
+  PetscSFBasicPack next;
+};
+
+typedef enum {PETSCSF_BASIC_BCAST=0,PETSCSF_BASIC_REDUCE=1} PetscSFBasicDirection;
+
+/* Operations started between PetscSFBatchBegin() and PetscSFBatchEnd() share one message per rank */
+typedef struct {
+  PetscBool             active;     /* Between PetscSFBatchBegin() and PetscSFBatchEnd() */
+  PetscBool             inflight;   /* Messages have been sent but not yet distributed to the links */
+  PetscSFBasicDirection direction;
+  PetscInt              nlinks,maxlinks;
+  PetscSFBasicPack      *links;     /* Links in the batch, in the order their data is laid out in each message */
+  size_t                unitbytes;  /* Sum of unitbytes over links, so the message for a rank holds n*unitbytes bytes */
+  size_t                rootlen,leaflen;
+  char                  *rootbuf;   /* Coalesced root data of the non-distinguished ranks */
+  char                  *leafbuf;   /* Coalesced leaf data of the non-distinguished ranks */
+  MPI_Request           *requests;  /* Root requests followed by leaf requests */
+} PetscSFBasicBatch;
+
+/* Entries exchanged with each rank, described as blocks of consecutive indices so packing can bypass the index array.
+   A rank with one block is contiguous; a rank without blocks uses indexed access, because its blocks are too short to pay off. */
+typedef struct {
+  PetscInt *offset;             /* Array of length nranks+1 holding offset in start[] and len[] for each rank */
+  PetscInt *start;              /* First index of each block */
+  PetscInt *len;                /* Number of consecutive indices in each block */
+} PetscSFBasicPackOpt;
+
+/* On-node rank that exchanges data with this process through a shared memory window */
+typedef struct {
+  PetscMPIInt rank;             /* Rank in the shared memory communicator, or MPI_PROC_NULL if the rank is off-node */
+  PetscInt    index;            /* Position of this rank among the on-node ranks, root ranks first */
+  PetscInt    offset;           /* Offset in units of the data for this rank in my slots and messages */
+  PetscInt    peeroffset;       /* Offset in units of my data in the slots of this rank */
+  char        *base;            /* Slots of this rank */
+  size_t      slotbytes;        /* Size of each slot of this rank */
+} PetscSFBasicShmPeer;
+
+/* Shared memory window split in slots, each slot holding the packed data of one operation for all on-node ranks */
+typedef struct {
+  PetscMPIInt         tag;            /* Tag for acknowledgments that a slot has been read */
+  MPI_Comm            comm;           /* Communicator of the ranks sharing memory with this process, owned by the PetscShmComm */
+  MPI_Win             win;
+  char                *base;          /* My slots */
+  size_t              slotbytes;
+  PetscInt            unitbytes;      /* Largest unit size that fits in the slots */
+  PetscInt            nslots;
+  PetscInt            *pending;       /* Number of outstanding acknowledgments for each slot */
+  PetscBool           *busy;          /* Slot is written by an operation that has not completed */
+  PetscInt            npeers;         /* Number of on-node root ranks plus number of on-node leaf ranks */
+  PetscInt            units;          /* Total number of units of all on-node ranks */
+  PetscSFBasicShmPeer *rootpeers;     /* Indexed by root rank */
+  PetscSFBasicShmPeer *leafpeers;     /* Indexed by leaf rank */
+} PetscSFBasicShm;
+
+/* Whether the data of root or leaf rank i goes through shared memory in the current operation of link */
+#define PetscSFBasicShmOnNode(link,peers,i) ((link)->shm && (peers)[i].rank != MPI_PROC_NULL)
+
+#define SFBASICHEADER \
+  PetscMPIInt      tag;                                                                            \
+  PetscMPIInt      niranks;     /* Number of incoming ranks (ranks accessing my roots) */           \
+  PetscMPIInt      ndiranks;    /* Number of incoming ranks (ranks accessing my roots) in distinguished set */ \
+  PetscMPIInt      *iranks;     /* Array of ranks that reference my roots */                        \
+  PetscInt         itotal;      /* Total number of graph edges referencing my roots */              \
+  PetscInt         *ioffset;    /* Array of length niranks+1 holding offset in irootloc[] for each rank */ \
+  PetscInt         *irootloc;   /* Incoming roots referenced by ranks starting at ioffset[rank] */  \
+  PetscSFBasicPack avail;       /* One or more entries per MPI Datatype, lazily constructed */      \
+  PetscSFBasicPack inuse;       /* Buffers being used for transactions that have not yet completed */ \
+  PetscBool        persistent;  /* Communicate with persistent requests bound to the pack buffers */       \
+  PetscMPIInt      batchtag;    /* Tag for coalesced messages, so they cannot match unbatched operations */ \
+  PetscSFBasicBatch batch;                                                                         \
+  PetscBool        usepackopt;  /* Pack and unpack by blocks where rootpackopt and leafpackopt allow */ \
+  PetscBool        viewpackopt; /* Report the packing of each rank in PetscSFView() */             \
+  PetscSFBasicPackOpt rootpackopt; /* Layout of irootloc[] for each root rank */                    \
+  PetscSFBasicPackOpt leafpackopt; /* Layout of sf->rmine[] for each leaf rank */                  \
+  PetscBool        useshm;      /* Exchange data with on-node ranks through shared memory */       \
+  PetscSFBasicShm  shm
+
+typedef struct {
+  SFBASICHEADER;
+} PetscSF_Basic;
+
+PETSC_INTERN PetscErrorCode PetscSFSetUp_Basic(PetscSF);
+PETSC_INTERN PetscErrorCode PetscSFReset_Basic(PetscSF);
+PETSC_INTERN PetscErrorCode PetscSFView_Basic(PetscSF,PetscViewer);
+PETSC_INTERN PetscErrorCode PetscSFBasicGetRootInfo(PetscSF,PetscInt*,PetscInt*,const PetscMPIInt**,const PetscInt**,const PetscInt**);
+PETSC_INTERN PetscErrorCode PetscSFBasicGetLeafInfo(PetscSF,PetscInt*,PetscInt*,const PetscMPIInt**,const PetscInt**,const PetscInt**);
+PETSC_INTERN PetscErrorCode PetscSFBasicGetPack(PetscSF,MPI_Datatype,const void*,PetscSFBasicPack*);
+PETSC_INTERN PetscErrorCode PetscSFBasicGetPackInUse(PetscSF,MPI_Datatype,const void*,PetscCopyMode,PetscSFBasicPack*);
+PETSC_INTERN PetscErrorCode PetscSFBasicReclaimPack(PetscSF,PetscSFBasicPack*);
+PETSC_INTERN PetscErrorCode PetscSFBasicPackGetFetchAndOp(PetscSF,PetscSFBasicPack,MPI_Op,void (**)(PetscInt,PetscInt,const PetscInt*,void*,void*));
+PETSC_INTERN PetscErrorCode PetscSFBasicPackRootRank(PetscSF,PetscSFBasicPack,PetscInt,const void*);
+PETSC_INTERN PetscErrorCode PetscSFBasicPackLeafRank(PetscSF,PetscSFBasicPack,PetscInt,const void*);
+PETSC_INTERN PetscErrorCode PetscSFBasicUnpackLeafRank(PetscSF,PetscSFBasicPack,PetscInt,void*);
+PETSC_INTERN PetscErrorCode PetscSFBasicShmSetUp(PetscSF);
+PETSC_INTERN PetscErrorCode PetscSFBasicShmReset(PetscSF);
+PETSC_INTERN PetscErrorCode PetscSFBasicShmPackDestroy(PetscSF,PetscSFBasicPack);
+PETSC_INTERN PetscErrorCode PetscSFBasicShmBegin(PetscSF,PetscSFBasicPack,PetscSFBasicDirection,MPI_Request*);
+PETSC_INTERN PetscErrorCode PetscSFBasicShmNotify(PetscSF,PetscSFBasicPack,PetscSFBasicDirection,MPI_Request*);
+PETSC_INTERN PetscErrorCode PetscSFBasicShmComplete(PetscSF,PetscSFBasicPack,PetscSFBasicDirection);
+PETSC_INTERN PetscErrorCode PetscSFBasicShmEnd(PetscSF,PetscSFBasicPack,PetscSFBasicDirection);
+PETSC_INTERN PetscErrorCode PetscSFBasicUnpackRootsAndOp(PetscSF,PetscSFBasicPack,MPI_Datatype,void*,MPI_Op);
+
+#endif
@@ -0,0 +1,396 @@
+/*
+   On-node communication for PetscSF basic through MPI-3 shared memory windows.
+
+   Root and leaf arrays belong to the user, so they cannot be exposed in a window. Instead each process owns a window
+   split into slots, and an operation packs the data for its on-node ranks directly into one of its slots rather than
+   into a message buffer. The receiving ranks unpack straight out of the slot, so the data is copied once instead of
+   going through the MPI transport. Synchronization uses a small header message carrying the slot number, sent on the
+   same tag and in the same order as the regular messages, and an acknowledgment sent back once the slot has been read.
+   When no slot is free, the data travels in the header message itself, so operations never block on each other.
+*/
+#include <../src/vec/is/sf/impls/basic/sfbasic.h>
+
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
+/* Size of the header in front of each message, keeping the data aligned */
+#define PETSCSF_BASIC_SHM_HEADER PETSC_MEMALIGN
+
+PetscErrorCode PetscSFBasicShmSetUp(PetscSF sf)
+{
+  PetscSF_Basic     *bas = (PetscSF_Basic*)sf->data;
+  PetscSFBasicShm   *shm = &bas->shm;
+  PetscErrorCode    ierr;
+  MPI_Comm          comm;
+  PetscShmComm      pshmcomm;
+  MPI_Info          info;
+  MPI_Request       *reqs;
+  PetscInt          *sendinfo,*recvinfo;
+  PetscInt          i,nrootranks,ndrootranks,nleafranks,ndleafranks,nreqs = 0;
+  const PetscInt    *rootoffset,*leafoffset;
+  const PetscMPIInt *rootranks,*leafranks;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)sf,&comm);CHKERRQ(ierr);
+  if (bas->persistent) SETERRQ(comm,PETSC_ERR_SUP,"Shared memory communication cannot be combined with persistent requests");
+  if (shm->nslots < 1) SETERRQ1(comm,PETSC_ERR_ARG_OUTOFRANGE,"Number of shared memory slots %D must be positive",shm->nslots);
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,NULL);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,NULL);CHKERRQ(ierr);
+  ierr = PetscObjectGetNewTag((PetscObject)sf,&shm->tag);CHKERRQ(ierr);
+  ierr = PetscShmCommGet(comm,&pshmcomm);CHKERRQ(ierr);
+  ierr = PetscShmCommGetMpiShmComm(pshmcomm,&shm->comm);CHKERRQ(ierr);
+
+  /* Lay out the data of the on-node ranks one after the other, root ranks first */
+  ierr = PetscCalloc2(nrootranks,&shm->rootpeers,nleafranks,&shm->leafpeers);CHKERRQ(ierr);
+  shm->npeers = 0;
+  shm->units  = 0;
+  for (i=0; i<nrootranks; i++) {
+    PetscSFBasicShmPeer *peer = &shm->rootpeers[i];
+    peer->rank = MPI_PROC_NULL;
+    if (i < ndrootranks) continue;
+    ierr = PetscShmCommGlobalToLocal(pshmcomm,rootranks[i],&peer->rank);CHKERRQ(ierr);
+    if (peer->rank == MPI_PROC_NULL) continue;
+    peer->index  = shm->npeers++;
+    peer->offset = shm->units;
+    shm->units  += rootoffset[i+1] - rootoffset[i];
+  }
+  for (i=0; i<nleafranks; i++) {
+    PetscSFBasicShmPeer *peer = &shm->leafpeers[i];
+    peer->rank = MPI_PROC_NULL;
+    if (i < ndleafranks) continue;
+    ierr = PetscShmCommGlobalToLocal(pshmcomm,leafranks[i],&peer->rank);CHKERRQ(ierr);
+    if (peer->rank == MPI_PROC_NULL) continue;
+    peer->index  = shm->npeers++;
+    peer->offset = shm->units;
+    shm->units  += leafoffset[i+1] - leafoffset[i];
+  }
+
+  /* Round the slots up to a cache line so concurrent operations do not share lines */
+  shm->slotbytes = ((shm->units*(size_t)shm->unitbytes + 63)/64)*64;
+
+  /* Tell each on-node rank where its data lives in my slots, since the segments of the window may be padded. The
+     message from a root rank to a leaf rank goes on bas->tag and the one from a leaf rank to a root rank on shm->tag,
+     so they cannot be confused when two ranks are both roots and leaves of each other. */
+  ierr = PetscMalloc3(2*shm->npeers,&reqs,2*shm->npeers,&sendinfo,2*shm->npeers,&recvinfo);CHKERRQ(ierr);
+  for (i=0; i<nrootranks+nleafranks; i++) {
+    PetscSFBasicShmPeer *peer = i < nrootranks ? &shm->rootpeers[i] : &shm->leafpeers[i-nrootranks];
+    PetscMPIInt         rank  = i < nrootranks ? rootranks[i] : leafranks[i-nrootranks];
+    if (peer->rank == MPI_PROC_NULL) continue;
+    sendinfo[2*peer->index]   = peer->offset;
+    sendinfo[2*peer->index+1] = (PetscInt)shm->slotbytes;
+    ierr = MPI_Irecv(&recvinfo[2*peer->index],2,MPIU_INT,rank,i < nrootranks ? shm->tag : bas->tag,comm,&reqs[nreqs++]);CHKERRQ(ierr);
+    ierr = MPI_Isend(&sendinfo[2*peer->index],2,MPIU_INT,rank,i < nrootranks ? bas->tag : shm->tag,comm,&reqs[nreqs++]);CHKERRQ(ierr);
+  }
+
+  ierr = MPI_Info_create(&info);CHKERRQ(ierr);
+  ierr = MPI_Info_set(info,"alloc_shared_noncontig","true");CHKERRQ(ierr);
+  ierr = MPI_Win_allocate_shared((MPI_Aint)(shm->nslots*shm->slotbytes),1,info,shm->comm,&shm->base,&shm->win);CHKERRQ(ierr);
+  ierr = MPI_Info_free(&info);CHKERRQ(ierr);
+  ierr = MPI_Win_lock_all(MPI_MODE_NOCHECK,shm->win);CHKERRQ(ierr);
+  ierr = MPI_Waitall(nreqs,reqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  for (i=0; i<nrootranks+nleafranks; i++) {
+    PetscSFBasicShmPeer *peer = i < nrootranks ? &shm->rootpeers[i] : &shm->leafpeers[i-nrootranks];
+    MPI_Aint            size;
+    PetscMPIInt         dispunit;
+    if (peer->rank == MPI_PROC_NULL) continue;
+    ierr = MPI_Win_shared_query(shm->win,peer->rank,&size,&dispunit,&peer->base);CHKERRQ(ierr);
+    peer->peeroffset = recvinfo[2*peer->index];
+    peer->slotbytes  = (size_t)recvinfo[2*peer->index+1];
+  }
+  ierr = PetscFree3(reqs,sendinfo,recvinfo);CHKERRQ(ierr);
+  ierr = PetscCalloc2(shm->nslots,&shm->pending,shm->nslots,&shm->busy);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscSFBasicShmReset(PetscSF sf)
+{
+  PetscSF_Basic   *bas = (PetscSF_Basic*)sf->data;
+  PetscSFBasicShm *shm = &bas->shm;
+  PetscErrorCode  ierr;
+  PetscInt        s,npending = 0;
+  PetscMPIInt     slot;
+
+  PetscFunctionBegin;
+  if (!shm->pending) PetscFunctionReturn(0);
+  /* On-node ranks may still be reading my slots in place, wait until they are done before freeing the window */
+  for (s=0; s<shm->nslots; s++) npending += shm->pending[s];
+  for (; npending>0; npending--) {
+    ierr = MPI_Recv(&slot,1,MPI_INT,MPI_ANY_SOURCE,shm->tag,PetscObjectComm((PetscObject)sf),MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  }
+  ierr = MPI_Win_unlock_all(shm->win);CHKERRQ(ierr);
+  ierr = MPI_Win_free(&shm->win);CHKERRQ(ierr);
+  ierr = PetscFree2(shm->rootpeers,shm->leafpeers);CHKERRQ(ierr);
+  ierr = PetscFree2(shm->pending,shm->busy);CHKERRQ(ierr);
+  shm->base   = NULL;
+  shm->npeers = 0;
+  shm->units  = 0;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscSFBasicShmPackDestroy(PetscSF sf,PetscSFBasicPack link)
+{
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!link->shmreqs) PetscFunctionReturn(0);
+  ierr = MPI_Waitall(bas->shm.npeers,link->shmreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  ierr = PetscFree(link->shmreqs);CHKERRQ(ierr);
+  ierr = PetscFree(link->shmbuf);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Collect the acknowledgments that have arrived, without blocking */
+static PetscErrorCode PetscSFBasicShmProgress(PetscSF sf)
+{
+  PetscSF_Basic   *bas = (PetscSF_Basic*)sf->data;
+  PetscSFBasicShm *shm = &bas->shm;
+  PetscErrorCode  ierr;
+  MPI_Comm        comm = PetscObjectComm((PetscObject)sf);
+  MPI_Status      status;
+  PetscMPIInt     flag,slot;
+
+  PetscFunctionBegin;
+  for (;;) {
+    ierr = MPI_Iprobe(MPI_ANY_SOURCE,shm->tag,comm,&flag,&status);CHKERRQ(ierr);
+    if (!flag) break;
+    ierr = MPI_Recv(&slot,1,MPI_INT,status.MPI_SOURCE,shm->tag,comm,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+    shm->pending[slot]--;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Message to or from an on-node rank in link->shmbuf, the data follows the header */
+PETSC_STATIC_INLINE char *PetscSFBasicShmMessage(PetscSFBasicPack link,const PetscSFBasicShmPeer *peer)
+{
+  return link->shmbuf + peer->index*PETSCSF_BASIC_SHM_HEADER + peer->offset*link->unitbytes;
+}
+
+/*
+   Called before packing: selects a slot, points the send buffers of the on-node ranks to it and posts the header
+   receives from the on-node ranks into recvreqs, which are the leaf requests for a broadcast and the root requests
+   for a reduction.
+*/
+PetscErrorCode PetscSFBasicShmBegin(PetscSF sf,PetscSFBasicPack link,PetscSFBasicDirection direction,MPI_Request *recvreqs)
+{
+  PetscSF_Basic       *bas = (PetscSF_Basic*)sf->data;
+  PetscSFBasicShm     *shm = &bas->shm;
+  PetscErrorCode      ierr;
+  MPI_Comm            comm = PetscObjectComm((PetscObject)sf);
+  PetscInt            i,s,nrootranks,ndrootranks,nleafranks,ndleafranks,nsendranks,ndsendranks,nrecvranks,ndrecvranks;
+  const PetscInt      *rootoffset,*leafoffset,*recvoffset;
+  const PetscMPIInt   *rootranks,*leafranks,*recvranks;
+  PetscSFBasicShmPeer *sendpeers,*recvpeers;
+  char                **sendbuf;
+
+  PetscFunctionBegin;
+  link->shm     = PETSC_FALSE;
+  link->shmslot = -1;
+  /* Every process takes the same decision, so both sides of a message agree on the protocol */
+  if (!shm->pending || link->unitbytes > (size_t)shm->unitbytes) PetscFunctionReturn(0);
+  link->shm = PETSC_TRUE;
+  if (!shm->npeers) PetscFunctionReturn(0);
+  if (!link->shmbuf) {
+    ierr = PetscMalloc(shm->npeers*PETSCSF_BASIC_SHM_HEADER+shm->units*link->unitbytes,&link->shmbuf);CHKERRQ(ierr);
+    ierr = PetscMalloc1(shm->npeers,&link->shmreqs);CHKERRQ(ierr);
+    for (i=0; i<shm->npeers; i++) link->shmreqs[i] = MPI_REQUEST_NULL;
+  } else {
+    /* The headers and acknowledgments of the previous operation on this link must be out before reusing shmbuf */
+    ierr = MPI_Waitall(shm->npeers,link->shmreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  }
+
+  ierr = PetscSFBasicShmProgress(sf);CHKERRQ(ierr);
+  for (s=0; s<shm->nslots; s++) {
+    if (!shm->busy[s] && !shm->pending[s]) {
+      shm->busy[s]  = PETSC_TRUE;
+      link->shmslot = s;
+      break;
+    }
+  }
+
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,NULL);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,NULL);CHKERRQ(ierr);
+  if (direction == PETSCSF_BASIC_BCAST) {
+    nsendranks = nrootranks; ndsendranks = ndrootranks; sendpeers = shm->rootpeers; sendbuf = link->root;
+    nrecvranks = nleafranks; ndrecvranks = ndleafranks; recvpeers = shm->leafpeers; recvranks = leafranks; recvoffset = leafoffset;
+  } else {
+    nsendranks = nleafranks; ndsendranks = ndleafranks; sendpeers = shm->leafpeers; sendbuf = link->leaf;
+    nrecvranks = nrootranks; ndrecvranks = ndrootranks; recvpeers = shm->rootpeers; recvranks = rootranks; recvoffset = rootoffset;
+  }
+  for (i=ndsendranks; i<nsendranks; i++) {
+    if (sendpeers[i].rank == MPI_PROC_NULL) continue;
+    if (link->shmslot >= 0) sendbuf[i] = shm->base + link->shmslot*shm->slotbytes + sendpeers[i].offset*link->unitbytes;
+    else sendbuf[i] = PetscSFBasicShmMessage(link,&sendpeers[i]) + PETSCSF_BASIC_SHM_HEADER;
+  }
+  for (i=ndrecvranks; i<nrecvranks; i++) {
+    PetscMPIInt n;
+    if (recvpeers[i].rank == MPI_PROC_NULL) continue;
+    /* Large enough for the data in case the sender found no free slot */
+    ierr = PetscMPIIntCast(PETSCSF_BASIC_SHM_HEADER+(recvoffset[i+1]-recvoffset[i])*link->unitbytes,&n);CHKERRQ(ierr);
+    ierr = MPI_Irecv(PetscSFBasicShmMessage(link,&recvpeers[i]),n,MPI_BYTE,recvranks[i],bas->tag,comm,&recvreqs[i-ndrecvranks]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Called after packing: sends the headers to the on-node ranks, with the data appended if there is no slot. The
+   header sends complete lazily, so the corresponding entries of sendreqs are left empty.
+*/
+PetscErrorCode PetscSFBasicShmNotify(PetscSF sf,PetscSFBasicPack link,PetscSFBasicDirection direction,MPI_Request *sendreqs)
+{
+  PetscSF_Basic       *bas = (PetscSF_Basic*)sf->data;
+  PetscSFBasicShm     *shm = &bas->shm;
+  PetscErrorCode      ierr;
+  MPI_Comm            comm = PetscObjectComm((PetscObject)sf);
+  PetscInt            i,nsendranks,ndsendranks,nnotified = 0;
+  const PetscInt      *sendoffset;
+  const PetscMPIInt   *sendranks;
+  PetscSFBasicShmPeer *sendpeers;
+
+  PetscFunctionBegin;
+  if (!link->shm || !shm->npeers) PetscFunctionReturn(0);
+  if (direction == PETSCSF_BASIC_BCAST) {
+    ierr = PetscSFBasicGetRootInfo(sf,&nsendranks,&ndsendranks,&sendranks,&sendoffset,NULL);CHKERRQ(ierr);
+    sendpeers = shm->rootpeers;
+  } else {
+    ierr = PetscSFBasicGetLeafInfo(sf,&nsendranks,&ndsendranks,&sendranks,&sendoffset,NULL);CHKERRQ(ierr);
+    sendpeers = shm->leafpeers;
+  }
+  /* Make the packed slot visible before the on-node ranks learn about it */
+  if (link->shmslot >= 0) {ierr = MPI_Win_sync(shm->win);CHKERRQ(ierr);}
+  for (i=ndsendranks; i<nsendranks; i++) {
+    char        *msg;
+    PetscMPIInt n;
+    if (sendpeers[i].rank == MPI_PROC_NULL) continue;
+    msg = PetscSFBasicShmMessage(link,&sendpeers[i]);
+    *(PetscMPIInt*)msg = (PetscMPIInt)link->shmslot;
+    ierr = PetscMPIIntCast(PETSCSF_BASIC_SHM_HEADER+(link->shmslot >= 0 ? 0 : (sendoffset[i+1]-sendoffset[i])*link->unitbytes),&n);CHKERRQ(ierr);
+    ierr = MPI_Isend(msg,n,MPI_BYTE,sendranks[i],bas->tag,comm,&link->shmreqs[sendpeers[i].index]);CHKERRQ(ierr);
+    sendreqs[i-ndsendranks] = MPI_REQUEST_NULL;
+    nnotified++;
+  }
+  if (link->shmslot >= 0) shm->pending[link->shmslot] += nnotified;
+  PetscFunctionReturn(0);
+}
+
+/* Called once the headers have arrived: points the receive buffers of the on-node ranks to the data to unpack */
+PetscErrorCode PetscSFBasicShmComplete(PetscSF sf,PetscSFBasicPack link,PetscSFBasicDirection direction)
+{
+  PetscSF_Basic       *bas = (PetscSF_Basic*)sf->data;
+  PetscSFBasicShm     *shm = &bas->shm;
+  PetscErrorCode      ierr;
+  PetscInt            i,nrecvranks,ndrecvranks;
+  PetscSFBasicShmPeer *recvpeers;
+  char                **recvbuf;
+  PetscBool           synced = PETSC_FALSE;
+
+  PetscFunctionBegin;
+  if (!link->shm || !shm->npeers) PetscFunctionReturn(0);
+  if (direction == PETSCSF_BASIC_BCAST) {
+    ierr = PetscSFBasicGetLeafInfo(sf,&nrecvranks,&ndrecvranks,NULL,NULL,NULL);CHKERRQ(ierr);
+    recvpeers = shm->leafpeers; recvbuf = link->leaf;
+  } else {
+    ierr = PetscSFBasicGetRootInfo(sf,&nrecvranks,&ndrecvranks,NULL,NULL,NULL);CHKERRQ(ierr);
+    recvpeers = shm->rootpeers; recvbuf = link->root;
+  }
+  for (i=ndrecvranks; i<nrecvranks; i++) {
+    char        *msg;
+    PetscMPIInt slot;
+    if (recvpeers[i].rank == MPI_PROC_NULL) continue;
+    msg  = PetscSFBasicShmMessage(link,&recvpeers[i]);
+    slot = *(PetscMPIInt*)msg;
+    if (slot >= 0) {
+      if (!synced) {ierr = MPI_Win_sync(shm->win);CHKERRQ(ierr); synced = PETSC_TRUE;}
+      recvbuf[i] = recvpeers[i].base + slot*recvpeers[i].slotbytes + recvpeers[i].peeroffset*link->unitbytes;
+    } else recvbuf[i] = msg + PETSCSF_BASIC_SHM_HEADER;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Called after unpacking: acknowledges the slots read, releases the slot written and restores the pack buffers */
+PetscErrorCode PetscSFBasicShmEnd(PetscSF sf,PetscSFBasicPack link,PetscSFBasicDirection direction)
+{
+  PetscSF_Basic       *bas = (PetscSF_Basic*)sf->data;
+  PetscSFBasicShm     *shm = &bas->shm;
+  PetscErrorCode      ierr;
+  MPI_Comm            comm = PetscObjectComm((PetscObject)sf);
+  PetscInt            i,nrootranks,ndrootranks,nleafranks,ndleafranks,nrecvranks,ndrecvranks;
+  const PetscInt      *rootoffset,*leafoffset;
+  const PetscMPIInt   *rootranks,*leafranks,*recvranks;
+  PetscSFBasicShmPeer *recvpeers;
+
+  PetscFunctionBegin;
+  if (!link->shm) PetscFunctionReturn(0);
+  link->shm = PETSC_FALSE;
+  if (!shm->npeers) PetscFunctionReturn(0);
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,NULL);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,NULL);CHKERRQ(ierr);
+  if (direction == PETSCSF_BASIC_BCAST) {
+    nrecvranks = nleafranks; ndrecvranks = ndleafranks; recvpeers = shm->leafpeers; recvranks = leafranks;
+  } else {
+    nrecvranks = nrootranks; ndrecvranks = ndrootranks; recvpeers = shm->rootpeers; recvranks = rootranks;
+  }
+  for (i=ndrecvranks; i<nrecvranks; i++) {
+    char *msg;
+    if (recvpeers[i].rank == MPI_PROC_NULL) continue;
+    msg = PetscSFBasicShmMessage(link,&recvpeers[i]);
+    if (*(PetscMPIInt*)msg < 0) continue;
+    ierr = MPI_Isend(msg,1,MPI_INT,recvranks[i],shm->tag,comm,&link->shmreqs[recvpeers[i].index]);CHKERRQ(ierr);
+  }
+  if (link->shmslot >= 0) shm->busy[link->shmslot] = PETSC_FALSE;
+  link->shmslot = -1;
+  for (i=ndrootranks; i<nrootranks; i++) {
+    if (shm->rootpeers[i].rank != MPI_PROC_NULL) link->root[i] = link->rootbuf + rootoffset[i]*link->unitbytes;
+  }
+  for (i=ndleafranks; i<nleafranks; i++) {
+    if (shm->leafpeers[i].rank != MPI_PROC_NULL) link->leaf[i] = link->leafbuf + (leafoffset[i]-leafoffset[ndleafranks])*link->unitbytes;
+  }
+  PetscFunctionReturn(0);
+}
+
+#else
+
+PetscErrorCode PetscSFBasicShmSetUp(PetscSF sf)
+{
+  PetscFunctionBegin;
+  SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_SUP_SYS,"Shared memory communication requires MPI-3 process shared memory");
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscSFBasicShmReset(PetscSF sf)
+{
+  PetscFunctionBegin;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscSFBasicShmPackDestroy(PetscSF sf,PetscSFBasicPack link)
+{
+  PetscFunctionBegin;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscSFBasicShmBegin(PetscSF sf,PetscSFBasicPack link,PetscSFBasicDirection direction,MPI_Request *recvreqs)
+{
+  PetscFunctionBegin;
+  link->shm = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscSFBasicShmNotify(PetscSF sf,PetscSFBasicPack link,PetscSFBasicDirection direction,MPI_Request *sendreqs)
+{
+  PetscFunctionBegin;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscSFBasicShmComplete(PetscSF sf,PetscSFBasicPack link,PetscSFBasicDirection direction)
+{
+  PetscFunctionBegin;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscSFBasicShmEnd(PetscSF sf,PetscSFBasicPack link,PetscSFBasicDirection direction)
+{
+  PetscFunctionBegin;
+  PetscFunctionReturn(0);
+}
+
+#endif
@@ -0,0 +1,215 @@
+
+#include <../src/vec/is/sf/impls/basic/sfbasic.h> /*I "petscsf.h" I*/
+
+typedef struct {
+  SFBASICHEADER;
+  MPI_Comm      comms[2];      /* Distributed graph communicators for PETSCSF_BASIC_BCAST and PETSCSF_BASIC_REDUCE */
+  PetscMPIInt   *rootcounts;   /* Number of units exchanged with each non-distinguished root rank */
+  PetscMPIInt   *rootdispls;   /* Displacement of each non-distinguished root rank in the packed root buffer */
+  PetscMPIInt   *leafcounts;   /* Number of units exchanged with each non-distinguished leaf rank */
+  PetscMPIInt   *leafdispls;   /* Displacement of each non-distinguished leaf rank in the packed leaf buffer */
+} PetscSF_Neighbor;
+
+static PetscErrorCode PetscSFSetUp_Neighbor(PetscSF sf)
+{
+  PetscSF_Neighbor  *dat = (PetscSF_Neighbor*)sf->data;
+  PetscErrorCode    ierr;
+  PetscInt          i,nrootranks,ndrootranks,nleafranks,ndleafranks;
+  const PetscInt    *rootoffset,*leafoffset;
+  const PetscMPIInt *rootranks,*leafranks;
+  PetscMPIInt       *sources,*destinations,*sourceweights,*destweights;
+  MPI_Comm          comm;
+
+  PetscFunctionBegin;
+  ierr = PetscSFSetUp_Basic(sf);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,NULL);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,NULL);CHKERRQ(ierr);
+
+  /* Distinguished ranks communicate through shared memory, so they are not part of the neighborhood */
+  ierr = PetscMalloc4(nrootranks-ndrootranks,&dat->rootcounts,nrootranks-ndrootranks,&dat->rootdispls,nleafranks-ndleafranks,&dat->leafcounts,nleafranks-ndleafranks,&dat->leafdispls);CHKERRQ(ierr);
+  for (i=ndrootranks; i<nrootranks; i++) {
+    ierr = PetscMPIIntCast(rootoffset[i+1]-rootoffset[i],&dat->rootcounts[i-ndrootranks]);CHKERRQ(ierr);
+    ierr = PetscMPIIntCast(rootoffset[i]-rootoffset[ndrootranks],&dat->rootdispls[i-ndrootranks]);CHKERRQ(ierr);
+  }
+  for (i=ndleafranks; i<nleafranks; i++) {
+    ierr = PetscMPIIntCast(leafoffset[i+1]-leafoffset[i],&dat->leafcounts[i-ndleafranks]);CHKERRQ(ierr);
+    ierr = PetscMPIIntCast(leafoffset[i]-leafoffset[ndleafranks],&dat->leafdispls[i-ndleafranks]);CHKERRQ(ierr);
+  }
+
+  /* Roots send to the ranks referencing them in a bcast, leaves send to the ranks owning their roots in a reduce */
+  /* The edges are weighted by the number of units they carry. An empty side of the graph is passed as NULL with
+     MPI_WEIGHTS_EMPTY rather than as pointers past the distinguished ranks */
+  ierr = PetscObjectGetComm((PetscObject)sf,&comm);CHKERRQ(ierr);
+  sources       = nleafranks > ndleafranks ? (PetscMPIInt*)leafranks+ndleafranks : NULL;
+  sourceweights = nleafranks > ndleafranks ? dat->leafcounts : MPI_WEIGHTS_EMPTY;
+  destinations  = nrootranks > ndrootranks ? (PetscMPIInt*)rootranks+ndrootranks : NULL;
+  destweights   = nrootranks > ndrootranks ? dat->rootcounts : MPI_WEIGHTS_EMPTY;
+  ierr = MPI_Dist_graph_create_adjacent(comm,nleafranks-ndleafranks,sources,sourceweights,nrootranks-ndrootranks,destinations,destweights,MPI_INFO_NULL,0,&dat->comms[PETSCSF_BASIC_BCAST]);CHKERRQ(ierr);
+  ierr = MPI_Dist_graph_create_adjacent(comm,nrootranks-ndrootranks,destinations,destweights,nleafranks-ndleafranks,sources,sourceweights,MPI_INFO_NULL,0,&dat->comms[PETSCSF_BASIC_REDUCE]);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFReset_Neighbor(PetscSF sf)
+{
+  PetscSF_Neighbor *dat = (PetscSF_Neighbor*)sf->data;
+  PetscErrorCode   ierr;
+  PetscInt         i;
+
+  PetscFunctionBegin;
+  ierr = PetscSFReset_Basic(sf);CHKERRQ(ierr);
+  for (i=0; i<2; i++) {
+    if (dat->comms[i] != MPI_COMM_NULL) {ierr = MPI_Comm_free(&dat->comms[i]);CHKERRQ(ierr);}
+  }
+  ierr = PetscFree4(dat->rootcounts,dat->rootdispls,dat->leafcounts,dat->leafdispls);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFDestroy_Neighbor(PetscSF sf)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFReset_Neighbor(sf);CHKERRQ(ierr);
+  ierr = PetscFree(sf->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Exchange the packed buffers of link between all non-distinguished ranks in the given direction */
+static PetscErrorCode PetscSFNeighborStart(PetscSF sf,MPI_Datatype unit,PetscSFBasicPack link,PetscSFBasicDirection direction)
+{
+  PetscSF_Neighbor *dat = (PetscSF_Neighbor*)sf->data;
+  PetscErrorCode   ierr;
+  char             *rootbuf = link->rootbuf + dat->ioffset[dat->ndiranks]*link->unitbytes;
+
+  PetscFunctionBegin;
+  if (direction == PETSCSF_BASIC_BCAST) {
+    ierr = MPI_Ineighbor_alltoallv(rootbuf,dat->rootcounts,dat->rootdispls,unit,link->leafbuf,dat->leafcounts,dat->leafdispls,unit,dat->comms[direction],&link->requests[0]);CHKERRQ(ierr);
+  } else {
+    ierr = MPI_Ineighbor_alltoallv(link->leafbuf,dat->leafcounts,dat->leafdispls,unit,rootbuf,dat->rootcounts,dat->rootdispls,unit,dat->comms[direction],&link->requests[0]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFBcastBegin_Neighbor(PetscSF sf,MPI_Datatype unit,const void *rootdata,void *leafdata)
+{
+  PetscErrorCode   ierr;
+  PetscSFBasicPack link;
+  PetscInt         i,nrootranks;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetPack(sf,unit,rootdata,&link);CHKERRQ(ierr);
+  for (i=0; i<nrootranks; i++) {
+    ierr = PetscSFBasicPackRootRank(sf,link,i,rootdata);CHKERRQ(ierr);
+  }
+  ierr = PetscSFNeighborStart(sf,unit,link,PETSCSF_BASIC_BCAST);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFBcastEnd_Neighbor(PetscSF sf,MPI_Datatype unit,const void *rootdata,void *leafdata)
+{
+  PetscErrorCode   ierr;
+  PetscSFBasicPack link;
+  PetscInt         i,nleafranks;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetPackInUse(sf,unit,rootdata,PETSC_OWN_POINTER,&link);CHKERRQ(ierr);
+  ierr = MPI_Wait(&link->requests[0],MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
+  for (i=0; i<nleafranks; i++) {
+    ierr = PetscSFBasicUnpackLeafRank(sf,link,i,leafdata);CHKERRQ(ierr);
+  }
+  ierr = PetscSFBasicReclaimPack(sf,&link);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFReduceBegin_Neighbor(PetscSF sf,MPI_Datatype unit,const void *leafdata,void *rootdata,MPI_Op op)
+{
+  PetscErrorCode   ierr;
+  PetscSFBasicPack link;
+  PetscInt         i,nleafranks;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetPack(sf,unit,rootdata,&link);CHKERRQ(ierr);
+  for (i=0; i<nleafranks; i++) {
+    ierr = PetscSFBasicPackLeafRank(sf,link,i,leafdata);CHKERRQ(ierr);
+  }
+  ierr = PetscSFNeighborStart(sf,unit,link,PETSCSF_BASIC_REDUCE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFReduceEnd_Neighbor(PetscSF sf,MPI_Datatype unit,const void *leafdata,void *rootdata,MPI_Op op)
+{
+  PetscErrorCode   ierr;
+  PetscSFBasicPack link;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetPackInUse(sf,unit,rootdata,PETSC_OWN_POINTER,&link);CHKERRQ(ierr);
+  ierr = MPI_Wait(&link->requests[0],MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  ierr = PetscSFBasicUnpackRootsAndOp(sf,link,unit,rootdata,op);CHKERRQ(ierr);
+  ierr = PetscSFBasicReclaimPack(sf,&link);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFFetchAndOpBegin_Neighbor(PetscSF sf,MPI_Datatype unit,void *rootdata,const void *leafdata,void *leafupdate,MPI_Op op)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFReduceBegin_Neighbor(sf,unit,leafdata,rootdata,op);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFFetchAndOpEnd_Neighbor(PetscSF sf,MPI_Datatype unit,void *rootdata,const void *leafdata,void *leafupdate,MPI_Op op)
+{
+  void             (*FetchAndOp)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  PetscErrorCode   ierr;
+  PetscSFBasicPack link;
+  PetscInt         i,nrootranks,nleafranks;
+  const PetscInt   *rootoffset,*rootloc;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetPackInUse(sf,unit,rootdata,PETSC_OWN_POINTER,&link);CHKERRQ(ierr);
+  ierr = MPI_Wait(&link->requests[0],MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,NULL,NULL,&rootoffset,&rootloc);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
+  /* Process local fetch-and-op, then send the fetched values back to the leaves */
+  ierr = PetscSFBasicPackGetFetchAndOp(sf,link,op,&FetchAndOp);CHKERRQ(ierr);
+  for (i=0; i<nrootranks; i++) {
+    PetscMPIInt n = rootoffset[i+1] - rootoffset[i];
+    (*FetchAndOp)(n,link->bs,rootloc+rootoffset[i],rootdata,link->root[i]);
+  }
+  ierr = PetscSFNeighborStart(sf,unit,link,PETSCSF_BASIC_BCAST);CHKERRQ(ierr);
+  ierr = MPI_Wait(&link->requests[0],MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  for (i=0; i<nleafranks; i++) {
+    ierr = PetscSFBasicUnpackLeafRank(sf,link,i,leafupdate);CHKERRQ(ierr);
+  }
+  ierr = PetscSFBasicReclaimPack(sf,&link);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_EXTERN PetscErrorCode PetscSFCreate_Neighbor(PetscSF sf)
+{
+  PetscSF_Neighbor *dat;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  sf->ops->SetUp           = PetscSFSetUp_Neighbor;
+  sf->ops->Reset           = PetscSFReset_Neighbor;
+  sf->ops->Destroy         = PetscSFDestroy_Neighbor;
+  sf->ops->View            = PetscSFView_Basic;
+  sf->ops->BcastBegin      = PetscSFBcastBegin_Neighbor;
+  sf->ops->BcastEnd        = PetscSFBcastEnd_Neighbor;
+  sf->ops->ReduceBegin     = PetscSFReduceBegin_Neighbor;
+  sf->ops->ReduceEnd       = PetscSFReduceEnd_Neighbor;
+  sf->ops->FetchAndOpBegin = PetscSFFetchAndOpBegin_Neighbor;
+  sf->ops->FetchAndOpEnd   = PetscSFFetchAndOpEnd_Neighbor;
+
+  ierr = PetscNewLog(sf,&dat);CHKERRQ(ierr);
+  dat->comms[PETSCSF_BASIC_BCAST]  = MPI_COMM_NULL;
+  dat->comms[PETSCSF_BASIC_REDUCE] = MPI_COMM_NULL;
+  dat->usepackopt                  = PETSC_TRUE;
+  sf->data = (void*)dat;
+  PetscFunctionReturn(0);
+}
@@ -1022,6 +1022,59 @@ PetscErrorCode PetscSFCreateEmbeddedLeafSF(PetscSF sf, PetscInt nleaves, const P
   PetscFunctionReturn(0);
 }
 
+/*@
+   PetscSFBatchBegin - begin a batch of communication operations whose messages are coalesced
+
+   Collective on PetscSF
+
+   Input Arguments:
+.  sf - star forest on which to communicate
+
+   Notes:
+   Broadcasts or reductions started with PetscSFBcastBegin() or PetscSFReduceBegin() after this call are packed, but their
+   data is not sent until PetscSFBatchEnd(), which sends the data of all of them in one message per neighbor rank. Each
+   operation is then completed as usual with PetscSFBcastEnd() or PetscSFReduceEnd(), which may only be called after
+   PetscSFBatchEnd(). A batch may not mix broadcasts and reductions.
+
+   Implementations that do not support batching start each operation immediately, so the calling sequence is portable.
+
+   Level: advanced
+
+.seealso: PetscSFBatchEnd(), PetscSFBcastBegin(), PetscSFReduceBegin()
+@*/
+PetscErrorCode PetscSFBatchBegin(PetscSF sf)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf,PETSCSF_CLASSID,1);
+  ierr = PetscSFSetUp(sf);CHKERRQ(ierr);
+  if (sf->ops->BatchBegin) {ierr = (*sf->ops->BatchBegin)(sf);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/*@
+   PetscSFBatchEnd - send the coalesced messages of the operations started since PetscSFBatchBegin()
+
+   Collective on PetscSF
+
+   Input Arguments:
+.  sf - star forest on which to communicate
+
+   Level: advanced
+
+.seealso: PetscSFBatchBegin(), PetscSFBcastEnd(), PetscSFReduceEnd()
+@*/
+PetscErrorCode PetscSFBatchEnd(PetscSF sf)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf,PETSCSF_CLASSID,1);
+  if (sf->ops->BatchEnd) {ierr = (*sf->ops->BatchEnd)(sf);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
 /*@C
    PetscSFBcastBegin - begin pointwise broadcast to be concluded with call to PetscSFBcastEnd()
 
@@ -63,10 +63,15 @@ PetscErrorCode ISGetPointSubrange(IS subpointIS, PetscInt pStart, PetscInt pEnd,
 
 /* -----------------------------------------------------------------------------------------*/
 
+/* mappings whose indices span fewer entries than this always use the dense array of ISLOCALTOGLOBALMAPPINGBASIC */
+#define ISLTOG_BASIC_MIN 65536
+
 /*
     Creates the global mapping information in the ISLocalToGlobalMapping structure
 
-    If the user has not selected how to handle the global to local mapping then use HASH for "large" problems
+    If the user has not selected how to handle the global to local mapping then use HASH when the dense array,
+    which has one entry for each global index between the smallest and largest one, would be much larger than the
+    number of indices; a hash table needs about 3 PetscInt per index.
 */
 static PetscErrorCode ISGlobalToLocalMappingSetUp(ISLocalToGlobalMapping mapping)
 {
@@ -87,7 +92,9 @@ static PetscErrorCode ISGlobalToLocalMappingSetUp(ISLocalToGlobalMapping mapping
   mapping->globalstart = start;
   mapping->globalend   = end;
   if (!((PetscObject)mapping)->type_name) {
-    if ((end - start) > PetscMax(4*n,1000000)) {
+    /* most mappings are created inside the library and never see ISLocalToGlobalMappingSetFromOptions() */
+    ierr = PetscOptionsGetReal(((PetscObject)mapping)->options,((PetscObject)mapping)->prefix,"-islocaltoglobalmapping_hash_ratio",&mapping->hashratio,NULL);CHKERRQ(ierr);
+    if ((end - start) >= ISLTOG_BASIC_MIN && (PetscReal)(end - start) > mapping->hashratio*n) {
       ierr = ISLocalToGlobalMappingSetType(mapping,ISLOCALTOGLOBALMAPPINGHASH);CHKERRQ(ierr);
     } else {
       ierr = ISLocalToGlobalMappingSetType(mapping,ISLOCALTOGLOBALMAPPINGBASIC);CHKERRQ(ierr);
@@ -128,6 +135,8 @@ static PetscErrorCode ISGlobalToLocalMappingSetUp_Hash(ISLocalToGlobalMapping ma
   PetscFunctionBegin;
   ierr = PetscNew(&map);CHKERRQ(ierr);
   ierr = PetscHMapICreate(&map->globalht);CHKERRQ(ierr);
+  /* enough buckets that the indices are inserted without rehashing */
+  ierr = PetscHMapIResize(map->globalht,n/3*4+4);CHKERRQ(ierr);
   for (i=0; i<n; i++ ) {
     if (idx[i] < 0) continue;
     ierr = PetscHMapISet(map->globalht,idx[i],i);CHKERRQ(ierr);
@@ -509,9 +518,11 @@ PetscErrorCode  ISLocalToGlobalMappingGetBlockSize(ISLocalToGlobalMapping mappin
     Notes:
     There is one integer value in indices per block and it represents the actual indices bs*idx + j, where j=0,..,bs-1
 
-    For "small" problems when using ISGlobalToLocalMappingApply() and ISGlobalToLocalMappingApplyBlock(), the ISLocalToGlobalMappingType of ISLOCALTOGLOBALMAPPINGBASIC will be used;
-    this uses more memory but is faster; this approach is not scalable for extremely large mappings. For large problems ISLOCALTOGLOBALMAPPINGHASH is used, this is scalable.
-    Use ISLocalToGlobalMappingSetType() or call ISLocalToGlobalMappingSetFromOptions() with the option -islocaltoglobalmapping_type <basic,hash> to control which is used.
+    When using ISGlobalToLocalMappingApply() and ISGlobalToLocalMappingApplyBlock() the ISLocalToGlobalMappingType of ISLOCALTOGLOBALMAPPINGBASIC is used
+    if the global indices are close together; it stores an array with an entry for each global index between the smallest and largest one and is faster.
+    If the indices span more than 4 times their number (and the span is at least 65536), ISLOCALTOGLOBALMAPPINGHASH is used, which needs memory proportional to the number of indices.
+    Use ISLocalToGlobalMappingSetType() or call ISLocalToGlobalMappingSetFromOptions() with the options -islocaltoglobalmapping_type <basic,hash> or
+    -islocaltoglobalmapping_hash_ratio <ratio> to control which is used.
 
     Level: advanced
 
@@ -543,6 +554,7 @@ PetscErrorCode  ISLocalToGlobalMappingCreate(MPI_Comm comm,PetscInt bs,PetscInt
   (*mapping)->info_indices  = NULL;
   (*mapping)->info_nodec    = NULL;
   (*mapping)->info_nodei    = NULL;
+  (*mapping)->hashratio     = 4.0;
 
   (*mapping)->ops->globaltolocalmappingapply      = NULL;
   (*mapping)->ops->globaltolocalmappingapplyblock = NULL;
@@ -571,6 +583,10 @@ PetscFunctionList ISLocalToGlobalMappingList = NULL;
    Input Parameters:
 .  mapping - mapping data structure
 
+   Options Database Keys:
++  -islocaltoglobalmapping_type <basic,hash> - how ISGlobalToLocalMappingApply() finds the local indices
+-  -islocaltoglobalmapping_hash_ratio <4> - if the type is not set, use a hash table when the global indices span more than this multiple of their number
+
    Level: advanced
 
 @*/
@@ -589,6 +605,7 @@ PetscErrorCode ISLocalToGlobalMappingSetFromOptions(ISLocalToGlobalMapping mappi
   if (flg) {
     ierr = ISLocalToGlobalMappingSetType(mapping,type);CHKERRQ(ierr);
   }
+  ierr = PetscOptionsReal("-islocaltoglobalmapping_hash_ratio","Use a hash table when the global indices span more than this multiple of their number","None",mapping->hashratio,&mapping->hashratio,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsEnd();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -813,9 +830,11 @@ PetscErrorCode ISLocalToGlobalMappingApplyBlock(ISLocalToGlobalMapping mapping,P
     Notes:
     Either nout or idxout may be NULL. idx and idxout may be identical.
 
-    For "small" problems when using ISGlobalToLocalMappingApply() and ISGlobalToLocalMappingApplyBlock(), the ISLocalToGlobalMappingType of ISLOCALTOGLOBALMAPPINGBASIC will be used;
-    this uses more memory but is faster; this approach is not scalable for extremely large mappings. For large problems ISLOCALTOGLOBALMAPPINGHASH is used, this is scalable.
-    Use ISLocalToGlobalMappingSetType() or call ISLocalToGlobalMappingSetFromOptions() with the option -islocaltoglobalmapping_type <basic,hash> to control which is used.
+    When using ISGlobalToLocalMappingApply() and ISGlobalToLocalMappingApplyBlock() the ISLocalToGlobalMappingType of ISLOCALTOGLOBALMAPPINGBASIC is used
+    if the global indices are close together; it stores an array with an entry for each global index between the smallest and largest one and is faster.
+    If the indices span more than 4 times their number (and the span is at least 65536), ISLOCALTOGLOBALMAPPINGHASH is used, which needs memory proportional to the number of indices.
+    Use ISLocalToGlobalMappingSetType() or call ISLocalToGlobalMappingSetFromOptions() with the options -islocaltoglobalmapping_type <basic,hash> or
+    -islocaltoglobalmapping_hash_ratio <ratio> to control which is used.
 
     Level: advanced
 
@@ -915,9 +934,11 @@ PetscErrorCode  ISGlobalToLocalMappingApplyIS(ISLocalToGlobalMapping mapping,ISG
     Notes:
     Either nout or idxout may be NULL. idx and idxout may be identical.
 
-    For "small" problems when using ISGlobalToLocalMappingApply() and ISGlobalToLocalMappingApplyBlock(), the ISLocalToGlobalMappingType of ISLOCALTOGLOBALMAPPINGBASIC will be used;
-    this uses more memory but is faster; this approach is not scalable for extremely large mappings. For large problems ISLOCALTOGLOBALMAPPINGHASH is used, this is scalable.
-    Use ISLocalToGlobalMappingSetType() or call ISLocalToGlobalMappingSetFromOptions() with the option -islocaltoglobalmapping_type <basic,hash> to control which is used.
+    When using ISGlobalToLocalMappingApply() and ISGlobalToLocalMappingApplyBlock() the ISLocalToGlobalMappingType of ISLOCALTOGLOBALMAPPINGBASIC is used
+    if the global indices are close together; it stores an array with an entry for each global index between the smallest and largest one and is faster.
+    If the indices span more than 4 times their number (and the span is at least 65536), ISLOCALTOGLOBALMAPPINGHASH is used, which needs memory proportional to the number of indices.
+    Use ISLocalToGlobalMappingSetType() or call ISLocalToGlobalMappingSetFromOptions() with the options -islocaltoglobalmapping_type <basic,hash> or
+    -islocaltoglobalmapping_hash_ratio <ratio> to control which is used.
 
     Level: advanced
 
@@ -1820,7 +1841,8 @@ PETSC_EXTERN PetscErrorCode ISLocalToGlobalMappingCreate_Basic(ISLocalToGlobalMa
 
 
    Notes:
-    This is selected automatically for large problems if the user does not set the type.
+    This is selected automatically if the user does not set the type and the global indices span more than
+    -islocaltoglobalmapping_hash_ratio (default 4) times their number.
 
    Level: beginner
 
@@ -0,0 +1,111 @@
+
+/*
+   Sorting of integers that are distributed over the processes of a communicator
+*/
+#include <petsc/private/isimpl.h>   /*I "petscis.h" I*/
+
+/*@
+   PetscParallelSortInt - Sorts integers that are distributed over the processes of a communicator
+
+   Collective on the communicator of the layouts
+
+   Input Parameters:
++  mapin - the layout of the input keys
+.  mapout - the layout of the sorted keys, with the same global size as mapin
+-  keysin - the local input keys, as many as the local size of mapin
+
+   Output Parameter:
+.  keysout - the local part of the sorted keys, as many as the local size of mapout; it may be the same array as keysin
+
+   Notes:
+   This is a sample sort: each process sorts its keys and contributes a regular sample of them, from which size-1
+   splitters are chosen. The keys are then exchanged so that each process gets the keys between two splitters,
+   sorted again, and moved to the process that owns their position in mapout. Every process stores the samples of
+   all processes, that is O(size^2) integers.
+
+   Level: developer
+
+   Concepts: sorting^parallel
+
+.seealso: PetscSortInt(), PetscLayoutCreate()
+@*/
+PetscErrorCode PetscParallelSortInt(PetscLayout mapin,PetscLayout mapout,PetscInt keysin[],PetscInt keysout[])
+{
+  PetscErrorCode ierr;
+  MPI_Comm       comm;
+  PetscMPIInt    size,p,ns,nall,*scounts,*sdispls,*rcounts,*rdispls;
+  PetscInt       i,j,n,nrecv,offset,lo,hi,*keys,*samples,*allsamples,*splitters,*recv;
+
+  PetscFunctionBegin;
+  PetscValidPointer(mapin,1);
+  PetscValidPointer(mapout,2);
+  if (mapin->n) PetscValidIntPointer(keysin,3);
+  if (mapout->n) PetscValidIntPointer(keysout,4);
+  if (mapin->N != mapout->N) SETERRQ2(mapin->comm,PETSC_ERR_ARG_SIZ,"Input and output layouts have different global sizes %D and %D",mapin->N,mapout->N);
+  comm = mapin->comm;
+  n    = mapin->n;
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  if (size == 1) {
+    if (keysout != keysin) {ierr = PetscMemcpy(keysout,keysin,n*sizeof(PetscInt));CHKERRQ(ierr);}
+    ierr = PetscSortInt(n,keysout);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (!mapin->N) PetscFunctionReturn(0);
+
+  ierr = PetscMalloc4(size,&scounts,size,&sdispls,size,&rcounts,size,&rdispls);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n,&keys);CHKERRQ(ierr);
+  ierr = PetscMemcpy(keys,keysin,n*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscSortInt(n,keys);CHKERRQ(ierr);
+
+  /* a regular sample of size-1 of the local keys, or all of them if there are fewer */
+  ierr = PetscMPIIntCast(PetscMin(size-1,n),&ns);CHKERRQ(ierr);
+  ierr = PetscMalloc2(ns,&samples,size-1,&splitters);CHKERRQ(ierr);
+  for (p=0; p<ns; p++) samples[p] = keys[((p+1)*n)/(ns+1)];
+  ierr = MPI_Allgather(&ns,1,MPI_INT,rcounts,1,MPI_INT,comm);CHKERRQ(ierr);
+  for (p=0,nall=0; p<size; p++) {rdispls[p] = nall; nall += rcounts[p];}
+  ierr = PetscMalloc1(nall,&allsamples);CHKERRQ(ierr);
+  ierr = MPI_Allgatherv(samples,ns,MPIU_INT,allsamples,rcounts,rdispls,MPIU_INT,comm);CHKERRQ(ierr);
+  ierr = PetscSortInt(nall,allsamples);CHKERRQ(ierr);
+  for (p=0; p<size-1; p++) splitters[p] = allsamples[((p+1)*(PetscInt)nall)/size];
+  ierr = PetscFree(allsamples);CHKERRQ(ierr);
+
+  /* process p gets the keys from splitters[p-1] up to, but not including, splitters[p] */
+  for (p=0,j=0; p<size-1; p++) {
+    i = j;
+    while (j < n && keys[j] < splitters[p]) j++;
+    ierr = PetscMPIIntCast(j-i,&scounts[p]);CHKERRQ(ierr);
+  }
+  ierr = PetscMPIIntCast(n-j,&scounts[size-1]);CHKERRQ(ierr);
+  ierr = PetscFree2(samples,splitters);CHKERRQ(ierr);
+  ierr = MPI_Alltoall(scounts,1,MPI_INT,rcounts,1,MPI_INT,comm);CHKERRQ(ierr);
+  for (p=0,i=0,nrecv=0; p<size; p++) {
+    sdispls[p] = (PetscMPIInt)i;
+    i         += scounts[p];
+    ierr       = PetscMPIIntCast(nrecv,&rdispls[p]);CHKERRQ(ierr);
+    nrecv     += rcounts[p];
+  }
+  ierr = PetscMalloc1(nrecv,&recv);CHKERRQ(ierr);
+  ierr = MPI_Alltoallv(keys,scounts,sdispls,MPIU_INT,recv,rcounts,rdispls,MPIU_INT,comm);CHKERRQ(ierr);
+  ierr = PetscFree(keys);CHKERRQ(ierr);
+  ierr = PetscSortInt(nrecv,recv);CHKERRQ(ierr);
+
+  /* the keys of this process are at positions offset to offset+nrecv-1 of the sorted keys; send them to the owners of those positions */
+  ierr    = MPI_Scan(&nrecv,&offset,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+  offset -= nrecv;
+  for (p=0,i=0; p<size; p++) {
+    lo         = PetscMax(offset,mapout->range[p]);
+    hi         = PetscMin(offset+nrecv,mapout->range[p+1]);
+    scounts[p] = hi > lo ? (PetscMPIInt)(hi-lo) : 0;
+    sdispls[p] = (PetscMPIInt)i;
+    i         += scounts[p];
+  }
+  ierr = MPI_Alltoall(scounts,1,MPI_INT,rcounts,1,MPI_INT,comm);CHKERRQ(ierr);
+  for (p=0,i=0; p<size; p++) {
+    rdispls[p] = (PetscMPIInt)i;
+    i         += rcounts[p];
+  }
+  ierr = MPI_Alltoallv(recv,scounts,sdispls,MPIU_INT,keysout,rcounts,rdispls,MPIU_INT,comm);CHKERRQ(ierr);
+  ierr = PetscFree(recv);CHKERRQ(ierr);
+  ierr = PetscFree4(scounts,sdispls,rcounts,rdispls);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -10,7 +10,7 @@ int main(int argc,char **argv)
   PetscMPIInt    size;
   PetscInt       i,j,r,n = 50,repeat = 1,bs;
   PetscScalar    val,*vals,zero=0.0;
-  PetscBool      subset = PETSC_FALSE,flg;
+  PetscBool      subset = PETSC_FALSE,twice = PETSC_FALSE,flg;
   Vec            x,y;
 
   ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
@@ -19,6 +19,7 @@ int main(int argc,char **argv)
 
   ierr = PetscOptionsGetInt(NULL,NULL,"-repeat",&repeat,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsGetBool(NULL,NULL,"-subset",&subset,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-twice",&twice,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
   ierr = VecCreate(PETSC_COMM_WORLD,&x);CHKERRQ(ierr);
   ierr = VecSetSizes(x,PETSC_DECIDE,n*bs);CHKERRQ(ierr);
@@ -34,6 +35,14 @@ int main(int argc,char **argv)
       val  = i*1.0;
       ierr = VecSetValues(x,1,&i,&val,INSERT_VALUES);CHKERRQ(ierr);
     }
+    /* With -twice the even iterations in between set every value twice, more than the previous assembly sent */
+    if (twice && r && repeat-1-r && !(r%2)) {
+      for (i=0; i<n*bs; i++) {
+        val  = i*1.0;
+        ierr = VecSetValues(x,1,&i,&val,INSERT_VALUES);CHKERRQ(ierr);
+        ierr = VecSetValues(x,1,&i,&val,INSERT_VALUES);CHKERRQ(ierr);
+      }
+    }
     ierr = VecAssemblyBegin(x);CHKERRQ(ierr);
     ierr = VecAssemblyEnd(x);CHKERRQ(ierr);
     if (!r) {ierr = VecCopy(x,y);CHKERRQ(ierr);} /* Save result of first assembly */
@@ -105,4 +114,15 @@ int main(int argc,char **argv)
       args: -n 126 -vec_assembly_legacy -repeat 5 -subset
       output_file: output/ex29_1.out
 
+   test:
+      suffix: subset_proper
+      nsize: 3
+      args: -n 126 -repeat 5 -subset
+      output_file: output/ex29_1.out
+
+   test:
+      suffix: subset_twice
+      nsize: 3
+      args: -n 126 -repeat 5 -subset -twice
+
 TEST*/
@@ -1,4 +1,4 @@
-static char help[] = "Tests VecMDot(),VecDot(),VecMTDot(), and VecTDot()\n";
+static char help[] = "Tests VecMDot(),VecDot(),VecMTDot(),VecTDot(), and VecMAXPY()\n";
 
 
 #include <petscvec.h>
@@ -6,10 +6,11 @@ static char help[] = "Tests VecMDot(),VecDot(),VecMTDot(), and VecTDot()\n";
 int main(int argc, char **argv)
 {
   PetscErrorCode ierr;
-  Vec            *V,t;
+  Vec            *V,t,u,w;
   PetscInt       i,j,reps,n=15,k=6;
   PetscRandom    rctx;
   PetscScalar    *val_dot,*val_mdot,*tval_dot,*tval_mdot;
+  PetscReal      unorm,wnorm;
 
   ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
   ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
@@ -22,6 +23,8 @@ int main(int argc, char **argv)
   ierr = VecSetSizes(t,n,PETSC_DECIDE);CHKERRQ(ierr);
   ierr = VecSetFromOptions(t);CHKERRQ(ierr);
   ierr = VecDuplicateVecs(t,k,&V);CHKERRQ(ierr);
+  ierr = VecDuplicate(t,&u);CHKERRQ(ierr);
+  ierr = VecDuplicate(t,&w);CHKERRQ(ierr);
   ierr = VecSetRandom(t,rctx);CHKERRQ(ierr);
   ierr = PetscMalloc1(k,&val_dot);CHKERRQ(ierr);
   ierr = PetscMalloc1(k,&val_mdot);CHKERRQ(ierr);
@@ -47,6 +50,19 @@ int main(int argc, char **argv)
           break;
         }
       }
+      /* VecMAXPY() against a sequence of VecAXPY() */
+      ierr = VecCopy(t,u);CHKERRQ(ierr);
+      ierr = VecCopy(t,w);CHKERRQ(ierr);
+      ierr = VecMAXPY(u,i,val_mdot,V);CHKERRQ(ierr);
+      for (j=0;j<i;j++) {
+        ierr = VecAXPY(w,val_mdot[j],V[j]);CHKERRQ(ierr);
+      }
+      ierr = VecAXPY(w,-1.0,u);CHKERRQ(ierr);
+      ierr = VecNorm(w,NORM_INFINITY,&wnorm);CHKERRQ(ierr);
+      ierr = VecNorm(u,NORM_INFINITY,&unorm);CHKERRQ(ierr);
+      if (wnorm > 1e-5*unorm) {
+        ierr = PetscPrintf(PETSC_COMM_WORLD, "[TEST FAILED] i=%D, |VecMAXPY() - VecAXPY()|=%g\n",i,(double)wnorm);CHKERRQ(ierr);
+      }
     }
   }
   ierr = PetscPrintf(PETSC_COMM_WORLD,"Test completed successfully!\n",k,n);CHKERRQ(ierr);
@@ -56,6 +72,8 @@ int main(int argc, char **argv)
   ierr = PetscFree(tval_mdot);CHKERRQ(ierr);
   ierr = VecDestroyVecs(k,&V);CHKERRQ(ierr);
   ierr = VecDestroy(&t);CHKERRQ(ierr);
+  ierr = VecDestroy(&u);CHKERRQ(ierr);
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
   ierr = PetscRandomDestroy(&rctx);CHKERRQ(ierr);
   ierr = PetscFinalize();
   return ierr;
@@ -66,6 +84,11 @@ int main(int argc, char **argv)
 
    test:
 
+   test:
+      suffix: 2
+      nsize: 2
+      args: -n 37 -k 19
+
    test:
       suffix: cuda
       args: -vec_type cuda
@@ -0,0 +1,104 @@
+static char help[] = "Tests VecReduction: dot products, norms, maxima, minima and sums computed with a single reduction.\n\n";
+
+#include <petscvec.h>
+
+static PetscErrorCode CheckValue(const char *name,PetscScalar val,PetscScalar ref)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (PetscAbsScalar(val-ref) > 100*PETSC_MACHINE_EPSILON*PetscMax(1.0,PetscAbsScalar(ref))) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_PLIB,"%s: VecReduction gives %g, expected %g",name,(double)PetscRealPart(val),(double)PetscRealPart(ref));
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"%-8s %g\n",name,(double)PetscRealPart(val));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,k,n = 1500,rstart,rend;
+  PetscScalar    *xa,dot,tdot,sum,wdot,rdot,rtdot,rsum,rwdot;
+  PetscReal      nrm1,nrm2,nrminf,nrm12[2],max,min,rnrm[5],rmax,rmin;
+  Vec            x,y,w;
+  VecReduction   red;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+
+  ierr = VecCreate(PETSC_COMM_WORLD,&x);CHKERRQ(ierr);
+  ierr = VecSetSizes(x,PETSC_DECIDE,n);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = VecGetOwnershipRange(x,&rstart,&rend);CHKERRQ(ierr);
+  ierr = VecGetArray(x,&xa);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) xa[i-rstart] = (PetscReal)(i%7) - 3.0;
+  ierr = VecRestoreArray(x,&xa);CHKERRQ(ierr);
+  ierr = VecGetArray(y,&xa);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) xa[i-rstart] = 1.0 + (PetscReal)(i%3);
+  ierr = VecRestoreArray(y,&xa);CHKERRQ(ierr);
+  /* w has a different local length, so requests involving it are not computed in the fused pass */
+  ierr = VecCreateMPI(PETSC_COMM_WORLD,PETSC_DECIDE,n+1,&w);CHKERRQ(ierr);
+  ierr = VecSet(w,0.5);CHKERRQ(ierr);
+
+  ierr = VecReductionCreate(PETSC_COMM_WORLD,&red);CHKERRQ(ierr);
+  ierr = VecReductionAddDot(red,x,y,&dot);CHKERRQ(ierr);
+  ierr = VecReductionAddTDot(red,y,x,&tdot);CHKERRQ(ierr);
+  ierr = VecReductionAddNorm(red,x,NORM_1,&nrm1);CHKERRQ(ierr);
+  ierr = VecReductionAddNorm(red,x,NORM_2,&nrm2);CHKERRQ(ierr);
+  ierr = VecReductionAddNorm(red,y,NORM_INFINITY,&nrminf);CHKERRQ(ierr);
+  ierr = VecReductionAddNorm(red,y,NORM_1_AND_2,nrm12);CHKERRQ(ierr);
+  ierr = VecReductionAddMax(red,x,&max);CHKERRQ(ierr);
+  ierr = VecReductionAddMin(red,x,&min);CHKERRQ(ierr);
+  ierr = VecReductionAddSum(red,y,&sum);CHKERRQ(ierr);
+
+  /* the same context is used twice, the second time with a changed x and an extra request */
+  for (k=0; k<2; k++) {
+    ierr = VecReductionBegin(red);CHKERRQ(ierr);
+    ierr = VecReductionEnd(red);CHKERRQ(ierr);
+
+    ierr = VecDot(x,y,&rdot);CHKERRQ(ierr);
+    ierr = VecTDot(y,x,&rtdot);CHKERRQ(ierr);
+    ierr = VecSum(y,&rsum);CHKERRQ(ierr);
+    ierr = VecNorm(x,NORM_1,&rnrm[0]);CHKERRQ(ierr);
+    ierr = VecNorm(x,NORM_2,&rnrm[1]);CHKERRQ(ierr);
+    ierr = VecNorm(y,NORM_INFINITY,&rnrm[2]);CHKERRQ(ierr);
+    ierr = VecNorm(y,NORM_1_AND_2,&rnrm[3]);CHKERRQ(ierr);
+    ierr = VecMax(x,NULL,&rmax);CHKERRQ(ierr);
+    ierr = VecMin(x,NULL,&rmin);CHKERRQ(ierr);
+    ierr = CheckValue("dot",dot,rdot);CHKERRQ(ierr);
+    ierr = CheckValue("tdot",tdot,rtdot);CHKERRQ(ierr);
+    ierr = CheckValue("norm1",nrm1,rnrm[0]);CHKERRQ(ierr);
+    ierr = CheckValue("norm2",nrm2,rnrm[1]);CHKERRQ(ierr);
+    ierr = CheckValue("norminf",nrminf,rnrm[2]);CHKERRQ(ierr);
+    ierr = CheckValue("norm12",nrm12[0],rnrm[3]);CHKERRQ(ierr);
+    ierr = CheckValue("norm12",nrm12[1],rnrm[4]);CHKERRQ(ierr);
+    ierr = CheckValue("max",max,rmax);CHKERRQ(ierr);
+    ierr = CheckValue("min",min,rmin);CHKERRQ(ierr);
+    ierr = CheckValue("sum",sum,rsum);CHKERRQ(ierr);
+    if (k) {
+      ierr = VecDot(w,w,&rwdot);CHKERRQ(ierr);
+      ierr = CheckValue("wdot",wdot,rwdot);CHKERRQ(ierr);
+    }
+
+    ierr = VecScale(x,-2.0);CHKERRQ(ierr);
+    if (!k) {ierr = VecReductionAddDot(red,w,w,&wdot);CHKERRQ(ierr);}
+  }
+
+  ierr = VecReductionDestroy(&red);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+
+   test:
+      suffix: 2
+      nsize: 3
+      output_file: output/ex49_1.out
+
+TEST*/
@@ -0,0 +1,113 @@
+static char help[] = "Tests the fused update and reduction kernels VecAXPYNorm(), VecWAXPYDot() and VecAXPBYPCZDotNorm().\n\n";
+
+#include <petscvec.h>
+
+/* checks that the fused result u and the reference v agree, and that the reductions agree with what VecDot() and VecNorm() give */
+static PetscErrorCode Check(const char *name,Vec u,Vec v,PetscScalar dot,PetscScalar rdot,PetscReal nrm,PetscReal rnrm)
+{
+  PetscErrorCode ierr;
+  PetscReal      err,tol = 100*PETSC_MACHINE_EPSILON;
+
+  PetscFunctionBegin;
+  ierr = VecAXPY(v,-1.0,u);CHKERRQ(ierr);
+  ierr = VecNorm(v,NORM_INFINITY,&err);CHKERRQ(ierr);
+  if (err > tol) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"%s: updated vector differs by %g",name,(double)err);
+  if (PetscAbsScalar(dot-rdot) > tol*PetscMax(1.0,PetscAbsScalar(rdot))) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_PLIB,"%s: dot %g, expected %g",name,(double)PetscRealPart(dot),(double)PetscRealPart(rdot));
+  if (PetscAbsReal(nrm-rnrm) > tol*PetscMax(1.0,rnrm)) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_PLIB,"%s: norm %g, expected %g",name,(double)nrm,(double)rnrm);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"%-10s dot %g norm %g\n",name,(double)PetscRealPart(dot),(double)nrm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,n = 100,rstart,rend;
+  PetscScalar    *a,dot = 0.0,rdot = 0.0;
+  PetscReal      nrm = 0.0,rnrm = 0.0;
+  Vec            x,y,z,w,u,v;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&x);CHKERRQ(ierr);
+  ierr = VecSetSizes(x,PETSC_DECIDE,n);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&z);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&w);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&u);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&v);CHKERRQ(ierr);
+  ierr = VecGetOwnershipRange(x,&rstart,&rend);CHKERRQ(ierr);
+  ierr = VecGetArray(x,&a);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) a[i-rstart] = (PetscReal)(i%5) - 2.0;
+  ierr = VecRestoreArray(x,&a);CHKERRQ(ierr);
+  ierr = VecGetArray(y,&a);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) a[i-rstart] = 1.0 + (PetscReal)(i%3);
+  ierr = VecRestoreArray(y,&a);CHKERRQ(ierr);
+  ierr = VecGetArray(z,&a);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) a[i-rstart] = 0.5*(PetscReal)(i%4);
+  ierr = VecRestoreArray(z,&a);CHKERRQ(ierr);
+  ierr = VecSet(w,-1.5);CHKERRQ(ierr);
+
+  /* u <- u + 2 x */
+  ierr = VecCopy(z,u);CHKERRQ(ierr);
+  ierr = VecCopy(z,v);CHKERRQ(ierr);
+  ierr = VecAXPYNorm(u,2.0,x,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(v,2.0,x);CHKERRQ(ierr);
+  ierr = VecNorm(v,NORM_2,&rnrm);CHKERRQ(ierr);
+  ierr = Check("axpynorm",u,v,0.0,0.0,nrm,rnrm);CHKERRQ(ierr);
+
+  /* u <- -3 x + y, (u,w) */
+  ierr = VecSet(u,PETSC_MAX_REAL);CHKERRQ(ierr);
+  ierr = VecWAXPYDot(u,-3.0,x,y,w,&dot);CHKERRQ(ierr);
+  ierr = VecWAXPY(v,-3.0,x,y);CHKERRQ(ierr);
+  ierr = VecDot(v,w,&rdot);CHKERRQ(ierr);
+  ierr = Check("waxpydot",u,v,dot,rdot,0.0,0.0);CHKERRQ(ierr);
+
+  /* u <- 2 x - y + 0.5 u, (u,u), ||u|| with the inner product taken against the updated vector itself */
+  ierr = VecCopy(z,u);CHKERRQ(ierr);
+  ierr = VecCopy(z,v);CHKERRQ(ierr);
+  ierr = VecAXPBYPCZDotNorm(u,2.0,-1.0,0.5,x,y,u,&dot,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPBYPCZ(v,2.0,-1.0,0.5,x,y);CHKERRQ(ierr);
+  ierr = VecDot(v,v,&rdot);CHKERRQ(ierr);
+  ierr = VecNorm(v,NORM_2,&rnrm);CHKERRQ(ierr);
+  ierr = Check("axpbypcz",u,v,dot,rdot,nrm,rnrm);CHKERRQ(ierr);
+
+  /* u <- 4 x + u, (u,x), the cached norm of u must be the fused one */
+  ierr = VecCopy(z,u);CHKERRQ(ierr);
+  ierr = VecCopy(z,v);CHKERRQ(ierr);
+  ierr = VecAXPBYPCZDotNorm(u,4.0,0.0,1.0,x,NULL,x,&dot,&nrm);CHKERRQ(ierr);
+  ierr = VecNorm(u,NORM_2,&rnrm);CHKERRQ(ierr);
+  if (rnrm != nrm) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Norm of the updated vector is not cached");
+  ierr = VecAXPY(v,4.0,x);CHKERRQ(ierr);
+  ierr = VecDot(v,x,&rdot);CHKERRQ(ierr);
+  ierr = VecNorm(v,NORM_2,&rnrm);CHKERRQ(ierr);
+  ierr = Check("axpydotnrm",u,v,dot,rdot,nrm,rnrm);CHKERRQ(ierr);
+
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
+  ierr = VecDestroy(&u);CHKERRQ(ierr);
+  ierr = VecDestroy(&v);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+
+   test:
+      suffix: 2
+      nsize: 3
+      output_file: output/ex50_1.out
+
+   test:
+      suffix: node
+      nsize: 3
+      args: -vec_type node
+      output_file: output/ex50_1.out
+      requires: define(PETSC_HAVE_MPI_WIN_CREATE_FEATURE)
+
+TEST*/
@@ -0,0 +1,146 @@
+static char help[] = "Tests VecCreateNodeGhost() against VecCreateGhost().\n\n";
+
+#include <petscvec.h>
+
+/* checks that the local forms of the two ghosted vectors agree */
+static PetscErrorCode CheckLocalForms(const char *name,Vec gm,Vec gn)
+{
+  PetscErrorCode ierr;
+  Vec            lm,ln;
+  PetscReal      err,nrm;
+
+  PetscFunctionBegin;
+  ierr = VecGhostGetLocalForm(gm,&lm);CHKERRQ(ierr);
+  ierr = VecGhostGetLocalForm(gn,&ln);CHKERRQ(ierr);
+  ierr = VecNorm(ln,NORM_1,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(ln,-1.0,lm);CHKERRQ(ierr);
+  ierr = VecNorm(ln,NORM_INFINITY,&err);CHKERRQ(ierr);
+  if (err > 0.0) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"%s: local forms differ by %g",name,(double)err);
+  ierr = VecAXPY(ln,1.0,lm);CHKERRQ(ierr);
+  ierr = VecGhostRestoreLocalForm(gm,&lm);CHKERRQ(ierr);
+  ierr = VecGhostRestoreLocalForm(gn,&ln);CHKERRQ(ierr);
+  ierr = PetscSynchronizedPrintf(PETSC_COMM_WORLD,"%-8s local form norm %g\n",name,(double)nrm);CHKERRQ(ierr);
+  ierr = PetscSynchronizedFlush(PETSC_COMM_WORLD,PETSC_STDOUT);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* sets the ghost points of the local form to 10 times their global index */
+static PetscErrorCode SetGhosts(Vec g,PetscInt n,PetscInt nghost,const PetscInt ghosts[])
+{
+  PetscErrorCode ierr;
+  Vec            l;
+  PetscScalar    *a;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  ierr = VecGhostGetLocalForm(g,&l);CHKERRQ(ierr);
+  ierr = VecGetArray(l,&a);CHKERRQ(ierr);
+  for (i=0; i<nghost; i++) a[n+i] = 10.0*ghosts[i];
+  ierr = VecRestoreArray(l,&a);CHKERRQ(ierr);
+  ierr = VecGhostRestoreLocalForm(g,&l);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    rank,size,r;
+  PetscInt       n,N,i,nghost = 0,ghosts[64],rstart,rend;
+  const PetscInt *range;
+  PetscScalar    one = 1.0;
+  Vec            gm,gn,dm,dn;
+  PetscLayout    map;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  if (size > 16) SETERRQ(PETSC_COMM_WORLD,PETSC_ERR_SUP,"Example is for at most 16 processes");
+  n = 4+rank;
+
+  /* ghost the first and the last two entries of every other process */
+  ierr = PetscLayoutCreate(PETSC_COMM_WORLD,&map);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(map,n);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(map);CHKERRQ(ierr);
+  ierr = PetscLayoutGetRanges(map,&range);CHKERRQ(ierr);
+  ierr = PetscLayoutGetSize(map,&N);CHKERRQ(ierr);
+  for (r=size-1; r>=0; r--) {
+    if (r == rank) continue;
+    ghosts[nghost++] = range[r+1]-1;
+    ghosts[nghost++] = range[r];
+    ghosts[nghost++] = range[r+1]-2;
+  }
+
+  ierr = VecCreateGhost(PETSC_COMM_WORLD,n,N,nghost,ghosts,&gm);CHKERRQ(ierr);
+  ierr = VecCreateNodeGhost(PETSC_COMM_WORLD,n,N,nghost,ghosts,&gn);CHKERRQ(ierr);
+
+  /* x_i = i, with an off-process contribution to the first entry from every process */
+  ierr = VecGetOwnershipRange(gn,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    PetscScalar v = i;
+    ierr = VecSetValues(gm,1,&i,&v,ADD_VALUES);CHKERRQ(ierr);
+    ierr = VecSetValues(gn,1,&i,&v,ADD_VALUES);CHKERRQ(ierr);
+  }
+  i    = 0;
+  ierr = VecSetValues(gm,1,&i,&one,ADD_VALUES);CHKERRQ(ierr);
+  ierr = VecSetValues(gn,1,&i,&one,ADD_VALUES);CHKERRQ(ierr);
+  ierr = VecAssemblyBegin(gm);CHKERRQ(ierr);
+  ierr = VecAssemblyBegin(gn);CHKERRQ(ierr);
+  ierr = VecAssemblyEnd(gm);CHKERRQ(ierr);
+  ierr = VecAssemblyEnd(gn);CHKERRQ(ierr);
+
+  ierr = VecGhostUpdateBegin(gm,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecGhostUpdateEnd(gm,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecGhostUpdateBegin(gn,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecGhostUpdateEnd(gn,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = CheckLocalForms("insert",gm,gn);CHKERRQ(ierr);
+
+  ierr = VecGhostUpdateBegin(gm,ADD_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecGhostUpdateEnd(gm,ADD_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecGhostUpdateBegin(gn,ADD_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecGhostUpdateEnd(gn,ADD_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = CheckLocalForms("add",gm,gn);CHKERRQ(ierr);
+
+  /* accumulate the ghost points onto their owners */
+  ierr = SetGhosts(gm,n,nghost,ghosts);CHKERRQ(ierr);
+  ierr = SetGhosts(gn,n,nghost,ghosts);CHKERRQ(ierr);
+  ierr = VecGhostUpdateBegin(gm,ADD_VALUES,SCATTER_REVERSE);CHKERRQ(ierr);
+  ierr = VecGhostUpdateEnd(gm,ADD_VALUES,SCATTER_REVERSE);CHKERRQ(ierr);
+  ierr = VecGhostUpdateBegin(gn,ADD_VALUES,SCATTER_REVERSE);CHKERRQ(ierr);
+  ierr = VecGhostUpdateEnd(gn,ADD_VALUES,SCATTER_REVERSE);CHKERRQ(ierr);
+  ierr = CheckLocalForms("reverse",gm,gn);CHKERRQ(ierr);
+
+  /* duplicates share the ghost pattern */
+  ierr = VecDuplicate(gm,&dm);CHKERRQ(ierr);
+  ierr = VecDuplicate(gn,&dn);CHKERRQ(ierr);
+  ierr = VecCopy(gm,dm);CHKERRQ(ierr);
+  ierr = VecCopy(gn,dn);CHKERRQ(ierr);
+  ierr = VecScale(dm,2.0);CHKERRQ(ierr);
+  ierr = VecScale(dn,2.0);CHKERRQ(ierr);
+  ierr = VecGhostUpdateBegin(dm,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecGhostUpdateEnd(dm,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecGhostUpdateBegin(dn,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecGhostUpdateEnd(dn,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = CheckLocalForms("dup",dm,dn);CHKERRQ(ierr);
+
+  ierr = VecDestroy(&dm);CHKERRQ(ierr);
+  ierr = VecDestroy(&dn);CHKERRQ(ierr);
+  ierr = VecDestroy(&gm);CHKERRQ(ierr);
+  ierr = VecDestroy(&gn);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&map);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      nsize: 3
+      requires: define(PETSC_HAVE_MPI_WIN_CREATE_FEATURE)
+
+   test:
+      suffix: 2
+      nsize: 4
+      args: -vec_node_ghost_shared_size 2
+      requires: define(PETSC_HAVE_MPI_WIN_CREATE_FEATURE)
+
+TEST*/
@@ -0,0 +1,172 @@
+static char help[] = "Tests VECSINGLE vectors against VECSTANDARD vectors holding the same values.\n\n";
+
+#include <petscvec.h>
+
+/* compares a single precision vector with its double precision counterpart */
+static PetscErrorCode CheckVecs(const char *name,Vec d,Vec s)
+{
+  PetscErrorCode ierr;
+  Vec            w;
+  PetscReal      nrm,err;
+
+  PetscFunctionBegin;
+  ierr = VecDuplicate(d,&w);CHKERRQ(ierr);
+  ierr = VecCopy(s,w);CHKERRQ(ierr);
+  ierr = VecAXPY(w,-1.0,d);CHKERRQ(ierr);
+  ierr = VecNorm(w,NORM_INFINITY,&err);CHKERRQ(ierr);
+  ierr = VecNorm(d,NORM_INFINITY,&nrm);CHKERRQ(ierr);
+  if (err > 1.e-6*nrm) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%-10s vectors differ by %g\n",name,(double)(err/nrm));CHKERRQ(ierr);
+  } else {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%-10s norm %g\n",name,(double)nrm);CHKERRQ(ierr);
+  }
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CheckScalars(const char *name,PetscInt n,const PetscScalar d[],const PetscScalar s[])
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) {
+    if (PetscAbsScalar(d[i]-s[i]) > 1.e-12*PetscAbsScalar(d[i])) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"%-10s results %D differ: %g %g\n",name,i,(double)PetscRealPart(d[i]),(double)PetscRealPart(s[i]));CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+  }
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"%-10s %g\n",name,(double)PetscRealPart(d[0]));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscInt       n = 13,N,i,nv = 6;
+  PetscScalar    v,alpha[6],dd[6],ds[6],*a;
+  PetscReal      rd[2],rs[2];
+  Vec            xd,xs,yd[6],ys[6],wd,ws;
+  NormType       types[] = {NORM_1,NORM_2,NORM_INFINITY};
+  const char     *tnames[] = {"norm1","norm2","norminf"};
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+
+  ierr = VecCreate(PETSC_COMM_WORLD,&xd);CHKERRQ(ierr);
+  ierr = VecSetSizes(xd,n,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = VecSetType(xd,VECSTANDARD);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&xs);CHKERRQ(ierr);
+  ierr = VecSetSizes(xs,n,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = VecSetType(xs,VECSINGLE);CHKERRQ(ierr);
+  ierr = VecGetSize(xd,&N);CHKERRQ(ierr);
+
+  /* every process adds a power of two to every entry, so most of the values are communicated and the sums are exact in single precision */
+  for (i=0; i<N; i++) {
+    v    = 1.0/(PetscReal)(1 << (i%8));
+    ierr = VecSetValues(xd,1,&i,&v,ADD_VALUES);CHKERRQ(ierr);
+    ierr = VecSetValues(xs,1,&i,&v,ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = VecAssemblyBegin(xd);CHKERRQ(ierr);
+  ierr = VecAssemblyEnd(xd);CHKERRQ(ierr);
+  ierr = VecAssemblyBegin(xs);CHKERRQ(ierr);
+  ierr = VecAssemblyEnd(xs);CHKERRQ(ierr);
+  ierr = CheckVecs("assembly",xd,xs);CHKERRQ(ierr);
+
+  /* round trip through the double precision array */
+  ierr = VecGetArray(xs,&a);CHKERRQ(ierr);
+  for (i=0; i<n; i++) a[i] += i;
+  ierr = VecRestoreArray(xs,&a);CHKERRQ(ierr);
+  ierr = VecGetArray(xd,&a);CHKERRQ(ierr);
+  for (i=0; i<n; i++) a[i] += i;
+  ierr = VecRestoreArray(xd,&a);CHKERRQ(ierr);
+  ierr = CheckVecs("getarray",xd,xs);CHKERRQ(ierr);
+
+  for (i=0; i<nv; i++) {
+    ierr     = VecDuplicate(xd,&yd[i]);CHKERRQ(ierr);
+    ierr     = VecDuplicate(xs,&ys[i]);CHKERRQ(ierr);
+    ierr     = VecCopy(xd,yd[i]);CHKERRQ(ierr);
+    ierr     = VecCopy(xs,ys[i]);CHKERRQ(ierr);
+    ierr     = VecShift(yd[i],i);CHKERRQ(ierr);
+    ierr     = VecShift(ys[i],i);CHKERRQ(ierr);
+    alpha[i] = 1.0/(i+2);
+  }
+  ierr = CheckVecs("duplicate",yd[nv-1],ys[nv-1]);CHKERRQ(ierr);
+
+  /* reductions are accumulated in double precision, so they agree with the standard vectors to rounding */
+  ierr = VecDot(xd,yd[1],&dd[0]);CHKERRQ(ierr);
+  ierr = VecDot(xs,ys[1],&ds[0]);CHKERRQ(ierr);
+  ierr = CheckScalars("dot",1,dd,ds);CHKERRQ(ierr);
+  ierr = VecMDot(xd,nv,yd,dd);CHKERRQ(ierr);
+  ierr = VecMDot(xs,nv,ys,ds);CHKERRQ(ierr);
+  ierr = CheckScalars("mdot",nv,dd,ds);CHKERRQ(ierr);
+  ierr = VecMDot(xs,nv,yd,ds);CHKERRQ(ierr);
+  ierr = CheckScalars("mdot mixed",nv,dd,ds);CHKERRQ(ierr);
+  for (i=0; i<3; i++) {
+    ierr = VecNorm(xd,types[i],rd);CHKERRQ(ierr);
+    ierr = VecNorm(xs,types[i],rs);CHKERRQ(ierr);
+    dd[0] = rd[0]; ds[0] = rs[0];
+    ierr = CheckScalars(tnames[i],1,dd,ds);CHKERRQ(ierr);
+  }
+
+  /* the updates are rounded to single precision when they are stored */
+  ierr = VecMAXPY(xd,nv,alpha,yd);CHKERRQ(ierr);
+  ierr = VecMAXPY(xs,nv,alpha,ys);CHKERRQ(ierr);
+  ierr = CheckVecs("maxpy",xd,xs);CHKERRQ(ierr);
+  ierr = VecAXPY(xd,0.5,yd[2]);CHKERRQ(ierr);
+  ierr = VecAXPY(xs,0.5,ys[2]);CHKERRQ(ierr);
+  ierr = CheckVecs("axpy",xd,xs);CHKERRQ(ierr);
+  ierr = VecAXPY(xs,-0.25,yd[3]);CHKERRQ(ierr);
+  ierr = VecAXPY(xd,-0.25,yd[3]);CHKERRQ(ierr);
+  ierr = CheckVecs("axpy mixed",xd,xs);CHKERRQ(ierr);
+  ierr = VecAXPBY(xd,2.0,-1.0,yd[1]);CHKERRQ(ierr);
+  ierr = VecAXPBY(xs,2.0,-1.0,ys[1]);CHKERRQ(ierr);
+  ierr = CheckVecs("axpby",xd,xs);CHKERRQ(ierr);
+  ierr = VecAYPX(xd,0.5,yd[4]);CHKERRQ(ierr);
+  ierr = VecAYPX(xs,0.5,ys[4]);CHKERRQ(ierr);
+  ierr = CheckVecs("aypx",xd,xs);CHKERRQ(ierr);
+  ierr = VecAXPBYPCZ(xd,1.0,-2.0,0.5,yd[0],yd[5]);CHKERRQ(ierr);
+  ierr = VecAXPBYPCZ(xs,1.0,-2.0,0.5,ys[0],ys[5]);CHKERRQ(ierr);
+  ierr = CheckVecs("axpbypcz",xd,xs);CHKERRQ(ierr);
+  ierr = VecDuplicate(xd,&wd);CHKERRQ(ierr);
+  ierr = VecDuplicate(xs,&ws);CHKERRQ(ierr);
+  ierr = VecWAXPY(wd,3.0,xd,yd[2]);CHKERRQ(ierr);
+  ierr = VecWAXPY(ws,3.0,xs,ys[2]);CHKERRQ(ierr);
+  ierr = CheckVecs("waxpy",wd,ws);CHKERRQ(ierr);
+  ierr = VecScale(wd,-0.125);CHKERRQ(ierr);
+  ierr = VecScale(ws,-0.125);CHKERRQ(ierr);
+  ierr = CheckVecs("scale",wd,ws);CHKERRQ(ierr);
+  ierr = VecSwap(wd,xd);CHKERRQ(ierr);
+  ierr = VecSwap(ws,xs);CHKERRQ(ierr);
+  ierr = CheckVecs("swap",xd,xs);CHKERRQ(ierr);
+  ierr = VecPointwiseMult(wd,xd,yd[1]);CHKERRQ(ierr);
+  ierr = VecPointwiseMult(ws,xs,ys[1]);CHKERRQ(ierr);
+  ierr = CheckVecs("pmult",wd,ws);CHKERRQ(ierr);
+  ierr = VecSet(ws,2.0);CHKERRQ(ierr);
+  ierr = VecSet(wd,2.0);CHKERRQ(ierr);
+  ierr = CheckVecs("set",wd,ws);CHKERRQ(ierr);
+
+  for (i=0; i<nv; i++) {
+    ierr = VecDestroy(&yd[i]);CHKERRQ(ierr);
+    ierr = VecDestroy(&ys[i]);CHKERRQ(ierr);
+  }
+  ierr = VecDestroy(&wd);CHKERRQ(ierr);
+  ierr = VecDestroy(&ws);CHKERRQ(ierr);
+  ierr = VecDestroy(&xd);CHKERRQ(ierr);
+  ierr = VecDestroy(&xs);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   build:
+      requires: double !complex
+
+   test:
+
+   test:
+      suffix: 2
+      nsize: 3
+
+TEST*/
@@ -0,0 +1,146 @@
+static char help[] = "Tests VecView() and VecLoad() of compressed vectors with a binary viewer.\n\
+  -n <n> : global length of the vectors\n\
+  -tol <tol> : absolute error allowed by the lossy compression\n\n";
+
+#include <petscvec.h>
+#include <petscviewer.h>
+
+/* compares a loaded vector with the one that was saved, which has a different layout */
+static PetscErrorCode CheckVec(const char *name,Vec x,Vec y,PetscReal tol)
+{
+  PetscErrorCode ierr;
+  Vec            w;
+  IS             is;
+  VecScatter     scatter;
+  PetscInt       n,rstart;
+  PetscReal      err;
+
+  PetscFunctionBegin;
+  ierr = VecDuplicate(x,&w);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(x,&n);CHKERRQ(ierr);
+  ierr = VecGetOwnershipRange(x,&rstart,NULL);CHKERRQ(ierr);
+  ierr = ISCreateStride(PETSC_COMM_WORLD,n,rstart,1,&is);CHKERRQ(ierr);
+  ierr = VecScatterCreateWithData(y,is,w,is,&scatter);CHKERRQ(ierr);
+  ierr = VecScatterBegin(scatter,y,w,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecScatterEnd(scatter,y,w,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecScatterDestroy(&scatter);CHKERRQ(ierr);
+  ierr = ISDestroy(&is);CHKERRQ(ierr);
+  ierr = VecAXPY(w,-1.0,x);CHKERRQ(ierr);
+  ierr = VecNorm(w,NORM_INFINITY,&err);CHKERRQ(ierr);
+  if (!tol) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%-8s %s\n",name,err == 0.0 ? "loaded exactly" : "loaded with errors");CHKERRQ(ierr);
+  } else {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%-8s %s\n",name,err <= tol*(1.0+PETSC_SQRT_MACHINE_EPSILON) ? "loaded within the tolerance" : "loaded with too large errors");CHKERRQ(ierr);
+  }
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    rank,size;
+  PetscInt       n = 40000,nlocal,i,rstart,rend;
+  PetscReal      tol = 1.e-6;
+  PetscScalar    *a;
+  PetscRandom    rnd;
+  PetscViewer    viewer;
+  Vec            smooth,rough,constant,y[4];
+  const char     *names[] = {"smooth","rough","constant","lossy"};
+  PetscBool      compress,matlab = PETSC_FALSE;
+  FILE           *info;
+  char           line[PETSC_MAX_PATH_LEN];
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetReal(NULL,NULL,"-tol",&tol,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-matlab",&matlab,NULL);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+
+  /* the vectors are saved with an uneven layout and loaded with the default one */
+  nlocal = 2*(rank+1)*(n/(size*(size+1)));
+  if (rank == size-1) nlocal = n - 2*(n/(size*(size+1)))*(size*(size-1)/2);
+  ierr = VecCreateMPI(PETSC_COMM_WORLD,nlocal,n,&smooth);CHKERRQ(ierr);
+  ierr = VecDuplicate(smooth,&rough);CHKERRQ(ierr);
+  ierr = VecDuplicate(smooth,&constant);CHKERRQ(ierr);
+  ierr = VecGetOwnershipRange(smooth,&rstart,&rend);CHKERRQ(ierr);
+  ierr = VecGetArray(smooth,&a);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) a[i-rstart] = PetscSinReal(2.0*PETSC_PI*i/n) + 0.001*i;
+  ierr = VecRestoreArray(smooth,&a);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rnd);CHKERRQ(ierr);
+  ierr = VecSetRandom(rough,rnd);CHKERRQ(ierr);
+  ierr = VecSet(constant,-3.0);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject)smooth,names[0]);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject)rough,names[1]);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject)constant,names[2]);CHKERRQ(ierr);
+
+  ierr = PetscViewerBinaryOpen(PETSC_COMM_WORLD,"ex53.bin",FILE_MODE_WRITE,&viewer);CHKERRQ(ierr);
+  ierr = PetscViewerBinarySetCompression(viewer,PETSC_TRUE,0.0);CHKERRQ(ierr);
+  ierr = PetscViewerSetFromOptions(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryGetCompression(viewer,&compress,NULL);CHKERRQ(ierr);
+  if (matlab) {ierr = PetscViewerPushFormat(viewer,PETSC_VIEWER_BINARY_MATLAB);CHKERRQ(ierr);}
+  ierr = VecView(smooth,viewer);CHKERRQ(ierr);
+  ierr = VecView(rough,viewer);CHKERRQ(ierr);
+  /* compressed and uncompressed vectors may be mixed in a file */
+  ierr = PetscViewerBinarySetCompression(viewer,PETSC_FALSE,0.0);CHKERRQ(ierr);
+  ierr = VecView(constant,viewer);CHKERRQ(ierr);
+  ierr = PetscViewerBinarySetCompression(viewer,compress,tol);CHKERRQ(ierr);
+  ierr = VecView(smooth,viewer);CHKERRQ(ierr);
+  if (matlab) {ierr = PetscViewerPopFormat(viewer);CHKERRQ(ierr);}
+  ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+
+  /* the MATLAB loading code must be written for the compressed vectors as well */
+  if (matlab && !rank) {
+    ierr = PetscFOpen(PETSC_COMM_SELF,"ex53.bin.info","r",&info);CHKERRQ(ierr);
+    while (fgets(line,sizeof(line),info)) {
+      if (!strncmp(line,"#$$ Set.",8)) {ierr = PetscPrintf(PETSC_COMM_SELF,"%s",line);CHKERRQ(ierr);}
+    }
+    ierr = PetscFClose(PETSC_COMM_SELF,info);CHKERRQ(ierr);
+  }
+
+  ierr = PetscViewerBinaryOpen(PETSC_COMM_WORLD,"ex53.bin",FILE_MODE_READ,&viewer);CHKERRQ(ierr);
+  for (i=0; i<4; i++) {
+    ierr = VecCreate(PETSC_COMM_WORLD,&y[i]);CHKERRQ(ierr);
+    ierr = VecSetType(y[i],VECSTANDARD);CHKERRQ(ierr);
+    ierr = VecLoad(y[i],viewer);CHKERRQ(ierr);
+  }
+  ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+  ierr = CheckVec(names[0],smooth,y[0],0.0);CHKERRQ(ierr);
+  ierr = CheckVec(names[1],rough,y[1],0.0);CHKERRQ(ierr);
+  ierr = CheckVec(names[2],constant,y[2],0.0);CHKERRQ(ierr);
+  ierr = CheckVec(names[3],smooth,y[3],compress ? tol : 0.0);CHKERRQ(ierr);
+
+  for (i=0; i<4; i++) {ierr = VecDestroy(&y[i]);CHKERRQ(ierr);}
+  ierr = VecDestroy(&smooth);CHKERRQ(ierr);
+  ierr = VecDestroy(&rough);CHKERRQ(ierr);
+  ierr = VecDestroy(&constant);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rnd);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+
+   test:
+      suffix: 2
+      nsize: 3
+
+   test:
+      suffix: 3
+      nsize: 2
+      args: -n 100 -tol 1.e-2
+
+   test:
+      suffix: uncompressed
+      nsize: 2
+      args: -viewer_binary_compression 0
+
+   test:
+      suffix: matlab
+      nsize: 2
+      args: -matlab
+
+TEST*/
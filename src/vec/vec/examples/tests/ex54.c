@@ -0,0 +1,84 @@
+static char help[] = "Tests asynchronous VecView() with a binary viewer using MPI-IO.\n\
+  -n <n> : global length of the vectors\n\
+  -steps <steps> : number of vectors written before the viewer is flushed\n\n";
+
+#include <petscvec.h>
+#include <petscviewer.h>
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscInt       n = 1000,steps = 5,i,k,rstart,rend;
+  PetscScalar    *a;
+  PetscReal      err,maxerr = 0.0;
+  PetscViewer    viewer;
+  Vec            x,y,z;
+  PetscBool      async;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-steps",&steps,NULL);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&x);CHKERRQ(ierr);
+  ierr = VecSetSizes(x,PETSC_DECIDE,n);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&z);CHKERRQ(ierr);
+  ierr = VecGetOwnershipRange(x,&rstart,&rend);CHKERRQ(ierr);
+  ierr = VecGetArray(x,&a);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) a[i-rstart] = (PetscScalar)i;
+  ierr = VecRestoreArray(x,&a);CHKERRQ(ierr);
+
+  ierr = PetscViewerCreate(PETSC_COMM_WORLD,&viewer);CHKERRQ(ierr);
+  ierr = PetscViewerSetType(viewer,PETSCVIEWERBINARY);CHKERRQ(ierr);
+  ierr = PetscViewerFileSetMode(viewer,FILE_MODE_WRITE);CHKERRQ(ierr);
+  ierr = PetscViewerBinarySetUseMPIIO(viewer,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = PetscViewerBinarySetAsync(viewer,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = PetscViewerSetFromOptions(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerFileSetName(viewer,"ex54.bin");CHKERRQ(ierr);
+  ierr = PetscViewerBinaryGetAsync(viewer,&async);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Writing %D vectors %s\n",steps,async ? "asynchronously" : "synchronously");CHKERRQ(ierr);
+  /* the vector is changed right after each view, as a time step following a checkpoint would */
+  for (k=0; k<steps; k++) {
+    ierr = VecView(x,viewer);CHKERRQ(ierr);
+    ierr = VecShift(x,1.0);CHKERRQ(ierr);
+  }
+  ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
+  /* more views after a flush go on being asynchronous and are completed by the destruction of the viewer */
+  ierr = VecView(x,viewer);CHKERRQ(ierr);
+  ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+
+  /* the file is read back without MPI-IO */
+  ierr = PetscViewerBinaryOpen(PETSC_COMM_WORLD,"ex54.bin",FILE_MODE_READ,&viewer);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&y);CHKERRQ(ierr);
+  for (k=0; k<=steps; k++) {
+    ierr = VecLoad(y,viewer);CHKERRQ(ierr);
+    ierr = VecGetArray(z,&a);CHKERRQ(ierr);
+    for (i=rstart; i<rend; i++) a[i-rstart] = (PetscScalar)(i+k);
+    ierr = VecRestoreArray(z,&a);CHKERRQ(ierr);
+    ierr = VecAXPY(z,-1.0,y);CHKERRQ(ierr);
+    ierr = VecNorm(z,NORM_INFINITY,&err);CHKERRQ(ierr);
+    maxerr = PetscMax(maxerr,err);
+  }
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Read %D vectors %s\n",steps+1,maxerr == 0.0 ? "exactly" : "with errors");CHKERRQ(ierr);
+  ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 3}}
+      requires: define(PETSC_HAVE_MPIIO)
+      output_file: output/ex54_1.out
+
+   test:
+      suffix: 2
+      nsize: 2
+      requires: define(PETSC_HAVE_MPIIO)
+      args: -n 37 -steps 3 -viewer_binary_async 0
+      output_file: output/ex54_2.out
+
+TEST*/
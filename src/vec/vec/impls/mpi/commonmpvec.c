@@ -1,5 +1,6 @@
 
 #include <../src/vec/vec/impls/mpi/pvecimpl.h>   /*I  "petscvec.h"   I*/
+#include <../src/vec/vec/impls/node/vecnodeimpl.h>
 
 /*
   This is used in VecGhostGetLocalForm and VecGhostRestoreLocalForm to ensure
@@ -31,8 +32,8 @@ static PetscErrorCode VecGhostStateSync_Private(Vec g,Vec l)
 
 /*@
     VecGhostGetLocalForm - Obtains the local ghosted representation of
-    a parallel vector (obtained with VecCreateGhost(), VecCreateGhostWithArray()
-    or VecCreateSeq()). Returns NULL if the Vec is not ghosted.
+    a parallel vector (obtained with VecCreateGhost(), VecCreateGhostWithArray(),
+    VecCreateNodeGhost() or VecCreateSeq()). Returns NULL if the Vec is not ghosted.
 
     Logically Collective
 
@@ -72,7 +73,7 @@ $     VecGhostRestoreLocalForm(x,&xlocal);
 PetscErrorCode  VecGhostGetLocalForm(Vec g,Vec *l)
 {
   PetscErrorCode ierr;
-  PetscBool      isseq,ismpi;
+  PetscBool      isseq,ismpi,isnode;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(g,VEC_CLASSID,1);
@@ -80,11 +81,16 @@ PetscErrorCode  VecGhostGetLocalForm(Vec g,Vec *l)
 
   ierr = PetscObjectTypeCompare((PetscObject)g,VECSEQ,&isseq);CHKERRQ(ierr);
   ierr = PetscObjectTypeCompare((PetscObject)g,VECMPI,&ismpi);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)g,VECNODE,&isnode);CHKERRQ(ierr);
   if (ismpi) {
     Vec_MPI *v = (Vec_MPI*)g->data;
     *l = v->localrep;
   } else if (isseq) {
     *l = g;
+#if defined(PETSC_HAVE_MPI_WIN_CREATE_FEATURE)
+  } else if (isnode) {
+    ierr = VecGhostGetLocalForm_Node(g,l);CHKERRQ(ierr);
+#endif
   } else {
     *l = NULL;
   }
@@ -117,7 +123,7 @@ PetscErrorCode  VecGhostGetLocalForm(Vec g,Vec *l)
 PetscErrorCode VecGhostIsLocalForm(Vec g,Vec l,PetscBool *flg)
 {
   PetscErrorCode ierr;
-  PetscBool      isseq,ismpi;
+  PetscBool      isseq,ismpi,isnode;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(g,VEC_CLASSID,1);
@@ -126,11 +132,17 @@ PetscErrorCode VecGhostIsLocalForm(Vec g,Vec l,PetscBool *flg)
   *flg = PETSC_FALSE;
   ierr = PetscObjectTypeCompare((PetscObject)g,VECSEQ,&isseq);CHKERRQ(ierr);
   ierr = PetscObjectTypeCompare((PetscObject)g,VECMPI,&ismpi);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)g,VECNODE,&isnode);CHKERRQ(ierr);
   if (ismpi) {
     Vec_MPI *v = (Vec_MPI*)g->data;
     if (l == v->localrep) *flg = PETSC_TRUE;
   } else if (isseq) {
     if (l == g) *flg = PETSC_TRUE;
+#if defined(PETSC_HAVE_MPI_WIN_CREATE_FEATURE)
+  } else if (isnode) {
+    Vec_Node *v = (Vec_Node*)g->data;
+    if (l == v->localrep) *flg = PETSC_TRUE;
+#endif
   } else SETERRQ(PetscObjectComm((PetscObject)g),PETSC_ERR_ARG_WRONG,"Global vector is not ghosted");
   PetscFunctionReturn(0);
 }
@@ -209,12 +221,13 @@ PetscErrorCode  VecGhostUpdateBegin(Vec g,InsertMode insertmode,ScatterMode scat
 {
   Vec_MPI        *v;
   PetscErrorCode ierr;
-  PetscBool      ismpi,isseq;
+  PetscBool      ismpi,isseq,isnode;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(g,VEC_CLASSID,1);
   ierr = PetscObjectTypeCompare((PetscObject)g,VECMPI,&ismpi);CHKERRQ(ierr);
   ierr = PetscObjectTypeCompare((PetscObject)g,VECSEQ,&isseq);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)g,VECNODE,&isnode);CHKERRQ(ierr);
   if (ismpi) {
     v = (Vec_MPI*)g->data;
     if (!v->localrep) SETERRQ(PetscObjectComm((PetscObject)g),PETSC_ERR_ARG_WRONG,"Vector is not ghosted");
@@ -226,6 +239,10 @@ PetscErrorCode  VecGhostUpdateBegin(Vec g,InsertMode insertmode,ScatterMode scat
     }
   } else if (isseq) {
     /* Do nothing */
+#if defined(PETSC_HAVE_MPI_WIN_CREATE_FEATURE)
+  } else if (isnode) {
+    ierr = VecGhostUpdateBegin_Node(g,insertmode,scattermode);CHKERRQ(ierr);
+#endif
   } else SETERRQ(PetscObjectComm((PetscObject)g),PETSC_ERR_ARG_WRONG,"Vector is not ghosted");
   PetscFunctionReturn(0);
 }
@@ -274,11 +291,12 @@ PetscErrorCode  VecGhostUpdateEnd(Vec g,InsertMode insertmode,ScatterMode scatte
 {
   Vec_MPI        *v;
   PetscErrorCode ierr;
-  PetscBool      ismpi;
+  PetscBool      ismpi,isnode;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(g,VEC_CLASSID,1);
   ierr = PetscObjectTypeCompare((PetscObject)g,VECMPI,&ismpi);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)g,VECNODE,&isnode);CHKERRQ(ierr);
   if (ismpi) {
     v = (Vec_MPI*)g->data;
     if (!v->localrep) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Vector is not ghosted");
@@ -288,6 +306,10 @@ PetscErrorCode  VecGhostUpdateEnd(Vec g,InsertMode insertmode,ScatterMode scatte
     } else {
       ierr = VecScatterEnd(v->localupdate,g,v->localrep,insertmode,scattermode);CHKERRQ(ierr);
     }
+#if defined(PETSC_HAVE_MPI_WIN_CREATE_FEATURE)
+  } else if (isnode) {
+    ierr = VecGhostUpdateEnd_Node(g,insertmode,scattermode);CHKERRQ(ierr);
+#endif
   }
   PetscFunctionReturn(0);
 }
@@ -254,6 +254,7 @@ PetscErrorCode VecCreate_MPICUDA_Private(Vec vv,PetscBool alloc,PetscInt nghost,
   ierr = PetscObjectChangeTypeName((PetscObject)vv,VECMPICUDA);CHKERRQ(ierr);
 
   vv->ops->dotnorm2               = VecDotNorm2_MPICUDA;
+  vv->ops->axpbypczdotnorm        = 0; /* the fused host kernel would copy the vectors off the GPU */
   vv->ops->waxpy                  = VecWAXPY_SeqCUDA;
   vv->ops->duplicate              = VecDuplicate_MPICUDA;
   vv->ops->dot                    = VecDot_MPICUDA;
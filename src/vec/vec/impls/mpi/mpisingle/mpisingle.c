@@ -0,0 +1,240 @@
+/*
+   Implements the parallel vectors with single precision storage and double precision arithmetic.
+   The local parts are handled by the VECSEQSINGLE kernels.
+*/
+
+#include <../src/vec/vec/impls/mpi/pvecimpl.h>
+#include <../src/vec/vec/impls/seq/seqsingle/vecsingleimpl.h>
+
+static PetscErrorCode VecDot_MPISingle(Vec xin,Vec yin,PetscScalar *z)
+{
+  PetscScalar    sum,work;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecDot_SeqSingle(xin,yin,&work);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&work,&sum,1,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+  *z   = sum;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecMDot_MPISingle(Vec xin,PetscInt nv,const Vec y[],PetscScalar *z)
+{
+  PetscScalar    awork[128],*work = awork;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (nv > 128) {
+    ierr = PetscMalloc1(nv,&work);CHKERRQ(ierr);
+  }
+  ierr = VecMDot_SeqSingle(xin,nv,y,work);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(work,z,nv,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+  if (nv > 128) {
+    ierr = PetscFree(work);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecNorm_MPISingle(Vec xin,NormType type,PetscReal *z)
+{
+  PetscReal      work[2];
+  MPI_Comm       comm = PetscObjectComm((PetscObject)xin);
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (type == NORM_2 || type == NORM_FROBENIUS) {
+    ierr    = VecNorm_SeqSingle(xin,NORM_2,work);CHKERRQ(ierr);
+    work[0] = work[0]*work[0];
+    ierr    = MPIU_Allreduce(work,z,1,MPIU_REAL,MPIU_SUM,comm);CHKERRQ(ierr);
+    *z      = PetscSqrtReal(*z);
+  } else if (type == NORM_1) {
+    ierr = VecNorm_SeqSingle(xin,NORM_1,work);CHKERRQ(ierr);
+    ierr = MPIU_Allreduce(work,z,1,MPIU_REAL,MPIU_SUM,comm);CHKERRQ(ierr);
+  } else if (type == NORM_INFINITY) {
+    ierr = VecNorm_SeqSingle(xin,NORM_INFINITY,work);CHKERRQ(ierr);
+    ierr = MPIU_Allreduce(work,z,1,MPIU_REAL,MPIU_MAX,comm);CHKERRQ(ierr);
+  } else if (type == NORM_1_AND_2) {
+    ierr    = VecNorm_SeqSingle(xin,NORM_1_AND_2,work);CHKERRQ(ierr);
+    work[1] = work[1]*work[1];
+    ierr    = MPIU_Allreduce(work,z,2,MPIU_REAL,MPIU_SUM,comm);CHKERRQ(ierr);
+    z[1]    = PetscSqrtReal(z[1]);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecSetValues_MPISingle(Vec xin,PetscInt ni,const PetscInt ix[],const PetscScalar y[],InsertMode addv)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSetValues_Single_Private(xin,ni,ix,y,addv,PETSC_TRUE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecSetValuesBlocked_MPISingle(Vec xin,PetscInt ni,const PetscInt ix[],const PetscScalar y[],InsertMode addv)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSetValuesBlocked_Single_Private(xin,ni,ix,y,addv,PETSC_TRUE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecSetOption_MPISingle(Vec v,VecOption op,PetscBool flag)
+{
+  PetscFunctionBegin;
+  switch (op) {
+  case VEC_IGNORE_OFF_PROC_ENTRIES: v->stash.donotstash = flag;
+    break;
+  case VEC_IGNORE_NEGATIVE_INDICES: v->stash.ignorenegidx = flag;
+    break;
+  default:
+    break;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecDestroy_MPISingle(Vec v)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecDestroy_Single_Private(v);CHKERRQ(ierr);
+  /* Destroy the stashes: note the order - so that the tags are freed properly */
+  ierr = VecStashDestroy_Private(&v->bstash);CHKERRQ(ierr);
+  ierr = VecStashDestroy_Private(&v->stash);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static struct _VecOps DvOps = { VecDuplicate_Single, /* 1 */
+                                VecDuplicateVecs_Default,
+                                VecDestroyVecs_Default,
+                                VecDot_MPISingle,
+                                VecMDot_MPISingle,
+                                VecNorm_MPISingle,
+                                VecDot_MPISingle,
+                                VecMDot_MPISingle,
+                                VecScale_SeqSingle,
+                                VecCopy_SeqSingle, /* 10 */
+                                VecSet_SeqSingle,
+                                VecSwap_SeqSingle,
+                                VecAXPY_SeqSingle,
+                                VecAXPBY_SeqSingle,
+                                VecMAXPY_SeqSingle,
+                                VecAYPX_SeqSingle,
+                                VecWAXPY_SeqSingle,
+                                VecAXPBYPCZ_SeqSingle,
+                                VecPointwiseMult_Seq,
+                                VecPointwiseDivide_Seq,
+                                VecSetValues_MPISingle, /* 20 */
+                                VecAssemblyBegin_MPI,
+                                VecAssemblyEnd_MPI,
+                                VecGetArray_Single,
+                                VecGetSize_MPI,
+                                VecGetSize_Seq,
+                                VecRestoreArray_Single,
+                                VecMax_MPI,
+                                VecMin_MPI,
+                                VecSetRandom_Seq,
+                                VecSetOption_MPISingle,
+                                VecSetValuesBlocked_MPISingle,
+                                VecDestroy_MPISingle,
+                                VecView_MPI,
+                                0,
+                                0,
+                                VecDot_SeqSingle,
+                                VecDot_SeqSingle,
+                                VecNorm_SeqSingle,
+                                VecMDot_SeqSingle,
+                                VecMDot_SeqSingle,
+                                VecLoad_Default,
+                                VecReciprocal_Default,
+                                VecConjugate_Seq,
+                                0,
+                                0,
+                                0,
+                                0,
+                                VecMaxPointwiseDivide_Seq,
+                                VecPointwiseMax_Seq,
+                                VecPointwiseMaxAbs_Seq,
+                                VecPointwiseMin_Seq,
+                                VecGetValues_Single,
+                                0,
+                                0,
+                                0,
+                                0,
+                                0,
+                                0,
+                                VecStrideGather_Default,
+                                VecStrideScatter_Default,
+                                0,
+                                0,
+                                0,
+                                VecGetArrayRead_Single,
+                                VecRestoreArrayRead_Single,
+                                VecStrideSubSetGather_Default,
+                                VecStrideSubSetScatter_Default,
+                                0,
+                                0,
+                                0,
+                                0,
+                                0,
+                                0,
+                                0
+};
+
+/*MC
+   VECMPISINGLE - VECMPISINGLE = "mpisingle" - The basic parallel vector with its values stored in single precision
+
+   Options Database Keys:
+. -vec_type mpisingle - sets the vector type to VECMPISINGLE during a call to VecSetFromOptions()
+
+   Notes:
+   See VECSEQSINGLE. Off-process values set with VecSetValues() are communicated with the legacy (MPI-1) assembly.
+
+   Level: intermediate
+
+.seealso: VecCreate(), VecSetType(), VecSetFromOptions(), VECSINGLE, VECSEQSINGLE, VECMPI, KSPGMRESSetBasisVecType()
+M*/
+
+PETSC_EXTERN PetscErrorCode VecCreate_MPISingle(Vec v)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecCreate_Single_Private(v);CHKERRQ(ierr);
+  ierr = PetscMemcpy(v->ops,&DvOps,sizeof(DvOps));CHKERRQ(ierr);
+
+  v->stash.insertmode  = NOT_SET_VALUES;
+  v->bstash.insertmode = NOT_SET_VALUES;
+  ierr = VecStashCreate_Private(PetscObjectComm((PetscObject)v),1,&v->stash);CHKERRQ(ierr);
+  ierr = VecStashCreate_Private(PetscObjectComm((PetscObject)v),PetscAbs(v->map->bs),&v->bstash);CHKERRQ(ierr);
+  ierr = PetscObjectChangeTypeName((PetscObject)v,VECMPISINGLE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   VECSINGLE - VECSINGLE = "single" - A VECSEQSINGLE on one process and VECMPISINGLE on more than one process
+
+   Options Database Keys:
+. -vec_type single - sets a vector type to single on calls to VecSetFromOptions()
+
+   Level: intermediate
+
+.seealso: VecCreate(), VecSetType(), VecSetFromOptions(), VECSEQSINGLE, VECMPISINGLE, VECSTANDARD, KSPGMRESSetBasisVecType()
+M*/
+
+PETSC_EXTERN PetscErrorCode VecCreate_Single(Vec v)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    size;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)v),&size);CHKERRQ(ierr);
+  if (size == 1) {
+    ierr = VecSetType(v,VECSEQSINGLE);CHKERRQ(ierr);
+  } else {
+    ierr = VecSetType(v,VECMPISINGLE);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
@@ -220,7 +220,9 @@ static PetscErrorCode VecAssemblyBegin_MPI_BTS(Vec X)
      * VEC_SUBSET_OFF_PROC_ENTRIES will leave the old pointers (dangling because the stash has been collected) when
      * there is nothing new to send, so that size-zero messages get sent instead. */
     x->sendhdr[i].count = 0;
-    if (X->stash.n) {
+    if (X->stash.frozen) {      /* values were stashed directly into the buffer for this rank */
+      ierr = VecStashGetFrozenValues_Private(&X->stash,i,&x->sendhdr[i].count,&x->sendptrs[i].ints,&x->sendptrs[i].scalars);CHKERRQ(ierr);
+    } else if (X->stash.n) {
       x->sendptrs[i].ints    = &X->stash.idx[j];
       x->sendptrs[i].scalars = &X->stash.array[j];
       for ( ; j<X->stash.n && X->stash.idx[j] < X->map->range[rank+1]; j++) x->sendhdr[i].count++;
@@ -354,6 +356,15 @@ static PetscErrorCode VecAssemblyEnd_MPI_BTS(Vec X)
   X->bstash.insertmode = NOT_SET_VALUES;
   ierr = VecStashScatterEnd_Private(&X->stash);CHKERRQ(ierr);
   ierr = VecStashScatterEnd_Private(&X->bstash);CHKERRQ(ierr);
+  if (x->assembly_subset && !X->stash.frozen) {
+    /* The communication pattern is reused from now on, so later off-process values can be stashed directly
+     * into one buffer per receiving rank, sized from this assembly, and sent without sorting */
+    PetscInt *counts;
+    ierr = PetscMalloc1(x->nsendranks,&counts);CHKERRQ(ierr);
+    for (r=0; r<x->nsendranks; r++) counts[r] = x->sendhdr[r].count;
+    ierr = VecStashFreeze_Private(&X->stash,X->map,x->nsendranks,x->sendranks,counts);CHKERRQ(ierr);
+    ierr = PetscFree(counts);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -370,6 +381,7 @@ PetscErrorCode VecAssemblyReset_MPI(Vec X)
   ierr = PetscFree(x->sendhdr);CHKERRQ(ierr);
   ierr = PetscFree(x->recvhdr);CHKERRQ(ierr);
   ierr = PetscFree(x->sendptrs);CHKERRQ(ierr);
+  ierr = VecStashUnfreeze_Private(&X->stash);CHKERRQ(ierr);
   ierr = PetscSegBufferDestroy(&x->segrecvint);CHKERRQ(ierr);
   ierr = PetscSegBufferDestroy(&x->segrecvscalar);CHKERRQ(ierr);
   ierr = PetscSegBufferDestroy(&x->segrecvframe);CHKERRQ(ierr);
@@ -468,7 +480,12 @@ static struct _VecOps DvOps = { VecDuplicate_MPI, /* 1 */
                                 VecStrideSubSetGather_Default,
                                 VecStrideSubSetScatter_Default,
                                 0,
-                                0
+                                0,
+                                0,
+                                0,
+                                0,
+                                0,
+                                VecAXPBYPCZDotNorm_MPI
 };
 
 /*
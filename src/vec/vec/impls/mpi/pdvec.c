@@ -394,14 +394,23 @@ PetscErrorCode VecView_MPI_Binary(Vec xin,PetscViewer viewer)
 #if defined(PETSC_HAVE_MPIIO)
   PetscBool         isMPIIO;
 #endif
-  PetscBool         skipHeader;
+  PetscBool         skipHeader,compress;
   PetscInt          message_count,flowcontrolcount;
   PetscViewerFormat format;
 
   PetscFunctionBegin;
+  ierr = PetscViewerBinaryGetSkipHeader(viewer,&skipHeader);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryGetCompression(viewer,&compress,NULL);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_MPIIO)
+  ierr = PetscViewerBinaryGetUseMPIIO(viewer,&isMPIIO);CHKERRQ(ierr);
+  if (isMPIIO) compress = PETSC_FALSE;
+#endif
+  if (compress && !skipHeader) {
+    ierr = VecView_Binary_Compressed(xin,viewer);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = VecGetArrayRead(xin,&xarray);CHKERRQ(ierr);
   ierr = PetscViewerBinaryGetDescriptor(viewer,&fdes);CHKERRQ(ierr);
-  ierr = PetscViewerBinaryGetSkipHeader(viewer,&skipHeader);CHKERRQ(ierr);
 
   /* determine maximum message to arrive */
   ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)xin),&rank);CHKERRQ(ierr);
@@ -414,7 +423,6 @@ PetscErrorCode VecView_MPI_Binary(Vec xin,PetscViewer viewer)
   }
 
 #if defined(PETSC_HAVE_MPIIO)
-  ierr = PetscViewerBinaryGetUseMPIIO(viewer,&isMPIIO);CHKERRQ(ierr);
   if (!isMPIIO) {
 #endif
     ierr = PetscViewerFlowControlStart(viewer,&message_count,&flowcontrolcount);CHKERRQ(ierr);
@@ -459,13 +467,19 @@ PetscErrorCode VecView_MPI_Binary(Vec xin,PetscViewer viewer)
     MPI_Offset   off;
     MPI_File     mfdes;
     PetscMPIInt  lsize;
+    PetscBool    async;
 
     ierr = PetscMPIIntCast(xin->map->n,&lsize);CHKERRQ(ierr);
     ierr = PetscViewerBinaryGetMPIIODescriptor(viewer,&mfdes);CHKERRQ(ierr);
     ierr = PetscViewerBinaryGetMPIIOOffset(viewer,&off);CHKERRQ(ierr);
     off += xin->map->rstart*sizeof(PetscScalar); /* off is MPI_Offset, not PetscMPIInt */
-    ierr = MPI_File_set_view(mfdes,off,MPIU_SCALAR,MPIU_SCALAR,(char*)"native",MPI_INFO_NULL);CHKERRQ(ierr);
-    ierr = MPIU_File_write_all(mfdes,(void*)xarray,lsize,MPIU_SCALAR,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+    ierr = PetscViewerBinaryGetAsync(viewer,&async);CHKERRQ(ierr);
+    if (async) {
+      ierr = PetscViewerBinaryMPIIOWriteAsync(viewer,off,xarray,lsize,MPIU_SCALAR);CHKERRQ(ierr);
+    } else {
+      ierr = MPI_File_set_view(mfdes,off,MPIU_SCALAR,MPIU_SCALAR,(char*)"native",MPI_INFO_NULL);CHKERRQ(ierr);
+      ierr = MPIU_File_write_all(mfdes,(void*)xarray,lsize,MPIU_SCALAR,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+    }
     ierr = PetscViewerBinaryAddMPIIOOffset(viewer,xin->map->N*sizeof(PetscScalar));CHKERRQ(ierr);
   }
 #endif
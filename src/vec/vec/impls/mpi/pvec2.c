@@ -78,6 +78,21 @@ PetscErrorCode VecNorm_MPI(Vec xin,NormType type,PetscReal *z)
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode VecAXPBYPCZDotNorm_MPI(Vec zin,PetscScalar alpha,PetscScalar beta,PetscScalar gamma,Vec xin,Vec yin,Vec win,PetscScalar *z,PetscReal *nrm)
+{
+  PetscScalar    work[2],sum[2];
+  PetscReal      nrm2;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr    = VecAXPBYPCZDotNorm2_Seq(zin,alpha,beta,gamma,xin,yin,win,work,&nrm2);CHKERRQ(ierr);
+  work[1] = nrm2;
+  ierr    = MPIU_Allreduce(work,sum,2,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)zin));CHKERRQ(ierr);
+  if (z)   *z   = sum[0];
+  if (nrm) *nrm = PetscSqrtReal(PetscRealPart(sum[1]));
+  PetscFunctionReturn(0);
+}
+
 extern MPI_Op MPIU_MAXINDEX_OP, MPIU_MININDEX_OP;
 
 PetscErrorCode VecMax_MPI(Vec xin,PetscInt *idx,PetscReal *z)
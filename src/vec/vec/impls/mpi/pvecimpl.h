@@ -45,6 +45,7 @@ PETSC_INTERN PetscErrorCode VecMDot_MPI(Vec,PetscInt,const Vec[],PetscScalar*);
 PETSC_INTERN PetscErrorCode VecTDot_MPI(Vec,Vec,PetscScalar*);
 PETSC_INTERN PetscErrorCode VecMTDot_MPI(Vec,PetscInt,const Vec[],PetscScalar*);
 PETSC_INTERN PetscErrorCode VecNorm_MPI(Vec,NormType,PetscReal*);
+PETSC_INTERN PetscErrorCode VecAXPBYPCZDotNorm_MPI(Vec,PetscScalar,PetscScalar,PetscScalar,Vec,Vec,Vec,PetscScalar*,PetscReal*);
 PETSC_INTERN PetscErrorCode VecMax_MPI(Vec,PetscInt*,PetscReal*);
 PETSC_INTERN PetscErrorCode VecMin_MPI(Vec,PetscInt*,PetscReal*);
 PETSC_INTERN PetscErrorCode VecDestroy_MPI(Vec);
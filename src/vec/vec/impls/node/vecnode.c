@@ -4,25 +4,22 @@
 
 #if defined(PETSC_HAVE_MPI_WIN_CREATE_FEATURE)
 
-PetscErrorCode VecSetValues_Node(Vec xin,PetscInt ni,const PetscInt ix[],const PetscScalar y[],InsertMode addv)
-{
-  PetscFunctionBegin;
-  SETERRQ(PetscObjectComm((PetscObject)xin),PETSC_ERR_SUP,"Not implemented yet");
-  PetscFunctionReturn(0);
-}
-
-/* check all blocks are filled */
 static PetscErrorCode VecAssemblyBegin_Node(Vec v)
 {
+  PetscErrorCode ierr;
+
   PetscFunctionBegin;
+  ierr = VecAssemblyBegin_MPI(v);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
 static PetscErrorCode VecAssemblyEnd_Node(Vec v)
 {
+  PetscErrorCode ierr;
   Vec_Node       *s = (Vec_Node*)v->data;
 
   PetscFunctionBegin;
+  ierr = VecAssemblyEnd_MPI(v);CHKERRQ(ierr);
   s->array[-1] += 1.0; /* update local object state counter if this routine changes values of v */
   /* printf("VecAssemblyEnd_Node s->array[-1] %g\n",s->array[-1]); */
   PetscFunctionReturn(0);
@@ -63,12 +60,33 @@ static PetscErrorCode VecSet_Node(Vec v,PetscScalar alpha)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode VecNodeGhostDestroy_Private(VecNodeGhost *ghost)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*ghost) PetscFunctionReturn(0);
+  if (--(*ghost)->refct > 0) {*ghost = NULL; PetscFunctionReturn(0);}
+  ierr = PetscFree3((*ghost)->sstart,(*ghost)->sslot,(*ghost)->sidx);CHKERRQ(ierr);
+  ierr = PetscFree3((*ghost)->rstart,(*ghost)->ridx,(*ghost)->rslot);CHKERRQ(ierr);
+  ierr = PetscFree(*ghost);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode VecDestroy_Node(Vec v)
 {
   Vec_Node       *vs = (Vec_Node*)v->data;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  if (vs->localrep) {
+    ierr = VecDestroy(&vs->localrep);CHKERRQ(ierr);
+    ierr = VecScatterDestroy(&vs->localupdate);CHKERRQ(ierr);
+    ierr = VecNodeGhostDestroy_Private(&vs->ghost);CHKERRQ(ierr);
+  }
+  ierr = VecStashDestroy_Private(&v->bstash);CHKERRQ(ierr);
+  ierr = VecStashDestroy_Private(&v->stash);CHKERRQ(ierr);
+  ierr = MPI_Win_unlock_all(vs->win);CHKERRQ(ierr);
   ierr = MPI_Win_free(&vs->win);CHKERRQ(ierr);
   ierr = MPI_Comm_free(&vs->shmcomm);CHKERRQ(ierr);
   ierr = PetscFree(vs->winarray);CHKERRQ(ierr);
@@ -76,20 +94,33 @@ static PetscErrorCode VecDestroy_Node(Vec v)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode VecCreate_Node_Private(Vec,PetscInt);
+
 static PetscErrorCode VecDuplicate_Node(Vec x,Vec *y)
 {
   PetscErrorCode ierr;
+  Vec_Node       *s = (Vec_Node*)x->data,*ys;
 
   PetscFunctionBegin;
   ierr = VecCreate(PetscObjectComm((PetscObject)x),y);CHKERRQ(ierr);
-  ierr = VecSetSizes(*y,x->map->n,x->map->N);CHKERRQ(ierr);
-  ierr = VecSetType(*y,((PetscObject)x)->type_name);CHKERRQ(ierr);
   ierr = PetscLayoutReference(x->map,&(*y)->map);CHKERRQ(ierr);
+  ierr = VecCreate_Node_Private(*y,s->nghost);CHKERRQ(ierr);
   ierr = PetscObjectListDuplicate(((PetscObject)x)->olist,&((PetscObject)(*y))->olist);CHKERRQ(ierr);
   ierr = PetscFunctionListDuplicate(((PetscObject)x)->qlist,&((PetscObject)(*y))->qlist);CHKERRQ(ierr);
 
   ierr = PetscMemcpy((*y)->ops,x->ops,sizeof(struct _VecOps));CHKERRQ(ierr);
 
+  /* the ghost points of the new vector have the same owners, so the scatter and the on-node lists are shared */
+  if (s->localrep) {
+    ys   = (Vec_Node*)(*y)->data;
+    ierr = VecCreateSeqWithArray(PETSC_COMM_SELF,PetscAbs(s->localrep->map->bs),x->map->n+s->nghost,ys->array,&ys->localrep);CHKERRQ(ierr);
+    ierr = PetscLogObjectParent((PetscObject)*y,(PetscObject)ys->localrep);CHKERRQ(ierr);
+    ys->localupdate = s->localupdate;
+    ierr = PetscObjectReference((PetscObject)ys->localupdate);CHKERRQ(ierr);
+    ys->ghost = s->ghost;
+    ys->ghost->refct++;
+  }
+
   /* New vector should inherit stashing property of parent */
   (*y)->stash.donotstash   = x->stash.donotstash;
   (*y)->stash.ignorenegidx = x->stash.ignorenegidx;
@@ -112,8 +143,12 @@ static PetscErrorCode VecAYPX_Node(Vec y,PetscScalar alpha,Vec x)
 
 static PetscErrorCode VecAXPBY_Node(Vec y,PetscScalar alpha,PetscScalar beta,Vec x)
 {
+  PetscErrorCode ierr;
+  Vec_Node       *s = (Vec_Node*)y->data;
+
   PetscFunctionBegin;
-  SETERRQ(PetscObjectComm((PetscObject)x),PETSC_ERR_SUP,"Not implemented yet");
+  ierr = VecAXPBY_Seq(y,alpha,beta,x);CHKERRQ(ierr);
+  s->array[-1] += 1.0;
   PetscFunctionReturn(0);
 }
 
@@ -129,35 +164,36 @@ static PetscErrorCode VecAXPBYPCZ_Node(Vec z,PetscScalar alpha,PetscScalar beta,
 }
 
 
-static PetscErrorCode VecConjugate_Node(Vec x)
+static PetscErrorCode VecAXPBYPCZDotNorm_Node(Vec z,PetscScalar alpha,PetscScalar beta,PetscScalar gamma,Vec x,Vec y,Vec w,PetscScalar *dot,PetscReal *nrm)
 {
+  PetscErrorCode ierr;
+  Vec_Node       *s = (Vec_Node*)z->data;
+
   PetscFunctionBegin;
-  SETERRQ(PetscObjectComm((PetscObject)x),PETSC_ERR_SUP,"Not implemented yet");
+  ierr = VecAXPBYPCZDotNorm_MPI(z,alpha,beta,gamma,x,y,w,dot,nrm);CHKERRQ(ierr);
+  s->array[-1] += 1.0;
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode VecWAXPY_Node(Vec w,PetscScalar alpha,Vec x,Vec y)
+static PetscErrorCode VecConjugate_Node(Vec x)
 {
   PetscErrorCode ierr;
-  Vec_Node       *s = (Vec_Node*)w->data;
+  Vec_Node       *s = (Vec_Node*)x->data;
 
   PetscFunctionBegin;
-  ierr = VecWAXPY_Seq(w,alpha,x,y);CHKERRQ(ierr);
+  ierr = VecConjugate_Seq(x);CHKERRQ(ierr);
   s->array[-1] += 1.0;
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode VecMax_Node(Vec x,PetscInt *p,PetscReal *max)
+static PetscErrorCode VecWAXPY_Node(Vec w,PetscScalar alpha,Vec x,Vec y)
 {
-  PetscFunctionBegin;
-  SETERRQ(PetscObjectComm((PetscObject)x),PETSC_ERR_SUP,"Not implemented yet");
-  PetscFunctionReturn(0);
-}
+  PetscErrorCode ierr;
+  Vec_Node       *s = (Vec_Node*)w->data;
 
-static PetscErrorCode VecMin_Node(Vec x,PetscInt *p,PetscReal *min)
-{
   PetscFunctionBegin;
-  SETERRQ(PetscObjectComm((PetscObject)x),PETSC_ERR_SUP,"Not implemented yet");
+  ierr = VecWAXPY_Seq(w,alpha,x,y);CHKERRQ(ierr);
+  s->array[-1] += 1.0;
   PetscFunctionReturn(0);
 }
 
@@ -225,18 +261,18 @@ static struct _VecOps DvOps = { VecDuplicate_Node, /* 1 */
                                 VecAXPBYPCZ_Node,
                                 0,
                                 0,
-                                VecSetValues_Node, /* 20 */
+                                VecSetValues_MPI, /* 20 */
                                 VecAssemblyBegin_Node,
                                 VecAssemblyEnd_Node,
                                 VecGetArray_Node,
                                 VecGetSize_MPI,
                                 VecGetSize_Seq,
                                 VecRestoreArray_Node,
-                                VecMax_Node,
-                                VecMin_Node,
+                                VecMax_MPI,
+                                VecMin_MPI,
                                 VecSetRandom_Seq,
                                 0,
-                                VecSetValuesBlocked_Seq,
+                                VecSetValuesBlocked_MPI,
                                 VecDestroy_Node,
                                 VecView_Node,
                                 VecPlaceArray_Seq,
@@ -278,7 +314,8 @@ static struct _VecOps DvOps = { VecDuplicate_Node, /* 1 */
                                 0,
                                 0,
                                 0,
-                                0
+                                0,
+                                VecAXPBYPCZDotNorm_Node
 };
 
 /*@C
@@ -296,7 +333,7 @@ static struct _VecOps DvOps = { VecDuplicate_Node, /* 1 */
 
    Level: advanced
 
-.seealso: VecCreate(), VecType(), VecCreateMPIWithArray(), VECNODE
+.seealso: VecCreate(), VecType(), VecCreateMPIWithArray(), VECNODE, VecCreateNodeGhost()
 @*/
 PetscErrorCode VecCreateNode(MPI_Comm comm,PetscInt n,PetscInt N,Vec *v)
 {
@@ -309,64 +346,318 @@ PetscErrorCode VecCreateNode(MPI_Comm comm,PetscInt n,PetscInt N,Vec *v)
   PetscFunctionReturn(0);
 }
 
+/*
+   Sorts the ghost points into those owned by processes on this node, which are read directly from the
+   shared window, and those owned by processes on other nodes, which are updated with a VecScatter
+*/
+static PetscErrorCode VecNodeSetGhosts_Private(Vec v,const PetscInt ghosts[])
+{
+  PetscErrorCode         ierr;
+  Vec_Node               *s = (Vec_Node*)v->data;
+  VecNodeGhost           ghost;
+  MPI_Comm               comm = PetscObjectComm((PetscObject)v);
+  MPI_Group              group,shmgroup;
+  PetscMPIInt            size,msize,mrank,r,*granks,*sranks,*scnt,*sdispl,*rcnt,*rdispl;
+  PetscInt               n = v->map->n,nghost = s->nghost,i,k,owner,noff = 0,*offidx,*offslot,*sbuf,*rbuf,*indices,rstart,shsize;
+  IS                     from,to;
+  ISLocalToGlobalMapping ltog;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(s->shmcomm,&msize);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(s->shmcomm,&mrank);CHKERRQ(ierr);
+  shsize = msize;
+  ierr = PetscOptionsGetInt(((PetscObject)v)->options,((PetscObject)v)->prefix,"-vec_node_ghost_shared_size",&shsize,NULL);CHKERRQ(ierr);
+  if (shsize < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"-vec_node_ghost_shared_size %D must be positive",shsize);
+
+  /* rank in shmcomm of every process in comm, MPI_UNDEFINED for processes on other nodes */
+  ierr = PetscMalloc2(size,&granks,size,&sranks);CHKERRQ(ierr);
+  for (r=0; r<size; r++) granks[r] = r;
+  ierr = MPI_Comm_group(comm,&group);CHKERRQ(ierr);
+  ierr = MPI_Comm_group(s->shmcomm,&shmgroup);CHKERRQ(ierr);
+  ierr = MPI_Group_translate_ranks(group,size,granks,shmgroup,sranks);CHKERRQ(ierr);
+  ierr = MPI_Group_free(&group);CHKERRQ(ierr);
+  ierr = MPI_Group_free(&shmgroup);CHKERRQ(ierr);
+  /* for testing, -vec_node_ghost_shared_size treats processes outside groups of that many consecutive processes in shmcomm as if they were on other nodes */
+  for (r=0; r<size; r++) {
+    if (sranks[r] != MPI_UNDEFINED && sranks[r]/shsize != mrank/shsize) sranks[r] = MPI_UNDEFINED;
+  }
+
+  ierr = PetscNew(&ghost);CHKERRQ(ierr);
+  ghost->refct = 1;
+  ierr = PetscMalloc2(nghost,&offidx,nghost,&offslot);CHKERRQ(ierr);
+  ierr = PetscCalloc3(msize+1,&ghost->sstart,nghost,&ghost->sslot,nghost,&ghost->sidx);CHKERRQ(ierr);
+  for (i=0; i<nghost; i++) {
+    ierr = PetscLayoutFindOwner(v->map,ghosts[i],&owner);CHKERRQ(ierr);
+    if (sranks[owner] == MPI_UNDEFINED) {
+      offidx[noff]    = ghosts[i];
+      offslot[noff++] = n+i;
+    } else ghost->sstart[sranks[owner]+1]++;
+  }
+  for (r=0; r<msize; r++) ghost->sstart[r+1] += ghost->sstart[r];
+  for (i=0; i<nghost; i++) {
+    ierr = PetscLayoutFindOwner(v->map,ghosts[i],&owner);CHKERRQ(ierr);
+    if (sranks[owner] == MPI_UNDEFINED) continue;
+    k               = ghost->sstart[sranks[owner]]++;
+    ghost->sslot[k] = n+i;
+    ghost->sidx[k]  = ghosts[i]-v->map->range[owner];
+  }
+  for (r=msize; r>0; r--) ghost->sstart[r] = ghost->sstart[r-1];
+  ghost->sstart[0] = 0;
+  ierr = PetscFree2(granks,sranks);CHKERRQ(ierr);
+
+  /* tell the owners on this node which of their entries we hold and where, so that they can gather them in SCATTER_REVERSE */
+  ierr = PetscMalloc4(msize,&scnt,msize,&sdispl,msize,&rcnt,msize,&rdispl);CHKERRQ(ierr);
+  for (r=0; r<msize; r++) {
+    ierr = PetscMPIIntCast(2*(ghost->sstart[r+1]-ghost->sstart[r]),&scnt[r]);CHKERRQ(ierr);
+    ierr = PetscMPIIntCast(2*ghost->sstart[r],&sdispl[r]);CHKERRQ(ierr);
+  }
+  ierr = MPI_Alltoall(scnt,1,MPI_INT,rcnt,1,MPI_INT,s->shmcomm);CHKERRQ(ierr);
+  rdispl[0] = 0;
+  for (r=1; r<msize; r++) rdispl[r] = rdispl[r-1]+rcnt[r-1];
+  k    = msize ? (rdispl[msize-1]+rcnt[msize-1])/2 : 0;
+  ierr = PetscMalloc2(2*ghost->sstart[msize],&sbuf,2*k,&rbuf);CHKERRQ(ierr);
+  for (i=0; i<ghost->sstart[msize]; i++) {
+    sbuf[2*i]   = ghost->sidx[i];
+    sbuf[2*i+1] = ghost->sslot[i];
+  }
+  ierr = MPI_Alltoallv(sbuf,scnt,sdispl,MPIU_INT,rbuf,rcnt,rdispl,MPIU_INT,s->shmcomm);CHKERRQ(ierr);
+  ierr = PetscMalloc3(msize+1,&ghost->rstart,k,&ghost->ridx,k,&ghost->rslot);CHKERRQ(ierr);
+  for (r=0; r<msize; r++) ghost->rstart[r] = rdispl[r]/2;
+  ghost->rstart[msize] = k;
+  for (i=0; i<k; i++) {
+    ghost->ridx[i]  = rbuf[2*i];
+    ghost->rslot[i] = rbuf[2*i+1];
+  }
+  ierr     = PetscFree2(sbuf,rbuf);CHKERRQ(ierr);
+  ierr     = PetscFree4(scnt,sdispl,rcnt,rdispl);CHKERRQ(ierr);
+  s->ghost = ghost;
+
+  /* local representation and the scatter for the ghost points owned off-node; the latter is collective so every process creates it */
+  ierr = VecCreateSeqWithArray(PETSC_COMM_SELF,1,n+nghost,s->array,&s->localrep);CHKERRQ(ierr);
+  ierr = PetscLogObjectParent((PetscObject)v,(PetscObject)s->localrep);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(comm,noff,offidx,PETSC_USE_POINTER,&from);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PETSC_COMM_SELF,noff,offslot,PETSC_USE_POINTER,&to);CHKERRQ(ierr);
+  ierr = VecScatterCreateWithData(v,from,s->localrep,to,&s->localupdate);CHKERRQ(ierr);
+  ierr = PetscLogObjectParent((PetscObject)v,(PetscObject)s->localupdate);CHKERRQ(ierr);
+  ierr = ISDestroy(&to);CHKERRQ(ierr);
+  ierr = ISDestroy(&from);CHKERRQ(ierr);
+  ierr = PetscFree2(offidx,offslot);CHKERRQ(ierr);
+  ierr = PetscInfo3(v,"%D ghost points, %D owned on this node, %D owned on other nodes\n",nghost,nghost-noff,noff);CHKERRQ(ierr);
+
+  /* set local to global mapping for ghosted vector */
+  ierr = PetscMalloc1(n+nghost,&indices);CHKERRQ(ierr);
+  ierr = VecGetOwnershipRange(v,&rstart,NULL);CHKERRQ(ierr);
+  for (i=0; i<n; i++) indices[i] = rstart + i;
+  for (i=0; i<nghost; i++) indices[n+i] = ghosts[i];
+  ierr = ISLocalToGlobalMappingCreate(comm,1,n+nghost,indices,PETSC_OWN_POINTER,&ltog);CHKERRQ(ierr);
+  ierr = VecSetLocalToGlobalMapping(v,ltog);CHKERRQ(ierr);
+  ierr = ISLocalToGlobalMappingDestroy(&ltog);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   VecCreateNodeGhost - Creates a parallel vector in shared memory with ghost padding on each process
+
+   Collective on MPI_Comm
+
+   Input Parameters:
++  comm - the MPI communicator to use
+.  n - local vector length
+.  N - global vector length (or PETSC_DECIDE to have calculated if n is given)
+.  nghost - number of local ghost points
+-  ghosts - global indices of ghost points, these do not need to be in increasing order (sorted)
+
+   Output Parameter:
+.  vv - the global vector representation (without ghost points as part of vector)
+
+   Notes:
+   The vector is used like one obtained with VecCreateGhost(): VecGhostGetLocalForm() gives the local,
+   ghosted representation and VecGhostUpdateBegin()/VecGhostUpdateEnd() update the ghost points. Ghost
+   points owned by processes on the same node are copied directly out of the owner's shared memory,
+   only the ghost points owned by processes on other nodes go through a VecScatter.
+
+   This also automatically sets the ISLocalToGlobalMapping() for this vector.
+
+   Options Database Keys:
+.  -vec_node_ghost_shared_size <k> - for testing, read only ghost points owned by the same group of k consecutive processes of the node from shared memory and treat the rest as off-node
+
+   Level: advanced
+
+   Concepts: vectors^ghosted
+
+.seealso: VecCreateNode(), VecCreateGhost(), VecGhostGetLocalForm(), VecGhostUpdateBegin(), VECNODE
+@*/
+PetscErrorCode VecCreateNodeGhost(MPI_Comm comm,PetscInt n,PetscInt N,PetscInt nghost,const PetscInt ghosts[],Vec *vv)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *vv = 0;
+  if (n == PETSC_DECIDE)      SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Must set local size");
+  if (nghost == PETSC_DECIDE) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Must set local ghost size");
+  if (nghost < 0)             SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Ghost length must be >= 0");
+  if (nghost) PetscValidIntPointer(ghosts,5);
+  ierr = PetscSplitOwnership(comm,&n,&N);CHKERRQ(ierr);
+  ierr = VecCreate(comm,vv);CHKERRQ(ierr);
+  ierr = VecSetSizes(*vv,n,N);CHKERRQ(ierr);
+  ierr = VecCreate_Node_Private(*vv,nghost);CHKERRQ(ierr);
+  ierr = VecNodeSetGhosts_Private(*vv,ghosts);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecGhostGetLocalForm_Node(Vec g,Vec *l)
+{
+  Vec_Node *s = (Vec_Node*)g->data;
+
+  PetscFunctionBegin;
+  *l = s->localrep;
+  PetscFunctionReturn(0);
+}
+
+/*
+   The processes on the node synchronize before the ghost points are copied out of (SCATTER_FORWARD) or
+   gathered into (SCATTER_REVERSE) the shared window, and again in VecGhostUpdateEnd_Node() so that no
+   process changes its values while another one may still be reading them. The barriers are surrounded by
+   MPI_Win_sync() so that the stores made to the window before a barrier are visible to the loads made after it.
+*/
+PetscErrorCode VecGhostUpdateBegin_Node(Vec g,InsertMode insertmode,ScatterMode scattermode)
+{
+  PetscErrorCode ierr;
+  Vec_Node       *s = (Vec_Node*)g->data;
+  VecNodeGhost   ghost = s->ghost;
+  PetscMPIInt    msize,r;
+  PetscInt       k;
+  PetscScalar    *x = s->array,*y;
+
+  PetscFunctionBegin;
+  if (!s->localrep) SETERRQ(PetscObjectComm((PetscObject)g),PETSC_ERR_ARG_WRONG,"Vector is not ghosted");
+  if (insertmode != INSERT_VALUES && insertmode != ADD_VALUES) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Cannot handle insert mode %D",insertmode);
+  if (scattermode == SCATTER_REVERSE) {
+    ierr = VecScatterBegin(s->localupdate,s->localrep,g,insertmode,scattermode);CHKERRQ(ierr);
+  } else {
+    ierr = VecScatterBegin(s->localupdate,g,s->localrep,insertmode,scattermode);CHKERRQ(ierr);
+  }
+
+  ierr = MPI_Comm_size(s->shmcomm,&msize);CHKERRQ(ierr);
+  ierr = MPI_Win_sync(s->win);CHKERRQ(ierr);
+  ierr = MPI_Barrier(s->shmcomm);CHKERRQ(ierr);
+  ierr = MPI_Win_sync(s->win);CHKERRQ(ierr);
+  if (scattermode == SCATTER_REVERSE) {
+    for (r=0; r<msize; r++) {
+      y = s->winarray[r];
+      if (insertmode == ADD_VALUES) {
+        for (k=ghost->rstart[r]; k<ghost->rstart[r+1]; k++) x[ghost->ridx[k]] += y[ghost->rslot[k]];
+      } else {
+        for (k=ghost->rstart[r]; k<ghost->rstart[r+1]; k++) x[ghost->ridx[k]] = y[ghost->rslot[k]];
+      }
+    }
+  } else {
+    for (r=0; r<msize; r++) {
+      y = s->winarray[r];
+      if (insertmode == ADD_VALUES) {
+        for (k=ghost->sstart[r]; k<ghost->sstart[r+1]; k++) x[ghost->sslot[k]] += y[ghost->sidx[k]];
+      } else {
+        for (k=ghost->sstart[r]; k<ghost->sstart[r+1]; k++) x[ghost->sslot[k]] = y[ghost->sidx[k]];
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecGhostUpdateEnd_Node(Vec g,InsertMode insertmode,ScatterMode scattermode)
+{
+  PetscErrorCode ierr;
+  Vec_Node       *s = (Vec_Node*)g->data;
+
+  PetscFunctionBegin;
+  if (!s->localrep) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Vector is not ghosted");
+  if (scattermode == SCATTER_REVERSE) {
+    ierr = VecScatterEnd(s->localupdate,s->localrep,g,insertmode,scattermode);CHKERRQ(ierr);
+  } else {
+    ierr = VecScatterEnd(s->localupdate,g,s->localrep,insertmode,scattermode);CHKERRQ(ierr);
+  }
+  ierr = MPI_Win_sync(s->win);CHKERRQ(ierr);
+  ierr = MPI_Barrier(s->shmcomm);CHKERRQ(ierr);
+  ierr = MPI_Win_sync(s->win);CHKERRQ(ierr);
+  s->array[-1] += 1.0;
+  PetscFunctionReturn(0);
+}
+
 /*MC
   VECNODE - VECNODE = "node" - Vector type uses on-node shared memory.
 
   Level: intermediate
 
   Notes:
-  This vector type uses on-node shared memory.
+  This vector type uses on-node shared memory: the arrays of all processes on a node are
+  allocated in one MPI-3 shared window, so each process can read the values of the others directly.
+  Vectors created with VecCreateNodeGhost() use this to update ghost points owned on the same node
+  without any messages.
 
-.seealso: VecCreate(), VecType.
+.seealso: VecCreate(), VecType, VecCreateNode(), VecCreateNodeGhost()
 M*/
 
-PETSC_EXTERN PetscErrorCode VecCreate_Node(Vec v)
+/* allocates the local part of the vector and nghost ghost points in the shared window */
+static PetscErrorCode VecCreate_Node_Private(Vec v,PetscInt nghost)
 {
   PetscErrorCode ierr;
   Vec_Node       *s;
-  PetscBool      alloc=PETSC_TRUE;
-  PetscScalar    *array=NULL;
   MPI_Comm       shmcomm;
   MPI_Win        win;
+  PetscInt       n;
+  PetscMPIInt    msize,mrank,disp_unit;
+  PetscInt       i;
+  MPI_Aint       sz;
 
   PetscFunctionBegin;
   ierr           = PetscNewLog(v,&s);CHKERRQ(ierr);
   v->data        = (void*)s;
   ierr           = PetscMemcpy(v->ops,&DvOps,sizeof(DvOps));CHKERRQ(ierr);
   v->petscnative = PETSC_FALSE;
+  s->nghost      = nghost;
 
   ierr = PetscLayoutSetUp(v->map);CHKERRQ(ierr);
 
-  s->array           = (PetscScalar*)array;
   s->array_allocated = 0;
-
-  if (alloc && !array) {
-    PetscInt n = v->map->n;
-    PetscMPIInt msize,mrank,disp_unit;
-    PetscInt    i;
-    MPI_Aint    sz;
-
-    ierr = MPI_Comm_split_type(PetscObjectComm((PetscObject)v),MPI_COMM_TYPE_SHARED,0,MPI_INFO_NULL,&shmcomm);CHKERRQ(ierr);
-    ierr = MPIU_Win_allocate_shared((n+1)*sizeof(PetscScalar),sizeof(PetscScalar),MPI_INFO_NULL,shmcomm,&s->array,&win);CHKERRQ(ierr);
-    ierr               = PetscLogObjectMemory((PetscObject)v,(n+1)*sizeof(PetscScalar));CHKERRQ(ierr);
-    ierr               = PetscMemzero(s->array,(n+1)*sizeof(PetscScalar));CHKERRQ(ierr);
-    s->array++;    /* create initial space for object state counter */
-
-    ierr = MPI_Comm_size(shmcomm,&msize);CHKERRQ(ierr);
-    ierr = MPI_Comm_rank(shmcomm,&mrank);CHKERRQ(ierr);
-    ierr = PetscMalloc1(msize,&s->winarray);CHKERRQ(ierr);
-    for (i=0; i<msize; i++) {
-      if (i != mrank) {
-        MPIU_Win_shared_query(win,i,&sz,&disp_unit,&s->winarray[i]);
-        s->winarray[i]++;
-      }
-    }
-    s->win             = win;
-    s->shmcomm         = shmcomm;
+  n                  = v->map->n+nghost;
+
+  ierr = MPI_Comm_split_type(PetscObjectComm((PetscObject)v),MPI_COMM_TYPE_SHARED,0,MPI_INFO_NULL,&shmcomm);CHKERRQ(ierr);
+  ierr = MPIU_Win_allocate_shared((n+1)*sizeof(PetscScalar),sizeof(PetscScalar),MPI_INFO_NULL,shmcomm,&s->array,&win);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)v,(n+1)*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscMemzero(s->array,(n+1)*sizeof(PetscScalar));CHKERRQ(ierr);
+  s->array++;    /* create initial space for object state counter */
+
+  ierr = MPI_Comm_size(shmcomm,&msize);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(shmcomm,&mrank);CHKERRQ(ierr);
+  ierr = PetscMalloc1(msize,&s->winarray);CHKERRQ(ierr);
+  for (i=0; i<msize; i++) {
+    if (i != mrank) {
+      MPIU_Win_shared_query(win,i,&sz,&disp_unit,&s->winarray[i]);
+      s->winarray[i]++;
+    } else s->winarray[i] = s->array;
   }
+  s->win     = win;
+  s->shmcomm = shmcomm;
+  /* a passive target epoch is open for the life of the vector so that MPI_Win_sync() can order the accesses to the window */
+  ierr = MPI_Win_lock_all(MPI_MODE_NOCHECK,win);CHKERRQ(ierr);
+
+  v->stash.insertmode  = NOT_SET_VALUES;
+  v->bstash.insertmode = NOT_SET_VALUES;
+  ierr = VecStashCreate_Private(PetscObjectComm((PetscObject)v),1,&v->stash);CHKERRQ(ierr);
+  ierr = VecStashCreate_Private(PetscObjectComm((PetscObject)v),PetscAbs(v->map->bs),&v->bstash);CHKERRQ(ierr);
 
   ierr = PetscObjectChangeTypeName((PetscObject)v,VECNODE);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
+PETSC_EXTERN PetscErrorCode VecCreate_Node(Vec v)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecCreate_Node_Private(v,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #endif
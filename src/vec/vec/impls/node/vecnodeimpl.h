@@ -1,16 +1,39 @@
-
 #if !defined(VecNode_impl_h)
 #define VecNode_impl_h
 
 #include <petsc/private/vecimpl.h>
 
 #if defined(PETSC_HAVE_MPI_WIN_CREATE_FEATURE)
+/*
+   Ghost points of a VECNODE that are owned by processes on the same node. They are read directly
+   from the owner's part of the shared window, the lists are ordered by the rank of the owner in shmcomm.
+   The lists only depend on the layout, so they are shared by all duplicates of a vector.
+*/
+typedef struct _n_VecNodeGhost *VecNodeGhost;
+struct _n_VecNodeGhost {
+  PetscInt refct;
+  PetscInt *sstart;     /* ghost points sstart[r] to sstart[r+1]-1 are owned by process r of shmcomm */
+  PetscInt *sslot;      /* location of the ghost point in the local form */
+  PetscInt *sidx;       /* location of the ghost point in the array of its owner */
+  PetscInt *rstart;     /* owned entries rstart[r] to rstart[r+1]-1 are ghost points on process r of shmcomm */
+  PetscInt *ridx;       /* location of the owned entry in the local array */
+  PetscInt *rslot;      /* location of the copy in the local form of process r */
+};
+
 typedef struct {
   VECHEADER
-  MPI_Win     win;
-  MPI_Comm    shmcomm;
-  PetscScalar **winarray; /* holds array pointer of shared value array */
+  MPI_Win      win;
+  MPI_Comm     shmcomm;
+  PetscScalar  **winarray;   /* holds array pointer of shared value array */
+  PetscInt     nghost;       /* number of ghost points on this process */
+  Vec          localrep;     /* local representation of vector */
+  VecScatter   localupdate;  /* scatter to update the ghost points owned by processes on other nodes */
+  VecNodeGhost ghost;        /* ghost points owned by processes on this node */
 } Vec_Node;
+
+PETSC_INTERN PetscErrorCode VecGhostGetLocalForm_Node(Vec,Vec*);
+PETSC_INTERN PetscErrorCode VecGhostUpdateBegin_Node(Vec,InsertMode,ScatterMode);
+PETSC_INTERN PetscErrorCode VecGhostUpdateEnd_Node(Vec,InsertMode,ScatterMode);
 #endif
 
 #endif
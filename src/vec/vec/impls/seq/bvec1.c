@@ -151,3 +151,59 @@ PetscErrorCode VecAXPBYPCZ_Seq(Vec zin,PetscScalar alpha,PetscScalar beta,PetscS
   ierr = VecRestoreArray(zin,&zz);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+
+/*
+   Computes z = alpha x + beta y + gamma z together with the local parts of (z,w) (when w is given) and of ||z||^2,
+   in one pass over the vectors. y may be NULL, z is not read when gamma is 0.
+*/
+#define VecUpdateReduce_Seq_Loop(zi) do {                                                         \
+    if (ww) {                                                                                      \
+      for (i=0; i<n; i++) {zz[i] = zi; dot += zz[i]*PetscConj(ww[i]); nrm += PetscRealPart(zz[i]*PetscConj(zz[i]));} \
+    } else {                                                                                       \
+      for (i=0; i<n; i++) {zz[i] = zi; nrm += PetscRealPart(zz[i]*PetscConj(zz[i]));}              \
+    }                                                                                              \
+  } while (0)
+
+PetscErrorCode VecAXPBYPCZDotNorm2_Seq(Vec zin,PetscScalar alpha,PetscScalar beta,PetscScalar gamma,Vec xin,Vec yin,Vec win,PetscScalar *z,PetscReal *nrm2)
+{
+  PetscErrorCode    ierr;
+  PetscInt          n = zin->map->n,i;
+  const PetscScalar *xx,*yy = NULL,*ww = NULL;
+  PetscScalar       *zz,dot = 0.0;
+  PetscReal         nrm = 0.0;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
+  if (yin) {ierr = VecGetArrayRead(yin,&yy);CHKERRQ(ierr);}
+  ierr = VecGetArray(zin,&zz);CHKERRQ(ierr);
+  /* w may be z itself, zz[i] is assigned before ww[i] is read */
+  if (win) {ierr = VecGetArrayRead(win,&ww);CHKERRQ(ierr);}
+  if (!yy) {
+    if (gamma == (PetscScalar)1.0) VecUpdateReduce_Seq_Loop(zz[i] + alpha*xx[i]);
+    else if (gamma == (PetscScalar)0.0) VecUpdateReduce_Seq_Loop(alpha*xx[i]);
+    else VecUpdateReduce_Seq_Loop(alpha*xx[i] + gamma*zz[i]);
+  } else {
+    if (gamma == (PetscScalar)1.0) VecUpdateReduce_Seq_Loop(alpha*xx[i] + beta*yy[i] + zz[i]);
+    else if (gamma == (PetscScalar)0.0) VecUpdateReduce_Seq_Loop(alpha*xx[i] + beta*yy[i]);
+    else VecUpdateReduce_Seq_Loop(alpha*xx[i] + beta*yy[i] + gamma*zz[i]);
+  }
+  if (win) {ierr = VecRestoreArrayRead(win,&ww);CHKERRQ(ierr);}
+  ierr = VecRestoreArray(zin,&zz);CHKERRQ(ierr);
+  if (yin) {ierr = VecRestoreArrayRead(yin,&yy);CHKERRQ(ierr);}
+  ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
+  ierr = PetscLogFlops((yin ? 3.0 : 1.0)*n + (gamma == (PetscScalar)0.0 ? 0.0 : 2.0*n) + (win ? 4.0*n : 2.0*n));CHKERRQ(ierr);
+  if (z) *z = dot;
+  *nrm2 = nrm;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecAXPBYPCZDotNorm_Seq(Vec zin,PetscScalar alpha,PetscScalar beta,PetscScalar gamma,Vec xin,Vec yin,Vec win,PetscScalar *z,PetscReal *nrm)
+{
+  PetscErrorCode ierr;
+  PetscReal      nrm2;
+
+  PetscFunctionBegin;
+  ierr = VecAXPBYPCZDotNorm2_Seq(zin,alpha,beta,gamma,xin,yin,win,z,&nrm2);CHKERRQ(ierr);
+  if (nrm) *nrm = PetscSqrtReal(nrm2);
+  PetscFunctionReturn(0);
+}
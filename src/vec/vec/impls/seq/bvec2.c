@@ -535,12 +535,22 @@ PetscErrorCode VecView_Seq_Binary(Vec xin,PetscViewer viewer)
 #if defined(PETSC_HAVE_MPIIO)
   PetscBool         isMPIIO;
 #endif
-  PetscBool         skipHeader;
+  PetscBool         skipHeader,compress;
   PetscViewerFormat format;
 
   PetscFunctionBegin;
-  /* Write vector header */
   ierr = PetscViewerBinaryGetSkipHeader(viewer,&skipHeader);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryGetCompression(viewer,&compress,NULL);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_MPIIO)
+  ierr = PetscViewerBinaryGetUseMPIIO(viewer,&isMPIIO);CHKERRQ(ierr);
+  if (isMPIIO) compress = PETSC_FALSE;
+#endif
+  if (compress && !skipHeader) {
+    ierr = VecView_Binary_Compressed(xin,viewer);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
+  /* Write vector header */
   if (!skipHeader) {
     ierr = PetscViewerBinaryWrite(viewer,&classid,1,PETSC_INT,PETSC_FALSE);CHKERRQ(ierr);
     ierr = PetscViewerBinaryWrite(viewer,&n,1,PETSC_INT,PETSC_FALSE);CHKERRQ(ierr);
@@ -548,7 +558,6 @@ PetscErrorCode VecView_Seq_Binary(Vec xin,PetscViewer viewer)
 
   /* Write vector contents */
 #if defined(PETSC_HAVE_MPIIO)
-  ierr = PetscViewerBinaryGetUseMPIIO(viewer,&isMPIIO);CHKERRQ(ierr);
   if (!isMPIIO) {
 #endif
     ierr = PetscViewerBinaryGetDescriptor(viewer,&fdes);CHKERRQ(ierr);
@@ -573,13 +582,19 @@ PetscErrorCode VecView_Seq_Binary(Vec xin,PetscViewer viewer)
     MPI_Offset   off;
     MPI_File     mfdes;
     PetscMPIInt  lsize;
+    PetscBool    async;
 
     ierr = PetscMPIIntCast(n,&lsize);CHKERRQ(ierr);
     ierr = PetscViewerBinaryGetMPIIODescriptor(viewer,&mfdes);CHKERRQ(ierr);
     ierr = PetscViewerBinaryGetMPIIOOffset(viewer,&off);CHKERRQ(ierr);
-    ierr = MPI_File_set_view(mfdes,off,MPIU_SCALAR,MPIU_SCALAR,(char*)"native",MPI_INFO_NULL);CHKERRQ(ierr);
+    ierr = PetscViewerBinaryGetAsync(viewer,&async);CHKERRQ(ierr);
     ierr = VecGetArrayRead(xin,&xv);CHKERRQ(ierr);
-    ierr = MPIU_File_write_all(mfdes,(void*)xv,lsize,MPIU_SCALAR,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+    if (async) {
+      ierr = PetscViewerBinaryMPIIOWriteAsync(viewer,off,xv,lsize,MPIU_SCALAR);CHKERRQ(ierr);
+    } else {
+      ierr = MPI_File_set_view(mfdes,off,MPIU_SCALAR,MPIU_SCALAR,(char*)"native",MPI_INFO_NULL);CHKERRQ(ierr);
+      ierr = MPIU_File_write_all(mfdes,(void*)xv,lsize,MPIU_SCALAR,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+    }
     ierr = VecRestoreArrayRead(xin,&xv);CHKERRQ(ierr);
     ierr = PetscViewerBinaryAddMPIIOOffset(viewer,n*sizeof(PetscScalar));CHKERRQ(ierr);
   }
@@ -882,7 +897,12 @@ static struct _VecOps DvOps = {VecDuplicate_Seq, /* 1 */
                                VecStrideSubSetGather_Default,
                                VecStrideSubSetScatter_Default,
                                0,
-                               0
+                               0,
+                               0,
+                               0,
+                               0,
+                               0,
+                               VecAXPBYPCZDotNorm_Seq
 };
 
 
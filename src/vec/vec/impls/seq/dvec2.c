@@ -6,7 +6,131 @@
 #include <../src/vec/vec/impls/dvecimpl.h>
 #include <petsc/private/kernels/petscaxpy.h>
 
+/*
+   Explicit SIMD kernels for VecMDot_Seq() and VecMAXPY_Seq() that work on eight vectors at a time so that
+   each load of x is reused eight times. The AVX-512 version is used when PETSc is configured with
+   --with-avx512-kernels and compiled for AVX-512, the AVX2 version whenever the compiler targets AVX2 with FMA.
+*/
+#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX)
+  #if defined(PETSC_USE_AVX512_KERNELS) && defined(__AVX512F__)
+    #include <immintrin.h>
+    #define PETSC_VEC_SEQ_SIMD_KERNELS
+    #define VecSIMDWidth           8
+    #define VecSIMDType            __m512d
+    #define VecSIMDZero()          _mm512_setzero_pd()
+    #define VecSIMDSet1(a)         _mm512_set1_pd(a)
+    #define VecSIMDLoad(p)         _mm512_loadu_pd(p)
+    #define VecSIMDStore(p,v)      _mm512_storeu_pd(p,v)
+    #define VecSIMDFMA(a,b,c)      _mm512_fmadd_pd(a,b,c)
+    #define VecSIMDReduceAdd(v)    _mm512_reduce_add_pd(v)
+  #elif defined(__AVX2__) && defined(__FMA__)
+    #include <immintrin.h>
+    #define PETSC_VEC_SEQ_SIMD_KERNELS
+    #define VecSIMDWidth           4
+    #define VecSIMDType            __m256d
+    #define VecSIMDZero()          _mm256_setzero_pd()
+    #define VecSIMDSet1(a)         _mm256_set1_pd(a)
+    #define VecSIMDLoad(p)         _mm256_loadu_pd(p)
+    #define VecSIMDStore(p,v)      _mm256_storeu_pd(p,v)
+    #define VecSIMDFMA(a,b,c)      _mm256_fmadd_pd(a,b,c)
+    #define VecSIMDReduceAdd(v)    VecSIMDReduceAdd_AVX2(v)
+PETSC_STATIC_INLINE double VecSIMDReduceAdd_AVX2(__m256d v)
+{
+  __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v),_mm256_extractf128_pd(v,1));
+  return _mm_cvtsd_f64(_mm_add_sd(s,_mm_unpackhi_pd(s,s)));
+}
+  #endif
+#endif
+
+#if defined(PETSC_VEC_SEQ_SIMD_KERNELS)
+/* z[k] = x . y[k] for k = 0,...,7 */
+PETSC_STATIC_INLINE void VecMDot8_SIMD_Private(PetscInt n,const PetscScalar *x,const PetscScalar *const *y,PetscScalar *z)
+{
+  const PetscScalar *y0 = y[0],*y1 = y[1],*y2 = y[2],*y3 = y[3],*y4 = y[4],*y5 = y[5],*y6 = y[6],*y7 = y[7];
+  VecSIMDType       vx,s0,s1,s2,s3,s4,s5,s6,s7;
+  PetscInt          i,nb = n - n%VecSIMDWidth;
+
+  s0 = s1 = s2 = s3 = s4 = s5 = s6 = s7 = VecSIMDZero();
+  for (i=0; i<nb; i+=VecSIMDWidth) {
+    vx = VecSIMDLoad(x+i);
+    s0 = VecSIMDFMA(vx,VecSIMDLoad(y0+i),s0);
+    s1 = VecSIMDFMA(vx,VecSIMDLoad(y1+i),s1);
+    s2 = VecSIMDFMA(vx,VecSIMDLoad(y2+i),s2);
+    s3 = VecSIMDFMA(vx,VecSIMDLoad(y3+i),s3);
+    s4 = VecSIMDFMA(vx,VecSIMDLoad(y4+i),s4);
+    s5 = VecSIMDFMA(vx,VecSIMDLoad(y5+i),s5);
+    s6 = VecSIMDFMA(vx,VecSIMDLoad(y6+i),s6);
+    s7 = VecSIMDFMA(vx,VecSIMDLoad(y7+i),s7);
+  }
+  z[0] = VecSIMDReduceAdd(s0); z[1] = VecSIMDReduceAdd(s1);
+  z[2] = VecSIMDReduceAdd(s2); z[3] = VecSIMDReduceAdd(s3);
+  z[4] = VecSIMDReduceAdd(s4); z[5] = VecSIMDReduceAdd(s5);
+  z[6] = VecSIMDReduceAdd(s6); z[7] = VecSIMDReduceAdd(s7);
+  for (; i<n; i++) {
+    z[0] += x[i]*y0[i]; z[1] += x[i]*y1[i]; z[2] += x[i]*y2[i]; z[3] += x[i]*y3[i];
+    z[4] += x[i]*y4[i]; z[5] += x[i]*y5[i]; z[6] += x[i]*y6[i]; z[7] += x[i]*y7[i];
+  }
+}
+
+/* x += sum_k alpha[k] y[k] for k = 0,...,7 */
+PETSC_STATIC_INLINE void VecMAXPY8_SIMD_Private(PetscInt n,PetscScalar *x,const PetscScalar *alpha,const PetscScalar *const *y)
+{
+  const PetscScalar *y0 = y[0],*y1 = y[1],*y2 = y[2],*y3 = y[3],*y4 = y[4],*y5 = y[5],*y6 = y[6],*y7 = y[7];
+  VecSIMDType       vx,a0,a1,a2,a3,a4,a5,a6,a7;
+  PetscInt          i,nb = n - n%VecSIMDWidth;
+
+  a0 = VecSIMDSet1(alpha[0]); a1 = VecSIMDSet1(alpha[1]); a2 = VecSIMDSet1(alpha[2]); a3 = VecSIMDSet1(alpha[3]);
+  a4 = VecSIMDSet1(alpha[4]); a5 = VecSIMDSet1(alpha[5]); a6 = VecSIMDSet1(alpha[6]); a7 = VecSIMDSet1(alpha[7]);
+  for (i=0; i<nb; i+=VecSIMDWidth) {
+    vx = VecSIMDLoad(x+i);
+    vx = VecSIMDFMA(a0,VecSIMDLoad(y0+i),vx);
+    vx = VecSIMDFMA(a1,VecSIMDLoad(y1+i),vx);
+    vx = VecSIMDFMA(a2,VecSIMDLoad(y2+i),vx);
+    vx = VecSIMDFMA(a3,VecSIMDLoad(y3+i),vx);
+    vx = VecSIMDFMA(a4,VecSIMDLoad(y4+i),vx);
+    vx = VecSIMDFMA(a5,VecSIMDLoad(y5+i),vx);
+    vx = VecSIMDFMA(a6,VecSIMDLoad(y6+i),vx);
+    vx = VecSIMDFMA(a7,VecSIMDLoad(y7+i),vx);
+    VecSIMDStore(x+i,vx);
+  }
+  for (; i<n; i++) {
+    x[i] += alpha[0]*y0[i] + alpha[1]*y1[i] + alpha[2]*y2[i] + alpha[3]*y3[i]
+          + alpha[4]*y4[i] + alpha[5]*y5[i] + alpha[6]*y6[i] + alpha[7]*y7[i];
+  }
+}
+
+/* Computes the dot products with the first nv vectors of yin[]; nv must be a multiple of 8 */
+static PetscErrorCode VecMDot_Seq_SIMD_Private(PetscInt n,const PetscScalar *x,PetscInt nv,const Vec yin[],PetscScalar *z)
+{
+  PetscErrorCode    ierr;
+  PetscInt          i,k;
+  const PetscScalar *yy[8];
 
+  PetscFunctionBegin;
+  for (i=0; i<nv; i+=8) {
+    for (k=0; k<8; k++) {ierr = VecGetArrayRead(yin[i+k],&yy[k]);CHKERRQ(ierr);}
+    VecMDot8_SIMD_Private(n,x,yy,z+i);
+    for (k=0; k<8; k++) {ierr = VecRestoreArrayRead(yin[i+k],&yy[k]);CHKERRQ(ierr);}
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Adds the first nv terms alpha[k] yin[k] to x; nv must be a multiple of 8 */
+static PetscErrorCode VecMAXPY_Seq_SIMD_Private(PetscInt n,PetscScalar *x,PetscInt nv,const PetscScalar *alpha,Vec yin[])
+{
+  PetscErrorCode    ierr;
+  PetscInt          i,k;
+  const PetscScalar *yy[8];
+
+  PetscFunctionBegin;
+  for (i=0; i<nv; i+=8) {
+    for (k=0; k<8; k++) {ierr = VecGetArrayRead(yin[i+k],&yy[k]);CHKERRQ(ierr);}
+    VecMAXPY8_SIMD_Private(n,x,alpha+i,yy);
+    for (k=0; k<8; k++) {ierr = VecRestoreArrayRead(yin[i+k],&yy[k]);CHKERRQ(ierr);}
+  }
+  PetscFunctionReturn(0);
+}
+#endif
 
 #if defined(PETSC_USE_FORTRAN_KERNEL_MDOT)
 #include <../src/vec/vec/impls/seq/ftn-kernels/fmdot.h>
@@ -27,6 +151,12 @@ PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
   nv_rem = nv&0x3;
   yy     = (Vec*)yin;
   ierr   = VecGetArrayRead(xin,&x);CHKERRQ(ierr);
+#if defined(PETSC_VEC_SEQ_SIMD_KERNELS)
+  ierr = VecMDot_Seq_SIMD_Private(n,x,nv&~0x7,yy,z);CHKERRQ(ierr);
+  z   += nv&~0x7;
+  yy  += nv&~0x7;
+  i   -= nv&~0x7;
+#endif
 
   switch (nv_rem) {
   case 3:
@@ -110,6 +240,12 @@ PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
   j      = n;
   ierr   = VecGetArrayRead(xin,&xbase);CHKERRQ(ierr);
   x      = xbase;
+#if defined(PETSC_VEC_SEQ_SIMD_KERNELS)
+  ierr = VecMDot_Seq_SIMD_Private(n,xbase,nv&~0x7,yy,z);CHKERRQ(ierr);
+  z   += nv&~0x7;
+  yy  += nv&~0x7;
+  i   -= nv&~0x7;
+#endif
 
   switch (nv_rem) {
   case 3:
@@ -567,6 +703,12 @@ PetscErrorCode VecMAXPY_Seq(Vec xin, PetscInt nv,const PetscScalar *alpha,Vec *y
   PetscFunctionBegin;
   ierr = PetscLogFlops(nv*2.0*n);CHKERRQ(ierr);
   ierr = VecGetArray(xin,&xx);CHKERRQ(ierr);
+#if defined(PETSC_VEC_SEQ_SIMD_KERNELS)
+  ierr   = VecMAXPY_Seq_SIMD_Private(n,xx,nv&~0x7,alpha,y);CHKERRQ(ierr);
+  alpha += nv&~0x7;
+  y     += nv&~0x7;
+  nv    &= 0x7;
+#endif
   switch (j_rem=nv&0x3) {
   case 3:
     ierr   = VecGetArrayRead(y[0],&yy0);CHKERRQ(ierr);
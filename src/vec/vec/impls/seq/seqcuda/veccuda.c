@@ -395,6 +395,7 @@ PetscErrorCode VecCreate_SeqCUDA_Private(Vec V,const PetscScalar *array)
   V->ops->aypx                   = VecAYPX_SeqCUDA;
   V->ops->waxpy                  = VecWAXPY_SeqCUDA;
   V->ops->dotnorm2               = VecDotNorm2_SeqCUDA;
+  V->ops->axpbypczdotnorm        = 0; /* the fused host kernel would copy the vectors off the GPU */
   V->ops->placearray             = VecPlaceArray_SeqCUDA;
   V->ops->replacearray           = VecReplaceArray_SeqCUDA;
   V->ops->resetarray             = VecResetArray_SeqCUDA;
@@ -0,0 +1,617 @@
+/*
+   Implements the sequential vectors with single precision storage and double precision arithmetic.
+*/
+
+#include <../src/vec/vec/impls/dvecimpl.h>
+#include <../src/vec/vec/impls/seq/seqsingle/vecsingleimpl.h>
+
+#define VecSingleArray(v) (((Vec_Single*)(v)->data)->farray)
+
+PetscErrorCode VecGetArray_Single(Vec v,PetscScalar **a)
+{
+  Vec_Single     *s = (Vec_Single*)v->data;
+  PetscInt       i,n = v->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!s->ngets) {
+    if (!s->array_allocated) {
+      ierr = PetscMalloc1(n,&s->array_allocated);CHKERRQ(ierr);
+      ierr = PetscLogObjectMemory((PetscObject)v,n*sizeof(PetscScalar));CHKERRQ(ierr);
+    }
+    s->array = s->array_allocated;
+    for (i=0; i<n; i++) s->array[i] = s->farray[i];
+  }
+  s->ngets++;
+  s->modified = PETSC_TRUE;
+  *a = s->array;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecGetArrayRead_Single(Vec v,const PetscScalar **a)
+{
+  Vec_Single     *s = (Vec_Single*)v->data;
+  PetscBool      modified = s->modified;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetArray_Single(v,(PetscScalar**)a);CHKERRQ(ierr);
+  s->modified = modified;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecRestoreArray_Single(Vec v,PetscScalar **a)
+{
+  Vec_Single     *s = (Vec_Single*)v->data;
+  PetscInt       i,n = v->map->n;
+
+  PetscFunctionBegin;
+  if (!s->ngets) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Array was not gotten");
+  if (--s->ngets) PetscFunctionReturn(0);
+  if (s->modified) {
+    for (i=0; i<n; i++) s->farray[i] = (float)s->array[i];
+  }
+  s->modified = PETSC_FALSE;
+  s->array    = NULL;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecRestoreArrayRead_Single(Vec v,const PetscScalar **a)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecRestoreArray_Single(v,(PetscScalar**)a);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecDuplicate_Single(Vec win,Vec *V)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecCreate(PetscObjectComm((PetscObject)win),V);CHKERRQ(ierr);
+  ierr = PetscLayoutReference(win->map,&(*V)->map);CHKERRQ(ierr);
+  ierr = VecSetType(*V,((PetscObject)win)->type_name);CHKERRQ(ierr);
+  ierr = PetscObjectListDuplicate(((PetscObject)win)->olist,&((PetscObject)(*V))->olist);CHKERRQ(ierr);
+  ierr = PetscFunctionListDuplicate(((PetscObject)win)->qlist,&((PetscObject)(*V))->qlist);CHKERRQ(ierr);
+
+  (*V)->ops->view          = win->ops->view;
+  (*V)->stash.donotstash   = win->stash.donotstash;
+  (*V)->stash.ignorenegidx = win->stash.ignorenegidx;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecGetValues_Single(Vec xin,PetscInt ni,const PetscInt ix[],PetscScalar y[])
+{
+  const float *xx = VecSingleArray(xin);
+  PetscInt    i,tmp,start = xin->map->rstart;
+
+  PetscFunctionBegin;
+  for (i=0; i<ni; i++) {
+    if (xin->stash.ignorenegidx && ix[i] < 0) continue;
+    tmp = ix[i] - start;
+    if (tmp < 0 || tmp >= xin->map->n) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Can only get local values, trying %D",ix[i]);
+    y[i] = xx[tmp];
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Sets the values owned by this process directly in the single precision array, the other values are put in the stash
+   when stash is true (parallel vectors) and generate an error otherwise.
+*/
+PetscErrorCode VecSetValues_Single_Private(Vec xin,PetscInt ni,const PetscInt ix[],const PetscScalar y[],InsertMode addv,PetscBool stash)
+{
+  float          *xx = VecSingleArray(xin);
+  PetscInt       i,row,start = xin->map->rstart,end = xin->map->rend;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (stash) {
+#if defined(PETSC_USE_DEBUG)
+    if (xin->stash.insertmode == INSERT_VALUES && addv == ADD_VALUES) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"You have already inserted values; you cannot now add");
+    else if (xin->stash.insertmode == ADD_VALUES && addv == INSERT_VALUES) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"You have already added values; you cannot now insert");
+#endif
+    xin->stash.insertmode = addv;
+  }
+  for (i=0; i<ni; i++) {
+    if (xin->stash.ignorenegidx && ix[i] < 0) continue;
+    if (ix[i] < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Out of range index value %D cannot be negative",ix[i]);
+    if ((row = ix[i]) >= start && row < end) {
+      if (addv == INSERT_VALUES) xx[row-start] = (float)y[i];
+      else xx[row-start] = (float)(xx[row-start] + y[i]);
+    } else if (!stash) {
+      SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Out of range index value %D maximum %D",ix[i],xin->map->n);
+    } else if (!xin->stash.donotstash) {
+      if (ix[i] >= xin->map->N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Out of range index value %D maximum %D",ix[i],xin->map->N);
+      ierr = VecStashValue_Private(&xin->stash,row,y[i]);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecSetValuesBlocked_Single_Private(Vec xin,PetscInt ni,const PetscInt ix[],const PetscScalar yin[],InsertMode addv,PetscBool stash)
+{
+  float          *xx = VecSingleArray(xin);
+  PetscScalar    *y = (PetscScalar*)yin;
+  PetscInt       i,j,row,bs = PetscAbs(xin->map->bs),start = xin->map->rstart,end = xin->map->rend;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (stash) {
+#if defined(PETSC_USE_DEBUG)
+    if (xin->stash.insertmode == INSERT_VALUES && addv == ADD_VALUES) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"You have already inserted values; you cannot now add");
+    else if (xin->stash.insertmode == ADD_VALUES && addv == INSERT_VALUES) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"You have already added values; you cannot now insert");
+#endif
+    xin->stash.insertmode = addv;
+  }
+  for (i=0; i<ni; i++, y+=bs) {
+    if (ix[i] < 0) continue;
+    if ((row = bs*ix[i]) >= start && row < end) {
+      if (addv == INSERT_VALUES) for (j=0; j<bs; j++) xx[row-start+j] = (float)y[j];
+      else for (j=0; j<bs; j++) xx[row-start+j] = (float)(xx[row-start+j] + y[j]);
+    } else if (!stash) {
+      SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Out of range index value %D maximum %D",row,xin->map->n);
+    } else if (!xin->stash.donotstash) {
+      if (row >= xin->map->N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Out of range index value %D max %D",ix[i],xin->map->N);
+      ierr = VecStashValuesBlocked_Private(&xin->bstash,ix[i],y);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecSetValues_SeqSingle(Vec xin,PetscInt ni,const PetscInt ix[],const PetscScalar y[],InsertMode addv)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSetValues_Single_Private(xin,ni,ix,y,addv,PETSC_FALSE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecSetValuesBlocked_SeqSingle(Vec xin,PetscInt ni,const PetscInt ix[],const PetscScalar y[],InsertMode addv)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSetValuesBlocked_Single_Private(xin,ni,ix,y,addv,PETSC_FALSE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   The kernels below read and write single precision values and accumulate in double precision. When one of the
+   other vectors is not of this type they fall back to the VECSEQ kernels, which go through VecGetArray().
+*/
+PetscErrorCode VecDot_SeqSingle(Vec xin,Vec yin,PetscScalar *z)
+{
+  const float    *xx = VecSingleArray(xin),*yy;
+  PetscScalar    sum = 0.0;
+  PetscInt       i,n = xin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!VecIsSingle_Private(yin)) {
+    ierr = VecDot_Seq(xin,yin,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  yy = VecSingleArray(yin);
+  for (i=0; i<n; i++) sum += (PetscScalar)xx[i]*(PetscScalar)yy[i];
+  *z   = sum;
+  ierr = PetscLogFlops(PetscMax(2.0*n-1,0.0));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecMDot_SeqSingle(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
+{
+  const float    *xx = VecSingleArray(xin),*y0,*y1,*y2,*y3;
+  PetscScalar    sum0,sum1,sum2,sum3,x;
+  PetscInt       i,j,n = xin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (j=0; j<nv; j++) {
+    if (!VecIsSingle_Private(yin[j])) {
+      ierr = VecMDot_Seq(xin,nv,yin,z);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+  }
+  /* four vectors at a time, so that x is read once for every four of them */
+  for (j=0; j+4<=nv; j+=4) {
+    y0   = VecSingleArray(yin[j]);
+    y1   = VecSingleArray(yin[j+1]);
+    y2   = VecSingleArray(yin[j+2]);
+    y3   = VecSingleArray(yin[j+3]);
+    sum0 = sum1 = sum2 = sum3 = 0.0;
+    for (i=0; i<n; i++) {
+      x     = xx[i];
+      sum0 += x*y0[i];
+      sum1 += x*y1[i];
+      sum2 += x*y2[i];
+      sum3 += x*y3[i];
+    }
+    z[j] = sum0; z[j+1] = sum1; z[j+2] = sum2; z[j+3] = sum3;
+  }
+  for (; j<nv; j++) {
+    y0   = VecSingleArray(yin[j]);
+    sum0 = 0.0;
+    for (i=0; i<n; i++) sum0 += (PetscScalar)xx[i]*y0[i];
+    z[j] = sum0;
+  }
+  ierr = PetscLogFlops(PetscMax(nv*(2.0*n-1),0.0));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecNorm_SeqSingle(Vec xin,NormType type,PetscReal *z)
+{
+  const float    *xx = VecSingleArray(xin);
+  PetscReal      sum = 0.0,max = 0.0,tmp;
+  PetscInt       i,n = xin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (type == NORM_2 || type == NORM_FROBENIUS) {
+    for (i=0; i<n; i++) sum += (PetscReal)xx[i]*(PetscReal)xx[i];
+    *z   = PetscSqrtReal(sum);
+    ierr = PetscLogFlops(PetscMax(2.0*n-1,0.0));CHKERRQ(ierr);
+  } else if (type == NORM_INFINITY) {
+    for (i=0; i<n; i++) {
+      tmp = PetscAbsReal((PetscReal)xx[i]);
+      if (tmp > max || PetscIsNanReal(tmp)) max = tmp;
+    }
+    *z = max;
+  } else if (type == NORM_1) {
+    for (i=0; i<n; i++) sum += PetscAbsReal((PetscReal)xx[i]);
+    *z   = sum;
+    ierr = PetscLogFlops(PetscMax(n-1.0,0.0));CHKERRQ(ierr);
+  } else if (type == NORM_1_AND_2) {
+    ierr = VecNorm_SeqSingle(xin,NORM_1,z);CHKERRQ(ierr);
+    ierr = VecNorm_SeqSingle(xin,NORM_2,z+1);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecScale_SeqSingle(Vec xin,PetscScalar alpha)
+{
+  float          *xx = VecSingleArray(xin);
+  PetscInt       i,n = xin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (alpha == (PetscScalar)0.0) {
+    ierr = VecSet_SeqSingle(xin,alpha);CHKERRQ(ierr);
+  } else if (alpha != (PetscScalar)1.0) {
+    for (i=0; i<n; i++) xx[i] = (float)(alpha*xx[i]);
+    ierr = PetscLogFlops(n);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecCopy_SeqSingle(Vec xin,Vec yin)
+{
+  const float    *xx = VecSingleArray(xin);
+  PetscScalar    *yy;
+  PetscInt       i,n = xin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (xin == yin) PetscFunctionReturn(0);
+  if (VecIsSingle_Private(yin)) {
+    ierr = PetscMemcpy(VecSingleArray(yin),xx,n*sizeof(float));CHKERRQ(ierr);
+  } else {
+    ierr = VecGetArray(yin,&yy);CHKERRQ(ierr);
+    for (i=0; i<n; i++) yy[i] = xx[i];
+    ierr = VecRestoreArray(yin,&yy);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecSet_SeqSingle(Vec xin,PetscScalar alpha)
+{
+  float          *xx = VecSingleArray(xin),a = (float)alpha;
+  PetscInt       i,n = xin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (alpha == (PetscScalar)0.0) {
+    ierr = PetscMemzero(xx,n*sizeof(float));CHKERRQ(ierr);
+  } else {
+    for (i=0; i<n; i++) xx[i] = a;
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecSwap_SeqSingle(Vec xin,Vec yin)
+{
+  float          *xx = VecSingleArray(xin),*yy,tmp;
+  PetscInt       i,n = xin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (xin == yin) PetscFunctionReturn(0);
+  if (!VecIsSingle_Private(yin)) {
+    ierr = VecSwap_Seq(xin,yin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  yy = VecSingleArray(yin);
+  for (i=0; i<n; i++) {
+    tmp   = xx[i];
+    xx[i] = yy[i];
+    yy[i] = tmp;
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecAXPY_SeqSingle(Vec yin,PetscScalar alpha,Vec xin)
+{
+  const float    *xx;
+  float          *yy = VecSingleArray(yin);
+  PetscInt       i,n = yin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!VecIsSingle_Private(xin)) {
+    ierr = VecAXPY_Seq(yin,alpha,xin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (alpha == (PetscScalar)0.0) PetscFunctionReturn(0);
+  xx = VecSingleArray(xin);
+  for (i=0; i<n; i++) yy[i] = (float)(yy[i] + alpha*xx[i]);
+  ierr = PetscLogFlops(2.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecAXPBY_SeqSingle(Vec yin,PetscScalar alpha,PetscScalar beta,Vec xin)
+{
+  const float    *xx;
+  float          *yy = VecSingleArray(yin);
+  PetscInt       i,n = yin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!VecIsSingle_Private(xin)) {
+    ierr = VecAXPBY_Seq(yin,alpha,beta,xin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  xx = VecSingleArray(xin);
+  for (i=0; i<n; i++) yy[i] = (float)(alpha*xx[i] + beta*yy[i]);
+  ierr = PetscLogFlops(3.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecMAXPY_SeqSingle(Vec yin,PetscInt nv,const PetscScalar *alpha,Vec *xin)
+{
+  const float    *x0,*x1,*x2,*x3;
+  float          *yy = VecSingleArray(yin);
+  PetscScalar    a0,a1,a2,a3;
+  PetscInt       i,j,n = yin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (j=0; j<nv; j++) {
+    if (!VecIsSingle_Private(xin[j])) {
+      ierr = VecMAXPY_Seq(yin,nv,alpha,xin);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+  }
+  /* four vectors at a time, so that y is read and rounded once for every four of them */
+  for (j=0; j+4<=nv; j+=4) {
+    x0 = VecSingleArray(xin[j]);
+    x1 = VecSingleArray(xin[j+1]);
+    x2 = VecSingleArray(xin[j+2]);
+    x3 = VecSingleArray(xin[j+3]);
+    a0 = alpha[j]; a1 = alpha[j+1]; a2 = alpha[j+2]; a3 = alpha[j+3];
+    for (i=0; i<n; i++) yy[i] = (float)(yy[i] + a0*x0[i] + a1*x1[i] + a2*x2[i] + a3*x3[i]);
+  }
+  for (; j<nv; j++) {
+    x0 = VecSingleArray(xin[j]);
+    a0 = alpha[j];
+    for (i=0; i<n; i++) yy[i] = (float)(yy[i] + a0*x0[i]);
+  }
+  ierr = PetscLogFlops(nv*2.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecAYPX_SeqSingle(Vec yin,PetscScalar alpha,Vec xin)
+{
+  const float    *xx;
+  float          *yy = VecSingleArray(yin);
+  PetscInt       i,n = yin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!VecIsSingle_Private(xin)) {
+    ierr = VecAYPX_Seq(yin,alpha,xin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  xx = VecSingleArray(xin);
+  for (i=0; i<n; i++) yy[i] = (float)(xx[i] + alpha*yy[i]);
+  ierr = PetscLogFlops(2.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecWAXPY_SeqSingle(Vec win,PetscScalar alpha,Vec xin,Vec yin)
+{
+  const float    *xx,*yy;
+  float          *ww = VecSingleArray(win);
+  PetscInt       i,n = win->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!VecIsSingle_Private(xin) || !VecIsSingle_Private(yin)) {
+    ierr = VecWAXPY_Seq(win,alpha,xin,yin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  xx = VecSingleArray(xin);
+  yy = VecSingleArray(yin);
+  for (i=0; i<n; i++) ww[i] = (float)(yy[i] + alpha*xx[i]);
+  ierr = PetscLogFlops(2.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecAXPBYPCZ_SeqSingle(Vec zin,PetscScalar alpha,PetscScalar beta,PetscScalar gamma,Vec xin,Vec yin)
+{
+  const float    *xx,*yy;
+  float          *zz = VecSingleArray(zin);
+  PetscInt       i,n = zin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!VecIsSingle_Private(xin) || !VecIsSingle_Private(yin)) {
+    ierr = VecAXPBYPCZ_Seq(zin,alpha,beta,gamma,xin,yin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  xx = VecSingleArray(xin);
+  yy = VecSingleArray(yin);
+  for (i=0; i<n; i++) zz[i] = (float)(alpha*xx[i] + beta*yy[i] + gamma*zz[i]);
+  ierr = PetscLogFlops(5.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecDestroy_Single_Private(Vec v)
+{
+  Vec_Single     *s = (Vec_Single*)v->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+#if defined(PETSC_USE_LOG)
+  PetscLogObjectState((PetscObject)v,"Length=%D",v->map->n);
+#endif
+  if (s->ngets) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Vector array was not restored");
+  ierr = PetscFree(s->farray_allocated);CHKERRQ(ierr);
+  ierr = PetscFree(s->array_allocated);CHKERRQ(ierr);
+  ierr = PetscFree(v->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static struct _VecOps DvOps = {VecDuplicate_Single, /* 1 */
+                               VecDuplicateVecs_Default,
+                               VecDestroyVecs_Default,
+                               VecDot_SeqSingle,
+                               VecMDot_SeqSingle,
+                               VecNorm_SeqSingle,
+                               VecDot_SeqSingle,
+                               VecMDot_SeqSingle,
+                               VecScale_SeqSingle,
+                               VecCopy_SeqSingle, /* 10 */
+                               VecSet_SeqSingle,
+                               VecSwap_SeqSingle,
+                               VecAXPY_SeqSingle,
+                               VecAXPBY_SeqSingle,
+                               VecMAXPY_SeqSingle,
+                               VecAYPX_SeqSingle,
+                               VecWAXPY_SeqSingle,
+                               VecAXPBYPCZ_SeqSingle,
+                               VecPointwiseMult_Seq,
+                               VecPointwiseDivide_Seq,
+                               VecSetValues_SeqSingle, /* 20 */
+                               0,0,
+                               VecGetArray_Single,
+                               VecGetSize_Seq,
+                               VecGetSize_Seq,
+                               VecRestoreArray_Single,
+                               VecMax_Seq,
+                               VecMin_Seq,
+                               VecSetRandom_Seq,
+                               VecSetOption_Seq, /* 30 */
+                               VecSetValuesBlocked_SeqSingle,
+                               VecDestroy_Single_Private,
+                               VecView_Seq,
+                               0,
+                               0,
+                               VecDot_SeqSingle,
+                               VecDot_SeqSingle,
+                               VecNorm_SeqSingle,
+                               VecMDot_SeqSingle,
+                               VecMDot_SeqSingle, /* 40 */
+                               VecLoad_Default,
+                               VecReciprocal_Default,
+                               VecConjugate_Seq,
+                               0,
+                               0,
+                               0,
+                               0,
+                               VecMaxPointwiseDivide_Seq,
+                               VecPointwiseMax_Seq,
+                               VecPointwiseMaxAbs_Seq,
+                               VecPointwiseMin_Seq,
+                               VecGetValues_Single,
+                               0,
+                               0,
+                               0,
+                               0,
+                               0,
+                               0,
+                               VecStrideGather_Default,
+                               VecStrideScatter_Default,
+                               0,
+                               0,
+                               0,
+                               VecGetArrayRead_Single,
+                               VecRestoreArrayRead_Single,
+                               VecStrideSubSetGather_Default,
+                               VecStrideSubSetScatter_Default,
+                               0,
+                               0,
+                               0,
+                               0,
+                               0,
+                               0,
+                               0
+};
+
+/*
+    Allocates the single precision array, shared by VecCreate_SeqSingle() and VecCreate_MPISingle()
+*/
+PetscErrorCode VecCreate_Single_Private(Vec v)
+{
+  Vec_Single     *s;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLayoutSetUp(v->map);CHKERRQ(ierr);
+  ierr = PetscNewLog(v,&s);CHKERRQ(ierr);
+  ierr = PetscCalloc1(v->map->n,&s->farray_allocated);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)v,v->map->n*sizeof(float));CHKERRQ(ierr);
+  s->farray      = s->farray_allocated;
+  v->data        = (void*)s;
+  v->petscnative = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   VECSEQSINGLE - VECSEQSINGLE = "seqsingle" - The basic sequential vector with its values stored in single precision
+
+   Options Database Keys:
+. -vec_type seqsingle - sets the vector type to VECSEQSINGLE during a call to VecSetFromOptions()
+
+   Notes:
+   All arithmetic is done in double precision, so vector operations move half as many bytes as with VECSEQ, at the
+   cost of rounding every stored value to single precision. Operations between vectors of this type read and write
+   the single precision values directly. VecGetArray() and VecGetArrayRead() return a double precision copy of the
+   values that is written back to the vector by VecRestoreArray(), so they cost a pass over the vector; other
+   vector types that operate on a VECSEQSINGLE go through them. The buffer of the copy is allocated on the first
+   VecGetArray() and kept until the vector is destroyed.
+
+   The vector values may not be accessed with the single precision operations while the array is gotten.
+
+   Only available when PETSc is configured with real double precision scalars. VecPlaceArray() is not supported.
+
+   Level: intermediate
+
+.seealso: VecCreate(), VecSetType(), VecSetFromOptions(), VECSINGLE, VECMPISINGLE, VECSEQ, KSPGMRESSetBasisVecType()
+M*/
+
+PETSC_EXTERN PetscErrorCode VecCreate_SeqSingle(Vec v)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    size;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)v),&size);CHKERRQ(ierr);
+  if (size > 1) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Cannot create VECSEQSINGLE on more than one process");
+  ierr = VecCreate_Single_Private(v);CHKERRQ(ierr);
+  ierr = PetscMemcpy(v->ops,&DvOps,sizeof(DvOps));CHKERRQ(ierr);
+  ierr = PetscObjectChangeTypeName((PetscObject)v,VECSEQSINGLE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
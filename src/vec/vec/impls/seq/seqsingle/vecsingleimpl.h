@@ -0,0 +1,52 @@
+#if !defined(__VECSINGLEIMPL)
+#define __VECSINGLEIMPL
+
+#include <petsc/private/vecimpl.h>
+
+/*
+   Vectors whose values are stored in single precision while all arithmetic is done in PetscScalar (double).
+
+   The array field of VECHEADER is only used for the double precision copy of the values handed out by
+   VecGetArray() and VecGetArrayRead(); it is filled on the first get and written back on the last restore. Its
+   buffer, array_allocated, is kept between gets.
+*/
+typedef struct {
+  VECHEADER
+  float     *farray;           /* the values */
+  float     *farray_allocated; /* if the array was allocated by PETSc this is its pointer */
+  PetscInt  ngets;             /* number of outstanding VecGetArray() and VecGetArrayRead() */
+  PetscBool modified;          /* the double precision copy was gotten with VecGetArray() and must be written back */
+} Vec_Single;
+
+PETSC_INTERN PetscErrorCode VecGetArray_Single(Vec,PetscScalar**);
+PETSC_INTERN PetscErrorCode VecRestoreArray_Single(Vec,PetscScalar**);
+PETSC_INTERN PetscErrorCode VecGetArrayRead_Single(Vec,const PetscScalar**);
+PETSC_INTERN PetscErrorCode VecRestoreArrayRead_Single(Vec,const PetscScalar**);
+PETSC_INTERN PetscErrorCode VecDuplicate_Single(Vec,Vec*);
+PETSC_INTERN PetscErrorCode VecGetValues_Single(Vec,PetscInt,const PetscInt[],PetscScalar[]);
+PETSC_INTERN PetscErrorCode VecSetValues_Single_Private(Vec,PetscInt,const PetscInt[],const PetscScalar[],InsertMode,PetscBool);
+PETSC_INTERN PetscErrorCode VecSetValuesBlocked_Single_Private(Vec,PetscInt,const PetscInt[],const PetscScalar[],InsertMode,PetscBool);
+PETSC_INTERN PetscErrorCode VecCreate_Single_Private(Vec);
+PETSC_INTERN PetscErrorCode VecDestroy_Single_Private(Vec);
+
+PETSC_INTERN PetscErrorCode VecDot_SeqSingle(Vec,Vec,PetscScalar*);
+PETSC_INTERN PetscErrorCode VecMDot_SeqSingle(Vec,PetscInt,const Vec[],PetscScalar*);
+PETSC_INTERN PetscErrorCode VecNorm_SeqSingle(Vec,NormType,PetscReal*);
+PETSC_INTERN PetscErrorCode VecScale_SeqSingle(Vec,PetscScalar);
+PETSC_INTERN PetscErrorCode VecCopy_SeqSingle(Vec,Vec);
+PETSC_INTERN PetscErrorCode VecSet_SeqSingle(Vec,PetscScalar);
+PETSC_INTERN PetscErrorCode VecSwap_SeqSingle(Vec,Vec);
+PETSC_INTERN PetscErrorCode VecAXPY_SeqSingle(Vec,PetscScalar,Vec);
+PETSC_INTERN PetscErrorCode VecAXPBY_SeqSingle(Vec,PetscScalar,PetscScalar,Vec);
+PETSC_INTERN PetscErrorCode VecMAXPY_SeqSingle(Vec,PetscInt,const PetscScalar*,Vec*);
+PETSC_INTERN PetscErrorCode VecAYPX_SeqSingle(Vec,PetscScalar,Vec);
+PETSC_INTERN PetscErrorCode VecWAXPY_SeqSingle(Vec,PetscScalar,Vec,Vec);
+PETSC_INTERN PetscErrorCode VecAXPBYPCZ_SeqSingle(Vec,PetscScalar,PetscScalar,PetscScalar,Vec,Vec);
+
+/* vectors of this type are recognized by their ops, which is cheaper than comparing type names in every kernel */
+PETSC_STATIC_INLINE PetscBool VecIsSingle_Private(Vec v)
+{
+  return (PetscBool)(v->ops->getarray == VecGetArray_Single);
+}
+
+#endif
@@ -710,6 +710,155 @@ PetscErrorCode  VecAXPBYPCZ(Vec z,PetscScalar alpha,PetscScalar beta,PetscScalar
   PetscFunctionReturn(0);
 }
 
+/*@
+   VecAXPBYPCZDotNorm - Computes z = alpha x + beta y + gamma z and then the inner product (z,w) and the 2-norm of z,
+   reading each vector only once
+
+   Collective on Vec
+
+   Input Parameters:
++  alpha,beta,gamma - the scalars
+.  x - the first vector
+.  y - the second vector, or NULL to compute z = alpha x + gamma z
+.  w - the vector for the inner product, can be NULL if dot is NULL
+-  z - the vector that is updated
+
+   Output Parameters:
++  z - the updated vector
+.  dot - (z,w) = w^H z computed with the updated z, or NULL
+-  nrm - ||z||_2 computed with the updated z, or NULL
+
+   Level: intermediate
+
+   Notes:
+    x, y and z must be different vectors, w may be any of them. When gamma is 0 the entries of z are not used.
+
+    Both reductions are done with a single MPI reduction. Vector types that do not provide a fused kernel compute the
+    update and then the reductions with VecDotBegin()/VecNormBegin().
+
+   Concepts: BLAS
+   Concepts: vector^BLAS
+
+.seealso: VecAXPBYPCZ(), VecAXPYNorm(), VecWAXPYDot(), VecDotNorm2()
+@*/
+PetscErrorCode  VecAXPBYPCZDotNorm(Vec z,PetscScalar alpha,PetscScalar beta,PetscScalar gamma,Vec x,Vec y,Vec w,PetscScalar *dot,PetscReal *nrm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(z,VEC_CLASSID,1);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,5);
+  PetscValidType(z,1);
+  PetscValidType(x,5);
+  PetscCheckSameTypeAndComm(x,5,z,1);
+  VecCheckSameSize(x,5,z,1);
+  if (y) {
+    PetscValidHeaderSpecific(y,VEC_CLASSID,6);
+    PetscCheckSameTypeAndComm(x,5,y,6);
+    VecCheckSameSize(x,5,y,6);
+    if (x == y || y == z) SETERRQ(PetscObjectComm((PetscObject)x),PETSC_ERR_ARG_IDN,"x, y, and z must be different vectors");
+  }
+  if (x == z) SETERRQ(PetscObjectComm((PetscObject)x),PETSC_ERR_ARG_IDN,"x, y, and z must be different vectors");
+  if (dot) {
+    PetscValidHeaderSpecific(w,VEC_CLASSID,7);
+    PetscCheckSameTypeAndComm(x,5,w,7);
+    VecCheckSameSize(x,5,w,7);
+    PetscValidScalarPointer(dot,8);
+  } else w = NULL;
+  if (nrm) PetscValidRealPointer(nrm,9);
+  PetscValidLogicalCollectiveScalar(z,alpha,2);
+  PetscValidLogicalCollectiveScalar(z,beta,3);
+  PetscValidLogicalCollectiveScalar(z,gamma,4);
+
+  if (z->ops->axpbypczdotnorm) {
+    ierr = PetscLogEventBegin(VEC_AXPBYPCZDotNorm,x,y,z,0);CHKERRQ(ierr);
+    ierr = (*z->ops->axpbypczdotnorm)(z,alpha,beta,gamma,x,y,w,dot,nrm);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(VEC_AXPBYPCZDotNorm,x,y,z,0);CHKERRQ(ierr);
+    ierr = PetscObjectStateIncrease((PetscObject)z);CHKERRQ(ierr);
+  } else {
+    if (!y && gamma == (PetscScalar)1.0) {
+      ierr = VecAXPY(z,alpha,x);CHKERRQ(ierr);
+    } else if (!y) {
+      ierr = VecAXPBY(z,alpha,gamma,x);CHKERRQ(ierr);
+    } else if (gamma == (PetscScalar)0.0 && beta == (PetscScalar)1.0) {
+      ierr = VecWAXPY(z,alpha,x,y);CHKERRQ(ierr);
+    } else {
+      ierr = VecAXPBYPCZ(z,alpha,beta,gamma,x,y);CHKERRQ(ierr);
+    }
+    if (dot) {ierr = VecDotBegin(z,w,dot);CHKERRQ(ierr);}
+    if (nrm) {ierr = VecNormBegin(z,NORM_2,nrm);CHKERRQ(ierr);}
+    if (dot) {ierr = VecDotEnd(z,w,dot);CHKERRQ(ierr);}
+    if (nrm) {ierr = VecNormEnd(z,NORM_2,nrm);CHKERRQ(ierr);}
+  }
+  if (nrm) {ierr = PetscObjectComposedDataSetReal((PetscObject)z,NormIds[NORM_2],*nrm);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecAXPYNorm - Computes y = y + alpha x and the 2-norm of the result in a single pass over the vectors
+
+   Collective on Vec
+
+   Input Parameters:
++  alpha - the scalar
+-  x, y  - the vectors
+
+   Output Parameters:
++  y - the updated vector
+-  nrm - ||y||_2 of the updated vector
+
+   Level: intermediate
+
+   Notes:
+    x and y MUST be different vectors
+
+   Concepts: vector^BLAS
+   Concepts: BLAS
+
+.seealso: VecAXPY(), VecNorm(), VecWAXPYDot(), VecAXPBYPCZDotNorm()
+@*/
+PetscErrorCode  VecAXPYNorm(Vec y,PetscScalar alpha,Vec x,PetscReal *nrm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecAXPBYPCZDotNorm(y,alpha,0.0,1.0,x,NULL,NULL,NULL,nrm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecWAXPYDot - Computes w = alpha x + y and the inner product (w,z) in a single pass over the vectors
+
+   Collective on Vec
+
+   Input Parameters:
++  alpha - the scalar
+.  x, y  - the vectors that are combined
+-  z - the vector for the inner product
+
+   Output Parameters:
++  w - the result
+-  dot - (w,z) = z^H w
+
+   Level: intermediate
+
+   Notes:
+    w cannot be either x or y, z may be any of the vectors
+
+   Concepts: vector^BLAS
+   Concepts: BLAS
+
+.seealso: VecWAXPY(), VecDot(), VecAXPYNorm(), VecAXPBYPCZDotNorm()
+@*/
+PetscErrorCode  VecWAXPYDot(Vec w,PetscScalar alpha,Vec x,Vec y,Vec z,PetscScalar *dot)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecAXPBYPCZDotNorm(w,alpha,1.0,0.0,x,y,z,dot,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
    VecAYPX - Computes y = x + alpha y.
 
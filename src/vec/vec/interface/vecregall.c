@@ -8,6 +8,11 @@ PETSC_EXTERN PetscErrorCode VecCreate_Shared(Vec);
 #if defined(PETSC_HAVE_MPI_WIN_CREATE_FEATURE)
 PETSC_EXTERN PetscErrorCode VecCreate_Node(Vec);
 #endif
+#if defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX)
+PETSC_EXTERN PetscErrorCode VecCreate_SeqSingle(Vec);
+PETSC_EXTERN PetscErrorCode VecCreate_MPISingle(Vec);
+PETSC_EXTERN PetscErrorCode VecCreate_Single(Vec);
+#endif
 #if defined(PETSC_HAVE_VIENNACL)
 PETSC_EXTERN PetscErrorCode VecCreate_SeqViennaCL(Vec);
 PETSC_EXTERN PetscErrorCode VecCreate_MPIViennaCL(Vec);
@@ -44,6 +49,11 @@ PetscErrorCode VecRegisterAll(void)
 #if defined PETSC_HAVE_MPI_WIN_CREATE_FEATURE
   ierr = VecRegister(VECNODE,       VecCreate_Node);CHKERRQ(ierr);
 #endif
+#if defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX)
+  ierr = VecRegister(VECSEQSINGLE,  VecCreate_SeqSingle);CHKERRQ(ierr);
+  ierr = VecRegister(VECMPISINGLE,  VecCreate_MPISingle);CHKERRQ(ierr);
+  ierr = VecRegister(VECSINGLE,     VecCreate_Single);CHKERRQ(ierr);
+#endif
 #if defined PETSC_HAVE_VIENNACL
   ierr = VecRegister(VECSEQVIENNACL,    VecCreate_SeqViennaCL);CHKERRQ(ierr);
   ierr = VecRegister(VECMPIVIENNACL,    VecCreate_MPIViennaCL);CHKERRQ(ierr);
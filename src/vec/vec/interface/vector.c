@@ -12,7 +12,7 @@ PetscLogEvent VEC_Norm, VEC_Normalize, VEC_Scale, VEC_Copy, VEC_Set, VEC_AXPY, V
 PetscLogEvent VEC_MTDot, VEC_MAXPY, VEC_Swap, VEC_AssemblyBegin, VEC_ScatterBegin, VEC_ScatterEnd;
 PetscLogEvent VEC_AssemblyEnd, VEC_PointwiseMult, VEC_SetValues, VEC_Load;
 PetscLogEvent VEC_SetRandom, VEC_ReduceArithmetic, VEC_ReduceCommunication,VEC_ReduceBegin,VEC_ReduceEnd,VEC_Ops;
-PetscLogEvent VEC_DotNorm2, VEC_AXPBYPCZ;
+PetscLogEvent VEC_DotNorm2, VEC_AXPBYPCZ, VEC_AXPBYPCZDotNorm;
 PetscLogEvent VEC_ViennaCLCopyFromGPU, VEC_ViennaCLCopyToGPU;
 PetscLogEvent VEC_CUDACopyFromGPU, VEC_CUDACopyToGPU;
 PetscLogEvent VEC_CUDACopyFromGPUSome, VEC_CUDACopyToGPUSome;
@@ -774,7 +774,9 @@ PetscErrorCode  VecGetOwnershipRanges(Vec x,const PetscInt *ranges[])
           entries will always be a subset (possibly equal) of the off-process entries set on the
           first assembly.  This reuses the communication pattern, thus avoiding a global reduction.
           Subsequent assemblies setting off-process values should use the same InsertMode as the
-          first assembly.
+          first assembly.  After the first assembly of a VECMPI the off-process values are stashed directly
+          into one send buffer per receiving process, so setting a value owned by a process that was not
+          sent any values in the first assembly generates an error.
 
    Developer Note:
    The InsertMode restriction could be removed by packing the stash messages out of place.
@@ -106,6 +106,62 @@ PETSC_EXTERN void MPIAPI PetscSplitReduction_Local(void *in,void *out,PetscMPIIn
   PetscFunctionReturnVoid();
 }
 
+/*
+   PetscSplitReductionIallreduce_Private - Combines the local values of a list of reductions, each of them a sum, max or min,
+   with a single reduction; uses the predefined MPI operation when all the reductions are of one kind.
+
+   lvalues[] must have room for 2*numops entries, the second half is used for the reduction types. If async is PETSC_TRUE
+   the reduction is started with MPI_Iallreduce() (when available) and *request must be waited on before using gvalues[].
+*/
+static PetscErrorCode PetscSplitReductionIallreduce_Private(MPI_Comm comm,PetscInt numops,const PetscInt reducetype[],PetscScalar *lvalues,PetscScalar *gvalues,PetscBool async,MPI_Request *request)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,sum_flg = 0,max_flg = 0,min_flg = 0;
+  PetscMPIInt    size,cmul = sizeof(PetscScalar)/sizeof(PetscReal);
+  MPI_Op         op;
+
+  PetscFunctionBegin;
+  *request = MPI_REQUEST_NULL;
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  if (size == 1) {
+    ierr = PetscMemcpy(gvalues,lvalues,numops*sizeof(PetscScalar));CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  /* determine if all reductions are sum, max, or min */
+  for (i=0; i<numops; i++) {
+    if      (reducetype[i] == PETSC_SR_REDUCE_MAX) max_flg = 1;
+    else if (reducetype[i] == PETSC_SR_REDUCE_SUM) sum_flg = 1;
+    else if (reducetype[i] == PETSC_SR_REDUCE_MIN) min_flg = 1;
+    else SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Error in PetscSplitReduction() data structure, probably memory corruption");
+  }
+  if (sum_flg + max_flg + min_flg > 1) {
+    /*
+       after all the entires in lvalues we store the reducetype flags to indicate
+       to the reduction operations what are sums and what are max
+    */
+    for (i=0; i<numops; i++) lvalues[numops+i] = reducetype[i];
+    if (async) {
+      ierr = MPIPetsc_Iallreduce(lvalues,gvalues,2*numops,MPIU_SCALAR,PetscSplitReduction_Op,comm,request);CHKERRQ(ierr);
+    } else {
+      ierr = MPIU_Allreduce(lvalues,gvalues,2*numops,MPIU_SCALAR,PetscSplitReduction_Op,comm);CHKERRQ(ierr);
+    }
+  } else if (max_flg || min_flg) { /* Compute max of real and imag parts separately, presumably only the real part is used */
+    op = max_flg ? MPIU_MAX : MPIU_MIN;
+    if (async) {
+      ierr = MPIPetsc_Iallreduce((PetscReal*)lvalues,(PetscReal*)gvalues,cmul*numops,MPIU_REAL,op,comm,request);CHKERRQ(ierr);
+    } else {
+      ierr = MPIU_Allreduce((PetscReal*)lvalues,(PetscReal*)gvalues,cmul*numops,MPIU_REAL,op,comm);CHKERRQ(ierr);
+    }
+  } else {
+    if (async) {
+      ierr = MPIPetsc_Iallreduce(lvalues,gvalues,numops,MPIU_SCALAR,MPIU_SUM,comm,request);CHKERRQ(ierr);
+    } else {
+      ierr = MPIU_Allreduce(lvalues,gvalues,numops,MPIU_SCALAR,MPIU_SUM,comm);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
 /*@
    PetscCommSplitReductionBegin - Begin an asynchronous split-mode reduction
 
@@ -130,40 +186,9 @@ PetscErrorCode PetscCommSplitReductionBegin(MPI_Comm comm)
   PetscFunctionBegin;
   ierr = PetscSplitReductionGet(comm,&sr);CHKERRQ(ierr);
   if (sr->numopsend > 0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Cannot call this after VecxxxEnd() has been called");
-  if (sr->async) {              /* Bad reuse, setup code copied from PetscSplitReductionApply(). */
-    PetscInt       i,numops = sr->numopsbegin,*reducetype = sr->reducetype;
-    PetscScalar    *lvalues = sr->lvalues,*gvalues = sr->gvalues;
-    PetscInt       sum_flg = 0,max_flg = 0, min_flg = 0;
-    MPI_Comm       comm = sr->comm;
-    PetscMPIInt    size,cmul = sizeof(PetscScalar)/sizeof(PetscReal);;
+  if (sr->async) {
     ierr = PetscLogEventBegin(VEC_ReduceBegin,0,0,0,0);CHKERRQ(ierr);
-    ierr = MPI_Comm_size(sr->comm,&size);CHKERRQ(ierr);
-    if (size == 1) {
-      ierr = PetscMemcpy(gvalues,lvalues,numops*sizeof(PetscScalar));CHKERRQ(ierr);
-    } else {
-      /* determine if all reductions are sum, max, or min */
-      for (i=0; i<numops; i++) {
-        if      (reducetype[i] == PETSC_SR_REDUCE_MAX) max_flg = 1;
-        else if (reducetype[i] == PETSC_SR_REDUCE_SUM) sum_flg = 1;
-        else if (reducetype[i] == PETSC_SR_REDUCE_MIN) min_flg = 1;
-        else SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Error in PetscSplitReduction() data structure, probably memory corruption");
-      }
-      if (sum_flg + max_flg + min_flg > 1) {
-        /*
-         after all the entires in lvalues we store the reducetype flags to indicate
-         to the reduction operations what are sums and what are max
-         */
-        for (i=0; i<numops; i++) lvalues[numops+i] = reducetype[i];
-
-        ierr = MPIPetsc_Iallreduce(lvalues,gvalues,2*numops,MPIU_SCALAR,PetscSplitReduction_Op,comm,&sr->request);CHKERRQ(ierr);
-      } else if (max_flg) {   /* Compute max of real and imag parts separately, presumably only the real part is used */
-        ierr = MPIPetsc_Iallreduce((PetscReal*)lvalues,(PetscReal*)gvalues,cmul*numops,MPIU_REAL,MPIU_MAX,comm,&sr->request);CHKERRQ(ierr);
-      } else if (min_flg) {
-        ierr = MPIPetsc_Iallreduce((PetscReal*)lvalues,(PetscReal*)gvalues,cmul*numops,MPIU_REAL,MPIU_MIN,comm,&sr->request);CHKERRQ(ierr);
-      } else {
-        ierr = MPIPetsc_Iallreduce(lvalues,gvalues,numops,MPIU_SCALAR,MPIU_SUM,comm,&sr->request);CHKERRQ(ierr);
-      }
-    }
+    ierr = PetscSplitReductionIallreduce_Private(sr->comm,sr->numopsbegin,sr->reducetype,sr->lvalues,sr->gvalues,PETSC_TRUE,&sr->request);CHKERRQ(ierr);
     sr->state     = STATE_PENDING;
     sr->numopsend = 0;
     ierr = PetscLogEventEnd(VEC_ReduceBegin,0,0,0,0);CHKERRQ(ierr);
@@ -202,41 +227,11 @@ PetscErrorCode PetscSplitReductionEnd(PetscSplitReduction *sr)
 static PetscErrorCode PetscSplitReductionApply(PetscSplitReduction *sr)
 {
   PetscErrorCode ierr;
-  PetscInt       i,numops = sr->numopsbegin,*reducetype = sr->reducetype;
-  PetscScalar    *lvalues = sr->lvalues,*gvalues = sr->gvalues;
-  PetscInt       sum_flg  = 0,max_flg = 0, min_flg = 0;
-  MPI_Comm       comm     = sr->comm;
-  PetscMPIInt    size,cmul = sizeof(PetscScalar)/sizeof(PetscReal);
 
   PetscFunctionBegin;
   if (sr->numopsend > 0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Cannot call this after VecxxxEnd() has been called");
   ierr = PetscLogEventBegin(VEC_ReduceCommunication,0,0,0,0);CHKERRQ(ierr);
-  ierr = MPI_Comm_size(sr->comm,&size);CHKERRQ(ierr);
-  if (size == 1) {
-    ierr = PetscMemcpy(gvalues,lvalues,numops*sizeof(PetscScalar));CHKERRQ(ierr);
-  } else {
-    /* determine if all reductions are sum, max, or min */
-    for (i=0; i<numops; i++) {
-      if      (reducetype[i] == PETSC_SR_REDUCE_MAX) max_flg = 1;
-      else if (reducetype[i] == PETSC_SR_REDUCE_SUM) sum_flg = 1;
-      else if (reducetype[i] == PETSC_SR_REDUCE_MIN) min_flg = 1;
-      else SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Error in PetscSplitReduction() data structure, probably memory corruption");
-    }
-    if (sum_flg + max_flg + min_flg > 1) {
-      /*
-         after all the entires in lvalues we store the reducetype flags to indicate
-         to the reduction operations what are sums and what are max
-      */
-      for (i=0; i<numops; i++) lvalues[numops+i] = reducetype[i];
-      ierr = MPIU_Allreduce(lvalues,gvalues,2*numops,MPIU_SCALAR,PetscSplitReduction_Op,comm);CHKERRQ(ierr);
-    } else if (max_flg) {     /* Compute max of real and imag parts separately, presumably only the real part is used */
-      ierr = MPIU_Allreduce((PetscReal*)lvalues,(PetscReal*)gvalues,cmul*numops,MPIU_REAL,MPIU_MAX,comm);CHKERRQ(ierr);
-    } else if (min_flg) {
-      ierr = MPIU_Allreduce((PetscReal*)lvalues,(PetscReal*)gvalues,cmul*numops,MPIU_REAL,MPIU_MIN,comm);CHKERRQ(ierr);
-    } else {
-      ierr = MPIU_Allreduce(lvalues,gvalues,numops,MPIU_SCALAR,MPIU_SUM,comm);CHKERRQ(ierr);
-    }
-  }
+  ierr = PetscSplitReductionIallreduce_Private(sr->comm,sr->numopsbegin,sr->reducetype,sr->lvalues,sr->gvalues,PETSC_FALSE,&sr->request);CHKERRQ(ierr);
   sr->state     = STATE_END;
   sr->numopsend = 0;
   ierr = PetscLogEventEnd(VEC_ReduceCommunication,0,0,0,0);CHKERRQ(ierr);
@@ -762,3 +757,524 @@ PetscErrorCode  VecMTDotEnd(Vec x,PetscInt nv,const Vec y[],PetscScalar result[]
   ierr = VecMDotEnd(x,nv,y,result);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+
+/* ----------------------------------------------------------------------------------------------------*/
+
+/* Number of entries processed for all the requests before moving on, so that vectors shared by several requests are read from cache */
+#define VEC_REDUCTION_CHUNK 512
+
+/*@
+   VecReductionCreate - Creates a context that computes any combination of dot products, norms, maxima, minima and sums
+   of vectors with a single pass over the local entries and a single global reduction
+
+   Collective on MPI_Comm
+
+   Input Parameter:
+.  comm - the communicator the vectors live on
+
+   Output Parameter:
+.  red - the reduction context
+
+   Level: advanced
+
+   Notes:
+   The requests are queued with VecReductionAddDot(), VecReductionAddTDot(), VecReductionAddNorm(), VecReductionAddMax(),
+   VecReductionAddMin() and VecReductionAddSum(). VecReductionBegin() computes the local parts of all of them, looping over
+   the entries only once when the vectors have the same layout, and starts one (non-blocking when the MPI supports it)
+   reduction; VecReductionEnd() waits for it and stores the results. The queued requests are kept, so in an iterative
+   method the context can be set up once and VecReductionBegin()/VecReductionEnd() called at every iteration.
+
+   Unlike VecMax() and VecMin() no location is returned for the maximum and minimum.
+
+.seealso: VecReductionDestroy(), VecReductionBegin(), VecReductionEnd(), VecReductionReset(), VecDotBegin(), VecNormBegin()
+@*/
+PetscErrorCode VecReductionCreate(MPI_Comm comm,VecReduction *red)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(red,2);
+  ierr = VecInitializePackage();CHKERRQ(ierr);
+  ierr = PetscNew(red);CHKERRQ(ierr);
+  ierr = PetscCommDuplicate(comm,&(*red)->comm,NULL);CHKERRQ(ierr);
+  (*red)->request = MPI_REQUEST_NULL;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecReductionReset - Removes all the requests queued in a reduction context
+
+   Not Collective
+
+   Input Parameter:
+.  red - the reduction context
+
+   Level: advanced
+
+.seealso: VecReductionCreate(), VecReductionDestroy()
+@*/
+PetscErrorCode VecReductionReset(VecReduction red)
+{
+  PetscErrorCode ierr;
+  PetscInt       k;
+
+  PetscFunctionBegin;
+  PetscValidPointer(red,1);
+  if (red->pending) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Cannot reset before VecReductionEnd() has been called");
+  for (k=0; k<red->nreq; k++) {
+    ierr = VecDestroy(&red->req[k].x);CHKERRQ(ierr);
+    ierr = VecDestroy(&red->req[k].y);CHKERRQ(ierr);
+  }
+  red->nreq    = 0;
+  red->nvalues = 0;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecReductionDestroy - Destroys a reduction context
+
+   Collective on VecReduction
+
+   Input Parameter:
+.  red - the reduction context
+
+   Level: advanced
+
+.seealso: VecReductionCreate(), VecReductionReset()
+@*/
+PetscErrorCode VecReductionDestroy(VecReduction *red)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*red) PetscFunctionReturn(0);
+  ierr = VecReductionReset(*red);CHKERRQ(ierr);
+  ierr = PetscFree((*red)->req);CHKERRQ(ierr);
+  ierr = PetscFree3((*red)->lvalues,(*red)->gvalues,(*red)->reducetype);CHKERRQ(ierr);
+  ierr = PetscCommDestroy(&(*red)->comm);CHKERRQ(ierr);
+  ierr = PetscFree(*red);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecReductionAdd_Private(VecReduction red,VecReductionOp op,Vec x,Vec y,NormType ntype,PetscScalar *sresult,PetscReal *rresult)
+{
+  PetscErrorCode      ierr;
+  VecReductionRequest *req;
+
+  PetscFunctionBegin;
+  if (red->pending) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Cannot add requests between VecReductionBegin() and VecReductionEnd()");
+  if (y && x->map->n != y->map->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"Incompatible vector local lengths %D != %D",x->map->n,y->map->n);
+  if (red->nreq == red->maxreq) {
+    red->maxreq = red->maxreq ? 2*red->maxreq : 8;
+    ierr = PetscRealloc(red->maxreq*sizeof(VecReductionRequest),&red->req);CHKERRQ(ierr);
+  }
+  req          = &red->req[red->nreq++];
+  req->op      = op;
+  req->ntype   = ntype;
+  req->x       = x;
+  req->y       = y;
+  req->slot    = red->nvalues;
+  req->sresult = sresult;
+  req->rresult = rresult;
+  req->xa      = NULL;
+  req->ya      = NULL;
+  ierr = PetscObjectReference((PetscObject)x);CHKERRQ(ierr);
+  if (y) {ierr = PetscObjectReference((PetscObject)y);CHKERRQ(ierr);}
+  red->nvalues += (op == VEC_REDUCTION_NORM && ntype == NORM_1_AND_2) ? 2 : 1;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecReductionAddDot - Queues the dot product (x,y) = y^H x in a reduction context
+
+   Not Collective
+
+   Input Parameters:
++  red - the reduction context
+.  x - the first vector
+.  y - the second vector
+-  result - where the result is stored by VecReductionEnd()
+
+   Level: advanced
+
+.seealso: VecReductionCreate(), VecReductionAddTDot(), VecReductionAddNorm(), VecReductionBegin(), VecReductionEnd(), VecDot()
+@*/
+PetscErrorCode VecReductionAddDot(VecReduction red,Vec x,Vec y,PetscScalar *result)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(red,1);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,2);
+  PetscValidHeaderSpecific(y,VEC_CLASSID,3);
+  PetscValidScalarPointer(result,4);
+  ierr = VecReductionAdd_Private(red,VEC_REDUCTION_DOT,x,y,NORM_2,result,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecReductionAddTDot - Queues the indefinite dot product y^T x in a reduction context
+
+   Not Collective
+
+   Input Parameters:
++  red - the reduction context
+.  x - the first vector
+.  y - the second vector
+-  result - where the result is stored by VecReductionEnd()
+
+   Level: advanced
+
+.seealso: VecReductionCreate(), VecReductionAddDot(), VecReductionBegin(), VecReductionEnd(), VecTDot()
+@*/
+PetscErrorCode VecReductionAddTDot(VecReduction red,Vec x,Vec y,PetscScalar *result)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(red,1);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,2);
+  PetscValidHeaderSpecific(y,VEC_CLASSID,3);
+  PetscValidScalarPointer(result,4);
+  ierr = VecReductionAdd_Private(red,VEC_REDUCTION_TDOT,x,y,NORM_2,result,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecReductionAddNorm - Queues a vector norm in a reduction context
+
+   Not Collective
+
+   Input Parameters:
++  red - the reduction context
+.  x - the vector
+.  ntype - one of NORM_1, NORM_2, NORM_INFINITY or NORM_1_AND_2
+-  result - where the result is stored by VecReductionEnd(), two entries for NORM_1_AND_2
+
+   Level: advanced
+
+   Notes:
+   As with VecNorm() the computed norm is cached in the vector.
+
+.seealso: VecReductionCreate(), VecReductionAddDot(), VecReductionBegin(), VecReductionEnd(), VecNorm()
+@*/
+PetscErrorCode VecReductionAddNorm(VecReduction red,Vec x,NormType ntype,PetscReal *result)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(red,1);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,2);
+  PetscValidRealPointer(result,4);
+  ierr = VecReductionAdd_Private(red,VEC_REDUCTION_NORM,x,NULL,ntype,NULL,result);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecReductionAddMax - Queues the maximum of the real parts of the entries of a vector in a reduction context
+
+   Not Collective
+
+   Input Parameters:
++  red - the reduction context
+.  x - the vector
+-  result - where the result is stored by VecReductionEnd()
+
+   Level: advanced
+
+.seealso: VecReductionCreate(), VecReductionAddMin(), VecReductionBegin(), VecReductionEnd(), VecMax()
+@*/
+PetscErrorCode VecReductionAddMax(VecReduction red,Vec x,PetscReal *result)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(red,1);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,2);
+  PetscValidRealPointer(result,3);
+  ierr = VecReductionAdd_Private(red,VEC_REDUCTION_MAX,x,NULL,NORM_2,NULL,result);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecReductionAddMin - Queues the minimum of the real parts of the entries of a vector in a reduction context
+
+   Not Collective
+
+   Input Parameters:
++  red - the reduction context
+.  x - the vector
+-  result - where the result is stored by VecReductionEnd()
+
+   Level: advanced
+
+.seealso: VecReductionCreate(), VecReductionAddMax(), VecReductionBegin(), VecReductionEnd(), VecMin()
+@*/
+PetscErrorCode VecReductionAddMin(VecReduction red,Vec x,PetscReal *result)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(red,1);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,2);
+  PetscValidRealPointer(result,3);
+  ierr = VecReductionAdd_Private(red,VEC_REDUCTION_MIN,x,NULL,NORM_2,NULL,result);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecReductionAddSum - Queues the sum of the entries of a vector in a reduction context
+
+   Not Collective
+
+   Input Parameters:
++  red - the reduction context
+.  x - the vector
+-  result - where the result is stored by VecReductionEnd()
+
+   Level: advanced
+
+.seealso: VecReductionCreate(), VecReductionAddDot(), VecReductionBegin(), VecReductionEnd(), VecSum()
+@*/
+PetscErrorCode VecReductionAddSum(VecReduction red,Vec x,PetscScalar *result)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(red,1);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,2);
+  PetscValidScalarPointer(result,3);
+  ierr = VecReductionAdd_Private(red,VEC_REDUCTION_SUM,x,NULL,NORM_2,result,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Accumulates entries [0,n) of the local arrays of the requests into lvalues[], chunk by chunk so that
+   an array used by several requests is only brought in from memory once
+*/
+static void VecReductionLocal_Private(PetscInt nreq,const VecReductionRequest *req,PetscInt n,PetscScalar *lvalues)
+{
+  PetscInt          s,e,i,k;
+  const PetscScalar *xa,*ya;
+  PetscScalar       sum;
+  PetscReal         rsum,rsum2,m;
+
+  for (s=0; s<n; s+=VEC_REDUCTION_CHUNK) {
+    e = PetscMin(n,s+VEC_REDUCTION_CHUNK);
+    for (k=0; k<nreq; k++) {
+      xa = req[k].xa; ya = req[k].ya;
+      switch (req[k].op) {
+      case VEC_REDUCTION_DOT:
+        sum = 0.0;
+        for (i=s; i<e; i++) sum += xa[i]*PetscConj(ya[i]);
+        lvalues[req[k].slot] += sum;
+        break;
+      case VEC_REDUCTION_TDOT:
+        sum = 0.0;
+        for (i=s; i<e; i++) sum += xa[i]*ya[i];
+        lvalues[req[k].slot] += sum;
+        break;
+      case VEC_REDUCTION_SUM:
+        sum = 0.0;
+        for (i=s; i<e; i++) sum += xa[i];
+        lvalues[req[k].slot] += sum;
+        break;
+      case VEC_REDUCTION_MAX:
+        m = PetscRealPart(lvalues[req[k].slot]);
+        for (i=s; i<e; i++) m = PetscMax(m,PetscRealPart(xa[i]));
+        lvalues[req[k].slot] = m;
+        break;
+      case VEC_REDUCTION_MIN:
+        m = PetscRealPart(lvalues[req[k].slot]);
+        for (i=s; i<e; i++) m = PetscMin(m,PetscRealPart(xa[i]));
+        lvalues[req[k].slot] = m;
+        break;
+      case VEC_REDUCTION_NORM:
+        switch (req[k].ntype) {
+        case NORM_1:
+          rsum = 0.0;
+          for (i=s; i<e; i++) rsum += PetscAbsScalar(xa[i]);
+          lvalues[req[k].slot] += rsum;
+          break;
+        case NORM_2:
+        case NORM_FROBENIUS:
+          rsum = 0.0;
+          for (i=s; i<e; i++) rsum += PetscRealPart(xa[i]*PetscConj(xa[i]));
+          lvalues[req[k].slot] += rsum;
+          break;
+        case NORM_1_AND_2:
+          rsum = 0.0; rsum2 = 0.0;
+          for (i=s; i<e; i++) {
+            rsum  += PetscAbsScalar(xa[i]);
+            rsum2 += PetscRealPart(xa[i]*PetscConj(xa[i]));
+          }
+          lvalues[req[k].slot]   += rsum;
+          lvalues[req[k].slot+1] += rsum2;
+          break;
+        case NORM_INFINITY:
+          m = PetscRealPart(lvalues[req[k].slot]);
+          for (i=s; i<e; i++) m = PetscMax(m,PetscAbsScalar(xa[i]));
+          lvalues[req[k].slot] = m;
+          break;
+        }
+        break;
+      }
+    }
+  }
+}
+
+/*@
+   VecReductionBegin - Computes the local parts of all the requests queued in a reduction context and starts the global reduction
+
+   Collective on VecReduction
+
+   Input Parameter:
+.  red - the reduction context
+
+   Level: advanced
+
+   Notes:
+   When all the vectors have the same local length and their entries are stored in host memory the local parts
+   are computed together in one pass, otherwise each request is computed separately.
+
+.seealso: VecReductionCreate(), VecReductionEnd(), VecReductionAddDot(), VecReductionAddNorm()
+@*/
+PetscErrorCode VecReductionBegin(VecReduction red)
+{
+  PetscErrorCode      ierr;
+  PetscInt            k,n,nvalues = red->nvalues;
+  PetscBool           fused = PETSC_TRUE;
+  PetscLogDouble      flops = 0.0;
+  VecReductionRequest *req = red->req;
+  PetscReal           lresult[2];
+
+  PetscFunctionBegin;
+  PetscValidPointer(red,1);
+  if (red->pending) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"VecReductionBegin() called twice without VecReductionEnd()");
+  if (nvalues > red->maxvalues) {
+    ierr = PetscFree3(red->lvalues,red->gvalues,red->reducetype);CHKERRQ(ierr);
+    red->maxvalues = PetscMax(2*red->maxvalues,nvalues);
+    ierr = PetscMalloc3(2*red->maxvalues,&red->lvalues,2*red->maxvalues,&red->gvalues,red->maxvalues,&red->reducetype);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventBegin(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+  n = red->nreq ? req[0].x->map->n : 0;
+  for (k=0; k<red->nreq; k++) {
+    VecReductionRequest *r = &req[k];
+
+    if (r->x->map->n != n || !r->x->petscnative || (r->y && !r->y->petscnative)) fused = PETSC_FALSE;
+    switch (r->op) {
+    case VEC_REDUCTION_MAX: red->reducetype[r->slot] = PETSC_SR_REDUCE_MAX; red->lvalues[r->slot] = PETSC_MIN_REAL; break;
+    case VEC_REDUCTION_MIN: red->reducetype[r->slot] = PETSC_SR_REDUCE_MIN; red->lvalues[r->slot] = PETSC_MAX_REAL; break;
+    case VEC_REDUCTION_NORM:
+      red->reducetype[r->slot] = (r->ntype == NORM_INFINITY) ? PETSC_SR_REDUCE_MAX : PETSC_SR_REDUCE_SUM;
+      red->lvalues[r->slot]    = 0.0;
+      if (r->ntype == NORM_1_AND_2) {
+        red->reducetype[r->slot+1] = PETSC_SR_REDUCE_SUM;
+        red->lvalues[r->slot+1]    = 0.0;
+      }
+      flops += (r->ntype == NORM_1_AND_2) ? 3.0*r->x->map->n : ((r->ntype == NORM_INFINITY) ? 0.0 : (r->ntype == NORM_1 ? 1.0 : 2.0)*r->x->map->n);
+      break;
+    case VEC_REDUCTION_SUM:
+      red->reducetype[r->slot] = PETSC_SR_REDUCE_SUM; red->lvalues[r->slot] = 0.0;
+      flops += r->x->map->n;
+      break;
+    default:
+      red->reducetype[r->slot] = PETSC_SR_REDUCE_SUM; red->lvalues[r->slot] = 0.0;
+      flops += 2.0*r->x->map->n;
+      break;
+    }
+  }
+  if (fused) {
+    for (k=0; k<red->nreq; k++) {
+      ierr = VecGetArrayRead(req[k].x,&req[k].xa);CHKERRQ(ierr);
+      if (req[k].y) {ierr = VecGetArrayRead(req[k].y,&req[k].ya);CHKERRQ(ierr);}
+    }
+    VecReductionLocal_Private(red->nreq,req,n,red->lvalues);
+    for (k=0; k<red->nreq; k++) {
+      ierr = VecRestoreArrayRead(req[k].x,&req[k].xa);CHKERRQ(ierr);
+      if (req[k].y) {ierr = VecRestoreArrayRead(req[k].y,&req[k].ya);CHKERRQ(ierr);}
+    }
+    ierr = PetscLogFlops(flops);CHKERRQ(ierr);
+  } else {
+    for (k=0; k<red->nreq; k++) {
+      VecReductionRequest *r = &req[k];
+      Vec                 x  = r->x;
+
+      if (r->op == VEC_REDUCTION_DOT && x->ops->dot_local) {
+        ierr = (*x->ops->dot_local)(x,r->y,red->lvalues+r->slot);CHKERRQ(ierr);
+      } else if (r->op == VEC_REDUCTION_TDOT && x->ops->tdot_local) {
+        ierr = (*x->ops->tdot_local)(x,r->y,red->lvalues+r->slot);CHKERRQ(ierr);
+      } else if (r->op == VEC_REDUCTION_NORM && x->ops->norm_local) {
+        ierr = (*x->ops->norm_local)(x,r->ntype,lresult);CHKERRQ(ierr);
+        if (r->ntype == NORM_2 || r->ntype == NORM_FROBENIUS) lresult[0] = lresult[0]*lresult[0];
+        red->lvalues[r->slot] = lresult[0];
+        if (r->ntype == NORM_1_AND_2) red->lvalues[r->slot+1] = lresult[1]*lresult[1];
+      } else {
+        ierr = VecGetArrayRead(x,&r->xa);CHKERRQ(ierr);
+        if (r->y) {ierr = VecGetArrayRead(r->y,&r->ya);CHKERRQ(ierr);}
+        VecReductionLocal_Private(1,r,x->map->n,red->lvalues);
+        ierr = VecRestoreArrayRead(x,&r->xa);CHKERRQ(ierr);
+        if (r->y) {ierr = VecRestoreArrayRead(r->y,&r->ya);CHKERRQ(ierr);}
+      }
+    }
+  }
+  ierr = PetscLogEventEnd(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+
+  ierr = PetscLogEventBegin(VEC_ReduceBegin,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscSplitReductionIallreduce_Private(red->comm,nvalues,red->reducetype,red->lvalues,red->gvalues,PETSC_TRUE,&red->request);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_ReduceBegin,0,0,0,0);CHKERRQ(ierr);
+  red->pending = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecReductionEnd - Completes the global reduction started with VecReductionBegin() and stores the results
+
+   Collective on VecReduction
+
+   Input Parameter:
+.  red - the reduction context
+
+   Level: advanced
+
+.seealso: VecReductionCreate(), VecReductionBegin(), VecReductionAddDot(), VecReductionAddNorm()
+@*/
+PetscErrorCode VecReductionEnd(VecReduction red)
+{
+  PetscErrorCode      ierr;
+  PetscInt            k;
+  VecReductionRequest *r;
+  PetscScalar         *g;
+
+  PetscFunctionBegin;
+  PetscValidPointer(red,1);
+  if (!red->pending) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"VecReductionEnd() called without VecReductionBegin()");
+  ierr = PetscLogEventBegin(VEC_ReduceEnd,0,0,0,0);CHKERRQ(ierr);
+  if (red->request != MPI_REQUEST_NULL) {
+    ierr = MPI_Wait(&red->request,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventEnd(VEC_ReduceEnd,0,0,0,0);CHKERRQ(ierr);
+  red->pending = PETSC_FALSE;
+  for (k=0; k<red->nreq; k++) {
+    r = &red->req[k];
+    g = red->gvalues + r->slot;
+    switch (r->op) {
+    case VEC_REDUCTION_MAX:
+    case VEC_REDUCTION_MIN:
+      r->rresult[0] = PetscRealPart(g[0]);
+      break;
+    case VEC_REDUCTION_NORM:
+      r->rresult[0] = PetscRealPart(g[0]);
+      if (r->ntype == NORM_2 || r->ntype == NORM_FROBENIUS) r->rresult[0] = PetscSqrtReal(r->rresult[0]);
+      else if (r->ntype == NORM_1_AND_2) r->rresult[1] = PetscSqrtReal(PetscRealPart(g[1]));
+      if (r->ntype != NORM_1_AND_2) {
+        ierr = PetscObjectComposedDataSetReal((PetscObject)r->x,NormIds[r->ntype],r->rresult[0]);CHKERRQ(ierr);
+      }
+      break;
+    default:
+      r->sresult[0] = g[0];
+      break;
+    }
+  }
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,436 @@
+
+/*
+   Compressed binary storage of vectors, see PetscViewerBinarySetCompression().
+
+   The file contains the header VEC_COMPRESSED_FILE_CLASSID, the global size and the number of blocks, then the
+   number of entries and of bytes of each block, then the compressed blocks. Each process compresses blocks of its
+   own entries and decompresses the blocks that overlap its entries, so the vector may be loaded with any layout.
+
+   A block is a method byte followed by
+     VEC_COMPRESS_RAW       - the entries, as big endian PetscReal
+     VEC_COMPRESS_LOSSLESS  - the LZ77 coded bytes of the entries, as big endian PetscReal, each one XORed with the
+                              previous one and the bytes shuffled so that bytes of the same significance are together
+     VEC_COMPRESS_QUANTIZED - the quantization step, as big endian PetscReal, then the LZ77 coded bytes of the
+                              differences of consecutive quantized entries, zigzag coded as 64 bit integers and shuffled
+*/
+#include <petsc/private/vecimpl.h>   /*I  "petscvec.h"  I*/
+
+#define VEC_COMPRESS_BLOCK      16384   /* entries in a block */
+#define VEC_COMPRESS_HASH_BITS  14
+#define VEC_COMPRESS_MIN_MATCH  4
+#define VEC_COMPRESS_MAX_OFFSET 65535
+#define VEC_COMPRESS_MAX_QUANT  4.0e18  /* largest quantized value, so the differences fit in 64 bits */
+
+enum {VEC_COMPRESS_RAW = 0,VEC_COMPRESS_LOSSLESS = 1,VEC_COMPRESS_QUANTIZED = 2};
+
+typedef unsigned long long VecCompressUInt64;
+
+/* big endian bytes of n reals */
+static PetscErrorCode VecCompressRealsToBytes_Private(PetscInt n,const PetscReal *x,unsigned char *b)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMemcpy(b,x,n*sizeof(PetscReal));CHKERRQ(ierr);
+#if !defined(PETSC_WORDS_BIGENDIAN)
+  ierr = PetscByteSwap(b,PETSC_REAL,n);CHKERRQ(ierr);
+#endif
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecCompressBytesToReals_Private(PetscInt n,const unsigned char *b,PetscReal *x)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMemcpy(x,b,n*sizeof(PetscReal));CHKERRQ(ierr);
+#if !defined(PETSC_WORDS_BIGENDIAN)
+  ierr = PetscByteSwap(x,PETSC_REAL,n);CHKERRQ(ierr);
+#endif
+  PetscFunctionReturn(0);
+}
+
+/* appends a length that does not fit in a token nibble: bytes of 255 and a final byte smaller than 255 */
+PETSC_STATIC_INLINE size_t VecCompressPutLength_Private(unsigned char *out,size_t op,size_t len)
+{
+  for (; len >= 255; len -= 255) out[op++] = 255;
+  out[op++] = (unsigned char)len;
+  return op;
+}
+
+/*
+   Byte oriented LZ77 coder: a sequence is a token with the number of literals in the high nibble and the match
+   length-4 in the low nibble (15 meaning that more length bytes follow), the literals, and the 2 byte offset of the
+   match. The last sequence has only literals. Returns PETSC_FALSE in ok if the result does not fit in cap bytes.
+*/
+static void VecCompressLZ_Private(const unsigned char *in,size_t n,unsigned char *out,size_t cap,size_t *outlen,PetscInt *table,PetscBool *ok)
+{
+  size_t       ip = 0,anchor = 0,op = 0,ref,lit,len,h;
+  unsigned int v;
+
+  *ok = PETSC_FALSE;
+  for (h=0; h<((size_t)1<<VEC_COMPRESS_HASH_BITS); h++) table[h] = -1;
+  while (ip + VEC_COMPRESS_MIN_MATCH <= n) {
+    memcpy(&v,in+ip,sizeof(v));
+    h        = (size_t)((v*2654435761U) >> (32-VEC_COMPRESS_HASH_BITS));
+    ref      = (size_t)table[h];
+    table[h] = (PetscInt)ip;
+    if (ref == (size_t)-1 || ip - ref > VEC_COMPRESS_MAX_OFFSET || memcmp(in+ref,in+ip,VEC_COMPRESS_MIN_MATCH)) {ip++; continue;}
+    for (len=VEC_COMPRESS_MIN_MATCH; ip+len < n && in[ref+len] == in[ip+len]; len++) ;
+    lit = ip - anchor;
+    /* token, literal length bytes, literals, offset, match length bytes */
+    if (op + 1 + lit/255 + 1 + lit + 2 + (len-VEC_COMPRESS_MIN_MATCH)/255 + 1 > cap) return;
+    out[op++] = (unsigned char)((PetscMin(lit,15) << 4) | PetscMin(len-VEC_COMPRESS_MIN_MATCH,15));
+    if (lit >= 15) op = VecCompressPutLength_Private(out,op,lit-15);
+    memcpy(out+op,in+anchor,lit);
+    op       += lit;
+    out[op++] = (unsigned char)((ip-ref) & 0xff);
+    out[op++] = (unsigned char)((ip-ref) >> 8);
+    if (len-VEC_COMPRESS_MIN_MATCH >= 15) op = VecCompressPutLength_Private(out,op,len-VEC_COMPRESS_MIN_MATCH-15);
+    ip    += len;
+    anchor = ip;
+  }
+  lit = n - anchor;
+  if (op + 1 + lit/255 + 1 + lit > cap) return;
+  out[op++] = (unsigned char)(PetscMin(lit,15) << 4);
+  if (lit >= 15) op = VecCompressPutLength_Private(out,op,lit-15);
+  memcpy(out+op,in+anchor,lit);
+  *outlen = op + lit;
+  *ok     = PETSC_TRUE;
+}
+
+PETSC_STATIC_INLINE PetscErrorCode VecCompressGetLength_Private(const unsigned char *in,size_t n,size_t *ip,size_t *len)
+{
+  unsigned char b;
+
+  PetscFunctionBegin;
+  do {
+    if (*ip >= n) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Corrupted compressed vector block");
+    b     = in[(*ip)++];
+    *len += b;
+  } while (b == 255);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecDecompressLZ_Private(const unsigned char *in,size_t n,unsigned char *out,size_t outlen)
+{
+  PetscErrorCode ierr;
+  size_t         ip = 0,op = 0,lit,len,off;
+  unsigned char  token;
+
+  PetscFunctionBegin;
+  while (ip < n) {
+    token = in[ip++];
+    lit   = token >> 4;
+    if (lit == 15) {ierr = VecCompressGetLength_Private(in,n,&ip,&lit);CHKERRQ(ierr);}
+    if (ip + lit > n || op + lit > outlen) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Corrupted compressed vector block");
+    ierr = PetscMemcpy(out+op,in+ip,lit);CHKERRQ(ierr);
+    ip  += lit;
+    op  += lit;
+    if (ip == n) break;
+    if (ip + 2 > n) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Corrupted compressed vector block");
+    off = (size_t)in[ip] | ((size_t)in[ip+1] << 8);
+    ip += 2;
+    len = token & 15;
+    if (len == 15) {ierr = VecCompressGetLength_Private(in,n,&ip,&len);CHKERRQ(ierr);}
+    len += VEC_COMPRESS_MIN_MATCH;
+    if (!off || off > op || op + len > outlen) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Corrupted compressed vector block");
+    /* the match may overlap the bytes it produces */
+    for (; len; len--,op++) out[op] = out[op-off];
+  }
+  if (op != outlen) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Corrupted compressed vector block");
+  PetscFunctionReturn(0);
+}
+
+/*
+   Compresses the m reals of x into out, which has room for the raw block (1 + m*sizeof(PetscReal) bytes).
+   work has room for 2*m*PetscMax(sizeof(PetscReal),8) bytes.
+*/
+static PetscErrorCode VecCompressBlock_Private(PetscInt m,const PetscReal *x,PetscReal tol,unsigned char *out,size_t *outlen,unsigned char *work,PetscInt *table)
+{
+  PetscErrorCode    ierr;
+  const size_t      w = sizeof(PetscReal),cap = 1 + m*w;
+  unsigned char     *e = work,*t = work + m*PetscMax(w,8);
+  PetscInt          i;
+  size_t            k,len,hlen;
+  PetscReal         step = 2.0*tol,r;
+  VecCompressUInt64 q,qprev = 0,z;
+  PetscBool         ok = PETSC_FALSE;
+
+  PetscFunctionBegin;
+  if (tol > 0.0) {
+    for (i=0; i<m; i++) {
+      r = x[i]/step;
+      if (!(PetscAbsReal(r) < VEC_COMPRESS_MAX_QUANT)) break;
+      q     = (VecCompressUInt64)(long long)PetscFloorReal(r+0.5);
+      z     = q - qprev;
+      z     = (z << 1) ^ (VecCompressUInt64)(-(long long)(z >> 63)); /* zigzag so that small negative differences have small codes */
+      qprev = q;
+      for (k=0; k<8; k++) t[k*m+i] = (unsigned char)(z >> (56-8*k));
+    }
+    if (i == m) {
+      out[0] = VEC_COMPRESS_QUANTIZED;
+      ierr   = VecCompressRealsToBytes_Private(1,&step,out+1);CHKERRQ(ierr);
+      hlen   = 1 + w;
+      VecCompressLZ_Private(t,8*m,out+hlen,cap > hlen ? cap-hlen : 0,&len,table,&ok);
+    }
+  }
+  if (!ok) {
+    ierr = VecCompressRealsToBytes_Private(m,x,e);CHKERRQ(ierr);
+    for (k=0; k<w; k++) {
+      t[k*m] = e[k];
+      for (i=1; i<m; i++) t[k*m+i] = e[i*w+k] ^ e[(i-1)*w+k];
+    }
+    out[0] = VEC_COMPRESS_LOSSLESS;
+    hlen   = 1;
+    VecCompressLZ_Private(t,w*m,out+hlen,cap-hlen,&len,table,&ok);
+    if (!ok) {
+      out[0] = VEC_COMPRESS_RAW;
+      ierr   = PetscMemcpy(out+1,e,m*w);CHKERRQ(ierr);
+      len    = m*w;
+    }
+  }
+  *outlen = hlen + len;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecDecompressBlock_Private(PetscInt m,const unsigned char *in,size_t n,PetscReal *x,unsigned char *work)
+{
+  PetscErrorCode    ierr;
+  const size_t      w = sizeof(PetscReal);
+  unsigned char     *e = work,*t = work + m*PetscMax(w,8);
+  PetscInt          i;
+  size_t            k;
+  PetscReal         step;
+  VecCompressUInt64 q = 0,z;
+
+  PetscFunctionBegin;
+  if (!n) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Corrupted compressed vector block");
+  switch (in[0]) {
+  case VEC_COMPRESS_RAW:
+    if (n != 1 + m*w) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Corrupted compressed vector block");
+    ierr = VecCompressBytesToReals_Private(m,in+1,x);CHKERRQ(ierr);
+    break;
+  case VEC_COMPRESS_LOSSLESS:
+    ierr = VecDecompressLZ_Private(in+1,n-1,t,m*w);CHKERRQ(ierr);
+    for (k=0; k<w; k++) {
+      e[k] = t[k*m];
+      for (i=1; i<m; i++) e[i*w+k] = t[k*m+i] ^ e[(i-1)*w+k];
+    }
+    ierr = VecCompressBytesToReals_Private(m,e,x);CHKERRQ(ierr);
+    break;
+  case VEC_COMPRESS_QUANTIZED:
+    if (n < 1 + w) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Corrupted compressed vector block");
+    ierr = VecCompressBytesToReals_Private(1,in+1,&step);CHKERRQ(ierr);
+    ierr = VecDecompressLZ_Private(in+1+w,n-1-w,t,8*m);CHKERRQ(ierr);
+    for (i=0; i<m; i++) {
+      for (k=0,z=0; k<8; k++) z = (z << 8) | t[k*m+i];
+      q   += (z >> 1) ^ (VecCompressUInt64)(-(long long)(z & 1));
+      x[i] = (PetscReal)(long long)q*step;
+    }
+    break;
+  default: SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Unknown compression method %d of vector block",(int)in[0]);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   VecView_Binary_Compressed - Writes a vector compressed to a binary viewer, see PetscViewerBinarySetCompression()
+*/
+PetscErrorCode VecView_Binary_Compressed(Vec xin,PetscViewer viewer)
+{
+  PetscErrorCode    ierr;
+  MPI_Comm          comm;
+  PetscMPIInt       rank,size,j,nb,mesgsize,tag = ((PetscObject)viewer)->tag,*nbs = NULL,*displs = NULL;
+  PetscInt          c = sizeof(PetscScalar)/sizeof(PetscReal),n = xin->map->n,b,m,tr[3],*lens,*bytes,*alllens = NULL,*allbytes = NULL,*table,len;
+  PetscInt          message_count,flowcontrolcount;
+  PetscReal         tol;
+  const PetscScalar *xarray;
+  unsigned char     *buf,*work,*values = NULL;
+  size_t            pos = 0,blen = 0;
+  int               fdes;
+  FILE              *file;
+  PetscViewerFormat format;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)xin,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryGetCompression(viewer,NULL,&tol);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryGetDescriptor(viewer,&fdes);CHKERRQ(ierr);
+
+  /* compress the local blocks */
+  ierr = PetscMPIIntCast((n+VEC_COMPRESS_BLOCK-1)/VEC_COMPRESS_BLOCK,&nb);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nb,&lens,nb,&bytes);CHKERRQ(ierr);
+  ierr = PetscMalloc3(nb+c*n*sizeof(PetscReal),&buf,2*c*PetscMin(n,VEC_COMPRESS_BLOCK)*PetscMax(sizeof(PetscReal),8),&work,(PetscInt)1<<VEC_COMPRESS_HASH_BITS,&table);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xin,&xarray);CHKERRQ(ierr);
+  for (b=0; b<nb; b++) {
+    lens[b]  = PetscMin(VEC_COMPRESS_BLOCK,n-b*VEC_COMPRESS_BLOCK);
+    m        = c*lens[b];
+    ierr     = VecCompressBlock_Private(m,(const PetscReal*)(xarray+b*VEC_COMPRESS_BLOCK),tol,buf+pos,&blen,work,table);CHKERRQ(ierr);
+    bytes[b] = (PetscInt)blen;
+    pos     += blen;
+  }
+  ierr = VecRestoreArrayRead(xin,&xarray);CHKERRQ(ierr);
+
+  /* the header and the sizes of all the blocks */
+  if (!rank) {ierr = PetscMalloc2(size,&nbs,size,&displs);CHKERRQ(ierr);}
+  ierr = MPI_Gather(&nb,1,MPI_INT,nbs,1,MPI_INT,0,comm);CHKERRQ(ierr);
+  if (!rank) {
+    for (j=0,tr[2]=0; j<size; j++) {
+      ierr   = PetscMPIIntCast(tr[2],&displs[j]);CHKERRQ(ierr);
+      tr[2] += nbs[j];
+    }
+    ierr = PetscMalloc2(tr[2],&alllens,tr[2],&allbytes);CHKERRQ(ierr);
+  }
+  ierr = MPI_Gatherv(lens,nb,MPIU_INT,alllens,nbs,displs,MPIU_INT,0,comm);CHKERRQ(ierr);
+  ierr = MPI_Gatherv(bytes,nb,MPIU_INT,allbytes,nbs,displs,MPIU_INT,0,comm);CHKERRQ(ierr);
+  tr[0] = VEC_COMPRESSED_FILE_CLASSID;
+  tr[1] = xin->map->N;
+  ierr  = PetscViewerBinaryWrite(viewer,tr,3,PETSC_INT,PETSC_FALSE);CHKERRQ(ierr);
+
+  /* the compressed blocks, in the order of the processes */
+  ierr = PetscViewerFlowControlStart(viewer,&message_count,&flowcontrolcount);CHKERRQ(ierr);
+  if (!rank) {
+    ierr = PetscBinaryWrite(fdes,alllens,tr[2],PETSC_INT,PETSC_FALSE);CHKERRQ(ierr);
+    ierr = PetscBinaryWrite(fdes,allbytes,tr[2],PETSC_INT,PETSC_FALSE);CHKERRQ(ierr);
+    ierr = PetscBinaryWrite(fdes,buf,(PetscInt)pos,PETSC_CHAR,PETSC_FALSE);CHKERRQ(ierr);
+    for (j=1,mesgsize=0; j<size; j++) {
+      for (b=displs[j],len=0; b<displs[j]+nbs[j]; b++) len += allbytes[b];
+      if (len > mesgsize) {
+        ierr = PetscFree(values);CHKERRQ(ierr);
+        ierr = PetscMPIIntCast(len,&mesgsize);CHKERRQ(ierr);
+        ierr = PetscMalloc1(mesgsize,&values);CHKERRQ(ierr);
+      }
+      ierr = PetscViewerFlowControlStepMaster(viewer,j,&message_count,flowcontrolcount);CHKERRQ(ierr);
+      ierr = MPI_Recv(values,(PetscMPIInt)len,MPI_BYTE,j,tag,comm,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+      ierr = PetscBinaryWrite(fdes,values,len,PETSC_CHAR,PETSC_TRUE);CHKERRQ(ierr);
+    }
+    ierr = PetscViewerFlowControlEndMaster(viewer,&message_count);CHKERRQ(ierr);
+    ierr = PetscFree(values);CHKERRQ(ierr);
+    ierr = PetscFree2(alllens,allbytes);CHKERRQ(ierr);
+    ierr = PetscFree2(nbs,displs);CHKERRQ(ierr);
+  } else {
+    ierr = PetscViewerFlowControlStepWorker(viewer,rank,&message_count);CHKERRQ(ierr);
+    ierr = PetscMPIIntCast((PetscInt)pos,&mesgsize);CHKERRQ(ierr);
+    ierr = MPI_Send(buf,mesgsize,MPI_BYTE,0,tag,comm);CHKERRQ(ierr);
+    ierr = PetscViewerFlowControlEndWorker(viewer,&message_count);CHKERRQ(ierr);
+  }
+  ierr = PetscFree3(buf,work,table);CHKERRQ(ierr);
+  ierr = PetscFree2(lens,bytes);CHKERRQ(ierr);
+
+  ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
+  if (format == PETSC_VIEWER_BINARY_MATLAB) {
+    FILE       *info;
+    const char *name;
+
+    ierr = PetscObjectGetName((PetscObject)xin,&name);CHKERRQ(ierr);
+    ierr = PetscViewerBinaryGetInfoPointer(viewer,&info);CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm,info,"#--- begin code written by PetscViewerBinary for MATLAB format ---#\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm,info,"#$$ Set.%s = PetscBinaryRead(fd);\n",name);CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm,info,"#--- end code written by PetscViewerBinary for MATLAB format ---#\n\n");CHKERRQ(ierr);
+  }
+  if (!rank) {
+    ierr = PetscViewerBinaryGetInfoPointer(viewer,&file);CHKERRQ(ierr);
+    if (file) {
+      if (((PetscObject)xin)->prefix) {
+        ierr = PetscFPrintf(PETSC_COMM_SELF,file,"-%svecload_block_size %D\n",((PetscObject)xin)->prefix,PetscAbs(xin->map->bs));CHKERRQ(ierr);
+      } else {
+        ierr = PetscFPrintf(PETSC_COMM_SELF,file,"-vecload_block_size %D\n",PetscAbs(xin->map->bs));CHKERRQ(ierr);
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* the blocks [*b0,*b1) overlap the entries [rstart,rend) */
+static void VecCompressFindBlocks_Private(PetscInt nb,const PetscInt *starts,PetscInt rstart,PetscInt rend,PetscInt *b0,PetscInt *b1)
+{
+  PetscInt b;
+
+  for (b=0; b<nb && starts[b+1] <= rstart; b++) ;
+  *b0 = b;
+  for (; b<nb && starts[b] < rend; b++) ;
+  *b1 = rend > rstart ? b : *b0;
+}
+
+/*
+   VecLoad_Binary_Compressed - Loads a compressed vector whose header, the class id and the size, has been read
+*/
+PetscErrorCode VecLoad_Binary_Compressed(Vec vec,PetscViewer viewer)
+{
+  PetscErrorCode ierr;
+  MPI_Comm       comm;
+  PetscMPIInt    rank,size,p,tag;
+  PetscInt       c = sizeof(PetscScalar)/sizeof(PetscReal),nb,b,b0,b1,pb0,pb1,i,lo,hi,maxlen = 0,*lens,*bytes,*starts,*offsets,*range;
+  PetscScalar    *avec;
+  PetscReal      *x;
+  unsigned char  *buf,*work,*mine = NULL;
+  off_t          datastart,off;
+  int            fd;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)viewer,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryGetDescriptor(viewer,&fd);CHKERRQ(ierr);
+  ierr = PetscObjectGetNewTag((PetscObject)viewer,&tag);CHKERRQ(ierr);
+
+  /* every process gets the sizes of all the blocks */
+  ierr = PetscViewerBinaryRead(viewer,&nb,1,NULL,PETSC_INT);CHKERRQ(ierr);
+  ierr = PetscMalloc4(nb,&lens,nb,&bytes,nb+1,&starts,nb+1,&offsets);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryRead(viewer,lens,nb,NULL,PETSC_INT);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryRead(viewer,bytes,nb,NULL,PETSC_INT);CHKERRQ(ierr);
+  starts[0] = offsets[0] = 0;
+  for (b=0; b<nb; b++) {
+    starts[b+1]  = starts[b] + lens[b];
+    offsets[b+1] = offsets[b] + bytes[b];
+    maxlen       = PetscMax(maxlen,lens[b]);
+  }
+  if (starts[nb] != vec->map->N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Compressed vector blocks have %D entries instead of %D",starts[nb],vec->map->N);
+
+  /* the first process reads the blocks that overlap the entries of each process and sends them */
+  range = vec->map->range;
+  VecCompressFindBlocks_Private(nb,starts,vec->map->rstart,vec->map->rend,&b0,&b1);
+  if (!rank) {
+    ierr = PetscBinarySeek(fd,0,PETSC_BINARY_SEEK_CUR,&datastart);CHKERRQ(ierr);
+    for (p=0,i=0; p<size; p++) {
+      VecCompressFindBlocks_Private(nb,starts,range[p],range[p+1],&pb0,&pb1);
+      i = PetscMax(i,offsets[pb1]-offsets[pb0]);
+    }
+    ierr = PetscMalloc1(i,&mine);CHKERRQ(ierr);
+    ierr = PetscBinaryRead(fd,mine,offsets[b1]-offsets[b0],PETSC_CHAR);CHKERRQ(ierr);
+    if (size > 1) {
+      ierr = PetscMalloc1(i,&buf);CHKERRQ(ierr);
+      for (p=1; p<size; p++) {
+        VecCompressFindBlocks_Private(nb,starts,range[p],range[p+1],&pb0,&pb1);
+        /* a block that overlaps two processes is read again */
+        ierr = PetscBinarySeek(fd,datastart+offsets[pb0],PETSC_BINARY_SEEK_SET,&off);CHKERRQ(ierr);
+        ierr = PetscBinaryRead(fd,buf,offsets[pb1]-offsets[pb0],PETSC_CHAR);CHKERRQ(ierr);
+        ierr = MPI_Send(buf,(PetscMPIInt)(offsets[pb1]-offsets[pb0]),MPI_BYTE,p,tag,comm);CHKERRQ(ierr);
+      }
+      ierr = PetscFree(buf);CHKERRQ(ierr);
+    }
+    ierr = PetscBinarySeek(fd,datastart+offsets[nb],PETSC_BINARY_SEEK_SET,&off);CHKERRQ(ierr);
+  } else {
+    ierr = PetscMalloc1(offsets[b1]-offsets[b0],&mine);CHKERRQ(ierr);
+    ierr = MPI_Recv(mine,(PetscMPIInt)(offsets[b1]-offsets[b0]),MPI_BYTE,0,tag,comm,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  }
+
+  /* decompress the blocks and keep the entries of this process */
+  ierr = PetscMalloc2(c*maxlen,&x,2*c*maxlen*PetscMax(sizeof(PetscReal),8),&work);CHKERRQ(ierr);
+  ierr = VecGetArray(vec,&avec);CHKERRQ(ierr);
+  for (b=b0; b<b1; b++) {
+    ierr = VecDecompressBlock_Private(c*lens[b],mine+offsets[b]-offsets[b0],bytes[b],x,work);CHKERRQ(ierr);
+    lo   = PetscMax(starts[b],vec->map->rstart);
+    hi   = PetscMin(starts[b+1],vec->map->rend);
+    ierr = PetscMemcpy(avec+lo-vec->map->rstart,x+c*(lo-starts[b]),c*(hi-lo)*sizeof(PetscReal));CHKERRQ(ierr);
+  }
+  ierr = VecRestoreArray(vec,&avec);CHKERRQ(ierr);
+  ierr = PetscFree2(x,work);CHKERRQ(ierr);
+  ierr = PetscFree(mine);CHKERRQ(ierr);
+  ierr = PetscFree4(lens,bytes,starts,offsets);CHKERRQ(ierr);
+  ierr = VecAssemblyBegin(vec);CHKERRQ(ierr);
+  ierr = VecAssemblyEnd(vec);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -10,7 +10,7 @@
 #include <petsc/private/vecimpl.h>
 #include <petsc/private/viewerimpl.h>
 
-static PetscErrorCode PetscViewerBinaryReadVecHeader_Private(PetscViewer viewer,PetscInt *rows)
+static PetscErrorCode PetscViewerBinaryReadVecHeader_Private(PetscViewer viewer,PetscInt *rows,PetscBool *compressed)
 {
   PetscErrorCode ierr;
   MPI_Comm       comm;
@@ -21,11 +21,12 @@ static PetscErrorCode PetscViewerBinaryReadVecHeader_Private(PetscViewer viewer,
   /* Read vector header */
   ierr = PetscViewerBinaryRead(viewer,tr,2,NULL,PETSC_INT);CHKERRQ(ierr);
   type = tr[0];
-  if (type != VEC_FILE_CLASSID) {
+  if (type != VEC_FILE_CLASSID && type != VEC_COMPRESSED_FILE_CLASSID) {
     ierr = PetscLogEventEnd(VEC_Load,viewer,0,0,0);CHKERRQ(ierr);
     SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Not a vector next in file");
   }
-  *rows = tr[1];
+  *rows       = tr[1];
+  *compressed = (PetscBool)(type == VEC_COMPRESSED_FILE_CLASSID);
   PetscFunctionReturn(0);
 }
 
@@ -62,7 +63,7 @@ PetscErrorCode VecLoad_Binary(Vec vec, PetscViewer viewer)
   int            fd;
   PetscInt       i,rows = 0,n,*range,N,bs;
   PetscErrorCode ierr;
-  PetscBool      flag,skipheader;
+  PetscBool      flag,skipheader,compressed = PETSC_FALSE;
   PetscScalar    *avec,*avecwork;
   MPI_Comm       comm;
   MPI_Request    request;
@@ -81,7 +82,7 @@ PetscErrorCode VecLoad_Binary(Vec vec, PetscViewer viewer)
   ierr = PetscViewerBinaryGetDescriptor(viewer,&fd);CHKERRQ(ierr);
   ierr = PetscViewerBinaryGetSkipHeader(viewer,&skipheader);CHKERRQ(ierr);
   if (!skipheader) {
-    ierr = PetscViewerBinaryReadVecHeader_Private(viewer,&rows);CHKERRQ(ierr);
+    ierr = PetscViewerBinaryReadVecHeader_Private(viewer,&rows,&compressed);CHKERRQ(ierr);
   } else {
     VecType vtype;
     ierr = VecGetType(vec,&vtype);CHKERRQ(ierr);
@@ -106,11 +107,16 @@ PetscErrorCode VecLoad_Binary(Vec vec, PetscViewer viewer)
 #if defined(PETSC_HAVE_MPIIO)
   ierr = PetscViewerBinaryGetUseMPIIO(viewer,&useMPIIO);CHKERRQ(ierr);
   if (useMPIIO) {
+    if (compressed) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Loading compressed vectors with MPI-IO is not supported");
     ierr = VecLoad_Binary_MPIIO(vec, viewer);CHKERRQ(ierr);
     PetscFunctionReturn(0);
   }
 #endif
 
+  if (compressed) {
+    ierr = VecLoad_Binary_Compressed(vec,viewer);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = VecGetLocalSize(vec,&n);CHKERRQ(ierr);
   ierr = PetscObjectGetNewTag((PetscObject)viewer,&tag);CHKERRQ(ierr);
   ierr = VecGetArray(vec,&avec);CHKERRQ(ierr);
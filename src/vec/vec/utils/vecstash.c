@@ -67,6 +67,17 @@ PetscErrorCode VecStashCreate_Private(MPI_Comm comm,PetscInt bs,VecStash *stash)
   stash->nprocessed   = 0;
   stash->donotstash   = PETSC_FALSE;
   stash->ignorenegidx = PETSC_FALSE;
+
+  stash->frozen = PETSC_FALSE;
+  stash->ndests = 0;
+  stash->dests  = 0;
+  stash->dlast  = 0;
+  stash->range  = 0;
+  stash->dn     = 0;
+  stash->dnmax  = 0;
+  stash->dlimit = 0;
+  stash->didx   = 0;
+  stash->darray = 0;
   PetscFunctionReturn(0);
 }
 
@@ -80,6 +91,7 @@ PetscErrorCode VecStashDestroy_Private(VecStash *stash)
   PetscFunctionBegin;
   ierr = PetscFree2(stash->array,stash->idx);CHKERRQ(ierr);
   ierr = PetscFree(stash->bowners);CHKERRQ(ierr);
+  ierr = VecStashUnfreeze_Private(stash);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -94,7 +106,7 @@ PetscErrorCode VecStashDestroy_Private(VecStash *stash)
 PetscErrorCode VecStashScatterEnd_Private(VecStash *stash)
 {
   PetscErrorCode ierr;
-  PetscInt       nsends=stash->nsends,oldnmax;
+  PetscInt       nsends=stash->nsends,oldnmax,i;
   MPI_Status     *send_status;
 
   PetscFunctionBegin;
@@ -116,6 +128,7 @@ PetscErrorCode VecStashScatterEnd_Private(VecStash *stash)
   stash->nmax       = 0;
   stash->n          = 0;
   stash->reallocs   = -1;
+  for (i=0; i<stash->ndests; i++) stash->dn[i] = 0;
   stash->rmax       = 0;
   stash->nprocessed = 0;
 
@@ -234,6 +247,7 @@ PetscErrorCode VecStashScatterBegin_Private(VecStash *stash,PetscInt *owners)
   MPI_Request    *send_waits,*recv_waits;
 
   PetscFunctionBegin;
+  if (stash->frozen) SETERRQ(comm,PETSC_ERR_ARG_WRONGSTATE,"Stash with a frozen communication pattern cannot be scattered");
   /*  first count number of contributors to each processor */
   ierr = PetscCalloc1(2*size,&nprocs);CHKERRQ(ierr);
   ierr = PetscMalloc1(stash->n,&owner);CHKERRQ(ierr);
@@ -376,6 +390,38 @@ PetscErrorCode VecStashScatterGetMesg_Private(VecStash *stash,PetscMPIInt *nvals
   PetscFunctionReturn(0);
 }
 
+/*
+ * Sort the values of a stash with block size 1, removing duplicates (combining as appropriate).
+ */
+static PetscErrorCode VecStashSortCompressValues_Private(PetscInt *n,PetscInt idx[],PetscScalar array[],InsertMode insertmode)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,j;
+
+  PetscFunctionBegin;
+  if (!*n) PetscFunctionReturn(0);
+  ierr = PetscSortIntWithScalarArray(*n,idx,array);CHKERRQ(ierr);
+  for (i=1,j=0; i<*n; i++) {
+    if (idx[i] == idx[j]) {
+      switch (insertmode) {
+      case ADD_VALUES:
+        array[j] += array[i];
+        break;
+      case INSERT_VALUES:
+        array[j] = array[i];
+        break;
+      default: SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Insert mode not supported 0x%x",insertmode);
+      }
+    } else {
+      j++;
+      idx[j]   = idx[i];
+      array[j] = array[i];
+    }
+  }
+  *n = j + 1;
+  PetscFunctionReturn(0);
+}
+
 /*
  * Sort the stash, removing duplicates (combining as appropriate).
  */
@@ -385,27 +431,9 @@ PetscErrorCode VecStashSortCompress_Private(VecStash *stash)
   PetscInt i,j,bs = stash->bs;
 
   PetscFunctionBegin;
-  if (!stash->n) PetscFunctionReturn(0);
+  if (!stash->n || stash->frozen) PetscFunctionReturn(0);
   if (bs == 1) {
-    ierr = PetscSortIntWithScalarArray(stash->n,stash->idx,stash->array);CHKERRQ(ierr);
-    for (i=1,j=0; i<stash->n; i++) {
-      if (stash->idx[i] == stash->idx[j]) {
-        switch (stash->insertmode) {
-        case ADD_VALUES:
-          stash->array[j] += stash->array[i];
-          break;
-        case INSERT_VALUES:
-          stash->array[j] = stash->array[i];
-          break;
-        default: SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Insert mode not supported 0x%x",stash->insertmode);
-        }
-      } else {
-        j++;
-        stash->idx[j]   = stash->idx[i];
-        stash->array[j] = stash->array[i];
-      }
-    }
-    stash->n = j + 1;
+    ierr = VecStashSortCompressValues_Private(&stash->n,stash->idx,stash->array,stash->insertmode);CHKERRQ(ierr);
   } else {                      /* block stash */
     PetscInt *perm = NULL;
     PetscScalar *arr;
@@ -463,3 +491,126 @@ PetscErrorCode VecStashGetOwnerList_Private(VecStash *stash,PetscLayout map,Pets
   ierr = PetscSegBufferDestroy(&seg);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+
+/*
+   VecStashFreeze_Private - Freezes the communication pattern of the stash, subsequent values are
+   stashed directly into one buffer per destination, in the order they are set, so that they can
+   be sent without sorting or copying.
+
+   Input Parameters:
+   stash  - the stash, bs must be 1
+   map    - the layout of the vector
+   ndests - number of destinations
+   dests  - sorted ranks of the destinations
+   counts - number of values sent to each destination in the previous assembly, which is the most the
+            destination can receive, also used to size the buffers
+*/
+PetscErrorCode VecStashFreeze_Private(VecStash *stash,PetscLayout map,PetscMPIInt ndests,const PetscMPIInt dests[],const PetscInt counts[])
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    i;
+
+  PetscFunctionBegin;
+  if (stash->bs != 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Cannot freeze a stash with block size %D",stash->bs);
+  if (stash->n) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Cannot freeze a stash that holds values");
+  ierr = VecStashUnfreeze_Private(stash);CHKERRQ(ierr);
+  ierr = PetscMalloc4(ndests,&stash->dests,ndests,&stash->dn,ndests,&stash->dnmax,ndests,&stash->dlimit);CHKERRQ(ierr);
+  ierr = PetscMalloc2(ndests,&stash->didx,ndests,&stash->darray);CHKERRQ(ierr);
+  for (i=0; i<ndests; i++) {
+    stash->dests[i] = dests[i];
+    stash->dn[i]     = 0;
+    stash->dnmax[i]  = counts[i] + counts[i]/10 + 5;
+    stash->dlimit[i] = counts[i];
+    ierr = PetscMalloc2(stash->dnmax[i],&stash->didx[i],stash->dnmax[i],&stash->darray[i]);CHKERRQ(ierr);
+  }
+  stash->ndests = ndests;
+  stash->dlast  = 0;
+  stash->range  = map->range;
+  stash->frozen = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*
+   VecStashUnfreeze_Private - Frees the per-destination buffers, the stash goes back to collecting
+   values for any process.
+*/
+PetscErrorCode VecStashUnfreeze_Private(VecStash *stash)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    i;
+
+  PetscFunctionBegin;
+  for (i=0; i<stash->ndests; i++) {
+    ierr = PetscFree2(stash->didx[i],stash->darray[i]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(stash->didx,stash->darray);CHKERRQ(ierr);
+  ierr = PetscFree4(stash->dests,stash->dn,stash->dnmax,stash->dlimit);CHKERRQ(ierr);
+  stash->ndests = 0;
+  stash->range  = 0;
+  stash->frozen = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/*
+   VecStashValueFrozen_Private - Appends a value to the buffer of its owner in a frozen stash.
+   The owner must be one of the destinations of the frozen communication pattern.
+*/
+PetscErrorCode VecStashValueFrozen_Private(VecStash *stash,PetscInt row,PetscScalar value)
+{
+  PetscErrorCode ierr;
+  const PetscInt *range = stash->range;
+  PetscMPIInt    d = stash->dlast,lo,hi,mid;
+
+  PetscFunctionBegin;
+  if (!stash->ndests || row < range[stash->dests[d]] || range[stash->dests[d]+1] <= row) {
+    for (lo=0,hi=stash->ndests; hi-lo>1; ) {
+      mid = (lo+hi)/2;
+      if (row < range[stash->dests[mid]]) hi = mid;
+      else lo = mid;
+    }
+    d = lo;
+    if (!stash->ndests || row < range[stash->dests[d]] || range[stash->dests[d]+1] <= row) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Off-process entry %D is not owned by a process that was sent entries in the first assembly, as VEC_SUBSET_OFF_PROC_ENTRIES requires",row);
+    stash->dlast = d;
+  }
+  if (stash->dn[d] == stash->dnmax[d]) {
+    PetscInt    newmax = 2*stash->dnmax[d],*n_idx;
+    PetscScalar *n_array;
+
+    ierr = PetscMalloc2(newmax,&n_idx,newmax,&n_array);CHKERRQ(ierr);
+    ierr = PetscMemcpy(n_idx,stash->didx[d],stash->dn[d]*sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = PetscMemcpy(n_array,stash->darray[d],stash->dn[d]*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = PetscFree2(stash->didx[d],stash->darray[d]);CHKERRQ(ierr);
+    stash->didx[d]   = n_idx;
+    stash->darray[d] = n_array;
+    stash->dnmax[d]  = newmax;
+    stash->reallocs++;
+  }
+  stash->didx[d][stash->dn[d]]   = row;
+  stash->darray[d][stash->dn[d]] = value;
+  stash->dn[d]++;
+  stash->n++;
+  PetscFunctionReturn(0);
+}
+
+/*
+   VecStashGetFrozenValues_Private - Gets the values stashed for a destination of a frozen stash, ready to be sent.
+
+   The buffer is only sorted and compressed when it holds more values than the destination can receive,
+   otherwise the values are sent in the order they were set.
+*/
+PetscErrorCode VecStashGetFrozenValues_Private(VecStash *stash,PetscMPIInt d,PetscInt *n,PetscInt **idx,PetscScalar **array)
+{
+  PetscErrorCode ierr;
+  PetscInt       nold = stash->dn[d];
+
+  PetscFunctionBegin;
+  if (stash->dn[d] > stash->dlimit[d]) {
+    ierr = VecStashSortCompressValues_Private(&stash->dn[d],stash->didx[d],stash->darray[d],stash->insertmode);CHKERRQ(ierr);
+    stash->n -= nold - stash->dn[d];
+    if (stash->dn[d] > stash->dlimit[d]) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"%D distinct off-process entries set for process %d, but only %D were set in the first assembly, as VEC_SUBSET_OFF_PROC_ENTRIES requires",stash->dn[d],(int)stash->dests[d],stash->dlimit[d]);
+  }
+  *n     = stash->dn[d];
+  *idx   = stash->didx[d];
+  *array = stash->darray[d];
+  PetscFunctionReturn(0);
+}
@@ -124,4 +124,22 @@ int main(int argc,char **argv)
       output_file: output/ex2_5.out
       requires:  define(PETSC_HAVE_MPI_WIN_CREATE_FEATURE)
 
+   test:
+      suffix: sf
+      nsize: 2
+      args: -vecscatter_type sf
+      output_file: output/ex2_1.out
+
+   test:
+      suffix: sf_2
+      nsize: 2
+      args: -bs 3 -vecscatter_type sf
+      output_file: output/ex2_2.out
+
+   test:
+      suffix: sf_3
+      nsize: 3
+      args: -vecscatter_type sf
+      output_file: output/ex2_5.out
+
 TEST*/
@@ -85,5 +85,12 @@ int main(int argc,char **argv)
    test:
       nsize: 2
       requires: double
+
+   test:
+      suffix: sf
+      nsize: 2
+      args: -vecscatter_type sf
+      output_file: output/ex6_1.out
+      requires: double
 TEST*/
 
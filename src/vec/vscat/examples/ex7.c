@@ -0,0 +1,113 @@
+static char help[]= "  Test VecScatter with entries of y owned by other processes, repeated creation of identical scatters\n\
+and scatters of several vectors at once\n\n";
+
+#include <petscvec.h>
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,k,n = 4,rstart,nrepeat = 3,nv = 3,*ix,*iy;
+  PetscMPIInt    size,rank,next,prev;
+  PetscScalar    *val;
+  PetscBool      equal;
+  Vec            x,y,z,*xm,*ym;
+  IS             isx,isy;
+  VecScatter     vscat;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nrepeat",&nrepeat,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nv",&nv,NULL);CHKERRQ(ierr);
+  next = (rank+1)%size;
+  prev = (rank+size-1)%size;
+
+  ierr = VecCreateMPI(PETSC_COMM_WORLD,n,PETSC_DECIDE,&x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&z);CHKERRQ(ierr);
+  ierr = VecGetOwnershipRange(x,&rstart,NULL);CHKERRQ(ierr);
+  ierr = VecGetArray(x,&val);CHKERRQ(ierr);
+  for (i=0; i<n; i++) val[i] = rstart + i;
+  ierr = VecRestoreArray(x,&val);CHKERRQ(ierr);
+
+  /* Each process reverses the entries of x owned by the next process into the entries of y owned by the previous one */
+  ierr = PetscMalloc2(n,&ix,n,&iy);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    ix[i] = next*n + n-1-i;
+    iy[i] = prev*n + i;
+  }
+  ierr = ISCreateGeneral(PETSC_COMM_WORLD,n,ix,PETSC_COPY_VALUES,&isx);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PETSC_COMM_WORLD,n,iy,PETSC_COPY_VALUES,&isy);CHKERRQ(ierr);
+
+  for (k=0; k<nrepeat; k++) {
+    ierr = VecScatterCreateWithData(x,isx,y,isy,&vscat);CHKERRQ(ierr);
+    ierr = VecSet(y,-1.0);CHKERRQ(ierr);
+    ierr = VecScatterBegin(vscat,x,y,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    ierr = VecScatterEnd(vscat,x,y,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    ierr = VecCopy(x,z);CHKERRQ(ierr);
+    ierr = VecScatterBegin(vscat,y,z,ADD_VALUES,SCATTER_REVERSE);CHKERRQ(ierr);
+    ierr = VecScatterEnd(vscat,y,z,ADD_VALUES,SCATTER_REVERSE);CHKERRQ(ierr);
+    ierr = VecScatterDestroy(&vscat);CHKERRQ(ierr);
+  }
+  ierr = VecView(y,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+  ierr = VecView(z,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+
+  /* Scatter nv multiples of x together, which must give the multiples of y and z */
+  ierr = VecScatterCreateWithData(x,isx,y,isy,&vscat);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(x,nv,&xm);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(y,nv,&ym);CHKERRQ(ierr);
+  for (k=0; k<nv; k++) {
+    ierr = VecCopy(x,xm[k]);CHKERRQ(ierr);
+    ierr = VecScale(xm[k],(PetscScalar)(k+1));CHKERRQ(ierr);
+    ierr = VecSet(ym[k],-1.0);CHKERRQ(ierr);
+  }
+  ierr = VecScatterBeginMulti(vscat,nv,xm,ym,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecScatterEndMulti(vscat,nv,xm,ym,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecScatterBeginMulti(vscat,nv,ym,xm,ADD_VALUES,SCATTER_REVERSE);CHKERRQ(ierr);
+  ierr = VecScatterEndMulti(vscat,nv,ym,xm,ADD_VALUES,SCATTER_REVERSE);CHKERRQ(ierr);
+  for (k=0; k<nv; k++) {
+    ierr = VecScale(ym[k],1.0/(k+1));CHKERRQ(ierr);
+    ierr = VecScale(xm[k],1.0/(k+1));CHKERRQ(ierr);
+    ierr = VecEqual(ym[k],y,&equal);CHKERRQ(ierr);
+    if (!equal) SETERRQ1(PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Forward scatter of vector %D differs",k);
+    ierr = VecEqual(xm[k],z,&equal);CHKERRQ(ierr);
+    if (!equal) SETERRQ1(PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Reverse scatter of vector %D differs",k);
+  }
+  ierr = VecDestroyVecs(nv,&xm);CHKERRQ(ierr);
+  ierr = VecDestroyVecs(nv,&ym);CHKERRQ(ierr);
+  ierr = VecScatterDestroy(&vscat);CHKERRQ(ierr);
+
+  ierr = ISDestroy(&isx);CHKERRQ(ierr);
+  ierr = ISDestroy(&isy);CHKERRQ(ierr);
+  ierr = PetscFree2(ix,iy);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      nsize: 3
+
+   test:
+      suffix: sf
+      nsize: 3
+      args: -vecscatter_type sf
+      output_file: output/ex7_1.out
+
+   test:
+      suffix: sf_nocache
+      nsize: 3
+      args: -vecscatter_type sf -vecscatter_sf_cache_size 0
+      output_file: output/ex7_1.out
+
+   test:
+      suffix: sf_reuse
+      nsize: 3
+      args: -vecscatter_type sf -info
+      filter: grep -c "Reusing the PetscSF"
+
+TEST*/
@@ -127,6 +127,8 @@ PetscErrorCode VecScatterDestroy_PtoP_MPI1(VecScatter ctx)
   ierr = PetscFree4(to->values,to->indices,to->starts,to->procs);CHKERRQ(ierr);
   ierr = PetscFree2(to->sstatus,to->rstatus);CHKERRQ(ierr);
   ierr = PetscFree4(from->values,from->indices,from->starts,from->procs);CHKERRQ(ierr);
+  ierr = PetscFree2(to->multivalues,to->multirequests);CHKERRQ(ierr);
+  ierr = PetscFree2(from->multivalues,from->multirequests);CHKERRQ(ierr);
   ierr = VecScatterMemcpyPlanDestroy_PtoP(to,from);CHKERRQ(ierr);
   ierr = PetscFree(from);CHKERRQ(ierr);
   ierr = PetscFree(to);CHKERRQ(ierr);
@@ -148,6 +150,8 @@ PetscErrorCode VecScatterCopy_PtoP_X_MPI1(VecScatter in,VecScatter out)
   out->ops->copy    = in->ops->copy;
   out->ops->destroy = in->ops->destroy;
   out->ops->view    = in->ops->view;
+  out->ops->beginmulti = in->ops->beginmulti;
+  out->ops->endmulti   = in->ops->endmulti;
 
   /* allocate entire send scatter context */
   ierr = PetscNewLog(out,&out_to);CHKERRQ(ierr);
@@ -251,6 +255,8 @@ PetscErrorCode VecScatterCopy_PtoP_AllToAll_MPI1(VecScatter in,VecScatter out)
   out->ops->copy      = in->ops->copy;
   out->ops->destroy   = in->ops->destroy;
   out->ops->view      = in->ops->view;
+  out->ops->beginmulti = in->ops->beginmulti;
+  out->ops->endmulti   = in->ops->endmulti;
 
   /* allocate entire send scatter context */
   ierr = PetscNewLog(out,&out_to);CHKERRQ(ierr);
@@ -1991,6 +1997,131 @@ PETSC_STATIC_INLINE PetscErrorCode Scatter_MPI1_bs(PetscInt n,const PetscInt *in
 #define BS bs
 #include <../src/vec/vscat/impls/mpi1/vpscat_mpi1.h>
 
+/* ==========================================================================================*/
+/*
+   Scatters of several vectors at once: the message to each process holds the values of the first vector,
+   then those of the second one, and so on. Nonpersistent requests are used since the buffers depend on the
+   number of vectors.
+*/
+static PetscErrorCode VecScatterMultiSetUp_MPI1(VecScatter ctx,VecScatter_MPI_General *gen,PetscInt nv)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (gen->multin >= nv) PetscFunctionReturn(0);
+  ierr = PetscFree2(gen->multivalues,gen->multirequests);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nv*gen->bs*gen->starts[gen->n],&gen->multivalues,gen->n,&gen->multirequests);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)ctx,(nv-gen->multin)*gen->bs*gen->starts[gen->n]*sizeof(PetscScalar));CHKERRQ(ierr);
+  gen->multin = nv;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecScatterBeginMulti_MPI1(VecScatter ctx,PetscInt nv,Vec *xin,Vec *yin,InsertMode addv,ScatterMode mode)
+{
+  VecScatter_MPI_General *to,*from;
+  MPI_Comm               comm;
+  PetscMPIInt            tag = ((PetscObject)ctx)->tag;
+  PetscScalar            *xv,*yv,*svalues;
+  PetscErrorCode         ierr;
+  PetscInt               i,j,bs,count;
+
+  PetscFunctionBegin;
+  if (mode & SCATTER_REVERSE) {
+    to   = (VecScatter_MPI_General*)ctx->fromdata;
+    from = (VecScatter_MPI_General*)ctx->todata;
+  } else {
+    to   = (VecScatter_MPI_General*)ctx->todata;
+    from = (VecScatter_MPI_General*)ctx->fromdata;
+  }
+  bs   = to->bs;
+  ierr = PetscObjectGetComm((PetscObject)ctx,&comm);CHKERRQ(ierr);
+
+  if (!(mode & SCATTER_LOCAL)) {
+    ierr = VecScatterMultiSetUp_MPI1(ctx,to,nv);CHKERRQ(ierr);
+    ierr = VecScatterMultiSetUp_MPI1(ctx,from,nv);CHKERRQ(ierr);
+    for (i=0; i<from->n; i++) {
+      count = bs*(from->starts[i+1]-from->starts[i]);
+      ierr  = MPI_Irecv(from->multivalues+nv*bs*from->starts[i],nv*count,MPIU_SCALAR,from->procs[i],tag,comm,from->multirequests+i);CHKERRQ(ierr);
+    }
+  }
+
+  for (j=0; j<nv; j++) {
+    ierr = VecGetArrayRead(xin[j],(const PetscScalar**)&xv);CHKERRQ(ierr);
+    if (!(mode & SCATTER_LOCAL)) {
+      for (i=0; i<to->n; i++) {
+        count   = bs*(to->starts[i+1]-to->starts[i]);
+        svalues = to->multivalues + nv*bs*to->starts[i] + j*count;
+        if (to->memcpy_plan.optimized[i]) {
+          ierr = VecScatterMemcpyPlanExecute_Pack(i,xv,&to->memcpy_plan,svalues,INSERT_VALUES,bs);CHKERRQ(ierr);
+        } else {
+          Pack_MPI1_bs(to->starts[i+1]-to->starts[i],to->indices+to->starts[i],xv,svalues,bs);
+        }
+      }
+    }
+    if (to->local.n) {
+      if (xin[j] != yin[j]) {ierr = VecGetArray(yin[j],&yv);CHKERRQ(ierr);}
+      else yv = xv;
+      if (to->local.memcpy_plan.optimized[0]) {
+        if (!(xv == yv && addv == INSERT_VALUES && to->local.memcpy_plan.same_copy_starts)) {
+          ierr = VecScatterMemcpyPlanExecute_Scatter(0,xv,&to->local.memcpy_plan,yv,&from->local.memcpy_plan,addv);CHKERRQ(ierr);
+        }
+      } else if (xv == yv && addv == INSERT_VALUES && to->local.nonmatching_computed) {
+        ierr = Scatter_MPI1_bs(to->local.n_nonmatching,to->local.slots_nonmatching,xv,from->local.slots_nonmatching,yv,addv,bs);CHKERRQ(ierr);
+      } else {
+        ierr = Scatter_MPI1_bs(to->local.n,to->local.vslots,xv,from->local.vslots,yv,addv,bs);CHKERRQ(ierr);
+      }
+      if (xin[j] != yin[j]) {ierr = VecRestoreArray(yin[j],&yv);CHKERRQ(ierr);}
+    }
+    ierr = VecRestoreArrayRead(xin[j],(const PetscScalar**)&xv);CHKERRQ(ierr);
+  }
+
+  if (!(mode & SCATTER_LOCAL)) {
+    for (i=0; i<to->n; i++) {
+      count = bs*(to->starts[i+1]-to->starts[i]);
+      ierr  = MPI_Isend(to->multivalues+nv*bs*to->starts[i],nv*count,MPIU_SCALAR,to->procs[i],tag,comm,to->multirequests+i);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecScatterEndMulti_MPI1(VecScatter ctx,PetscInt nv,Vec *xin,Vec *yin,InsertMode addv,ScatterMode mode)
+{
+  VecScatter_MPI_General *to,*from;
+  PetscScalar            **yv,*rvalues;
+  PetscErrorCode         ierr;
+  PetscInt               i,j,bs,n,count;
+  PetscMPIInt            imdex;
+
+  PetscFunctionBegin;
+  if (mode & SCATTER_LOCAL) PetscFunctionReturn(0);
+  if (mode & SCATTER_REVERSE) {
+    to   = (VecScatter_MPI_General*)ctx->fromdata;
+    from = (VecScatter_MPI_General*)ctx->todata;
+  } else {
+    to   = (VecScatter_MPI_General*)ctx->todata;
+    from = (VecScatter_MPI_General*)ctx->fromdata;
+  }
+  bs   = from->bs;
+  ierr = PetscMalloc1(nv,&yv);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {ierr = VecGetArray(yin[j],&yv[j]);CHKERRQ(ierr);}
+  for (n=from->n; n; n--) {
+    ierr  = MPI_Waitany(from->n,from->multirequests,&imdex,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+    count = bs*(from->starts[imdex+1]-from->starts[imdex]);
+    for (j=0; j<nv; j++) {
+      rvalues = from->multivalues + nv*bs*from->starts[imdex] + j*count;
+      if (from->memcpy_plan.optimized[imdex]) {
+        ierr = VecScatterMemcpyPlanExecute_Unpack(imdex,rvalues,yv[j],&from->memcpy_plan,addv,bs);CHKERRQ(ierr);
+      } else {
+        ierr = UnPack_MPI1_bs(from->starts[imdex+1]-from->starts[imdex],rvalues,from->indices+from->starts[imdex],yv[j],addv,bs);CHKERRQ(ierr);
+      }
+    }
+  }
+  for (j=0; j<nv; j++) {ierr = VecRestoreArray(yin[j],&yv[j]);CHKERRQ(ierr);}
+  ierr = PetscFree(yv);CHKERRQ(ierr);
+  for (i=0; i<to->n; i++) {ierr = MPI_Wait(to->multirequests+i,MPI_STATUS_IGNORE);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
 /* ==========================================================================================*/
 
 /*              create parallel to sequential scatter context                           */
@@ -2323,7 +2454,9 @@ PetscErrorCode VecScatterCreateCommon_PtoS_MPI1(VecScatter_MPI_General *from,Vec
     ctx->ops->end   = VecScatterEndMPI1_bs;
 
   }
-  ctx->ops->view = VecScatterView_MPI_MPI1;
+  ctx->ops->beginmulti = VecScatterBeginMulti_MPI1;
+  ctx->ops->endmulti   = VecScatterEndMulti_MPI1;
+  ctx->ops->view       = VecScatterView_MPI_MPI1;
   /* try to optimize PtoP vecscatter with memcpy's */
   ierr = VecScatterMemcpyPlanCreate_PtoP(to,from);CHKERRQ(ierr);
   PetscFunctionReturn(0);
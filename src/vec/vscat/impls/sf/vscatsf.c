@@ -0,0 +1,568 @@
+/*
+   Vector scatter implemented with a star forest: the roots are the entries of x and the leaves are the entries of y
+   that receive them. Since identical scatters are created over and over (adaptive loops, PCASM and PCGASM setup),
+   the star forests are cached per communicator and reused when the layouts and index sets match. A cached entry
+   keeps its star forest and a copy of the index sets after the scatters using it are destroyed, until newer scatters
+   on the same communicator evict it or PetscFinalize() is called, so the cache holds few entries.
+*/
+#include <petsc/private/vecscatterimpl.h>    /*I   "petscvec.h"    I*/
+#include <petsc/private/hashtable.h>
+#include <petscsf.h>
+
+typedef struct {
+  VECSCATTER_IMPL_HEADER
+  PetscSF     sf;       /* Roots are the local entries of x, leaves are the entries of y scattered on this process */
+  PetscInt    n;        /* Number of leaves */
+  PetscInt    *slots;   /* Local index in y of each leaf */
+  PetscInt    contig;   /* slots[] is contig,contig+1,..., or -1 */
+  PetscScalar *buf;     /* Leaf values when they cannot be accessed in place in y */
+  PetscInt    nself;    /* Number of leaves whose root is on this process, used by SCATTER_LOCAL */
+  PetscInt    *selfroots,*selfslots; /* Local index in x of their roots and local index in y of the leaves */
+} VecScatter_SF;
+
+/* Star forest of a previous scatter, with the data identifying it */
+typedef struct _n_VecScatterSFCacheEntry *VecScatterSFCacheEntry;
+struct _n_VecScatterSFCacheEntry {
+  MPI_Comm               comm;      /* Communicator of the scatter, kept valid by the reference held by sf */
+  PetscInt               id;        /* Creation number on comm, identical on all processes */
+  PetscInt               layout[6]; /* Ownership start, local size and global size (-1 if sequential) of x and y */
+  PetscHash_t            hash;      /* Hash of layout, ix and iy */
+  PetscInt               n;         /* Local size of ix and iy */
+  PetscInt               *ix,*iy;
+  PetscSF                sf;
+  PetscInt               nleaves;
+  PetscInt               *slots;
+  VecScatterSFCacheEntry next;
+};
+
+static VecScatterSFCacheEntry VecScatterSFCache = NULL; /* Newest entry first */
+
+static PetscErrorCode VecScatterSFCacheEntryDestroy_Private(VecScatterSFCacheEntry *entry)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFDestroy(&(*entry)->sf);CHKERRQ(ierr);
+  ierr = PetscFree3((*entry)->ix,(*entry)->iy,(*entry)->slots);CHKERRQ(ierr);
+  ierr = PetscFree(*entry);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   VecScatterSFCacheDestroy - Frees the star forests kept for reuse by VECSCATTERSF, called from VecScatterFinalizePackage()
+*/
+PetscErrorCode VecScatterSFCacheDestroy(void)
+{
+  PetscErrorCode         ierr;
+  VecScatterSFCacheEntry entry,next;
+
+  PetscFunctionBegin;
+  for (entry=VecScatterSFCache; entry; entry=next) {
+    next = entry->next;
+    ierr = VecScatterSFCacheEntryDestroy_Private(&entry);CHKERRQ(ierr);
+  }
+  VecScatterSFCache = NULL;
+  PetscFunctionReturn(0);
+}
+
+/* Finds an entry created on comm for the same local data, the caller must check that all processes found the same one */
+static PetscErrorCode VecScatterSFCacheFind_Private(MPI_Comm comm,const PetscInt layout[],PetscHash_t hash,PetscInt n,const PetscInt ix[],const PetscInt iy[],VecScatterSFCacheEntry *found)
+{
+  PetscErrorCode         ierr;
+  VecScatterSFCacheEntry entry;
+  PetscBool              same;
+
+  PetscFunctionBegin;
+  *found = NULL;
+  for (entry=VecScatterSFCache; entry; entry=entry->next) {
+    if (entry->comm != comm || entry->hash != hash || entry->n != n) continue;
+    ierr = PetscMemcmp(entry->layout,layout,sizeof(entry->layout),&same);CHKERRQ(ierr);
+    if (!same) continue;
+    ierr = PetscMemcmp(entry->ix,ix,n*sizeof(PetscInt),&same);CHKERRQ(ierr);
+    if (!same) continue;
+    ierr = PetscMemcmp(entry->iy,iy,n*sizeof(PetscInt),&same);CHKERRQ(ierr);
+    if (!same) continue;
+    *found = entry;
+    break;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Adds a new entry for comm, evicting the oldest one of comm beyond maxentries. Collective, so the ids and evictions agree on all processes. */
+static PetscErrorCode VecScatterSFCacheInsert_Private(MPI_Comm comm,PetscInt maxentries,const PetscInt layout[],PetscHash_t hash,PetscInt n,const PetscInt ix[],const PetscInt iy[],PetscSF sf,PetscInt nleaves,const PetscInt slots[])
+{
+  PetscErrorCode         ierr;
+  VecScatterSFCacheEntry entry,*link,*oldest = NULL;
+  PetscInt               nentries = 0,id = 0;
+
+  PetscFunctionBegin;
+  for (link=&VecScatterSFCache; *link; link=&(*link)->next) {
+    if ((*link)->comm != comm) continue;
+    if (!nentries) id = (*link)->id + 1;
+    nentries++;
+    oldest = link;
+  }
+  if (nentries >= maxentries) {
+    entry   = *oldest;
+    *oldest = entry->next;
+    ierr    = VecScatterSFCacheEntryDestroy_Private(&entry);CHKERRQ(ierr);
+  }
+  ierr = PetscNew(&entry);CHKERRQ(ierr);
+  entry->comm = comm;
+  entry->id   = id;
+  ierr = PetscMemcpy(entry->layout,layout,sizeof(entry->layout));CHKERRQ(ierr);
+  entry->hash = hash;
+  entry->n    = n;
+  ierr = PetscMalloc3(n,&entry->ix,n,&entry->iy,nleaves,&entry->slots);CHKERRQ(ierr);
+  ierr = PetscMemcpy(entry->ix,ix,n*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscMemcpy(entry->iy,iy,n*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscMemcpy(entry->slots,slots,nleaves*sizeof(PetscInt));CHKERRQ(ierr);
+  entry->nleaves = nleaves;
+  ierr = PetscObjectReference((PetscObject)sf);CHKERRQ(ierr);
+  entry->sf   = sf;
+  entry->next = VecScatterSFCache;
+  VecScatterSFCache = entry;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Builds the star forest of y[iy[i]] = x[ix[i]]. Pairs whose iy entry is owned by another process are sent to
+   that process first, since a leaf must live where its entry of y is stored. xranks[] maps the ranks of the
+   communicator of x to those of the scatter, NULL if they are the same.
+*/
+static PetscErrorCode VecScatterSFBuild_Private(VecScatter ctx,PetscBool xseq,PetscBool yseq,const PetscMPIInt xranks[],PetscBool migrate,PetscInt n,const PetscInt ix[],const PetscInt iy[],PetscSF *newsf,PetscInt *nleaves,PetscInt **slots)
+{
+  PetscErrorCode ierr;
+  MPI_Comm       comm = PetscObjectComm((PetscObject)ctx);
+  Vec            x = ctx->from_v,y = ctx->to_v;
+  PetscLayout    xmap = x->map,ymap = y->map;
+  PetscMPIInt    rank,size,tag,nto = 0,nfrom = 0,*toranks = NULL,*tocounts = NULL,*fromranks = NULL,*fromcounts = NULL;
+  PetscInt       i,j,k,nlocal = 0,nrecv = 0,*owner = NULL,*sendbuf = NULL,*recvbuf = NULL,*offset = NULL;
+  PetscSFNode    *remote;
+  MPI_Request    *reqs = NULL;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  if (migrate) {
+    /* Owner of each entry of iy, -1 if it is mine */
+    ierr = PetscMalloc1(n,&owner);CHKERRQ(ierr);
+    ierr = PetscCalloc2(size,&tocounts,size+1,&offset);CHKERRQ(ierr);
+    for (i=0; i<n; i++) {
+      if (iy[i] >= ymap->rstart && iy[i] < ymap->rend) {owner[i] = -1; continue;}
+      if (iy[i] < 0 || iy[i] >= ymap->N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Scatter index %D is out of range for vector of size %D",iy[i],ymap->N);
+      ierr = PetscLayoutFindOwner(ymap,iy[i],&owner[i]);CHKERRQ(ierr);
+      tocounts[owner[i]]++;
+    }
+    ierr = PetscMalloc1(size,&toranks);CHKERRQ(ierr);
+    for (j=0; j<size; j++) {
+      offset[j+1] = offset[j] + tocounts[j];
+      if (tocounts[j]) {toranks[nto] = j; tocounts[nto++] = tocounts[j];}
+    }
+    /* Each pair travels as the rank and index of its root followed by the global index in y */
+    ierr = PetscMalloc1(3*offset[size],&sendbuf);CHKERRQ(ierr);
+    for (i=0; i<n; i++) {
+      PetscInt rrank,rindex;
+      if (owner[i] < 0) {nlocal++; continue;}
+      if (xseq) {rrank = rank; rindex = ix[i];}
+      else {
+        ierr = PetscLayoutFindOwnerIndex(xmap,ix[i],&rrank,&rindex);CHKERRQ(ierr);
+        if (xranks) rrank = xranks[rrank];
+      }
+      k = 3*offset[owner[i]]++;
+      sendbuf[k] = rrank; sendbuf[k+1] = rindex; sendbuf[k+2] = iy[i];
+    }
+    ierr = PetscCommBuildTwoSided(comm,1,MPI_INT,nto,toranks,tocounts,&nfrom,&fromranks,&fromcounts);CHKERRQ(ierr);
+    /* Receive in rank order so the leaves do not depend on message arrival */
+    ierr = PetscSortMPIIntWithArray(nfrom,fromranks,fromcounts);CHKERRQ(ierr);
+    for (j=0; j<nfrom; j++) nrecv += fromcounts[j];
+    ierr = PetscMalloc2(3*nrecv,&recvbuf,nto+nfrom,&reqs);CHKERRQ(ierr);
+    ierr = PetscObjectGetNewTag((PetscObject)ctx,&tag);CHKERRQ(ierr);
+    for (j=0,k=0; j<nfrom; k+=3*fromcounts[j],j++) {
+      ierr = MPI_Irecv(recvbuf+k,3*fromcounts[j],MPIU_INT,fromranks[j],tag,comm,&reqs[j]);CHKERRQ(ierr);
+    }
+    for (j=0,k=0; j<nto; k+=3*tocounts[j],j++) {
+      ierr = MPI_Isend(sendbuf+k,3*tocounts[j],MPIU_INT,toranks[j],tag,comm,&reqs[nfrom+j]);CHKERRQ(ierr);
+    }
+  } else nlocal = n;
+
+  *nleaves = nlocal + nrecv;
+  ierr = PetscMalloc1(*nleaves,&remote);CHKERRQ(ierr);
+  ierr = PetscMalloc1(*nleaves,slots);CHKERRQ(ierr);
+  for (i=0,k=0; i<n; i++) {
+    if (owner && owner[i] >= 0) continue;
+    if (xseq) {
+      if (ix[i] < 0 || ix[i] >= xmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Scatter index %D is out of range for vector of local size %D",ix[i],xmap->n);
+      remote[k].rank  = rank;
+      remote[k].index = ix[i];
+    } else {
+      PetscInt rrank;
+      if (ix[i] < 0 || ix[i] >= xmap->N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Scatter index %D is out of range for vector of size %D",ix[i],xmap->N);
+      ierr = PetscLayoutFindOwnerIndex(xmap,ix[i],&rrank,&remote[k].index);CHKERRQ(ierr);
+      remote[k].rank = xranks ? xranks[rrank] : rrank;
+    }
+    (*slots)[k] = yseq ? iy[i] : iy[i] - ymap->rstart;
+    if ((*slots)[k] < 0 || (*slots)[k] >= ymap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Scatter index %D is out of range for vector of local size %D",iy[i],ymap->n);
+    k++;
+  }
+  if (migrate) {
+    ierr = MPI_Waitall(nto+nfrom,reqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+    for (i=0; i<nrecv; i++,k++) {
+      remote[k].rank  = recvbuf[3*i];
+      remote[k].index = recvbuf[3*i+1];
+      (*slots)[k]     = recvbuf[3*i+2] - ymap->rstart;
+    }
+    ierr = PetscFree(owner);CHKERRQ(ierr);
+    ierr = PetscFree2(tocounts,offset);CHKERRQ(ierr);
+    ierr = PetscFree(toranks);CHKERRQ(ierr);
+    ierr = PetscFree(sendbuf);CHKERRQ(ierr);
+    ierr = PetscFree(fromranks);CHKERRQ(ierr);
+    ierr = PetscFree(fromcounts);CHKERRQ(ierr);
+    ierr = PetscFree2(recvbuf,reqs);CHKERRQ(ierr);
+  }
+
+  ierr = PetscSFCreate(comm,newsf);CHKERRQ(ierr);
+  ierr = PetscSFSetFromOptions(*newsf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(*newsf,xmap->n,*nleaves,NULL,PETSC_OWN_POINTER,remote,PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(*newsf);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecScatterSFGetOp_Private(InsertMode addv,MPI_Op *op)
+{
+  PetscFunctionBegin;
+  switch (addv) {
+  case INSERT_VALUES:
+  case INSERT_ALL_VALUES:
+    *op = MPIU_REPLACE; break;
+  case ADD_VALUES:
+  case ADD_ALL_VALUES:
+    *op = MPIU_SUM; break;
+#if !defined(PETSC_USE_COMPLEX)
+  case MAX_VALUES:
+    *op = MPIU_MAX; break;
+#endif
+  default: SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Insert mode %d is not supported by this scatter type",(int)addv);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Scatters dst[dstidx[i]] op= src[srcidx[i]], used for the leaves whose root is on this process */
+static PetscErrorCode VecScatterSFLocal_Private(PetscInt n,const PetscScalar *src,const PetscInt srcidx[],PetscScalar *dst,const PetscInt dstidx[],MPI_Op op)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  if (op == MPIU_REPLACE) {
+    for (i=0; i<n; i++) dst[dstidx[i]] = src[srcidx[i]];
+  } else if (op == MPIU_SUM) {
+    for (i=0; i<n; i++) dst[dstidx[i]] += src[srcidx[i]];
+  }
+#if !defined(PETSC_USE_COMPLEX)
+  else {
+    for (i=0; i<n; i++) dst[dstidx[i]] = PetscMax(dst[dstidx[i]],src[srcidx[i]]);
+  }
+#endif
+  PetscFunctionReturn(0);
+}
+
+/* Forward scatters unpack in place when the leaves are a contiguous piece of y that is overwritten */
+PETSC_STATIC_INLINE PetscScalar *VecScatterSFForwardLeafData(VecScatter_SF *data,PetscScalar *yarray,InsertMode addv)
+{
+  return ((addv == INSERT_VALUES || addv == INSERT_ALL_VALUES) && data->contig >= 0) ? yarray + data->contig : data->buf;
+}
+
+static PetscErrorCode VecScatterBegin_SF(VecScatter ctx,Vec x,Vec y,InsertMode addv,ScatterMode mode)
+{
+  VecScatter_SF  *data = (VecScatter_SF*)ctx->todata;
+  PetscErrorCode ierr;
+  PetscScalar    *xarray,*yarray;
+  PetscInt       i;
+  MPI_Op         op;
+
+  PetscFunctionBegin;
+  ierr = VecScatterSFGetOp_Private(addv,&op);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(x,y,&xarray,&yarray);CHKERRQ(ierr);
+  if (mode & SCATTER_LOCAL) {
+    /* Only the pairs within this process are scattered, without communication, as MPI1 does */
+    if (mode & SCATTER_REVERSE) {
+      ierr = VecScatterSFLocal_Private(data->nself,xarray,data->selfslots,yarray,data->selfroots,op);CHKERRQ(ierr);
+    } else {
+      ierr = VecScatterSFLocal_Private(data->nself,xarray,data->selfroots,yarray,data->selfslots,op);CHKERRQ(ierr);
+    }
+  } else if (mode & SCATTER_REVERSE) {
+    /* x has the layout of the leaves and y the layout of the roots */
+    PetscScalar *leafdata = xarray + data->contig;
+    if (data->contig < 0) {
+      for (i=0; i<data->n; i++) data->buf[i] = xarray[data->slots[i]];
+      leafdata = data->buf;
+    }
+    ierr = PetscSFReduceBegin(data->sf,MPIU_SCALAR,leafdata,yarray,op);CHKERRQ(ierr);
+  } else {
+    ierr = PetscSFBcastBegin(data->sf,MPIU_SCALAR,xarray,VecScatterSFForwardLeafData(data,yarray,addv));CHKERRQ(ierr);
+  }
+  ierr = VecRestoreArrayPair(x,y,&xarray,&yarray);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecScatterEnd_SF(VecScatter ctx,Vec x,Vec y,InsertMode addv,ScatterMode mode)
+{
+  VecScatter_SF  *data = (VecScatter_SF*)ctx->todata;
+  PetscErrorCode ierr;
+  PetscScalar    *xarray,*yarray,*leafdata;
+  PetscInt       i;
+  MPI_Op         op;
+
+  PetscFunctionBegin;
+  if (mode & SCATTER_LOCAL) PetscFunctionReturn(0);
+  ierr = VecScatterSFGetOp_Private(addv,&op);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(x,y,&xarray,&yarray);CHKERRQ(ierr);
+  if (mode & SCATTER_REVERSE) {
+    leafdata = data->contig < 0 ? data->buf : xarray + data->contig;
+    ierr = PetscSFReduceEnd(data->sf,MPIU_SCALAR,leafdata,yarray,op);CHKERRQ(ierr);
+  } else {
+    leafdata = VecScatterSFForwardLeafData(data,yarray,addv);
+    ierr = PetscSFBcastEnd(data->sf,MPIU_SCALAR,xarray,leafdata);CHKERRQ(ierr);
+    if (leafdata == data->buf) {
+      if (op == MPIU_REPLACE) {
+        for (i=0; i<data->n; i++) yarray[data->slots[i]] = data->buf[i];
+      } else if (op == MPIU_SUM) {
+        for (i=0; i<data->n; i++) yarray[data->slots[i]] += data->buf[i];
+      }
+#if !defined(PETSC_USE_COMPLEX)
+      else {
+        for (i=0; i<data->n; i++) yarray[data->slots[i]] = PetscMax(yarray[data->slots[i]],data->buf[i]);
+      }
+#endif
+    }
+  }
+  ierr = VecRestoreArrayPair(x,y,&xarray,&yarray);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecScatterSFDataDestroy_Private(VecScatter_SF **data)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFDestroy(&(*data)->sf);CHKERRQ(ierr);
+  ierr = PetscFree2((*data)->slots,(*data)->buf);CHKERRQ(ierr);
+  ierr = PetscFree2((*data)->selfroots,(*data)->selfslots);CHKERRQ(ierr);
+  ierr = PetscFree(*data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecScatterDestroy_SF(VecScatter ctx)
+{
+  VecScatter_SF  *data = (VecScatter_SF*)ctx->todata;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecScatterSFDataDestroy_Private(&data);CHKERRQ(ierr);
+  ctx->todata   = NULL;
+  ctx->fromdata = NULL;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecScatterView_SF(VecScatter ctx,PetscViewer viewer)
+{
+  VecScatter_SF  *data = (VecScatter_SF*)ctx->todata;
+  PetscErrorCode ierr;
+  PetscBool      isascii;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii);CHKERRQ(ierr);
+  if (isascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"VecScatter based on a PetscSF\n");CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
+    ierr = PetscSFView(data->sf,viewer);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecScatterCopy_SF(VecScatter,VecScatter);
+
+/* Takes a reference to sf, copies slots and extracts the leaves whose root is on this process */
+static PetscErrorCode VecScatterSFSetData_Private(VecScatter ctx,PetscSF sf,PetscInt n,const PetscInt slots[])
+{
+  VecScatter_SF     *data;
+  PetscErrorCode    ierr;
+  PetscInt          i,k;
+  PetscMPIInt       rank;
+  const PetscSFNode *remote;
+
+  PetscFunctionBegin;
+  ierr = PetscNewLog(ctx,&data);CHKERRQ(ierr);
+  data->format = VEC_SCATTER_SF;
+  ierr = PetscObjectReference((PetscObject)sf);CHKERRQ(ierr);
+  data->sf     = sf;
+  data->n      = n;
+  ierr = PetscMalloc2(n,&data->slots,n,&data->buf);CHKERRQ(ierr);
+  ierr = PetscMemcpy(data->slots,slots,n*sizeof(PetscInt));CHKERRQ(ierr);
+  data->contig = n ? slots[0] : 0;
+  for (i=1; i<n; i++) {
+    if (slots[i] != slots[0]+i) {data->contig = -1; break;}
+  }
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)ctx),&rank);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sf,NULL,NULL,NULL,&remote);CHKERRQ(ierr);
+  for (i=0; i<n; i++) if (remote[i].rank == rank) data->nself++;
+  ierr = PetscMalloc2(data->nself,&data->selfroots,data->nself,&data->selfslots);CHKERRQ(ierr);
+  for (i=0,k=0; i<n; i++) {
+    if (remote[i].rank != rank) continue;
+    data->selfroots[k] = remote[i].index;
+    data->selfslots[k] = slots[i];
+    k++;
+  }
+  ctx->todata        = data;
+  ctx->fromdata      = data;
+  ctx->ops->begin    = VecScatterBegin_SF;
+  ctx->ops->end      = VecScatterEnd_SF;
+  ctx->ops->destroy  = VecScatterDestroy_SF;
+  ctx->ops->copy     = VecScatterCopy_SF;
+  ctx->ops->view     = VecScatterView_SF;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecScatterCopy_SF(VecScatter in,VecScatter out)
+{
+  VecScatter_SF  *data = (VecScatter_SF*)in->todata;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecScatterSFSetData_Private(out,data->sf,data->n,data->slots);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   VecScatterRemap_SF - Remaps the roots with tomap, called from VecScatterRemap(). Each leaf gets the new index
+   of its root from the process owning it, and the scatter gets a new star forest since its own may be shared.
+*/
+PetscErrorCode VecScatterRemap_SF(VecScatter ctx,const PetscInt tomap[],const PetscInt frommap[])
+{
+  VecScatter_SF     *data = (VecScatter_SF*)ctx->todata;
+  PetscErrorCode    ierr;
+  PetscInt          i,nroots,nleaves,newnroots = 0,*newindex;
+  const PetscSFNode *remote;
+  PetscSFNode       *newremote;
+  PetscSF           newsf;
+
+  PetscFunctionBegin;
+  if (frommap) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Unable to remap the FROM in scatters yet");
+  if (!tomap) PetscFunctionReturn(0);
+  ierr = PetscSFGetGraph(data->sf,&nroots,&nleaves,NULL,&remote);CHKERRQ(ierr);
+  for (i=0; i<nroots; i++) newnroots = PetscMax(newnroots,tomap[i]+1);
+  ierr = PetscMalloc1(nleaves,&newindex);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(data->sf,MPIU_INT,tomap,newindex);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(data->sf,MPIU_INT,tomap,newindex);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nleaves,&newremote);CHKERRQ(ierr);
+  for (i=0; i<nleaves; i++) {
+    newremote[i].rank  = remote[i].rank;
+    newremote[i].index = newindex[i];
+  }
+  ierr = PetscFree(newindex);CHKERRQ(ierr);
+  ierr = PetscSFCreate(PetscObjectComm((PetscObject)ctx),&newsf);CHKERRQ(ierr);
+  ierr = PetscSFSetFromOptions(newsf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(newsf,newnroots,nleaves,NULL,PETSC_OWN_POINTER,newremote,PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(newsf);CHKERRQ(ierr);
+  ierr = VecScatterSFSetData_Private(ctx,newsf,data->n,data->slots);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&newsf);CHKERRQ(ierr);
+  ierr = VecScatterSFDataDestroy_Private(&data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecScatterSetUp_SF(VecScatter ctx)
+{
+  PetscErrorCode         ierr;
+  MPI_Comm               comm = PetscObjectComm((PetscObject)ctx);
+  Vec                    x = ctx->from_v,y = ctx->to_v;
+  IS                     ix,iy,tix = NULL,tiy = NULL;
+  PetscMPIInt            xsize,ysize,result,*xranks = NULL;
+  PetscBool              xseq,yseq;
+  PetscInt               i,n,ny,layout[6],maxentries = 4,red[3],nleaves = 0,*slots = NULL;
+  const PetscInt         *xidx,*yidx;
+  PetscHash_t            hash = 0;
+  VecScatterSFCacheEntry entry = NULL;
+  PetscSF                sf;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)x),&xsize);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)y),&ysize);CHKERRQ(ierr);
+  xseq = xsize == 1 ? PETSC_TRUE : PETSC_FALSE;
+  yseq = ysize == 1 ? PETSC_TRUE : PETSC_FALSE;
+  ierr = GetInputISType_private(ctx,xseq ? VEC_SEQ_ID : VEC_MPI_ID,yseq ? VEC_SEQ_ID : VEC_MPI_ID,NULL,&tix,NULL,&tiy);CHKERRQ(ierr);
+  ix   = ctx->from_is ? ctx->from_is : tix;
+  iy   = ctx->to_is ? ctx->to_is : tiy;
+  ierr = ISGetLocalSize(ix,&n);CHKERRQ(ierr);
+  ierr = ISGetLocalSize(iy,&ny);CHKERRQ(ierr);
+  if (n != ny) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Local scatter sizes don't match, ix %D iy %D",n,ny);
+  ierr = ISGetIndices(ix,&xidx);CHKERRQ(ierr);
+  ierr = ISGetIndices(iy,&yidx);CHKERRQ(ierr);
+
+  layout[0] = x->map->rstart; layout[1] = x->map->n; layout[2] = xseq ? -1 : x->map->N;
+  layout[3] = y->map->rstart; layout[4] = y->map->n; layout[5] = yseq ? -1 : y->map->N;
+  ierr = PetscOptionsGetInt(((PetscObject)ctx)->options,((PetscObject)ctx)->prefix,"-vecscatter_sf_cache_size",&maxentries,NULL);CHKERRQ(ierr);
+  if (!xseq && !yseq) {
+    /* x may live on another ordering of the processes of y, then its owners are translated and the star forest is not cached */
+    ierr = MPI_Comm_compare(PetscObjectComm((PetscObject)x),comm,&result);CHKERRQ(ierr);
+    if (result != MPI_IDENT && result != MPI_CONGRUENT) {
+      MPI_Group xgroup,group;
+      PetscMPIInt *ranks;
+
+      ierr = PetscMalloc1(xsize,&ranks);CHKERRQ(ierr);
+      ierr = PetscMalloc1(xsize,&xranks);CHKERRQ(ierr);
+      for (i=0; i<xsize; i++) ranks[i] = (PetscMPIInt)i;
+      ierr = MPI_Comm_group(PetscObjectComm((PetscObject)x),&xgroup);CHKERRQ(ierr);
+      ierr = MPI_Comm_group(comm,&group);CHKERRQ(ierr);
+      ierr = MPI_Group_translate_ranks(xgroup,xsize,ranks,group,xranks);CHKERRQ(ierr);
+      ierr = MPI_Group_free(&xgroup);CHKERRQ(ierr);
+      ierr = MPI_Group_free(&group);CHKERRQ(ierr);
+      ierr = PetscFree(ranks);CHKERRQ(ierr);
+      maxentries = 0;
+    }
+  }
+  if (maxentries > 0) {
+    for (i=0; i<6; i++) hash = PetscHashCombine(hash,PetscHashInt(layout[i]));
+    for (i=0; i<n; i++) hash = PetscHashCombine(PetscHashCombine(hash,PetscHashInt(xidx[i])),PetscHashInt(yidx[i]));
+    ierr = VecScatterSFCacheFind_Private(comm,layout,hash,n,xidx,yidx,&entry);CHKERRQ(ierr);
+  }
+
+  /* One reduction tells whether all processes found the same entry and whether pairs have to move to other processes */
+  red[0] = entry ? entry->id : -1;
+  red[1] = entry ? -entry->id : 1;
+  red[2] = 0;
+  if (!entry && !yseq) {
+    for (i=0; i<n; i++) {
+      if (yidx[i] < y->map->rstart || yidx[i] >= y->map->rend) {red[2] = 1; break;}
+    }
+  }
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,red,3,MPIU_INT,MPI_MAX,comm);CHKERRQ(ierr);
+
+  if (red[0] >= 0 && red[0] == -red[1]) {
+    ierr = PetscInfo(ctx,"Reusing the PetscSF of an identical scatter\n");CHKERRQ(ierr);
+    ierr = VecScatterSFSetData_Private(ctx,entry->sf,entry->nleaves,entry->slots);CHKERRQ(ierr);
+  } else {
+    ierr = VecScatterSFBuild_Private(ctx,xseq,yseq,xranks,red[2] ? PETSC_TRUE : PETSC_FALSE,n,xidx,yidx,&sf,&nleaves,&slots);CHKERRQ(ierr);
+    ierr = VecScatterSFSetData_Private(ctx,sf,nleaves,slots);CHKERRQ(ierr);
+    if (maxentries > 0) {ierr = VecScatterSFCacheInsert_Private(comm,maxentries,layout,hash,n,xidx,yidx,sf,nleaves,slots);CHKERRQ(ierr);}
+    ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+    ierr = PetscFree(slots);CHKERRQ(ierr);
+  }
+  ierr = ISRestoreIndices(ix,&xidx);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(iy,&yidx);CHKERRQ(ierr);
+  ierr = ISDestroy(&tix);CHKERRQ(ierr);
+  ierr = ISDestroy(&tiy);CHKERRQ(ierr);
+  ierr = PetscFree(xranks);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecScatterCreate_SF(VecScatter ctx)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ctx->ops->setup = VecScatterSetUp_SF;
+  ierr = PetscObjectChangeTypeName((PetscObject)ctx,VECSCATTERSF);CHKERRQ(ierr);
+  ierr = PetscInfo(ctx,"Using PetscSF for vector scatter\n");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
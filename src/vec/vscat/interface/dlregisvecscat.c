@@ -18,6 +18,7 @@ PetscErrorCode VecScatterFinalizePackage(void)
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  ierr = VecScatterSFCacheDestroy();CHKERRQ(ierr);
   ierr = PetscFunctionListDestroy(&VecScatterList);CHKERRQ(ierr);
   VecScatterPackageInitialized = PETSC_FALSE;
   VecScatterRegisterAllCalled  = PETSC_FALSE;
@@ -86,6 +87,7 @@ PetscErrorCode VecScatterRegisterAll(void)
 
   ierr = VecScatterRegister(VECSCATTERSEQ,        VecScatterCreate_Seq);CHKERRQ(ierr);
   ierr = VecScatterRegister(VECSCATTERMPI1,       VecScatterCreate_MPI1);CHKERRQ(ierr);
+  ierr = VecScatterRegister(VECSCATTERSF,         VecScatterCreate_SF);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MPI_WIN_CREATE_FEATURE)
   ierr = VecScatterRegister(VECSCATTERMPI3,       VecScatterCreate_MPI3);CHKERRQ(ierr);
   ierr = VecScatterRegister(VECSCATTERMPI3NODE,   VecScatterCreate_MPI3Node);CHKERRQ(ierr);
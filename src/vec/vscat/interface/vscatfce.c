@@ -158,6 +158,123 @@ PetscErrorCode  VecScatterEnd(VecScatter ctx,Vec x,Vec y,InsertMode addv,Scatter
   PetscFunctionReturn(0);
 }
 
+/*@
+   VecScatterBeginMulti - Begins a generalized scatter of several vectors with the same scatter context,
+   communicating all of them together
+
+   Neighbor-wise Collective on VecScatter and Vec
+
+   Input Parameters:
++  ctx - scatter context generated by VecScatterCreateWithData()
+.  nv - the number of vectors
+.  x - the vectors from which we scatter
+.  y - the vectors to which we scatter
+.  addv - either ADD_VALUES, INSERT_VALUES or MAX_VALUES
+-  mode - the scattering mode, SCATTER_FORWARD or SCATTER_REVERSE
+
+   Level: intermediate
+
+   Notes:
+   This is equivalent to scattering x[i] to y[i] with VecScatterBegin() and VecScatterEnd() for each i, but the
+   values of all the vectors going to a given process are sent in a single message, so the latency is paid once
+   instead of nv times. This is useful for block Krylov methods and for solves with several right hand sides.
+
+   The scatter types that do not pack the vectors together scatter them one after the other.
+
+   You cannot change the values in the vectors x between the calls to VecScatterBeginMulti() and VecScatterEndMulti().
+
+.seealso: VecScatterEndMulti(), VecScatterBegin(), VecScatterCreateWithData()
+@*/
+PetscErrorCode VecScatterBeginMulti(VecScatter ctx,PetscInt nv,Vec x[],Vec y[],InsertMode addv,ScatterMode mode)
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+#if defined(PETSC_USE_DEBUG)
+  PetscInt       to_n,from_n;
+#endif
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ctx,VEC_SCATTER_CLASSID,1);
+  if (nv < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of vectors %D cannot be negative",nv);
+  if (!nv) PetscFunctionReturn(0);
+  PetscValidPointer(x,3);
+  PetscValidPointer(y,4);
+  if (!ctx->ops->beginmulti) {
+    /* Scatter all but the last vector now, the last one is completed by VecScatterEndMulti() */
+    for (i=0; i<nv-1; i++) {
+      ierr = VecScatterBegin(ctx,x[i],y[i],addv,mode);CHKERRQ(ierr);
+      ierr = VecScatterEnd(ctx,x[i],y[i],addv,mode);CHKERRQ(ierr);
+    }
+    ierr = VecScatterBegin(ctx,x[nv-1],y[nv-1],addv,mode);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (ctx->inuse) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE," Scatter ctx already in use");
+  for (i=0; i<nv; i++) {
+    PetscValidHeaderSpecific(x[i],VEC_CLASSID,3);
+    PetscValidHeaderSpecific(y[i],VEC_CLASSID,4);
+#if defined(PETSC_USE_DEBUG)
+    if (ctx->from_n >= 0 && ctx->to_n >= 0) {
+      ierr = VecGetLocalSize(x[i],&from_n);CHKERRQ(ierr);
+      ierr = VecGetLocalSize(y[i],&to_n);CHKERRQ(ierr);
+      if (mode & SCATTER_REVERSE) {PetscInt t = to_n; to_n = from_n; from_n = t;}
+      if (to_n != ctx->to_n || from_n != ctx->from_n) SETERRQ5(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Vectors %D have wrong sizes %D and %D for scatter %D and %D",i,from_n,to_n,ctx->from_n,ctx->to_n);
+    }
+#endif
+  }
+
+  ctx->inuse = PETSC_TRUE;
+  ierr = PetscLogEventBegin(VEC_ScatterBegin,ctx,x[0],y[0],0);CHKERRQ(ierr);
+  ierr = (*ctx->ops->beginmulti)(ctx,nv,x,y,addv,mode);CHKERRQ(ierr);
+  if (ctx->beginandendtogether) {
+    ctx->inuse = PETSC_FALSE;
+    ierr = (*ctx->ops->endmulti)(ctx,nv,x,y,addv,mode);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventEnd(VEC_ScatterBegin,ctx,x[0],y[0],0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecScatterEndMulti - Ends a generalized scatter of several vectors started with VecScatterBeginMulti()
+
+   Neighbor-wise Collective on VecScatter and Vec
+
+   Input Parameters:
++  ctx - scatter context generated by VecScatterCreateWithData()
+.  nv - the number of vectors
+.  x - the vectors from which we scatter
+.  y - the vectors to which we scatter
+.  addv - either ADD_VALUES, INSERT_VALUES or MAX_VALUES
+-  mode - the scattering mode, SCATTER_FORWARD or SCATTER_REVERSE
+
+   Level: intermediate
+
+   Notes:
+   The arguments must be the same as those passed to VecScatterBeginMulti().
+
+.seealso: VecScatterBeginMulti(), VecScatterEnd()
+@*/
+PetscErrorCode VecScatterEndMulti(VecScatter ctx,PetscInt nv,Vec x[],Vec y[],InsertMode addv,ScatterMode mode)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ctx,VEC_SCATTER_CLASSID,1);
+  if (!nv) PetscFunctionReturn(0);
+  PetscValidPointer(x,3);
+  PetscValidPointer(y,4);
+  if (!ctx->ops->endmulti) {
+    ierr = VecScatterEnd(ctx,x[nv-1],y[nv-1],addv,mode);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ctx->inuse = PETSC_FALSE;
+  if (!ctx->beginandendtogether) {
+    ierr = PetscLogEventBegin(VEC_ScatterEnd,ctx,x[0],y[0],0);CHKERRQ(ierr);
+    ierr = (*ctx->ops->endmulti)(ctx,nv,x,y,addv,mode);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(VEC_ScatterEnd,ctx,x[0],y[0],0);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 /*@
    VecScatterDestroy - Destroys a scatter context created by
    VecScatterCreate() or VecScatterCreateWithData()
@@ -318,7 +435,9 @@ PetscErrorCode  VecScatterRemap(VecScatter scat,PetscInt tomap[],PetscInt fromma
   sgfrom = (VecScatter_Seq_General*)scat->fromdata;
 
   /* remap indices from where we take/read data */
-  if (tomap) {
+  if (to->format == VEC_SCATTER_SF) {
+    ierr = VecScatterRemap_SF(scat,tomap,frommap);CHKERRQ(ierr);
+  } else if (tomap) {
     if (to->format == VEC_SCATTER_MPI_TOALL) {
       SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Not for to all scatter");
     } else if (to->format == VEC_SCATTER_MPI_GENERAL) {
@@ -273,6 +273,8 @@ PetscErrorCode VecScatterSetData(VecScatter ctx,Vec xin,IS ix,Vec yin,IS iy)
                               eliminates the chance for overlap of computation and communication
 .  -vecscatter_packtogether - Pack all messages before sending, receive all messages before unpacking
                               will make the results of scatters deterministic when otherwise they are not (it may be slower also).
+.  -vecscatter_type sf      - Use a PetscSF for the communication, reusing the PetscSF of a previous identical scatter
+-  -vecscatter_sf_cache_size <4> - Number of PetscSF kept for reuse on each communicator with -vecscatter_type sf, 0 disables the reuse
 
     Level: intermediate
 
@@ -294,6 +296,9 @@ PetscErrorCode VecScatterSetData(VecScatter ctx,Vec xin,IS ix,Vec yin,IS iy)
 
    Both ix and iy cannot be NULL at the same time.
 
+   With -vecscatter_type sf each cached PetscSF keeps its graph and a copy of ix and iy after the scatters
+   using it are destroyed, until newer scatters on the same communicator evict it or PetscFinalize() is called.
+
    Concepts: scatter^between vectors
    Concepts: gather^between vectors
 